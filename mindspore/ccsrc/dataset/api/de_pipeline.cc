@@ -25,6 +25,7 @@
 #include "dataset/engine/datasetops/source/voc_op.h"
 #include "dataset/core/tensor.h"
 #include "dataset/engine/dataset_iterator.h"
+#include "dataset/engine/datasetops/cache_op.h"
 #include "dataset/engine/datasetops/source/manifest_op.h"
 #include "dataset/engine/datasetops/source/cifar_op.h"
 #include "dataset/engine/datasetops/source/celeba_op.h"
@@ -43,6 +44,7 @@ using pFunction = Status (DEPipeline::*)(const py::dict &, std::shared_ptr<Datas
 
 static std::unordered_map<uint32_t, pFunction> g_parse_op_func_ = {{kStorage, &DEPipeline::ParseStorageOp},
                                                                    {kShuffle, &DEPipeline::ParseShuffleOp},
+                                                                   {kCache, &DEPipeline::ParseCacheOp},
                                                                    {kMindrecord, &DEPipeline::ParseMindRecordOp},
                                                                    {kMap, &DEPipeline::ParseMapOp},
                                                                    {kBatch, &DEPipeline::ParseBatchOp},
@@ -84,6 +86,10 @@ DEPipeline::~DEPipeline() {
   {
     // Release GIL before joining all threads
     py::gil_scoped_release gil_release;
+    Status rc = tree_->Stop();
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to stop the dataset pipeline: " << rc.ToString();
+    }
     // Release tree
     tree_.reset();
   }
@@ -359,6 +365,20 @@ Status DEPipeline::ParseShuffleOp(const py::dict &args, std::shared_ptr<DatasetO
   return Status::OK();
 }
 
+Status DEPipeline::ParseCacheOp(const py::dict &args, std::shared_ptr<DatasetOp> *ptr) {
+  std::shared_ptr<CacheOp::Builder> builder = std::make_shared<CacheOp::Builder>();
+  if (!args["cache_mem_size"].is_none()) {
+    (void)builder->SetCacheMemSize(py::reinterpret_borrow<py::int_>(args["cache_mem_size"]).cast<int64_t>());
+  }
+  if (!args["spill_dir"].is_none()) {
+    (void)builder->SetSpillDir(ToString(args["spill_dir"]));
+  }
+  std::shared_ptr<CacheOp> op;
+  RETURN_IF_NOT_OK(builder->Build(&op));
+  *ptr = op;
+  return Status::OK();
+}
+
 Status DEPipeline::CheckMindRecordPartitionInfo(const py::dict &args, std::vector<int> *in_partitions) {
   if (args["partitions"].is_none()) {
     std::string err_msg = "Error: partitions is not set (None)";
@@ -419,6 +439,10 @@ Status DEPipeline::ParseMindRecordOp(const py::dict &args, std::shared_ptr<Datas
         (void)builder->SetNumMindRecordWorkers(ToInt(value));
       } else if (key == "block_reader" && ToBool(value) == true) {
         (void)builder->SetBlockReader();
+      } else if (key == "use_mmap" && ToBool(value) == true) {
+        (void)builder->SetUseMmap();
+      } else if (key == "read_ahead_size") {
+        (void)builder->SetReadAheadSize(ToInt(value));
       } else if (key == "global_shuffle" && ToBool(value) == true) {
         uint32_t seed = args["partitions"].is_none() ? GetSeed() : 0;
         operators.push_back(std::make_shared<mindrecord::ShardShuffle>(seed));
@@ -183,11 +183,21 @@ void bindTensor(py::module *m) {
     .def("set_worker_connector_size", &ConfigManager::set_worker_connector_size)
     .def("set_op_connector_size", &ConfigManager::set_op_connector_size)
     .def("set_seed", &ConfigManager::set_seed)
+    .def("set_auto_num_workers", &ConfigManager::set_auto_num_workers)
+    .def("set_cpu_budget", &ConfigManager::set_cpu_budget)
+    .def("set_profiling_dir", &ConfigManager::set_profiling_dir)
+    .def("set_monitor_sampling_interval", &ConfigManager::set_monitor_sampling_interval)
+    .def("set_pinned_pool_size", &ConfigManager::set_pinned_pool_size)
     .def("get_rows_per_buffer", &ConfigManager::rows_per_buffer)
     .def("get_num_parallel_workers", &ConfigManager::num_parallel_workers)
     .def("get_worker_connector_size", &ConfigManager::worker_connector_size)
     .def("get_op_connector_size", &ConfigManager::op_connector_size)
     .def("get_seed", &ConfigManager::seed)
+    .def("get_auto_num_workers", &ConfigManager::auto_num_workers)
+    .def("get_cpu_budget", &ConfigManager::cpu_budget)
+    .def("get_profiling_dir", &ConfigManager::profiling_dir)
+    .def("get_monitor_sampling_interval", &ConfigManager::monitor_sampling_interval)
+    .def("get_pinned_pool_size", &ConfigManager::pinned_pool_size)
     .def("load", [](ConfigManager &c, std::string s) { (void)c.LoadFile(s); });
 
   (void)py::class_<Tensor, std::shared_ptr<Tensor>>(*m, "Tensor", py::buffer_protocol())
@@ -363,13 +373,14 @@ void bindTensorOps4(py::module *m) {
 
   (void)py::class_<RandomCropDecodeResizeOp, TensorOp, std::shared_ptr<RandomCropDecodeResizeOp>>(
     *m, "RandomCropDecodeResizeOp", "equivalent to RandomCropAndResize but crops before decoding")
-    .def(py::init<int32_t, int32_t, float, float, float, float, InterpolationMode, int32_t>(), py::arg("targetHeight"),
-         py::arg("targetWidth"), py::arg("scaleLb") = RandomCropDecodeResizeOp::kDefScaleLb,
+    .def(py::init<int32_t, int32_t, float, float, float, float, InterpolationMode, int32_t, bool>(),
+         py::arg("targetHeight"), py::arg("targetWidth"), py::arg("scaleLb") = RandomCropDecodeResizeOp::kDefScaleLb,
          py::arg("scaleUb") = RandomCropDecodeResizeOp::kDefScaleUb,
          py::arg("aspectLb") = RandomCropDecodeResizeOp::kDefAspectLb,
          py::arg("aspectUb") = RandomCropDecodeResizeOp::kDefAspectUb,
          py::arg("interpolation") = RandomCropDecodeResizeOp::kDefInterpolation,
-         py::arg("maxIter") = RandomCropDecodeResizeOp::kDefMaxIter);
+         py::arg("maxIter") = RandomCropDecodeResizeOp::kDefMaxIter,
+         py::arg("dctScaling") = RandomCropDecodeResizeOp::kDefDctScaling);
 
   (void)py::class_<PadOp, TensorOp, std::shared_ptr<PadOp>>(
     *m, "PadOp",
@@ -31,7 +31,12 @@ void ConfigManager::Print(std::ostream &out) const {
       << "\nDataCache Rows per buffer    : " << rows_per_buffer_
       << "\nParallelOp workers           : " << num_parallel_workers_
       << "\nParallelOp worker connector size    : " << worker_connector_size_
-      << "\nSize of each Connector : " << op_connector_size_ << std::endl;
+      << "\nSize of each Connector : " << op_connector_size_
+      << "\nAuto num workers             : " << std::boolalpha << auto_num_workers_
+      << "\nCpu budget                   : " << cpu_budget_
+      << "\nProfiling dir                : " << profiling_dir_
+      << "\nMonitor sampling interval    : " << monitor_sampling_interval_
+      << "\nPinned pool size (MB)        : " << pinned_pool_size_ << std::endl;
 }
 
 // Private helper function that taks a nlohmann json format and populates the settings
@@ -41,6 +46,11 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_worker_connector_size(j.value("workerConnectorSize", worker_connector_size_));
   set_op_connector_size(j.value("opConnectorSize", op_connector_size_));
   set_seed(j.value("seed", seed_));
+  set_auto_num_workers(j.value("autoNumWorkers", auto_num_workers_));
+  set_cpu_budget(j.value("cpuBudget", cpu_budget_));
+  set_profiling_dir(j.value("profilingDir", profiling_dir_));
+  set_monitor_sampling_interval(j.value("monitorSamplingInterval", monitor_sampling_interval_));
+  set_pinned_pool_size(j.value("pinnedPoolSize", pinned_pool_size_));
   return Status::OK();
 }
 
@@ -88,5 +98,20 @@ void ConfigManager::set_op_connector_size(int32_t connector_size) { op_connector
 uint32_t ConfigManager::seed() const { return seed_; }
 
 void ConfigManager::set_seed(uint32_t seed) { seed_ = seed; }
+
+// Setter function
+void ConfigManager::set_auto_num_workers(bool auto_num_workers) { auto_num_workers_ = auto_num_workers; }
+
+// Setter function
+void ConfigManager::set_cpu_budget(int32_t cpu_budget) { cpu_budget_ = cpu_budget; }
+
+// Setter function
+void ConfigManager::set_profiling_dir(const std::string &profiling_dir) { profiling_dir_ = profiling_dir; }
+
+// Setter function
+void ConfigManager::set_monitor_sampling_interval(int32_t interval) { monitor_sampling_interval_ = interval; }
+
+// Setter function
+void ConfigManager::set_pinned_pool_size(int32_t size) { pinned_pool_size_ = size; }
 }  // namespace dataset
 }  // namespace mindspore
@@ -105,6 +105,47 @@ class ConfigManager {
   // @param connector_size - The setting to apply to the config
   void set_op_connector_size(int32_t connector_size);
 
+  // getter function
+  // @return True if the execution tree tunes the number of running workers of each op
+  bool auto_num_workers() const { return auto_num_workers_; }
+
+  // setter function
+  // @param auto_num_workers - Whether the execution tree tunes the number of running workers of each op
+  void set_auto_num_workers(bool auto_num_workers);
+
+  // getter function
+  // @return The number of worker threads the auto tune shares between the ops, 0 means the number of cpus
+  int32_t cpu_budget() const { return cpu_budget_; }
+
+  // setter function
+  // @param cpu_budget - The number of worker threads the auto tune shares between the ops
+  void set_cpu_budget(int32_t cpu_budget);
+
+  // getter function
+  // @return The directory the pipeline profiling is written to, empty if the pipeline is not profiled
+  const std::string &profiling_dir() const { return profiling_dir_; }
+
+  // setter function
+  // @param profiling_dir - The directory the pipeline profiling is written to, empty to turn off the profiling
+  void set_profiling_dir(const std::string &profiling_dir);
+
+  // getter function
+  // @return The interval in milliseconds between two samples of the pipeline profiling
+  int32_t monitor_sampling_interval() const { return monitor_sampling_interval_; }
+
+  // setter function
+  // @param interval - The interval in milliseconds between two samples of the pipeline profiling
+  void set_monitor_sampling_interval(int32_t interval);
+
+  // getter function
+  // @return The size in MB of the pinned memory pool the batches are allocated from, 0 if the batches are not pinned
+  int32_t pinned_pool_size() const { return pinned_pool_size_; }
+
+  // setter function
+  // @param size - The size in MB of the pinned memory pool, 0 to not pin the batches. The pool is created the
+  //     first time a pipeline uses it, later changes of the size other than 0 have no effect.
+  void set_pinned_pool_size(int32_t size);
+
   uint32_t seed() const;
 
   // setter function
@@ -117,6 +158,11 @@ class ConfigManager {
   int32_t worker_connector_size_{kCfgWorkerConnectorSize};
   int32_t op_connector_size_{kCfgOpConnectorSize};
   uint32_t seed_{kCfgDefaultSeed};
+  bool auto_num_workers_{false};
+  int32_t cpu_budget_{0};
+  std::string profiling_dir_;
+  int32_t monitor_sampling_interval_{kCfgMonitorSamplingInterval};
+  int32_t pinned_pool_size_{0};
 
   // Private helper function that taks a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
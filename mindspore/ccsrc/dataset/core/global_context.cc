@@ -22,8 +22,10 @@
 #include "dataset/core/cv_tensor.h"
 #include "dataset/core/tensor.h"
 #include "dataset/util/allocator.h"
+#include "dataset/util/arena.h"
 #include "dataset/util/circular_pool.h"
 #include "dataset/util/system_pool.h"
+#include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace dataset {
@@ -61,6 +63,25 @@ Status GlobalContext::Init() {
   return Status::OK();
 }
 
+std::shared_ptr<MemoryPool> GlobalContext::pinned_pool() {
+  std::unique_lock<std::mutex> lck(pinned_pool_mux_);
+  int32_t size_in_MB = config_manager_->pinned_pool_size();
+  if (size_in_MB <= 0) {
+    return nullptr;
+  }
+  // Once created, the pool keeps its size
+  if (pinned_pool_ == nullptr) {
+    std::shared_ptr<Arena> arena;
+    Status rc = Arena::CreateArena(&arena, static_cast<size_t>(size_in_MB), true);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to create a pinned pool of " << size_in_MB << " MB: " << rc.ToString() << ".";
+      return nullptr;
+    }
+    pinned_pool_ = arena;
+  }
+  return pinned_pool_;
+}
+
 // A print method typically used for debugging
 void GlobalContext::Print(std::ostream &out) const {
   out << "GlobalContext contains the following default config: " << *config_manager_ << "\n";
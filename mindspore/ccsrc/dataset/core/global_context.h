@@ -86,6 +86,11 @@ class GlobalContext {
   // @return the integer allocator as raw pointer
   const IntAlloc *int_allocator() const { return int_allocator_.get(); }
 
+  // Getter method. The pool is created on the first call with the pinned pool size of the config, and kept
+  // for the later calls as long as the size is not set back to 0.
+  // @return the pool of pinned memory the batches are allocated from, null if the pinned pool size is 0
+  std::shared_ptr<MemoryPool> pinned_pool();
+
  private:
   // Constructor.
   // @note Singleton.  Instantiation flows through instance()
@@ -101,6 +106,8 @@ class GlobalContext {
   std::unique_ptr<TensorAlloc> tensor_allocator_;         // An allocator for Tensors
   std::unique_ptr<CVTensorAlloc> cv_tensor_allocator_;    // An allocator for CV Tensors
   std::unique_ptr<IntAlloc> int_allocator_;               // An allocator for ints
+  std::mutex pinned_pool_mux_;                            // Guards the creation of the pinned pool
+  std::shared_ptr<MemoryPool> pinned_pool_;               // A pool of page-locked memory for the batches
 };
 }  // namespace dataset
 }  // namespace mindspore
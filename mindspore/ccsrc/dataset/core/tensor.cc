@@ -120,6 +120,17 @@ Status Tensor::CreateTensor(std::shared_ptr<Tensor> *ptr, TensorImpl tensor_impl
   return Status::OK();  // returns base-class shared_ptr
 }
 
+Status Tensor::CreateTensor(std::shared_ptr<Tensor> *ptr, const TensorShape &shape, DataType type,
+                            const std::shared_ptr<MemoryPool> &pool) {
+  RETURN_UNEXPECTED_IF_NULL(pool);
+  RETURN_IF_NOT_OK(CreateTensor(ptr, TensorImpl::kFlexible, shape, type));
+  void *data = nullptr;
+  RETURN_IF_NOT_OK(pool->Allocate((*ptr)->SizeInBytes(), &data));
+  (*ptr)->data_allocator_ = std::make_unique<Allocator<unsigned char>>(pool);
+  (*ptr)->data_ = static_cast<unsigned char *>(data);
+  return Status::OK();
+}
+
 Status Tensor::CreateTensor(std::shared_ptr<Tensor> *ptr, py::array arr) {
   const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
   *ptr = std::allocate_shared<Tensor>(*alloc, TensorShape({}), DataType(DataType::DE_UNKNOWN));
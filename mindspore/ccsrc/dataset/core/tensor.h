@@ -87,6 +87,16 @@ class Tensor {
   // @return Status Code
   static Status CreateTensor(std::shared_ptr<Tensor> *ptr, py::array arr);
 
+  // A static factory method to create a flexible Tensor whose data is allocated from the given pool instead of
+  // the global one. The data is not initialized.
+  // @param ptr output argument to hold the created Tensor
+  // @param shape - shape of the tensor
+  // @param type - datatype of the tensor
+  // @param pool - the pool to allocate the data from
+  // @return Status Code, kOutOfMemory if the pool has no room for the data
+  static Status CreateTensor(std::shared_ptr<Tensor> *ptr, const TensorShape &shape, DataType type,
+                             const std::shared_ptr<MemoryPool> &pool);
+
   // Copy raw data of a array based on shape and strides to the destination pointer
   // @param dst Pointer to the destination array where the content is to be copied
   // @param src Pointer to the source of stided array to be copied
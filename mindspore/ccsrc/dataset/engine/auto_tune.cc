@@ -0,0 +1,180 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/auto_tune.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "dataset/engine/datasetops/dataset_op.h"
+#include "dataset/engine/execution_tree.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int32_t kSampleIntervalMs = 100;
+constexpr int32_t kSamplesPerTune = 10;
+constexpr double kHighOccupancy = 0.7;
+constexpr double kLowOccupancy = 0.3;
+}  // namespace
+
+AutoTune::AutoTune(ExecutionTree *tree, int32_t cpu_budget) : tree_(tree), cpu_budget_(cpu_budget), num_samples_(0) {
+  if (cpu_budget_ <= 0) {
+    cpu_budget_ = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+  }
+}
+
+Status AutoTune::Init() {
+  RETURN_IF_NOT_OK(quota_cv_.Register(tree_->AllTasks()->GetIntrpService()));
+  int32_t total_workers = 0;
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    DatasetOp *op = itr.get().get();
+    if (op->inlined()) {
+      continue;
+    }
+    // Look through the inlined ops, such as repeat, for the op that fills our input
+    DatasetOp *input = nullptr;
+    if (op->num_children() > 0) {
+      input = op->child(0).get();
+      while (input->inlined() && input->num_children() > 0) {
+        input = input->child(0).get();
+      }
+    }
+    int32_t max_workers = std::max(op->num_workers(), 1);
+    ops_[op->id()] = {op, input, max_workers, max_workers, 0, false, 0.0, 0.0};
+    total_workers += max_workers;
+  }
+  // Split the budget in proportion to the workers each op is built with
+  if (total_workers > cpu_budget_) {
+    for (auto &item : ops_) {
+      auto &info = item.second;
+      int64_t share = static_cast<int64_t>(info.max_workers) * cpu_budget_ / total_workers;
+      info.quota = std::max(static_cast<int32_t>(share), 1);
+    }
+  }
+  MS_LOG(INFO) << "Auto tune shares " << cpu_budget_ << " running workers between " << ops_.size()
+               << " operators with " << total_workers << " workers.";
+  return Status::OK();
+}
+
+Status AutoTune::operator()() {
+  // Synchronize with TaskManager once the thread is launched.
+  TaskManager::FindMe()->Post();
+  while (!this_thread::is_interrupted()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(kSampleIntervalMs));
+    Sample();
+  }
+  return Status::OK();
+}
+
+Status AutoTune::AcquireWorkerQuota(int32_t op_id) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto iter = ops_.find(op_id);
+  if (iter == ops_.end()) {
+    return Status::OK();
+  }
+  auto &info = iter->second;
+  info.enforced = true;
+  RETURN_IF_NOT_OK(quota_cv_.Wait(&lck, [&info]() { return info.running < info.quota; }));
+  info.running++;
+  return Status::OK();
+}
+
+void AutoTune::ReleaseWorkerQuota(int32_t op_id) {
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    auto iter = ops_.find(op_id);
+    if (iter == ops_.end()) {
+      return;
+    }
+    iter->second.running--;
+  }
+  quota_cv_.NotifyAll();
+}
+
+int32_t AutoTune::GetWorkerQuota(int32_t op_id) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto iter = ops_.find(op_id);
+  return (iter == ops_.end()) ? 0 : iter->second.quota;
+}
+
+double AutoTune::Occupancy(const DatasetOp *op) {
+  int32_t capacity = op->ConnectorCapacity();
+  return (capacity == 0) ? 0.0 : static_cast<double>(op->ConnectorSize()) / capacity;
+}
+
+void AutoTune::Sample() {
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    for (auto &item : ops_) {
+      auto &info = item.second;
+      info.out_occupancy += Occupancy(info.op);
+      // A leaf is never short of input
+      info.in_occupancy += (info.input == nullptr) ? 1.0 : Occupancy(info.input);
+    }
+    if (++num_samples_ < kSamplesPerTune) {
+      return;
+    }
+    Tune();
+  }
+  quota_cv_.NotifyAll();
+}
+
+void AutoTune::Tune() {
+  OpTuneInfo *bottleneck = nullptr;
+  OpTuneInfo *donor = nullptr;
+  int32_t total_quota = 0;
+  for (auto &item : ops_) {
+    auto &info = item.second;
+    info.out_occupancy /= num_samples_;
+    info.in_occupancy /= num_samples_;
+    total_quota += info.quota;
+    if (!info.enforced) {
+      continue;
+    }
+    // Waiting input and no output means the op is too slow for its neighbours
+    if (info.in_occupancy >= kHighOccupancy && info.out_occupancy <= kLowOccupancy && info.quota < info.max_workers &&
+        (bottleneck == nullptr ||
+         info.in_occupancy - info.out_occupancy > bottleneck->in_occupancy - bottleneck->out_occupancy)) {
+      bottleneck = &info;
+    }
+    // A full output means the consumer can't keep up, so the op can give up a worker
+    if (info.out_occupancy >= kHighOccupancy && info.quota > 1 &&
+        (donor == nullptr || info.out_occupancy > donor->out_occupancy)) {
+      donor = &info;
+    }
+  }
+  if (bottleneck != nullptr) {
+    if (total_quota < cpu_budget_) {
+      bottleneck->quota++;
+      MS_LOG(INFO) << "Auto tune adds a worker to bottleneck operator " << bottleneck->op->id() << ", quota is now "
+                   << bottleneck->quota << ".";
+    } else if (donor != nullptr && donor != bottleneck) {
+      donor->quota--;
+      bottleneck->quota++;
+      MS_LOG(INFO) << "Auto tune moves a worker from operator " << donor->op->id() << " to bottleneck operator "
+                   << bottleneck->op->id() << ", quotas are now " << donor->quota << " and " << bottleneck->quota
+                   << ".";
+    }
+  }
+  for (auto &item : ops_) {
+    item.second.out_occupancy = 0.0;
+    item.second.in_occupancy = 0.0;
+  }
+  num_samples_ = 0;
+}
+}  // namespace dataset
+}  // namespace mindspore
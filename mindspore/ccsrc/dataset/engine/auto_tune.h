@@ -0,0 +1,107 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_AUTO_TUNE_H_
+#define DATASET_ENGINE_AUTO_TUNE_H_
+
+#include <mutex>
+#include <unordered_map>
+#include "dataset/util/cond_var.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Forward declares
+class ExecutionTree;
+class DatasetOp;
+
+// The AutoTune shares a budget of running worker threads between the operators of an execution tree.
+// The ops keep the number of worker threads they are built with, since the order of the buffers
+// relies on a fixed round robin between the workers. Instead, the workers of the ops which support
+// it take a quota slot around the compute part of their work, and the auto tune moves the slots
+// between the ops at runtime:
+// - Every sample interval the occupancy of the output connector of each op is recorded.
+// - Every tune interval, the op with a full input connector and an empty output connector is the
+//   bottleneck. It gets a slot from the free budget, or from the op with the fullest output
+//   connector, whose consumer can't keep up anyway.
+class AutoTune {
+ public:
+  // Constructor
+  // @param tree - The execution tree to tune
+  // @param cpu_budget - The number of worker threads allowed to run at the same time, 0 means the number of cpus
+  AutoTune(ExecutionTree *tree, int32_t cpu_budget);
+
+  // Destructor
+  ~AutoTune() = default;
+
+  // Collects the ops of the tree and splits the budget between them. Must be called after the
+  // tree is prepared.
+  // @return Status - The error code return
+  Status Init();
+
+  // The sampling and tuning loop, it runs in its own thread until the tree is stopped.
+  // @return Status - The error code return
+  Status operator()();
+
+  // Called by a worker of the op before its compute work, blocks while the op is using all of its quota.
+  // @param op_id - The id of the op of the worker
+  // @return Status - The error code return
+  Status AcquireWorkerQuota(int32_t op_id);
+
+  // Called by a worker of the op after its compute work.
+  // @param op_id - The id of the op of the worker
+  void ReleaseWorkerQuota(int32_t op_id);
+
+  // Getter function
+  // @param op_id - The id of the op
+  // @return The number of workers of the op allowed to run at the same time
+  int32_t GetWorkerQuota(int32_t op_id);
+
+  // Getter function
+  // @return The number of worker threads allowed to run at the same time
+  int32_t cpu_budget() const { return cpu_budget_; }
+
+ private:
+  struct OpTuneInfo {
+    DatasetOp *op;     // The op being tuned
+    DatasetOp *input;  // The op producing the input of this op, null for a leaf
+    int32_t max_workers;
+    int32_t quota;
+    int32_t running;
+    bool enforced;  // The workers of the op take quota slots
+    double out_occupancy;
+    double in_occupancy;
+  };
+
+  // Takes a sample of the connector occupancies.
+  void Sample();
+
+  // Moves a quota slot toward the bottleneck op based on the collected samples.
+  void Tune();
+
+  // Returns the occupancy of the output connector of the op in [0, 1].
+  static double Occupancy(const DatasetOp *op);
+
+  ExecutionTree *tree_;
+  int32_t cpu_budget_;
+  int32_t num_samples_;
+  std::mutex mux_;
+  CondVar quota_cv_;
+  std::unordered_map<int32_t, OpTuneInfo> ops_;  // Keyed by the op id
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_AUTO_TUNE_H_
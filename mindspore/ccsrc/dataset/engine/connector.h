@@ -141,6 +141,34 @@ class Connector {
     MS_LOG(INFO) << "Connector counters reset.";
   }
 
+  // Getter function. The value is only a snapshot since the producers and consumers keep running.
+  // @return The total number of elements held in the internal queues
+  int32_t size() const {
+    int32_t total = 0;
+    for (int i = 0; i < queues_.size(); ++i) {
+      total += queues_[i]->LockedSize();
+    }
+    return total;
+  }
+
+  // Getter function
+  // @return The total capacity of the internal queues
+  int32_t capacity() const {
+    int32_t total = 0;
+    for (int i = 0; i < queues_.size(); ++i) {
+      total += queues_[i]->capacity();
+    }
+    return total;
+  }
+
+  // Getter function
+  // @return The number of threads producing data into this connector
+  int32_t num_producers() const { return num_producers_; }
+
+  // Getter function
+  // @return The number of threads consuming data from this connector
+  int32_t num_consumers() const { return num_consumers_; }
+
   void Print(std::ostream &out, bool showAll) const {
     out << "\n--------- Connector ------------"
         << "\nConnector Name           : " << my_name_ << "\nNumber of consumers      : " << num_consumers_
@@ -18,6 +18,7 @@
 #include "common/utils.h"
 #include "dataset/engine/data_buffer.h"
 #include "dataset/engine/db_connector.h"
+#include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace dataset {
@@ -50,7 +51,8 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, int32_t op_queue_size, int32_t n
       drop_(drop),
       input_column_names_(cols_to_map),
       batch_size_func_(batch_size_func),
-      batch_map_func_(batch_map_func) {
+      batch_map_func_(batch_map_func),
+      pinned_pool_(GlobalContext::Instance()->pinned_pool()) {
   worker_queues_.Init(num_workers, op_queue_size);
 }
 
@@ -115,7 +117,8 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *source_table,
   }
   TensorRow row = std::move((*source_table)->front());
   (*source_table)->pop_front();
-  if (batch_size == 1) {
+  // A pinned batch of one row still takes a copy into the pinned pool
+  if (batch_size == 1 && pinned_pool_ == nullptr) {
     for (std::shared_ptr<Tensor> tensor : row) {
       RETURN_IF_NOT_OK(tensor->ExpandDim(0));
     }
@@ -126,8 +129,8 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *source_table,
     for (size_t i = 0; i < row.size(); i++) {  // Handle the first row popped
       row_shapes.push_back(row[i]->shape());
       std::shared_ptr<Tensor> ts;
-      RETURN_IF_NOT_OK(Tensor::CreateTensor(
-        &ts, TensorImpl::kFlexible, row[i]->shape().PrependDim(static_cast<int64_t>(batch_size)), row[i]->type()));
+      RETURN_IF_NOT_OK(
+        CreateBatchTensor(row[i]->shape().PrependDim(static_cast<int64_t>(batch_size)), row[i]->type(), &ts));
       batched_row.emplace_back(ts);
       RETURN_IF_NOT_OK(batched_row[i]->InsertTensor(std::vector<dsize_t>(1, 0), row[i]));  // {j} = 0
     }
@@ -147,6 +150,18 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *source_table,
   return Status::OK();
 }
 
+Status BatchOp::CreateBatchTensor(const TensorShape &shape, DataType type, std::shared_ptr<Tensor> *ts) {
+  if (pinned_pool_ != nullptr) {
+    Status rc = Tensor::CreateTensor(ts, shape, type, pinned_pool_);
+    if (rc.IsOk()) {
+      return rc;
+    }
+    // The pool is full or the batch is larger than the pool, the batch is still made from the regular memory
+    MS_LOG(DEBUG) << "Batch of shape " << shape << " does not fit in the pinned pool: " << rc.ToString() << ".";
+  }
+  return Tensor::CreateTensor(ts, TensorImpl::kFlexible, shape, type);
+}
+
 Status BatchOp::WorkerEntry(int32_t workerId) {
   TaskManager::FindMe()->Post();
   std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair;
@@ -158,7 +173,11 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF)));
     } else if (table_pair.second.ctrl_ == batchCtrl::kNoCtrl) {
       std::unique_ptr<DataBuffer> db = nullptr;
-      RETURN_IF_NOT_OK(MakeBatchedBuffer(std::move(table_pair), &db));
+      RETURN_IF_NOT_OK(WorkerComputeBegin(workerId));
+      {
+        WorkerComputeScope compute_scope(this, workerId);
+        RETURN_IF_NOT_OK(MakeBatchedBuffer(std::move(table_pair), &db));
+      }
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::move(db)));
     }
     RETURN_IF_NOT_OK(worker_queues_[workerId]->PopFront(&table_pair));
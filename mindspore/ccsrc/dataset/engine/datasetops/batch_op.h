@@ -194,6 +194,13 @@ class BatchOp : public ParallelOp {
   // @return Status - The error code return
   Status BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest, size_t size);
 
+  // Create the tensor a column of a batch is copied into, from the pinned pool when there is one
+  // @param const TensorShape &shape - shape of the batched column
+  // @param DataType type - type of the column
+  // @param std::shared_ptr<Tensor> *ts - the created tensor
+  // @return Status - The error code return
+  Status CreateBatchTensor(const TensorShape &shape, DataType type, std::shared_ptr<Tensor> *ts);
+
   // Function that calls pyfunc to perform map on batch
   // @param (std::pair<std::unique_ptr<TensorQTable>, batch_stats> *table_pair - contains un-batched tensor
   // @return Status - The error code return
@@ -233,6 +240,8 @@ class BatchOp : public ParallelOp {
   py::function batch_size_func_;
   // Function pointer of per batch map function
   py::function batch_map_func_;
+  // Pool of page-locked memory the batches are allocated from, null when the batches are not pinned
+  std::shared_ptr<MemoryPool> pinned_pool_;
 };
 }  // namespace dataset
 }  // namespace mindspore
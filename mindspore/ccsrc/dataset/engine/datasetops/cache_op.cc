@@ -0,0 +1,338 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/datasetops/cache_op.h"
+
+#include <unistd.h>
+#include <cstdio>
+#include <iostream>
+#include <utility>
+
+#include "dataset/core/config_manager.h"
+#include "dataset/engine/data_buffer.h"
+#include "dataset/engine/db_connector.h"
+#include "dataset/engine/execution_tree.h"
+#include "dataset/util/path.h"
+#include "dataset/util/task_manager.h"
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+// Builder constructor. Creates the builder object.
+CacheOp::Builder::Builder() : build_cache_mem_size_(0) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  build_op_connector_size_ = cfg->op_connector_size();
+  build_rows_per_buffer_ = cfg->rows_per_buffer();
+}
+
+Status CacheOp::Builder::SanityCheck() const {
+  if (build_cache_mem_size_ < 0) {
+    RETURN_STATUS_UNEXPECTED("Cache memory size can not be negative.");
+  }
+  if (build_cache_mem_size_ > 0 && build_spill_dir_.empty()) {
+    RETURN_STATUS_UNEXPECTED("A spill directory is required when the cache memory size is limited.");
+  }
+  if (build_rows_per_buffer_ <= 0) {
+    RETURN_STATUS_UNEXPECTED("Rows per buffer must be greater than 0.");
+  }
+  return Status::OK();
+}
+
+// The builder "build" method creates the final object.
+Status CacheOp::Builder::Build(std::shared_ptr<CacheOp> *ptr) {
+  RETURN_IF_NOT_OK(SanityCheck());
+  *ptr = std::make_shared<CacheOp>(build_cache_mem_size_, build_spill_dir_, build_op_connector_size_,
+                                   build_rows_per_buffer_);
+  return Status::OK();
+}
+
+// Constructor of the CacheOp
+CacheOp::CacheOp(int64_t cache_mem_size, const std::string &spill_dir, int32_t op_connector_size,
+                 int32_t rows_per_buffer)
+    : PipelineOp(op_connector_size),
+      cache_mem_size_(cache_mem_size),
+      spill_dir_(spill_dir),
+      rows_per_buffer_(rows_per_buffer),
+      buffer_counter_(0),
+      cached_bytes_(0),
+      num_spilled_rows_(0),
+      cache_built_(false) {}
+
+CacheOp::~CacheOp() {
+  if (spill_stream_.is_open()) {
+    spill_stream_.close();
+  }
+  if (!spill_file_.empty()) {
+    (void)std::remove(spill_file_.c_str());
+  }
+}
+
+// A print method typically used for debugging
+void CacheOp::Print(std::ostream &out, bool show_all) const {
+  // Call base class printer first
+  PipelineOp::Print(out, show_all);
+
+  // Then display our own stuff
+  out << "CacheOp:\n  Cache memory size: " << cache_mem_size_ << "\n  Spill directory: " << spill_dir_
+      << "\n  rows_per_buffer_: " << rows_per_buffer_ << "\n  Cached rows in memory: " << mem_rows_.size()
+      << "\n  Cached bytes in memory: " << cached_bytes_ << "\n  Spilled rows: " << num_spilled_rows_;
+  out << "\n-------------------------\n\n";  // End the display with this line
+}
+
+// Base-class override for setting specific CacheOp configurations. This code will be called
+// during the execution tree prepare phase BEFORE traversing down to child operators.
+uint32_t CacheOp::PrepareFlags() const { return ExecutionTree::kDePrepCache; }
+
+// Base-class override for executing specific CacheOp configurations. This code will be called
+// during the execution tree prepare phase when it is visiting this operator.
+Status CacheOp::PrepareNodeAction() {
+  RETURN_IF_NOT_OK(PipelineOp::PrepareNodeAction());
+  // The leaf ops below us are hidden from the repeat, so we take their place and get reset by
+  // the RepeatOp above us instead.
+  if (BitTest(tree_->PrepareFlags(), ExecutionTree::kDePrepRepeat)) {
+    BitSet(&op_ctrl_flags_, kDeOpRepeated);
+    tree_->AddToRepeatStack(shared_from_this());
+  }
+  return Status::OK();
+}
+
+// Class functor operator () override.
+// All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
+// provide the master loop that drives the logic for performing the work
+Status CacheOp::operator()() {
+  wp_.Register(tree_->AllTasks());
+  // Synchronize with TaskManager once the thread is launched.
+  TaskManager::FindMe()->Post();
+
+  // Cache op does not have workers, and only consumes from child 0.
+  child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
+  RETURN_IF_NOT_OK(BuildCache());
+  while (true) {
+    if (!BitTest(op_ctrl_flags_, kDeOpRepeated) || BitTest(op_ctrl_flags_, kDeOpLastRepeat)) {
+      MS_LOG(INFO) << "Cache operator sending EOE and EOF.";
+      RETURN_IF_NOT_OK(out_connector_->Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE)));
+      RETURN_IF_NOT_OK(out_connector_->Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF)));
+      break;
+    }
+    MS_LOG(INFO) << "Cache operator sending EOE.";
+    RETURN_IF_NOT_OK(out_connector_->Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE)));
+    // Sleep until the RepeatOp above us resets us for the next epoch
+    RETURN_IF_NOT_OK(wp_.Wait());
+    wp_.Clear();
+    RETURN_IF_NOT_OK(ReplayCache());
+  }
+  return Status::OK();
+}
+
+// Private function to pass the rows of the child through while saving them into the cache.
+Status CacheOp::BuildCache() {
+  MS_LOG(INFO) << "Cache operator building the cache from its child.";
+  TensorRow new_row;
+  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+  while (!new_row.empty()) {
+    if (column_name_map_.empty()) {
+      column_name_map_ = child_iterator_->col_name_id_map();
+    }
+    RETURN_IF_NOT_OK(CacheRow(new_row));
+    RETURN_IF_NOT_OK(SendRow(std::move(new_row), false));
+    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+  }
+  RETURN_IF_NOT_OK(SendRow(TensorRow(), true));
+
+  // The subtree below us only runs one epoch, consume its eof so that it can finish.
+  if (!child_iterator_->eof_handled()) {
+    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+    if (!child_iterator_->eof_handled()) {
+      RETURN_STATUS_UNEXPECTED("Cache operator expects its child to produce a single epoch.");
+    }
+  }
+  if (spill_stream_.is_open()) {
+    spill_stream_.close();
+    if (spill_stream_.fail()) {
+      RETURN_STATUS_UNEXPECTED("Failed to write cache spill file: " + spill_file_);
+    }
+  }
+  cache_built_ = true;
+  MS_LOG(INFO) << "Cache operator built the cache, rows in memory: " << mem_rows_.size()
+               << ", bytes in memory: " << cached_bytes_ << ", rows spilled: " << num_spilled_rows_ << ".";
+  return Status::OK();
+}
+
+// Private function to send all the cached rows to the output connector.
+Status CacheOp::ReplayCache() {
+  if (!cache_built_) {
+    RETURN_STATUS_UNEXPECTED("Cache operator replayed before the cache is built.");
+  }
+  // The ops above us may modify their input tensors in place, each epoch gets a copy of the cached rows.
+  for (const auto &row : mem_rows_) {
+    TensorRow new_row;
+    RETURN_IF_NOT_OK(CopyRow(row, &new_row));
+    RETURN_IF_NOT_OK(SendRow(std::move(new_row), false));
+  }
+  if (num_spilled_rows_ > 0) {
+    spill_stream_.open(spill_file_, std::ios::in | std::ios::binary);
+    if (!spill_stream_.is_open()) {
+      RETURN_STATUS_UNEXPECTED("Failed to open cache spill file: " + spill_file_);
+    }
+    for (int64_t i = 0; i < num_spilled_rows_; ++i) {
+      TensorRow row;
+      RETURN_IF_NOT_OK(ReadSpillRow(&row));
+      RETURN_IF_NOT_OK(SendRow(std::move(row), false));
+    }
+    spill_stream_.close();
+  }
+  return SendRow(TensorRow(), true);
+}
+
+// Private function to add a row to the output table, the table is sent once it is full.
+Status CacheOp::SendRow(TensorRow &&row, bool flush) {
+  if (!out_table_) {
+    out_table_ = std::make_unique<TensorQTable>();
+  }
+  if (!row.empty()) {
+    out_table_->push_back(std::move(row));
+  }
+  if (out_table_->empty() || (!flush && out_table_->size() < static_cast<size_t>(rows_per_buffer_))) {
+    return Status::OK();
+  }
+  auto new_buffer = std::make_unique<DataBuffer>(buffer_counter_++, DataBuffer::kDeBFlagNone);
+  new_buffer->set_tensor_table(std::move(out_table_));
+  new_buffer->set_column_name_map(column_name_map_);
+  return out_connector_->Add(0, std::move(new_buffer));
+}
+
+// Private function to save one row into the cache, in memory while there is room and into the
+// spill file afterwards.
+Status CacheOp::CacheRow(const TensorRow &row) {
+  int64_t row_bytes = 0;
+  for (const auto &tensor : row) {
+    row_bytes += tensor->SizeInBytes();
+  }
+  // Once a row is spilled all the later rows are spilled too, so that the replay keeps the order.
+  if (num_spilled_rows_ == 0 && (cache_mem_size_ == 0 || cached_bytes_ + row_bytes <= cache_mem_size_)) {
+    // The row is sent on as it is, the cache keeps a copy of its own.
+    TensorRow new_row;
+    RETURN_IF_NOT_OK(CopyRow(row, &new_row));
+    mem_rows_.push_back(std::move(new_row));
+    cached_bytes_ += row_bytes;
+    return Status::OK();
+  }
+  if (!spill_stream_.is_open()) {
+    Path spill_dir(spill_dir_);
+    if (!spill_dir.Exists()) {
+      RETURN_IF_NOT_OK(spill_dir.CreateDirectories());
+    }
+    Path spill_file = spill_dir / ("cache_op_" + std::to_string(getpid()) + "_" + std::to_string(id()) + ".spill");
+    spill_file_ = spill_file.toString();
+    spill_stream_.open(spill_file_, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!spill_stream_.is_open()) {
+      RETURN_STATUS_UNEXPECTED("Failed to create cache spill file: " + spill_file_);
+    }
+    MS_LOG(INFO) << "Cache operator memory is full, spilling rows to " << spill_file_ << ".";
+  }
+  RETURN_IF_NOT_OK(WriteSpillRow(row));
+  num_spilled_rows_++;
+  return Status::OK();
+}
+
+// Private function to copy the data of the tensors of a row into new tensors.
+Status CacheOp::CopyRow(const TensorRow &row, TensorRow *new_row) {
+  new_row->reserve(row.size());
+  for (const auto &tensor : row) {
+    const Tensor &src = *tensor;
+    std::shared_ptr<Tensor> new_tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&new_tensor, TensorImpl::kFlexible, src.shape(), src.type(),
+                                          src.SizeInBytes() > 0 ? src.StartAddr() : nullptr));
+    new_row->push_back(std::move(new_tensor));
+  }
+  return Status::OK();
+}
+
+// A spilled row is the number of columns followed by each tensor as: type, rank, dims, bytes of
+// data and the data itself.
+Status CacheOp::WriteSpillRow(const TensorRow &row) {
+  auto num_cols = static_cast<int32_t>(row.size());
+  (void)spill_stream_.write(reinterpret_cast<const char *>(&num_cols), sizeof(num_cols));
+  for (const auto &tensor : row) {
+    uint8_t type = static_cast<uint8_t>(tensor->type().value());
+    std::vector<dsize_t> dims = tensor->shape().AsVector();
+    auto rank = static_cast<int32_t>(dims.size());
+    int64_t num_bytes = tensor->SizeInBytes();
+    (void)spill_stream_.write(reinterpret_cast<const char *>(&type), sizeof(type));
+    (void)spill_stream_.write(reinterpret_cast<const char *>(&rank), sizeof(rank));
+    (void)spill_stream_.write(reinterpret_cast<const char *>(dims.data()), sizeof(dsize_t) * rank);
+    (void)spill_stream_.write(reinterpret_cast<const char *>(&num_bytes), sizeof(num_bytes));
+    if (num_bytes > 0) {
+      (void)spill_stream_.write(reinterpret_cast<const char *>(tensor->StartAddr()), num_bytes);
+    }
+  }
+  if (spill_stream_.fail()) {
+    RETURN_STATUS_UNEXPECTED("Failed to write cache spill file: " + spill_file_);
+  }
+  return Status::OK();
+}
+
+Status CacheOp::ReadSpillRow(TensorRow *row) {
+  int32_t num_cols = 0;
+  (void)spill_stream_.read(reinterpret_cast<char *>(&num_cols), sizeof(num_cols));
+  for (int32_t i = 0; i < num_cols && !spill_stream_.fail(); ++i) {
+    uint8_t type = 0;
+    int32_t rank = 0;
+    int64_t num_bytes = 0;
+    (void)spill_stream_.read(reinterpret_cast<char *>(&type), sizeof(type));
+    (void)spill_stream_.read(reinterpret_cast<char *>(&rank), sizeof(rank));
+    if (spill_stream_.fail() || rank < 0) {
+      break;
+    }
+    std::vector<dsize_t> dims(rank);
+    (void)spill_stream_.read(reinterpret_cast<char *>(dims.data()), sizeof(dsize_t) * rank);
+    (void)spill_stream_.read(reinterpret_cast<char *>(&num_bytes), sizeof(num_bytes));
+    std::shared_ptr<Tensor> tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&tensor, TensorImpl::kFlexible, TensorShape(dims),
+                                          DataType(static_cast<DataType::Type>(type))));
+    if (tensor->SizeInBytes() != num_bytes) {
+      RETURN_STATUS_UNEXPECTED("Corrupted cache spill file: " + spill_file_);
+    }
+    if (num_bytes > 0) {
+      (void)spill_stream_.read(reinterpret_cast<char *>(tensor->StartAddr()), num_bytes);
+    }
+    row->push_back(std::move(tensor));
+  }
+  if (spill_stream_.fail()) {
+    RETURN_STATUS_UNEXPECTED("Failed to read cache spill file: " + spill_file_);
+  }
+  return Status::OK();
+}
+
+// The CacheOp generates the eoe of every epoch itself, the eoe of the child is just absorbed.
+Status CacheOp::EoeReceived(int32_t worker_id) {
+  state_ = OpState::kDeOpIdle;
+  return Status::OK();
+}
+
+// The CacheOp generates the eof itself once the last epoch is replayed.
+Status CacheOp::EofReceived(int32_t worker_id) { return Status::OK(); }
+
+// Base-class override for reset. Wakes up the master thread to replay the cache.
+Status CacheOp::Reset() {
+  MS_LOG(INFO) << "Cache operator reset, replaying the cache for the next epoch.";
+  RETURN_IF_NOT_OK(PipelineOp::Reset());
+  buffer_counter_ = 0;
+  wp_.Set();  // wake up master thread after reset is done
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
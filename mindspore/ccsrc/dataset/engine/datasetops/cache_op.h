@@ -0,0 +1,216 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_DATASETOPS_CACHE_OP_H_
+#define DATASET_ENGINE_DATASETOPS_CACHE_OP_H_
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dataset/core/tensor.h"
+#include "dataset/engine/dataset_iterator.h"
+#include "dataset/engine/datasetops/pipeline_op.h"
+#include "dataset/util/status.h"
+#include "dataset/util/wait_post.h"
+
+namespace mindspore {
+namespace dataset {
+// Forward declare
+class ExecutionTree;
+
+class DataBuffer;
+
+// The CacheOp saves the rows produced by the subtree below it during the first epoch, and replays
+// them from the cache in every following epoch, so that the expensive part of the pipeline below it
+// (file reading, decoding, deterministic augmentations) only runs once.
+// Rows are kept in memory until the configured memory size is reached, the remaining rows are then
+// spilled to a file in the spill directory.
+// Inside a repeat, the CacheOp acts as the repeated leaf of the tree: the subtree below it runs a
+// single epoch and it is the CacheOp that is reset and replayed for each repeat. Since the replay
+// order is fixed, a ShuffleOp should be placed above the CacheOp rather than below it if the data
+// needs to be shuffled differently in every epoch.
+class CacheOp : public PipelineOp {
+ public:
+  // The nested builder class inside of the CacheOp is used to help manage all of the arguments
+  // for constructing it.
+  class Builder {
+   public:
+    // Builder constructor.  Creates the builder object.
+    // @note No default args
+    // @return This is a constructor.
+    Builder();
+
+    // Default destructor
+    ~Builder() = default;
+
+    // Setter method.
+    // @param cache_mem_size - Bytes of tensor data to keep in memory, 0 means no limit
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetCacheMemSize(int64_t cache_mem_size) {
+      build_cache_mem_size_ = cache_mem_size;
+      return *this;
+    }
+
+    // Setter method.
+    // @param spill_dir - Directory for the rows that do not fit into memory
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetSpillDir(const std::string &spill_dir) {
+      build_spill_dir_ = spill_dir;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetRowsPerBuffer(int32_t rows_per_buffer) {
+      build_rows_per_buffer_ = rows_per_buffer;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetOpConnectorSize(int32_t op_connector_size) {
+      build_op_connector_size_ = op_connector_size;
+      return *this;
+    }
+
+    // The builder "build" method creates the final object.
+    // @return shared_ptr to the new CacheOp object
+    Status Build(std::shared_ptr<CacheOp> *);
+
+   private:
+    int64_t build_cache_mem_size_;
+    std::string build_spill_dir_;
+    int32_t build_rows_per_buffer_;
+    int32_t build_op_connector_size_;
+
+    Status SanityCheck() const;
+  };
+
+  // Constructor of the CacheOp
+  // @note The builder class should be used to call it
+  // @param cache_mem_size - Bytes of tensor data to keep in memory, 0 means no limit
+  // @param spill_dir - Directory for the rows that do not fit into memory
+  // @param op_connector_size - The output connector queue size
+  // @param rows_per_buffer - The requested number of rows per buffer
+  CacheOp(int64_t cache_mem_size, const std::string &spill_dir, int32_t op_connector_size, int32_t rows_per_buffer);
+
+  // Destructor, removes the spill file
+  ~CacheOp();
+
+  // A print method typically used for debugging
+  // @param out - The output stream to write output to
+  // @param show_all - A bool to control if you want to show all info or just a summary
+  void Print(std::ostream &out, bool show_all) const override;
+
+  // << Stream output operator overload
+  // @notes This allows you to write the debug print info using stream operators
+  // @param out - reference to the output stream being overloaded
+  // @param co - reference to the CacheOp to display
+  // @return - the output stream must be returned
+  friend std::ostream &operator<<(std::ostream &out, const CacheOp &co) {
+    co.Print(out, false);
+    return out;
+  }
+
+  // Class functor operator () override.
+  // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
+  // provide the master loop that drives the logic for performing the work
+  // @return Status - The error code return
+  Status operator()() override;
+
+  // Base-class override for special eoe handler.
+  // The CacheOp generates the eoe of every epoch itself.
+  // @return Status - The error code return
+  Status EoeReceived(int32_t worker_id) override;
+
+  // Base-class override for special eof handler.
+  // The CacheOp generates the eof itself once the last epoch is replayed.
+  // @return Status - The error code return
+  Status EofReceived(int32_t worker_id) override;
+
+  // Base-class override for reset. Wakes up the master thread to replay the cache.
+  // @return Status - The error code return
+  Status Reset() override;
+
+  // Base-class override. The subtree below the cache only runs one epoch, so only the cache
+  // itself is reset.
+  // @return Status - The error code return
+  Status ResetSubtree() override { return Reset(); }
+
+  // Base-class override for setting specific CacheOp configurations. This code will be called
+  // during the execution tree prepare phase BEFORE traversing down to child operators.
+  uint32_t PrepareFlags() const override;
+
+  // Base-class override for executing specific CacheOp configurations. This code will be called
+  // during the execution tree prepare phase when it is visiting this operator.
+  Status PrepareNodeAction() override;
+
+  // Getter
+  // @return The number of rows held in the cache
+  int64_t num_cached_rows() const { return static_cast<int64_t>(mem_rows_.size()) + num_spilled_rows_; }
+
+ private:
+  // Private function to pass the rows of the child through while saving them into the cache.
+  // @return Status - The error code return
+  Status BuildCache();
+
+  // Private function to send all the cached rows to the output connector.
+  // @return Status - The error code return
+  Status ReplayCache();
+
+  // Private function to add a row to the output table, the table is sent once it is full.
+  // @param row - The row to send
+  // @param flush - Send the table even if it is not full
+  // @return Status - The error code return
+  Status SendRow(TensorRow &&row, bool flush);
+
+  // Private function to save one row into the cache, in memory while there is room and into the
+  // spill file afterwards.
+  // @return Status - The error code return
+  Status CacheRow(const TensorRow &row);
+
+  // Private function to copy the data of the tensors of a row into new tensors.
+  // @param row - The row to copy
+  // @param new_row - The copy
+  // @return Status - The error code return
+  Status CopyRow(const TensorRow &row, TensorRow *new_row);
+
+  // Private functions to serialize a row to and from the spill file.
+  // @return Status - The error code return
+  Status WriteSpillRow(const TensorRow &row);
+  Status ReadSpillRow(TensorRow *row);
+
+  int64_t cache_mem_size_;   // Limit of bytes kept in memory, 0 means no limit
+  std::string spill_dir_;    // Where the rows that do not fit in memory go
+  int32_t rows_per_buffer_;  // Number of rows to pack into output buffer
+  int32_t buffer_counter_;   // For creating new buffer id's
+  int64_t cached_bytes_;     // Bytes of tensor data held in memory
+  int64_t num_spilled_rows_;
+  bool cache_built_;  // The first epoch is done and the cache holds all the rows
+  TensorTable mem_rows_;
+  std::string spill_file_;
+  std::fstream spill_stream_;
+  std::unique_ptr<TensorQTable> out_table_;
+  std::unordered_map<std::string, int32_t> column_name_map_;
+  std::unique_ptr<ChildIterator> child_iterator_;
+  WaitPost wp_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_DATASETOPS_CACHE_OP_H_
@@ -34,6 +34,8 @@ class DataBuffer;
 class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // Allow execution tree to access internal members
   friend class ExecutionTree;
+  // Allow the profiler to read the counters of the output connector
+  friend class PipelineProfiler;
 
  public:
   static constexpr int32_t kInvalidOperatorId = -1;
@@ -63,6 +65,10 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // @param child_index - An operator can have n children. Indicates choose which child to return.
   std::shared_ptr<DatasetOp> child(int32_t child_index) const;
 
+  // Getter function
+  // @return The number of children of this operator
+  int32_t num_children() const { return static_cast<int32_t>(child_.size()); }
+
   // Creates the connector within this operator
   // @param num_producers - number of threads that write into this connector
   // @param num_consumers - number of threads that read from this connector
@@ -180,6 +186,14 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // @return T/F if this is an inlined operator
   bool inlined() const { return (oc_queue_size_ == 0); }
 
+  // Getter function
+  // @return The number of buffers waiting in the output connector
+  int32_t ConnectorSize() const { return (out_connector_ == nullptr) ? 0 : out_connector_->size(); }
+
+  // Getter function
+  // @return The number of buffers the output connector can hold
+  int32_t ConnectorCapacity() const { return (out_connector_ == nullptr) ? 0 : out_connector_->capacity(); }
+
   // Setter function
   // @return Sets the control flags
   void set_control_flag(uint64_t flag) { BitSet(&op_ctrl_flags_, flag); }
@@ -17,6 +17,7 @@
 
 #include <iostream>
 #include <memory>
+#include <utility>
 
 #include "dataset/core/config_manager.h"
 #include "dataset/core/global_context.h"
@@ -38,17 +39,35 @@ DeviceQueueOp::DeviceQueueOp(std::string channel_name, DeviceType device_type, i
       device_type_(device_type),
       device_id_(device_id),
       prefetch_size_(prefetch_size),
-      num_batch_(num_batch) {}
+      num_batch_(num_batch),
+      held_tensors_(std::make_shared<HeldTensors>()) {}
 
 DeviceQueueOp::~DeviceQueueOp() {}
 
-#ifdef ENABLE_GPUQUE
-void ReleaseData(void *addr) {
-  if (addr != nullptr) {
-    free(addr);
+void DeviceQueueOp::HeldTensors::Hold(const std::shared_ptr<Tensor> &tensor) {
+  std::unique_lock<std::mutex> lck(mux_);
+  // A tensor can be handed over more than once, e.g. when the rows are replayed from a cache
+  (void)tensors_.emplace(tensor->StartAddr(), tensor);
+}
+
+void DeviceQueueOp::HeldTensors::Release(void *addr) {
+  std::shared_ptr<Tensor> tensor;
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    auto itr = tensors_.find(addr);
+    if (itr == tensors_.end()) {
+      return;
+    }
+    tensor = std::move(itr->second);
+    tensors_.erase(itr);
   }
+  // The tensor is freed out of the lock
+}
+
+size_t DeviceQueueOp::HeldTensors::size() {
+  std::unique_lock<std::mutex> lck(mux_);
+  return tensors_.size();
 }
-#endif
 
 DeviceQueueOp::Builder::Builder(int32_t prefetch_size)
     : builder_prefetch_size_(prefetch_size),
@@ -147,7 +166,9 @@ Status DeviceQueueOp::SendDataToGPU() {
         uint32_t feature_size = static_cast<uint32_t>(curr_row[0]->SizeInBytes());
         uint32_t label_size = static_cast<uint32_t>(curr_row[1]->SizeInBytes());
         if (!is_open) {
-          handle = GpuBufferMgr::GetInstance().Open(0, channel_name_, feature_size, label_size, ReleaseData);
+          std::shared_ptr<HeldTensors> held_tensors = held_tensors_;
+          handle = GpuBufferMgr::GetInstance().Open(0, channel_name_, feature_size, label_size,
+                                                    [held_tensors](void *addr) { held_tensors->Release(addr); });
           if (handle == INVALID_HANDLE) {
             return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "open failed");
           }
@@ -175,48 +196,26 @@ Status DeviceQueueOp::SendDataToGPU() {
 
 Status DeviceQueueOp::RetryPushGPUData(uint32_t feature_size, uint32_t label_size, const TensorRow &curr_row,
                                        uint32_t handle) {
-  unsigned char *feature_addr = nullptr;
-  unsigned char *label_addr = nullptr;
-  while (true && !GpuBufferMgr::GetInstance().IsClosed()) {
-    RETURN_IF_NOT_OK(MallocForGPUData(&feature_addr, feature_size, &label_addr, label_size, curr_row));
+  // The queue copies from the memory of the tensors, which are held until it releases them. When the batch
+  // comes from the pinned pool, the copy to the device is a direct DMA.
+  unsigned char *feature_addr = curr_row[0]->StartAddr();
+  unsigned char *label_addr = curr_row[1]->StartAddr();
+  held_tensors_->Hold(curr_row[0]);
+  held_tensors_->Hold(curr_row[1]);
+  bool pushed = false;
+  while (!GpuBufferMgr::GetInstance().IsClosed()) {
     auto ret = GpuBufferMgr::GetInstance().Push(handle, feature_addr, feature_size, label_addr, label_size, WAIT_TIME);
     if (ret) {
-      free(feature_addr);
-      free(label_addr);
       MS_LOG(WARNING) << "Retry pushing data...";
       continue;
-    } else {
-      break;
     }
+    pushed = true;
+    break;
   }
-  return Status::OK();
-}
-
-Status DeviceQueueOp::MallocForGPUData(unsigned char **feature_addr, uint32_t feature_size, unsigned char **label_addr,
-                                       uint32_t label_size, const TensorRow &curr_row) {
-  *feature_addr = (unsigned char *)malloc(feature_size);
-  if (*feature_addr == nullptr) {
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "feature memory malloc failed.");
-  }
-  (void)memset_s(*feature_addr, feature_size, 0, feature_size);
-  unsigned char *feature = curr_row[0]->StartAddr();
-  if (memcpy_s(*feature_addr, feature_size, feature, static_cast<uint32_t>(curr_row[0]->SizeInBytes())) != 0) {
-    MS_LOG(ERROR) << "Feature memcpy_s failed!";
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "feature memcpy_s failed.");
+  if (!pushed) {
+    held_tensors_->Release(feature_addr);
+    held_tensors_->Release(label_addr);
   }
-
-  *label_addr = (unsigned char *)malloc(label_size);
-  if (*label_addr == nullptr) {
-    free(*feature_addr);
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "label memory malloc failed.");
-  }
-  (void)memset_s(*label_addr, label_size, 0, label_size);
-  unsigned char *label = curr_row[1]->StartAddr();
-  if (memcpy_s(*label_addr, label_size, label, static_cast<uint32_t>(curr_row[1]->SizeInBytes())) != 0) {
-    MS_LOG(ERROR) << "Label memcpy_s failed!";
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "label memcpy_s failed.");
-  }
-
   return Status::OK();
 }
 #endif
@@ -224,6 +223,12 @@ Status DeviceQueueOp::MallocForGPUData(unsigned char **feature_addr, uint32_t fe
 Status DeviceQueueOp::SendDataToCPU() {
   MS_LOG(INFO) << "Device queue, sending data to CPU.";
   int64_t total_batch = 0;
+  // The rows go to the host queue of the channel when a consumer opened one
+  std::shared_ptr<HostQueue> host_queue = HostQueue::Find(channel_name_);
+  if (host_queue != nullptr) {
+    std::shared_ptr<HeldTensors> held_tensors = held_tensors_;
+    host_queue->RegisterRelease([held_tensors](void *addr) { held_tensors->Release(addr); });
+  }
 
   std::unique_ptr<ChildIterator> child_iterator = std::make_unique<ChildIterator>(this, 0, 0);
   while (!(child_iterator->eof_handled())) {
@@ -233,6 +238,12 @@ Status DeviceQueueOp::SendDataToCPU() {
     if (!curr_row.empty()) {
       MS_LOG(DEBUG) << "Feature size is " << curr_row[0]->SizeInBytes() << ".";
       MS_LOG(DEBUG) << "Label size is " << curr_row[1]->SizeInBytes() << ".";
+      if (host_queue != nullptr) {
+        RETURN_IF_NOT_OK(PushToHostQueue(host_queue, curr_row));
+        if (host_queue->IsClosed()) {
+          break;
+        }
+      }
       total_batch++;
       if (num_batch_ > 0 && total_batch == num_batch_) {
         break;
@@ -245,6 +256,16 @@ Status DeviceQueueOp::SendDataToCPU() {
   return Status::OK();
 }
 
+Status DeviceQueueOp::PushToHostQueue(const std::shared_ptr<HostQueue> &host_queue, const TensorRow &curr_row) {
+  HostQueue::Item item;
+  for (const auto &tensor : curr_row) {
+    held_tensors_->Hold(tensor);
+    item.addrs.push_back(tensor->StartAddr());
+    item.sizes.push_back(static_cast<size_t>(tensor->SizeInBytes()));
+  }
+  return host_queue->Push(std::move(item));
+}
+
 void DeviceQueueOp::Print(std::ostream &out, bool show_all) const {
   PipelineOp::Print(out, show_all);
 
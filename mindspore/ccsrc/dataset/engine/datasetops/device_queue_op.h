@@ -17,10 +17,13 @@
 #define DATASET_ENGINE_DATASETOPS_DEVICE_QUEUE_OP_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "dataset/engine/datasetops/pipeline_op.h"
+#include "dataset/engine/host_queue.h"
 #include "dataset/util/status.h"
 
 #ifdef ENABLE_TDTQUE
@@ -134,6 +137,28 @@ class DeviceQueueOp : public PipelineOp {
 
   Status operator()() override;
 
+  // Keeps the tensors handed to a device queue without a copy alive, until the queue releases their address.
+  // It is shared with the release function of the queue, which may outlive the op.
+  class HeldTensors {
+   public:
+    // @param tensor - The tensor to keep alive until its data address is released
+    void Hold(const std::shared_ptr<Tensor> &tensor);
+
+    // @param addr - The data address of a held tensor
+    void Release(void *addr);
+
+    // @return The number of tensors held
+    size_t size();
+
+   private:
+    std::mutex mux_;
+    std::unordered_multimap<void *, std::shared_ptr<Tensor>> tensors_;
+  };
+
+  // Getter function
+  // @return The tensors handed to the device queue and not released yet
+  const std::shared_ptr<HeldTensors> &held_tensors() const { return held_tensors_; }
+
  private:
   //  Name: checkExceptions(DataBuffer);
   //  Description: Check whether the dataBuffer meets the condition for performing DeviceQueueOp
@@ -146,16 +171,19 @@ class DeviceQueueOp : public PipelineOp {
 #ifdef ENABLE_GPUQUE
   Status SendDataToGPU();
   Status RetryPushGPUData(uint32_t feature_size, uint32_t label_size, const TensorRow &curr_row, uint32_t handle);
-  Status MallocForGPUData(unsigned char **feature_addr, uint32_t feature_size, unsigned char **label_addr,
-                          uint32_t label_size, const TensorRow &curr_row);
 #endif
 
   Status SendDataToCPU();
+
+  // Hands a row to the host queue stand-in without a copy
+  Status PushToHostQueue(const std::shared_ptr<HostQueue> &host_queue, const TensorRow &curr_row);
+
   std::string channel_name_;
   DeviceType device_type_;
   const int32_t device_id_;
   const int32_t prefetch_size_;
   const int64_t num_batch_;
+  std::shared_ptr<HeldTensors> held_tensors_;
 
 #ifdef ENABLE_TDTQUE
   std::shared_ptr<TdtPlugin> tdtInstancePtr;
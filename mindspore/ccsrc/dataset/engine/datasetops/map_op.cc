@@ -26,6 +26,11 @@
 #include "dataset/engine/data_buffer.h"
 #include "dataset/engine/db_connector.h"
 #include "dataset/engine/execution_tree.h"
+#include "dataset/kernels/data/to_float16_op.h"
+#include "dataset/kernels/data/type_cast_op.h"
+#include "dataset/kernels/image/fused_normalize_op.h"
+#include "dataset/kernels/image/hwc_to_chw_op.h"
+#include "dataset/kernels/image/normalize_op.h"
 #include "dataset/kernels/tensor_op.h"
 #include "utils/log_adapter.h"
 #include "dataset/util/task_manager.h"
@@ -62,7 +67,7 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
              std::vector<std::shared_ptr<TensorOp>> tensor_funcs, int32_t num_workers, int32_t op_connector_size,
              bool perf_mode)
     : ParallelOp(num_workers, op_connector_size),
-      tfuncs_(std::move(tensor_funcs)),
+      tfuncs_(FuseTensorOps(std::move(tensor_funcs))),
       in_columns_(in_col_names),
       out_columns_(out_col_names),
       perf_mode_(perf_mode) {
@@ -73,6 +78,51 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
   MS_LOG(DEBUG) << "Performance Mode in map operator is " << perf_mode_ << ".";
 }
 
+std::vector<std::shared_ptr<TensorOp>> MapOp::FuseTensorOps(std::vector<std::shared_ptr<TensorOp>> tensor_funcs) {
+  std::vector<std::shared_ptr<TensorOp>> fused;
+  size_t i = 0;
+  while (i < tensor_funcs.size()) {
+    auto normalize = std::dynamic_pointer_cast<NormalizeOp>(tensor_funcs[i]);
+    if (normalize == nullptr) {
+      fused.push_back(tensor_funcs[i++]);
+      continue;
+    }
+    // Absorb at most one HwcToChwOp and one cast to float following the NormalizeOp
+    bool hwc_to_chw = false;
+    bool cast = false;
+    DataType output_type(DataType::DE_FLOAT32);
+    size_t next = i + 1;
+    while (next < tensor_funcs.size()) {
+      const std::shared_ptr<TensorOp> &op = tensor_funcs[next];
+      auto type_cast = std::dynamic_pointer_cast<TypeCastOp>(op);
+      if (!hwc_to_chw && std::dynamic_pointer_cast<HwcToChwOp>(op) != nullptr) {
+        hwc_to_chw = true;
+      } else if (!cast && type_cast != nullptr &&
+                 (type_cast->type() == DataType::DE_FLOAT32 || type_cast->type() == DataType::DE_FLOAT16)) {
+        cast = true;
+        output_type = type_cast->type();
+      } else if (!cast && std::dynamic_pointer_cast<ToFloat16Op>(op) != nullptr) {
+        cast = true;
+        output_type = DataType(DataType::DE_FLOAT16);
+      } else {
+        break;
+      }
+      ++next;
+    }
+    if (next == i + 1) {
+      // Nothing to fuse with, the NormalizeOp is as fast on its own
+      fused.push_back(tensor_funcs[i++]);
+      continue;
+    }
+    fused.push_back(std::make_shared<FusedNormalizeOp>(
+      normalize->channel_mean(0), normalize->channel_mean(1), normalize->channel_mean(2), normalize->channel_std(0),
+      normalize->channel_std(1), normalize->channel_std(2), hwc_to_chw, output_type));
+    MS_LOG(INFO) << "Fused " << (next - i) << " TensorOps starting with NormalizeOp into a FusedNormalizeOp.";
+    i = next;
+  }
+  return fused;
+}
+
 // The number of threads consuming data from previous op's output Connector.
 int32_t MapOp::num_consumers() const {
   // When Performance Mode is on, there is only one thread consuming from the previous Connector.
@@ -181,8 +231,12 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
 
     std::unique_ptr<TensorQTable> new_tensor_table(std::make_unique<TensorQTable>());
     // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
-    RETURN_IF_NOT_OK(WorkerCompute(in_buffer.get(), to_process_indices, new_tensor_table.get(), keep_input_columns,
-                                   &input_columns, &output_columns));
+    RETURN_IF_NOT_OK(WorkerComputeBegin(worker_id));
+    {
+      WorkerComputeScope compute_scope(this, worker_id);
+      RETURN_IF_NOT_OK(WorkerCompute(in_buffer.get(), to_process_indices, new_tensor_table.get(), keep_input_columns,
+                                     &input_columns, &output_columns));
+    }
 
     // Update column name to index mapping because tensorOp might add/remove column.
     in_buffer->set_column_name_map(final_col_name_id_map);
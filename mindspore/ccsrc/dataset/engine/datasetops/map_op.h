@@ -171,6 +171,16 @@ class MapOp : public ParallelOp {
   // @return the number of threads consuming data from previous op's output Connector.
   int32_t num_consumers() const override;
 
+  // Replaces each NormalizeOp followed by a HwcToChwOp and/or a cast to float, in any order, with a
+  // FusedNormalizeOp doing the same work in one pass over the image. The other TensorOps are kept as they are.
+  // @param tensor_funcs The TensorOps in the order they are applied
+  // @return The TensorOps after the fusion
+  static std::vector<std::shared_ptr<TensorOp>> FuseTensorOps(std::vector<std::shared_ptr<TensorOp>> tensor_funcs);
+
+  // Getter
+  // @return the TensorOps applied by this op, after the fusion
+  const std::vector<std::shared_ptr<TensorOp>> &tfuncs() const { return tfuncs_; }
+
  private:
   // Local queues where worker threads can pop from.
   // Popping directly from the Connector can block if the previous designated threads haven't pop.
@@ -36,7 +36,13 @@ ParallelOp::ParallelOp(int32_t num_workers, int32_t op_connector_size)
       num_workers_(num_workers),
       num_producers_(num_workers),
       worker_connector_size_(1),
-      worker_connector_(nullptr) {}
+      worker_connector_(nullptr),
+      worker_busy_ns_(std::make_unique<std::atomic<int64_t>[]>(num_workers)),
+      worker_compute_start_(num_workers) {
+  for (int32_t i = 0; i < num_workers; ++i) {
+    worker_busy_ns_[i] = 0;
+  }
+}
 
 // Creates the internal worker connector for the parallel op if the derived class wants to use it
 Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size) {
@@ -83,5 +89,30 @@ Status ParallelOp::RegisterWorkerConnectors() {
   }
   return Status::OK();
 }
+
+// Takes a slot of the running worker quota of this op if the tree auto tunes the number of workers
+Status ParallelOp::WorkerComputeBegin(int32_t worker_id) {
+  AutoTune *auto_tune = tree_->auto_tune();
+  if (auto_tune != nullptr) {
+    RETURN_IF_NOT_OK(auto_tune->AcquireWorkerQuota(operator_id_));
+  }
+  if (tree_->profiler() != nullptr) {
+    worker_compute_start_[worker_id] = std::chrono::steady_clock::now();
+  }
+  return Status::OK();
+}
+
+// Gives back the slot of the running worker quota and counts the busy time of the worker
+void ParallelOp::WorkerComputeEnd(int32_t worker_id) {
+  if (tree_->profiler() != nullptr) {
+    auto elapsed = std::chrono::steady_clock::now() - worker_compute_start_[worker_id];
+    worker_busy_ns_[worker_id].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                         std::memory_order_relaxed);
+  }
+  AutoTune *auto_tune = tree_->auto_tune();
+  if (auto_tune != nullptr) {
+    auto_tune->ReleaseWorkerQuota(operator_id_);
+  }
+}
 }  // namespace dataset
 }  // namespace mindspore
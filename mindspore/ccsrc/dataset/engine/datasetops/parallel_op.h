@@ -16,6 +16,8 @@
 #ifndef DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 #define DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <vector>
 #include "dataset/core/constants.h"
@@ -98,16 +100,50 @@ class ParallelOp : public DatasetOp {
   // @return Status
   Status RegisterWorkerConnectors() override;
 
+  // Getter function. The busy time is only counted while the tree is profiled.
+  // @param worker_id - The id of the worker
+  // @return The time in nanoseconds the worker spent in the compute part of its work
+  int64_t worker_busy_ns(int32_t worker_id) const { return worker_busy_ns_[worker_id].load(); }
+
  protected:
   // Interface for derived classes to implement. All derived classes must provide the entry
   // function with the main execution loop for worker threads.
   // @return Status - The error code return
   virtual Status WorkerEntry(int32_t workerId) = 0;
 
+  // Called by a worker before the compute part of its work. When the tree auto tunes the number of
+  // workers, this blocks while the op is already running as many workers as its quota allows.
+  // @param worker_id - The id of the worker
+  // @return Status - The error code return
+  Status WorkerComputeBegin(int32_t worker_id);
+
+  // Called by a worker after the compute part of its work. When the tree is profiled, the time
+  // since WorkerComputeBegin is added to the busy time of the worker.
+  // @param worker_id - The id of the worker
+  void WorkerComputeEnd(int32_t worker_id);
+
+  // Calls WorkerComputeEnd when it goes out of scope, so that the quota slot taken by a successful
+  // WorkerComputeBegin is given back on the error paths of the compute too.
+  class WorkerComputeScope {
+   public:
+    WorkerComputeScope(ParallelOp *op, int32_t worker_id) : op_(op), worker_id_(worker_id) {}
+
+    ~WorkerComputeScope() { op_->WorkerComputeEnd(worker_id_); }
+
+    WorkerComputeScope(const WorkerComputeScope &) = delete;
+    WorkerComputeScope &operator=(const WorkerComputeScope &) = delete;
+
+   private:
+    ParallelOp *op_;
+    int32_t worker_id_;
+  };
+
   int32_t num_workers_;    // The number of worker threads
   int32_t num_producers_;  // The number of threads pushing to the out_connector_
   int32_t worker_connector_size_;
   std::unique_ptr<DbConnector> worker_connector_;  // The internal connector for worker threads
+  std::unique_ptr<std::atomic<int64_t>[]> worker_busy_ns_;                 // Compute time of each worker
+  std::vector<std::chrono::steady_clock::time_point> worker_compute_start_;  // Owned by each worker
 };
 }  // namespace dataset
 }  // namespace mindspore
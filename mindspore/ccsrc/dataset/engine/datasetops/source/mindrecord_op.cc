@@ -50,6 +50,8 @@ MindRecordOp::Builder::Builder() : build_dataset_file_("") {
   build_rows_per_buffer_ = cfg->rows_per_buffer();
   build_op_connector_queue_size_ = cfg->op_connector_size();
   build_block_reader_ = false;
+  build_use_mmap_ = false;
+  build_read_ahead_size_ = kDefaultReadAheadSize;
   builder_num_workers_ = 0;
 }
 
@@ -61,10 +63,14 @@ Status MindRecordOp::Builder::Build(std::shared_ptr<MindRecordOp> *ptr) {
     return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                   "Building a MindRecordOp that has not provided a file.");
   }
+  if (build_read_ahead_size_ < 0) {
+    RETURN_STATUS_UNEXPECTED("Building a MindRecordOp with a negative read ahead size.");
+  }
 
   new_mind_record_op = std::make_shared<MindRecordOp>(build_num_mind_record_workers_, build_rows_per_buffer_,
                                                       build_dataset_file_, build_op_connector_queue_size_,
-                                                      build_columns_to_load_, build_operators_, build_block_reader_);
+                                                      build_columns_to_load_, build_operators_, build_block_reader_,
+                                                      build_use_mmap_, build_read_ahead_size_);
 
   RETURN_IF_NOT_OK(new_mind_record_op->Init());
 
@@ -77,7 +83,8 @@ Status MindRecordOp::Builder::SanityCheck() const { return Status::OK(); }
 // Constructor of the MindRecordOp.
 MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buffer, std::string dataset_file,
                            int32_t op_connector_queue_size, const std::vector<std::string> &columns_to_load,
-                           const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader)
+                           const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader,
+                           const bool &use_mmap, int32_t read_ahead_size)
     : ParallelOp(num_mind_record_workers, op_connector_queue_size),
       rows_per_buffer_(rows_per_buffer),
       dataset_file_(dataset_file),
@@ -85,6 +92,8 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buf
       operators_(operators),
       num_mind_record_workers_(num_mind_record_workers),
       block_reader_(block_reader),
+      use_mmap_(use_mmap),
+      read_ahead_size_(read_ahead_size),
       buffers_needed_(0),
       buf_cnt_(0),
       num_rows_(0),
@@ -100,7 +109,11 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buf
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
   shard_reader_ = std::make_unique<ShardReader>();
-  auto rc = shard_reader_->Open(dataset_file_, num_mind_record_workers_, columns_to_load_, operators_, block_reader_);
+  shard_reader_->set_read_ahead_size(static_cast<uint64_t>(read_ahead_size_) << 20);
+  // The fields of binary raw rows are copied into the tensors from the mapped files, without json
+  shard_reader_->set_keep_encoded_labels(true);
+  auto rc = shard_reader_->Open(dataset_file_, num_mind_record_workers_, columns_to_load_, operators_, block_reader_,
+                                use_mmap_);
 
   CHECK_FAIL_RETURN_UNEXPECTED(rc != MSRStatus::FAILED,
                                "MindRecordOp init failed. Error message: " + ErrnoToMessage(rc));
@@ -150,8 +163,11 @@ Status MindRecordOp::Init() {
     data_schema_ = std::move(tmp_schema);
   }
 
+  const mindrecord::ShardRawCodec *raw_codec = shard_reader_->get_raw_codec();
+  raw_field_ids_.clear();
   for (int i = 0; i < static_cast<int>(columns_to_load_.size()); i++) {
     column_name_mapping_[columns_to_load_[i]] = i;
+    raw_field_ids_.push_back(raw_codec != nullptr ? raw_codec->GetFieldId(columns_to_load_[i]) : -1);
   }
 
   num_rows_ = shard_reader_->get_num_rows();
@@ -195,7 +211,8 @@ void MindRecordOp::Print(std::ostream &out, bool show_all) const {
 
 template <typename T>
 Status MindRecordOp::LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col,
-                                 const std::vector<uint8_t> &columns_blob, const mindrecord::json &columns_json) const {
+                                 const mindrecord::ShardBlobView &columns_blob, const mindrecord::json &columns_json,
+                                 const mindrecord::ShardBlobView &encoded_label) const {
   TensorShape new_shape = TensorShape::CreateUnknownRankShape();
   const unsigned char *data = nullptr;
 
@@ -207,9 +224,14 @@ Status MindRecordOp::LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col,
   DataType type = cur_column.type();
 
   // load blob column
-  if (columns_blob_index_[i_col] >= 0 && columns_blob.size() > 0) {
+  if (columns_blob_index_[i_col] >= 0 && columns_blob.size > 0) {
     int32_t pos = columns_blob_.size() == 1 ? -1 : columns_blob_index_[i_col];
     RETURN_IF_NOT_OK(LoadBlob(&new_shape, &data, columns_blob, pos, cur_column));
+  } else if (raw_field_ids_[i_col] >= 0 && shard_reader_->get_encoded_labels()) {
+    // the label of the row is only in the mapped file, its json is empty
+    CHECK_FAIL_RETURN_UNEXPECTED(encoded_label.data != nullptr, "Encoded raw row of column " + column_name +
+                                                                    " could not be viewed in the mapped file.");
+    RETURN_IF_NOT_OK(LoadEncodedField(&new_shape, &data, i_col, encoded_label));
   } else {
     switch (type.value()) {
       case DataType::DE_UINT8: {
@@ -244,8 +266,30 @@ Status MindRecordOp::LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col,
   return Status::OK();
 }
 
+Status MindRecordOp::LoadEncodedField(TensorShape *new_shape, const unsigned char **data, int32_t i_col,
+                                      const mindrecord::ShardBlobView &encoded_label) const {
+  const mindrecord::ShardRawCodec *raw_codec = shard_reader_->get_raw_codec();
+  const uint8_t *value = nullptr;
+  uint64_t size = 0;
+  if (!raw_codec->GetField(encoded_label.data, encoded_label.size, raw_field_ids_[i_col], &value, &size)) {
+    RETURN_STATUS_UNEXPECTED("Encoded raw row is broken.");
+  }
+  if (raw_codec->get_fields()[raw_field_ids_[i_col]].type == mindrecord::kRawFieldString) {
+    std::vector<dsize_t> shape_details = {static_cast<dsize_t>(size)};
+    *new_shape = TensorShape(shape_details);
+  } else {
+    // The number is stored at the width of the type of the column, it is copied as it is
+    if (size != static_cast<uint64_t>(data_schema_->column(i_col).type().SizeInBytes())) {
+      RETURN_STATUS_UNEXPECTED("Encoded field does not match the type of column " + columns_to_load_[i_col]);
+    }
+    *new_shape = TensorShape::CreateScalar();
+  }
+  *data = value;
+  return Status::OK();
+}
+
 Status MindRecordOp::LoadBlob(TensorShape *new_shape, const unsigned char **data,
-                              const std::vector<uint8_t> &columns_blob, const int32_t pos,
+                              const mindrecord::ShardBlobView &columns_blob, const int32_t pos,
                               const ColDescriptor &column) {
   const auto kColumnSize = column.type().SizeInBytes();
   if (kColumnSize == 0) {
@@ -255,18 +299,18 @@ Status MindRecordOp::LoadBlob(TensorShape *new_shape, const unsigned char **data
     if (column.hasShape()) {
       *new_shape = TensorShape::CreateUnknownRankShape();
       RETURN_IF_NOT_OK(
-        column.MaterializeTensorShape(static_cast<int32_t>(columns_blob.size() / kColumnSize), new_shape));
+        column.MaterializeTensorShape(static_cast<int32_t>(columns_blob.size / kColumnSize), new_shape));
     } else {
-      std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(columns_blob.size() / kColumnSize)};
+      std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(columns_blob.size / kColumnSize)};
       *new_shape = TensorShape(shapeDetails);
     }
-    *data = reinterpret_cast<const uint8_t *>(&(columns_blob[0]));
+    *data = columns_blob.data;
     return Status::OK();
   }
   auto uint64_from_bytes = [&](int64_t pos) {
     uint64_t result = 0;
     for (uint64_t n = 0; n < kInt64Len; n++) {
-      result = (result << 8) + columns_blob[pos + n];
+      result = (result << 8) + columns_blob.data[pos + n];
     }
     return result;
   };
@@ -284,7 +328,7 @@ Status MindRecordOp::LoadBlob(TensorShape *new_shape, const unsigned char **data
     std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(num_bytes / kColumnSize)};
     *new_shape = TensorShape(shapeDetails);
   }
-  *data = reinterpret_cast<const uint8_t *>(&(columns_blob[iStart]));
+  *data = columns_blob.data + iStart;
   return Status::OK();
 }
 
@@ -489,8 +533,25 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   *fetched_buffer = std::make_unique<DataBuffer>(buffer_id, DataBuffer::kDeBFlagNone);
   (*fetched_buffer)->set_column_name_map(column_name_mapping_);
   std::unique_ptr<TensorQTable> tensor_table = std::make_unique<TensorQTable>();
+  // The blobs of compressed pages are decompressed into their own buffers, they cannot be viewed
+  bool view_blobs = use_mmap_ && !block_reader_ && shard_reader_->get_compression() == mindrecord::kCompressionNone;
   for (int32_t i = 0; i < rows_per_buffer_; ++i) {
+    if (view_blobs) {
+      // The blobs stay in the mapped files until they are copied into the tensors
+      int32_t row_id = buffer_id * rows_per_buffer_ + i;
+      auto viewed_rows = shard_reader_->GetNextViewById(row_id);
+      if (viewed_rows.empty()) break;
+      auto encoded_label = shard_reader_->GetEncodedLabelView(row_id);
+      for (const auto &viewed_row : viewed_rows) {
+        TensorRow tensor_row;
+        RETURN_IF_NOT_OK(
+          LoadTensorRow(&tensor_row, std::get<0>(viewed_row), std::get<1>(viewed_row), encoded_label));
+        tensor_table->push_back(std::move(tensor_row));
+      }
+      continue;
+    }
     ShardTuple tupled_buffer;
+    mindrecord::ShardBlobView encoded_label{nullptr, 0};
     if (block_reader_) {
       if (i >= block_buffer_[buffer_id % num_workers_]->size()) break;
       tupled_buffer = block_buffer_[buffer_id % num_workers_]->at(i);
@@ -498,21 +559,13 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
       int32_t row_id = buffer_id * rows_per_buffer_ + i;
       tupled_buffer = shard_reader_->GetNextById(row_id, worker_id);
       if (tupled_buffer.empty()) break;
+      encoded_label = shard_reader_->GetEncodedLabelView(row_id);
     }
     for (const auto &tupled_row : tupled_buffer) {
-      std::vector<uint8_t> columnsBlob = std::get<0>(tupled_row);
-      mindrecord::json columns_json = std::get<1>(tupled_row);
+      const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
       TensorRow tensor_row;
-      for (uint32_t j = 0; j < columns_to_load_.size(); ++j) {
-        std::shared_ptr<Tensor> tensor;
-
-        const ColDescriptor &cur_column = data_schema_->column(j);
-        DataType type = cur_column.type();
-        RETURN_IF_NOT_OK(SwitchLoadFeature(type, &tensor, j, columnsBlob, columns_json));
-
-        tensor_row.push_back(std::move(tensor));
-      }
-
+      RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, mindrecord::ShardBlobView{columns_blob.data(), columns_blob.size()},
+                                     std::get<1>(tupled_row), encoded_label));
       tensor_table->push_back(std::move(tensor_row));
     }
   }
@@ -522,42 +575,58 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   return Status::OK();
 }
 
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const mindrecord::ShardBlobView &columns_blob,
+                                   const mindrecord::json &columns_json,
+                                   const mindrecord::ShardBlobView &encoded_label) const {
+  for (uint32_t j = 0; j < columns_to_load_.size(); ++j) {
+    std::shared_ptr<Tensor> tensor;
+
+    const ColDescriptor &cur_column = data_schema_->column(j);
+    DataType type = cur_column.type();
+    RETURN_IF_NOT_OK(SwitchLoadFeature(type, &tensor, j, columns_blob, columns_json, encoded_label));
+
+    tensor_row->push_back(std::move(tensor));
+  }
+  return Status::OK();
+}
+
 Status MindRecordOp::SwitchLoadFeature(const DataType &type, std::shared_ptr<Tensor> *tensor, int32_t i_col,
-                                       const std::vector<uint8_t> &columns_blob,
-                                       const mindrecord::json &columns_json) const {
+                                       const mindrecord::ShardBlobView &columns_blob,
+                                       const mindrecord::json &columns_json,
+                                       const mindrecord::ShardBlobView &encoded_label) const {
   switch (type.value()) {
     case DataType::DE_BOOL: {
-      return LoadFeature<bool>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<bool>(tensor, i_col, columns_blob, columns_json, encoded_label);
     }
     case DataType::DE_INT8: {
-      return LoadFeature<int8_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<int8_t>(tensor, i_col, columns_blob, columns_json, encoded_label);
     }
     case DataType::DE_UINT8: {
-      return LoadFeature<uint8_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<uint8_t>(tensor, i_col, columns_blob, columns_json, encoded_label);
     }
     case DataType::DE_INT16: {
-      return LoadFeature<int16_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<int16_t>(tensor, i_col, columns_blob, columns_json, encoded_label);
     }
     case DataType::DE_UINT16: {
-      return LoadFeature<uint16_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<uint16_t>(tensor, i_col, columns_blob, columns_json, encoded_label);
     }
     case DataType::DE_INT32: {
-      return LoadFeature<int32_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<int32_t>(tensor, i_col, columns_blob, columns_json, encoded_label);
     }
     case DataType::DE_UINT32: {
-      return LoadFeature<uint32_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<uint32_t>(tensor, i_col, columns_blob, columns_json, encoded_label);
     }
     case DataType::DE_INT64: {
-      return LoadFeature<int64_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<int64_t>(tensor, i_col, columns_blob, columns_json, encoded_label);
     }
     case DataType::DE_UINT64: {
-      return LoadFeature<uint64_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<uint64_t>(tensor, i_col, columns_blob, columns_json, encoded_label);
     }
     case DataType::DE_FLOAT32: {
-      return LoadFeature<float>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<float>(tensor, i_col, columns_blob, columns_json, encoded_label);
     }
     case DataType::DE_FLOAT64: {
-      return LoadFeature<double>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<double>(tensor, i_col, columns_blob, columns_json, encoded_label);
     }
     default: {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
@@ -98,12 +98,26 @@ class MindRecordOp : public ParallelOp {
       return *this;
     }
 
+    Builder &SetUseMmap() {
+      build_use_mmap_ = true;
+      return *this;
+    }
+
+    // Setter method
+    // @param read_ahead_size - Size in MB of the rows read ahead of the workers, 0 turns the read ahead off
+    // @return Builder setter method returns reference to the builder
+    Builder &SetReadAheadSize(int32_t read_ahead_size) {
+      build_read_ahead_size_ = read_ahead_size;
+      return *this;
+    }
+
     Status SanityCheck() const;
 
     static int32_t num_mind_record_workers() { return kDefaultMindRecordWorkers; }
 
    private:
     static constexpr int32_t kDefaultMindRecordWorkers = 4;
+    static constexpr int32_t kDefaultReadAheadSize = 64;  // MB
     // The builder saves all MindRecordOp construction arguments internally.
     // The following are the arguments.
     int32_t build_num_mind_record_workers_;
@@ -114,6 +128,8 @@ class MindRecordOp : public ParallelOp {
     std::vector<std::string> build_columns_to_load_;
     std::vector<std::shared_ptr<ShardOperator>> build_operators_;
     bool build_block_reader_;
+    bool build_use_mmap_;
+    int32_t build_read_ahead_size_;
   };
 
   // Constructor of the MindRecordOp.
@@ -124,9 +140,13 @@ class MindRecordOp : public ParallelOp {
   // @param op_connector_queue_size - The output connector queue size
   // @param columns_to_load - The list of columns to use (column name)
   // @param operators - ShardOperators for Shuffle, Category, Sample
+  // @param block_reader - Read the shard files page by page
+  // @param use_mmap - Read the shard files through memory maps, the blobs are copied straight into the tensors
+  // @param read_ahead_size - Size in MB of the rows read ahead of the workers in the order of the sampler
   MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buffer, std::string dataset_file,
                int32_t op_connector_queue_size, const std::vector<std::string> &columns_to_load,
-               const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader);
+               const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader,
+               const bool &use_mmap = false, int32_t read_ahead_size = 0);
 
   // Destructor
   ~MindRecordOp() override;
@@ -184,6 +204,9 @@ class MindRecordOp : public ParallelOp {
 
   bool block_reader() const { return block_reader_; }
 
+  // Getter method
+  bool use_mmap() const { return use_mmap_; }
+
   Status Init();
 
   Status SetColumnsBlob();
@@ -191,20 +214,38 @@ class MindRecordOp : public ParallelOp {
  private:
   Status GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_buffer, int64_t buffer_id, int32_t worker_id);
 
+  // Parses a row received from the reader into tensors
+  // @param tensor_row - the row of tensors to fill
+  // @param columns_blob - the blob data received from the reader
+  // @param columns_json - the data for fields received from the reader
+  // @param encoded_label - the binary raw row in the mapped file, data is nullptr if the fields are in columns_json
+  Status LoadTensorRow(TensorRow *tensor_row, const mindrecord::ShardBlobView &columns_blob,
+                       const mindrecord::json &columns_json, const mindrecord::ShardBlobView &encoded_label) const;
+
   // Parses a single cell and puts the data into a tensor
   // @param tensor - the tensor to put the parsed data in
   // @param i_col - the id of column to parse
   // @param columns_blob - the blob data received from the reader
   // @param columns_json - the data for fields received from the reader
+  // @param encoded_label - the binary raw row in the mapped file, data is nullptr if the fields are in columns_json
   template <typename T>
-  Status LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col, const std::vector<uint8_t> &columns_blob,
-                     const mindrecord::json &columns_json) const;
+  Status LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col, const mindrecord::ShardBlobView &columns_blob,
+                     const mindrecord::json &columns_json, const mindrecord::ShardBlobView &encoded_label) const;
 
   Status SwitchLoadFeature(const DataType &type, std::shared_ptr<Tensor> *tensor, int32_t i_col,
-                           const std::vector<uint8_t> &columns_blob, const mindrecord::json &columns_json) const;
+                           const mindrecord::ShardBlobView &columns_blob, const mindrecord::json &columns_json,
+                           const mindrecord::ShardBlobView &encoded_label) const;
+
+  // Get shape and data of a field of a binary raw row, the data stays in the mapped file
+  // @param new_shape - the shape of tensor to be created.
+  // @param data - the bytes of the field
+  // @param i_col - the id of column to parse
+  // @param encoded_label - the binary raw row in the mapped file
+  Status LoadEncodedField(TensorShape *new_shape, const unsigned char **data, int32_t i_col,
+                          const mindrecord::ShardBlobView &encoded_label) const;
 
-  static Status LoadBlob(TensorShape *new_shape, const unsigned char **data, const std::vector<uint8_t> &columns_blob,
-                         const int32_t pos, const ColDescriptor &column);
+  static Status LoadBlob(TensorShape *new_shape, const unsigned char **data,
+                         const mindrecord::ShardBlobView &columns_blob, const int32_t pos, const ColDescriptor &column);
 
   // Get shape and data (scalar or array) for tensor to be created (for floats and doubles)
   // @param new_shape - the shape of tensor to be created.
@@ -251,6 +292,8 @@ class MindRecordOp : public ParallelOp {
   std::vector<std::shared_ptr<ShardOperator>> operators_;  // ShardOperators to use
   int32_t num_mind_record_workers_;                        // number of workers to be spawned by ShardReader
   bool block_reader_;                                      // block reader switch
+  bool use_mmap_;                                          // memory map switch
+  int32_t read_ahead_size_;                                // size in MB of the rows read ahead
   int32_t buffers_needed_;                                 // Counter for the buffers that were fetched
   int64_t buf_cnt_;                                        // Buffer counter
   int32_t num_rows_;                                       // One more than the last row id in the range for this cache
@@ -260,6 +303,7 @@ class MindRecordOp : public ParallelOp {
   std::unique_ptr<DataSchema> data_schema_;  // Data schema for column typing
   std::vector<std::string> columns_blob_;    // Blob Columns to load from dataset
   std::vector<int32_t> columns_blob_index_;  // Blob Columns to load from dataset
+  std::vector<int32_t> raw_field_ids_;       // Fields of binary raw rows of the columns, -1 if not a raw field
 
   std::unordered_map<std::string, int32_t> column_name_mapping_;
   std::unique_ptr<ShardReader> shard_reader_;
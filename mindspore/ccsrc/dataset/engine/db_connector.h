@@ -16,6 +16,8 @@
 #ifndef DATASET_ENGINE_DB_CONNECTOR_H_
 #define DATASET_ENGINE_DB_CONNECTOR_H_
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <utility>
 #include "dataset/engine/connector.h"
@@ -24,6 +26,14 @@
 
 namespace mindspore {
 namespace dataset {
+// The profiling counters of one producer or consumer thread of a DbConnector. Each thread only updates
+// its own counters, so they need no lock and are kept on their own cache line.
+struct alignas(64) ConnectorThreadStats {
+  std::atomic<int64_t> blocked_ns{0};  // Time spent in push or pop, waiting for room or for data
+  std::atomic<int64_t> buffers{0};     // Number of buffers pushed or popped
+  std::atomic<int64_t> rows{0};        // Number of rows in those buffers
+};
+
 // DbConnector is a derived class from Connector with added logic to handle EOE and EOF.
 // The Connector class itself is responsible to ensure deterministic order on every run.
 class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
@@ -35,7 +45,11 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each internal queue.
   DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity), end_of_file_(false) {}
+      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity),
+        end_of_file_(false),
+        profiling_(false),
+        producer_stats_(std::make_unique<ConnectorThreadStats[]>(n_producers)),
+        consumer_stats_(std::make_unique<ConnectorThreadStats[]>(n_consumers)) {}
 
   // Destructor of DbConnector
   ~DbConnector() = default;
@@ -45,7 +59,14 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param worker_id The id of a worker thread calling this method.
   // @param el A rvalue reference to an element to be passed/added/pushed.
   Status Add(int32_t worker_id, std::unique_ptr<DataBuffer> &&el) noexcept {
-    return (Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el)));
+    if (!profiling_) {
+      return (Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el)));
+    }
+    int64_t num_rows = (el == nullptr) ? 0 : el->NumRows();
+    auto start = std::chrono::steady_clock::now();
+    Status rc = Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el));
+    UpdateStats(&producer_stats_[worker_id], start, num_rows);
+    return rc;
   }
 
   // Get a unique_ptr<DataBuffer> from the DbConnector.
@@ -57,6 +78,36 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param result The address of a unique_ptr<DataBuffer> where the popped element will be placed.
   // @param retry_if_eoe A flag to allow the same thread invoke pop() again if the current pop returns eoe buffer.
   Status PopWithRetry(int32_t worker_id, std::unique_ptr<DataBuffer> *result, bool retry_if_eoe = false) noexcept {
+    if (!profiling_) {
+      return DoPop(worker_id, result, retry_if_eoe);
+    }
+    auto start = std::chrono::steady_clock::now();
+    Status rc = DoPop(worker_id, result, retry_if_eoe);
+    int64_t num_rows = (rc.IsOk() && *result != nullptr) ? (*result)->NumRows() : 0;
+    UpdateStats(&consumer_stats_[worker_id], start, num_rows);
+    return rc;
+  }
+
+  // Turns on the profiling counters. Must be called before the producer and consumer threads start.
+  void EnableProfiling() { profiling_ = true; }
+
+  // Getter function
+  // @return True if the profiling counters are collected
+  bool profiling() const { return profiling_; }
+
+  // Getter function
+  // @param worker_id - The id of the producer thread
+  // @return The profiling counters of the producer
+  const ConnectorThreadStats &producer_stats(int32_t worker_id) const { return producer_stats_[worker_id]; }
+
+  // Getter function
+  // @param worker_id - The id of the consumer thread
+  // @return The profiling counters of the consumer
+  const ConnectorThreadStats &consumer_stats(int32_t worker_id) const { return consumer_stats_[worker_id]; }
+
+ private:
+  // The pop of PopWithRetry without the profiling counters.
+  Status DoPop(int32_t worker_id, std::unique_ptr<DataBuffer> *result, bool retry_if_eoe) noexcept {
     if (result == nullptr) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "[ERROR] nullptr detected when getting data from db connector");
@@ -87,9 +138,21 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
     return Status::OK();
   }
 
- private:
+  // Adds the time since start and the rows moved to the counters of a thread.
+  static void UpdateStats(ConnectorThreadStats *stats, std::chrono::steady_clock::time_point start,
+                          int64_t num_rows) noexcept {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    stats->blocked_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                std::memory_order_relaxed);
+    stats->buffers.fetch_add(1, std::memory_order_relaxed);
+    stats->rows.fetch_add(num_rows, std::memory_order_relaxed);
+  }
+
   // A flag to indicate the end of stream has been encountered.
   bool end_of_file_;
+  bool profiling_;
+  std::unique_ptr<ConnectorThreadStats[]> producer_stats_;
+  std::unique_ptr<ConnectorThreadStats[]> consumer_stats_;
 };
 }  // namespace dataset
 }  // namespace mindspore
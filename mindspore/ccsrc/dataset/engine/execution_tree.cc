@@ -16,9 +16,14 @@
 #include "dataset/engine/execution_tree.h"
 #include <iostream>
 #include <string>
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
+#include "dataset/engine/auto_tune.h"
 #include "dataset/engine/datasetops/dataset_op.h"
 #include "dataset/engine/datasetops/shuffle_op.h"
+#include "dataset/engine/pipeline_profiler.h"
 #include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace dataset {
@@ -100,6 +105,17 @@ Status ExecutionTree::Launch() {
       " Expected state: " + std::to_string(static_cast<int>(kDeTStateReady));
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
+  // The auto tune must be ready before the workers of the ops start asking it for quota
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  if (cfg->auto_num_workers()) {
+    auto_tune_ = std::make_unique<AutoTune>(this, cfg->cpu_budget());
+    RETURN_IF_NOT_OK(auto_tune_->Init());
+  }
+  // The connectors must count before the ops start using them
+  if (!cfg->profiling_dir().empty()) {
+    profiler_ = std::make_unique<PipelineProfiler>(this, cfg->profiling_dir(), cfg->monitor_sampling_interval());
+    RETURN_IF_NOT_OK(profiler_->Init());
+  }
   for (auto itr = this->begin(); itr != this->end(); ++itr) {
     // An inlined operator is one that has an output connector size of 0, and it does not
     // require a thread to execute.  Instead, the work of this operator is executed inlined
@@ -111,10 +127,30 @@ Status ExecutionTree::Launch() {
       // Set the state of the Operator as running. This only matters in Leaf ops, CacheOp and TakeOp
     }
   }
+  if (auto_tune_ != nullptr) {
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("Auto tune", std::ref(*auto_tune_)));
+  }
+  if (profiler_ != nullptr) {
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("Pipeline profiler", std::ref(*profiler_)));
+  }
   tree_state_ = kDeTStateExecuting;
   return Status::OK();
 }
 
+// Stops the threads of the tree and saves the profiling of the tree, if any
+Status ExecutionTree::Stop() {
+  if (tree_state_ == kDeTStateStopped) {
+    return Status::OK();
+  }
+  tree_state_ = kDeTStateStopped;
+  Status rc = tg_->ServiceStop();
+  // All the threads are stopped, so the counters are final
+  if (profiler_ != nullptr) {
+    RETURN_IF_NOT_OK(profiler_->SaveToFile());
+  }
+  return rc;
+}
+
 // A function that traverse the tree in postorder then save the results in nodes
 void ExecutionTree::Iterator::PostOrderTraverse(const std::shared_ptr<DatasetOp> &node) {
   if (node == nullptr) {
@@ -175,10 +211,18 @@ Status ExecutionTree::PrepareNode(const std::shared_ptr<DatasetOp> &dataset_op)
   }
   BitSet(&prepare_flags_, op_prep_flags);
 
+  // The subtree below a cache only runs one epoch, so hide the repeat from it and restore it
+  // for the cache itself.
+  uint32_t saved_flags = prepare_flags_;
+  if (BitTest(op_prep_flags, kDePrepCache)) {
+    BitClear(&prepare_flags_, kDePrepRepeat);
+  }
+
   // Now, descend to children
   for (int32_t i = 0; i < num_children; ++i) {
     RETURN_IF_NOT_OK(this->PrepareNode(dataset_op->child_[i]));
   }
+  prepare_flags_ = saved_flags;
 
   // No more children, now we execute any prepare actions before going back up the
   // the tree on recursive function exit
@@ -20,7 +20,9 @@
 #include <memory>
 #include <stack>
 #include <vector>
+#include "dataset/engine/auto_tune.h"
 #include "dataset/engine/datasetops/dataset_op.h"
+#include "dataset/engine/pipeline_profiler.h"
 #include "dataset/util/status.h"
 
 namespace mindspore {
@@ -34,7 +36,8 @@ class ExecutionTree {
   // Prepare flags used during tree prepare phase
   enum PrepareFlags {
     kDePrepNone = 0,
-    kDePrepRepeat = 1  //  Processing a repeat operation
+    kDePrepRepeat = 1,  //  Processing a repeat operation
+    kDePrepCache = 2    //  Processing a cache operation
   };
 
   // State flags for the lifecycle of the tree
@@ -43,7 +46,8 @@ class ExecutionTree {
     kDeTStateBuilding,  // The tree is being built, nodes are being added
     kDeTStatePrepare,   // The tree has been assigned a root node and is pending prepare
     kDeTStateReady,     // The tree has been prepared and is ready to be launched
-    kDeTStateExecuting  // The tree has been launched and is executing
+    kDeTStateExecuting,  // The tree has been launched and is executing
+    kDeTStateStopped     // The threads of the tree have been stopped
   };
 
   class Iterator {
@@ -112,6 +116,11 @@ class ExecutionTree {
   // @return Status - The error code return
   Status Launch();
 
+  // Stops the threads of the tree and saves the profiling of the tree, if any. Only the first call
+  // does anything, the destructor only stops the threads.
+  // @return Status - The error code return
+  Status Stop();
+
   // A print method typically used for debugging
   // @param out - The output stream to write output to
   // @param show_all - A bool to control if you want to show all info or just a summary
@@ -177,6 +186,14 @@ class ExecutionTree {
   // @return raw pointer to the TaskGroup
   TaskGroup *AllTasks() const { return tg_.get(); }
 
+  // Return the pointer to the AutoTune
+  // @return raw pointer to the AutoTune, null if the tree does not auto tune the number of workers
+  AutoTune *auto_tune() const { return auto_tune_.get(); }
+
+  // Return the pointer to the PipelineProfiler
+  // @return raw pointer to the PipelineProfiler, null if the tree is not profiled
+  PipelineProfiler *profiler() const { return profiler_.get(); }
+
  private:
   std::unique_ptr<TaskGroup> tg_;                        // Class for worker management
   std::shared_ptr<DatasetOp> root_;                      // The root node of the tree
@@ -184,6 +201,8 @@ class ExecutionTree {
   uint32_t prepare_flags_;                               // Flags used during tree prepare
   TreeState tree_state_;                                 // Tracking the current tree state
   std::stack<std::shared_ptr<DatasetOp>> repeat_stack_;  // A stack used during prepare phase
+  std::unique_ptr<AutoTune> auto_tune_;                  // Shares the running workers between the ops
+  std::unique_ptr<PipelineProfiler> profiler_;           // Records where the time of the ops goes
 };
 }  // namespace dataset
 }  // namespace mindspore
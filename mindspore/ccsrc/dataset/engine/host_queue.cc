@@ -0,0 +1,133 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/host_queue.h"
+#include <utility>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+std::mutex HostQueue::channels_mux_;
+std::unordered_map<std::string, std::shared_ptr<HostQueue>> HostQueue::channels_;
+
+Status HostQueue::Open(const std::string &channel_name, int32_t capacity, std::shared_ptr<HostQueue> *queue) {
+  RETURN_UNEXPECTED_IF_NULL(queue);
+  if (capacity <= 0) {
+    RETURN_STATUS_UNEXPECTED("The capacity of a host queue should be positive");
+  }
+  std::unique_lock<std::mutex> lck(channels_mux_);
+  if (channels_.find(channel_name) != channels_.end()) {
+    RETURN_STATUS_UNEXPECTED("The channel " + channel_name + " already has a host queue");
+  }
+  *queue = std::make_shared<HostQueue>(capacity);
+  channels_[channel_name] = *queue;
+  return Status::OK();
+}
+
+std::shared_ptr<HostQueue> HostQueue::Find(const std::string &channel_name) {
+  std::unique_lock<std::mutex> lck(channels_mux_);
+  auto itr = channels_.find(channel_name);
+  return itr == channels_.end() ? nullptr : itr->second;
+}
+
+void HostQueue::Close(const std::string &channel_name) {
+  std::shared_ptr<HostQueue> queue;
+  {
+    std::unique_lock<std::mutex> lck(channels_mux_);
+    auto itr = channels_.find(channel_name);
+    if (itr == channels_.end()) {
+      return;
+    }
+    queue = itr->second;
+    channels_.erase(itr);
+  }
+  std::unique_lock<std::mutex> lck(queue->mux_);
+  queue->closed_ = true;
+  for (const auto &item : queue->items_) {
+    queue->ReleaseItem(item);
+  }
+  queue->items_.clear();
+  queue->full_cv_.NotifyAll();
+  queue->empty_cv_.NotifyAll();
+}
+
+HostQueue::HostQueue(int32_t capacity) : capacity_(capacity), closed_(false) {}
+
+HostQueue::~HostQueue() {
+  std::unique_lock<std::mutex> lck(mux_);
+  for (const auto &item : items_) {
+    ReleaseItem(item);
+  }
+}
+
+void HostQueue::RegisterRelease(std::function<void(void *)> func) {
+  std::unique_lock<std::mutex> lck(mux_);
+  release_ = std::move(func);
+}
+
+Status HostQueue::Push(Item item) {
+  std::unique_lock<std::mutex> lck(mux_);
+  RETURN_IF_NOT_OK(
+    full_cv_.Wait(&lck, [this]() { return closed_ || static_cast<int32_t>(items_.size()) < capacity_; }));
+  if (closed_) {
+    ReleaseItem(item);
+    return Status::OK();
+  }
+  items_.push_back(std::move(item));
+  empty_cv_.NotifyAll();
+  return Status::OK();
+}
+
+Status HostQueue::Front(Item *item) {
+  RETURN_UNEXPECTED_IF_NULL(item);
+  std::unique_lock<std::mutex> lck(mux_);
+  RETURN_IF_NOT_OK(empty_cv_.Wait(&lck, [this]() { return closed_ || !items_.empty(); }));
+  if (items_.empty()) {
+    RETURN_STATUS_UNEXPECTED("The host queue is closed");
+  }
+  *item = items_.front();
+  return Status::OK();
+}
+
+void HostQueue::Pop() {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (items_.empty()) {
+    return;
+  }
+  ReleaseItem(items_.front());
+  items_.pop_front();
+  full_cv_.NotifyAll();
+}
+
+bool HostQueue::IsClosed() const {
+  std::unique_lock<std::mutex> lck(mux_);
+  return closed_;
+}
+
+int32_t HostQueue::size() const {
+  std::unique_lock<std::mutex> lck(mux_);
+  return static_cast<int32_t>(items_.size());
+}
+
+void HostQueue::ReleaseItem(const Item &item) {
+  if (release_ == nullptr) {
+    return;
+  }
+  for (void *addr : item.addrs) {
+    release_(addr);
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
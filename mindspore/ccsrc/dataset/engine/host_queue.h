@@ -0,0 +1,104 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_HOST_QUEUE_H_
+#define DATASET_ENGINE_HOST_QUEUE_H_
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "dataset/util/cond_var.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// A host side stand-in for the queue of a device, for the CPU device queue and the tests. It has the contract
+// of the GPU buffer manager: the producer hands over the addresses of the data without a copy and registers a
+// release function, the queue calls it on the addresses of an item once the consumer pops it.
+//
+// The consumer opens the queue of a channel before the pipeline runs, the DeviceQueueOp of the channel finds
+// it and pushes its rows into it.
+class HostQueue {
+ public:
+  // One row handed over to the queue
+  struct Item {
+    std::vector<void *> addrs;
+    std::vector<size_t> sizes;
+  };
+
+  // Creates the queue of a channel.
+  // @param channel_name - The name of the channel
+  // @param capacity - The number of items the queue holds before the producer blocks
+  // @param queue - The created queue
+  // @return Status - The error code return, an error if the channel already has a queue
+  static Status Open(const std::string &channel_name, int32_t capacity, std::shared_ptr<HostQueue> *queue);
+
+  // @param channel_name - The name of the channel
+  // @return The queue of the channel, null if none is opened
+  static std::shared_ptr<HostQueue> Find(const std::string &channel_name);
+
+  // Closes the queue of a channel, the producer stops pushing and the items left are released.
+  // @param channel_name - The name of the channel
+  static void Close(const std::string &channel_name);
+
+  explicit HostQueue(int32_t capacity);
+
+  ~HostQueue();
+
+  // @param func - The function called on each address of an item once it is popped
+  void RegisterRelease(std::function<void(void *)> func);
+
+  // Adds an item, blocks while the queue is full. The item is released at once if the queue is closed.
+  // @param item - The addresses of the data of a row
+  // @return Status - The error code return
+  Status Push(Item item);
+
+  // Gets the oldest item without removing it, blocks while the queue is empty.
+  // @param item - The oldest item, its addresses stay valid until it is popped
+  // @return Status - The error code return
+  Status Front(Item *item);
+
+  // Removes the oldest item and releases its addresses.
+  void Pop();
+
+  // @return True once the queue is closed
+  bool IsClosed() const;
+
+  // @return The number of items in the queue
+  int32_t size() const;
+
+ private:
+  // Releases the addresses of an item, the caller holds mux_.
+  void ReleaseItem(const Item &item);
+
+  int32_t capacity_;
+  bool closed_;
+  mutable std::mutex mux_;
+  CondVar full_cv_;
+  CondVar empty_cv_;
+  std::deque<Item> items_;
+  std::function<void(void *)> release_;
+
+  static std::mutex channels_mux_;
+  static std::unordered_map<std::string, std::shared_ptr<HostQueue>> channels_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_HOST_QUEUE_H_
@@ -0,0 +1,239 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/pipeline_profiler.h"
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <typeinfo>
+#include <utility>
+#include "dataset/engine/datasetops/dataset_op.h"
+#include "dataset/engine/datasetops/parallel_op.h"
+#include "dataset/engine/db_connector.h"
+#include "dataset/engine/execution_tree.h"
+#include "dataset/util/path.h"
+#include "dataset/util/services.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+#include "utils/misc.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Past this many samples, every other sample is dropped and the interval is doubled, so a long
+// running pipeline keeps a bounded trace covering its whole run.
+constexpr size_t kMaxSamples = 10000;
+constexpr double kNsPerMs = 1000000.0;
+
+double ToMs(int64_t ns) { return static_cast<double>(ns) / kNsPerMs; }
+}  // namespace
+
+PipelineProfiler::PipelineProfiler(ExecutionTree *tree, std::string dir, int32_t sampling_interval)
+    : tree_(tree), dir_(dir), sampling_interval_(sampling_interval), start_(std::chrono::steady_clock::now()) {
+  std::string suffix = std::to_string(getpid()) + "_" + Services::GetUniqueID() + ".json";
+  Path profiling_dir(dir_);
+  summary_file_ = (profiling_dir / ("pipeline_profiling_" + suffix)).toString();
+  trace_file_ = (profiling_dir / ("pipeline_trace_" + suffix)).toString();
+  if (sampling_interval_ <= 0) {
+    sampling_interval_ = 1;
+  }
+}
+
+Status PipelineProfiler::Init() {
+  RETURN_IF_NOT_OK(Path(dir_).CreateDirectories());
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    DatasetOp *op = itr.get().get();
+    if (op->inlined()) {
+      continue;
+    }
+    // Look through the inlined ops, such as repeat, for the connector we pop from
+    DbConnector *input_connector = nullptr;
+    if (op->num_children() > 0) {
+      DatasetOp *input = op->child(0).get();
+      while (input->inlined() && input->num_children() > 0) {
+        input = input->child(0).get();
+      }
+      input_connector = input->out_connector_.get();
+    }
+    DbConnector *connector = op->out_connector_.get();
+    RETURN_UNEXPECTED_IF_NULL(connector);
+    connector->EnableProfiling();
+    ops_.push_back({op, connector, input_connector, demangle(typeid(*op).name())});
+  }
+  start_ = std::chrono::steady_clock::now();
+  MS_LOG(INFO) << "Profiling " << ops_.size() << " operators into " << summary_file_ << ".";
+  return Status::OK();
+}
+
+Status PipelineProfiler::operator()() {
+  // Synchronize with TaskManager once the thread is launched.
+  TaskManager::FindMe()->Post();
+  while (!this_thread::is_interrupted()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(sampling_interval_));
+    Sample();
+  }
+  return Status::OK();
+}
+
+int64_t PipelineProfiler::ElapsedUs() const {
+  auto elapsed = std::chrono::steady_clock::now() - start_;
+  return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+void PipelineProfiler::Sample() {
+  ConnectorSample sample;
+  sample.time_us = ElapsedUs();
+  for (const auto &info : ops_) {
+    sample.depth.push_back(info.connector->size());
+    int64_t rows = 0;
+    for (int32_t i = 0; i < info.connector->num_producers(); ++i) {
+      rows += info.connector->producer_stats(i).rows.load(std::memory_order_relaxed);
+    }
+    sample.rows.push_back(rows);
+  }
+  std::unique_lock<std::mutex> lck(mux_);
+  samples_.push_back(std::move(sample));
+  if (samples_.size() >= kMaxSamples) {
+    size_t kept = 0;
+    for (size_t i = 0; i < samples_.size(); i += 2) {
+      samples_[kept++] = std::move(samples_[i]);
+    }
+    samples_.resize(kept);
+    sampling_interval_ *= 2;
+  }
+}
+
+nlohmann::json PipelineProfiler::Summary() {
+  int64_t elapsed_us = ElapsedUs();
+  double elapsed_s = static_cast<double>(elapsed_us) / 1000000.0;
+  std::unique_lock<std::mutex> lck(mux_);
+  nlohmann::json summary;
+  summary["elapsed_ms"] = static_cast<double>(elapsed_us) / 1000.0;
+  summary["num_samples"] = samples_.size();
+  summary["ops"] = nlohmann::json::array();
+  for (size_t k = 0; k < ops_.size(); ++k) {
+    const auto &info = ops_[k];
+    nlohmann::json op_js;
+    op_js["op_id"] = info.op->id();
+    op_js["op_type"] = info.name;
+    op_js["num_workers"] = info.op->num_workers();
+
+    // The pushes into our own connector
+    int64_t rows = 0;
+    int64_t buffers = 0;
+    std::vector<double> push_blocked_ms;
+    for (int32_t i = 0; i < info.connector->num_producers(); ++i) {
+      const ConnectorThreadStats &stats = info.connector->producer_stats(i);
+      rows += stats.rows.load(std::memory_order_relaxed);
+      buffers += stats.buffers.load(std::memory_order_relaxed);
+      push_blocked_ms.push_back(ToMs(stats.blocked_ns.load(std::memory_order_relaxed)));
+    }
+    op_js["rows"] = rows;
+    op_js["buffers"] = buffers;
+    op_js["rows_per_second"] = (elapsed_s > 0.0) ? static_cast<double>(rows) / elapsed_s : 0.0;
+    op_js["push_blocked_ms"] = push_blocked_ms;
+
+    // The pops of our threads from the connector of the child
+    std::vector<double> pop_blocked_ms;
+    if (info.input_connector != nullptr) {
+      for (int32_t i = 0; i < info.input_connector->num_consumers(); ++i) {
+        const ConnectorThreadStats &stats = info.input_connector->consumer_stats(i);
+        pop_blocked_ms.push_back(ToMs(stats.blocked_ns.load(std::memory_order_relaxed)));
+      }
+    }
+    op_js["pop_blocked_ms"] = pop_blocked_ms;
+
+    // Only the ops marking the compute of their workers count the busy time
+    auto parallel_op = dynamic_cast<const ParallelOp *>(info.op);
+    if (parallel_op != nullptr) {
+      std::vector<double> busy_ms;
+      std::vector<double> idle_ms;
+      for (int32_t i = 0; i < parallel_op->num_workers(); ++i) {
+        double busy = ToMs(parallel_op->worker_busy_ns(i));
+        busy_ms.push_back(busy);
+        idle_ms.push_back(std::max(elapsed_s * 1000.0 - busy, 0.0));
+      }
+      op_js["worker_busy_ms"] = busy_ms;
+      op_js["worker_idle_ms"] = idle_ms;
+    }
+
+    // The depth of our connector over the samples
+    int64_t total_depth = 0;
+    int32_t max_depth = 0;
+    for (const auto &sample : samples_) {
+      total_depth += sample.depth[k];
+      max_depth = std::max(max_depth, sample.depth[k]);
+    }
+    op_js["connector_capacity"] = info.connector->capacity();
+    op_js["connector_avg_depth"] =
+      samples_.empty() ? 0.0 : static_cast<double>(total_depth) / static_cast<double>(samples_.size());
+    op_js["connector_max_depth"] = max_depth;
+    summary["ops"].push_back(op_js);
+  }
+  return summary;
+}
+
+nlohmann::json PipelineProfiler::Trace() {
+  std::unique_lock<std::mutex> lck(mux_);
+  nlohmann::json events = nlohmann::json::array();
+  events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", 0}, {"args", {{"name", "dataset pipeline"}}}});
+  for (size_t i = 0; i < samples_.size(); ++i) {
+    const auto &sample = samples_[i];
+    for (size_t k = 0; k < ops_.size(); ++k) {
+      std::string op_name = ops_[k].name + "(" + std::to_string(ops_[k].op->id()) + ")";
+      events.push_back({{"name", op_name + " connector depth"},
+                        {"ph", "C"},
+                        {"ts", sample.time_us},
+                        {"pid", 0},
+                        {"args", {{"depth", sample.depth[k]}}}});
+      // The rows per second since the previous sample
+      if (i > 0 && sample.time_us > samples_[i - 1].time_us) {
+        double rate = static_cast<double>(sample.rows[k] - samples_[i - 1].rows[k]) * 1000000.0 /
+                      static_cast<double>(sample.time_us - samples_[i - 1].time_us);
+        events.push_back({{"name", op_name + " rows per second"},
+                          {"ph", "C"},
+                          {"ts", sample.time_us},
+                          {"pid", 0},
+                          {"args", {{"rows_per_second", rate}}}});
+      }
+    }
+  }
+  nlohmann::json trace;
+  trace["traceEvents"] = events;
+  trace["displayTimeUnit"] = "ms";
+  return trace;
+}
+
+Status PipelineProfiler::SaveToFile() {
+  // Take a last sample, so even a short run has its final state in the trace
+  Sample();
+  std::ofstream summary_stream(summary_file_, std::ios::out | std::ios::trunc);
+  if (!summary_stream.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Failed to create the profiling file: " + summary_file_);
+  }
+  summary_stream << Summary().dump(2) << std::endl;
+  summary_stream.close();
+  std::ofstream trace_stream(trace_file_, std::ios::out | std::ios::trunc);
+  if (!trace_stream.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Failed to create the profiling file: " + trace_file_);
+  }
+  trace_stream << Trace().dump() << std::endl;
+  trace_stream.close();
+  MS_LOG(INFO) << "Pipeline profiling is saved to " << summary_file_ << " and " << trace_file_ << ".";
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,118 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_PIPELINE_PROFILER_H_
+#define DATASET_ENGINE_PIPELINE_PROFILER_H_
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Forward declares
+class ExecutionTree;
+class DatasetOp;
+class DbConnector;
+
+// The PipelineProfiler records where the time of an execution tree goes, so the slowest op of a
+// pipeline can be found offline. It is cheap enough to stay on in production:
+// - The output connector of each op counts, per producer and per consumer thread, the buffers and
+//   rows it moved and the time the thread was blocked in push or pop. Each thread only touches its
+//   own counters.
+// - The ops marking the compute part of their workers (see ParallelOp::WorkerComputeBegin) count
+//   the busy time of each worker.
+// - A sampling thread records the depth and the number of rows of each output connector at a
+//   fixed interval.
+// When the tree is stopped, a summary per op is written to pipeline_profiling_<pid>_<id>.json and
+// the samples to pipeline_trace_<pid>_<id>.json in the chrome trace format (load it in chrome://tracing).
+class PipelineProfiler {
+ public:
+  // Constructor
+  // @param tree - The execution tree to profile
+  // @param dir - The directory the profiling files are written to
+  // @param sampling_interval - The interval in milliseconds between two samples of the connectors
+  PipelineProfiler(ExecutionTree *tree, std::string dir, int32_t sampling_interval);
+
+  // Destructor
+  ~PipelineProfiler() = default;
+
+  // Creates the profiling directory, collects the ops of the tree and turns on the counters of their
+  // connectors. Must be called after the tree is prepared and before the ops are launched.
+  // @return Status - The error code return
+  Status Init();
+
+  // The sampling loop, it runs in its own thread until the tree is stopped.
+  // @return Status - The error code return
+  Status operator()();
+
+  // Takes a sample of the connectors.
+  void Sample();
+
+  // Getter function
+  // @return The summary of the ops, with the rows per second, the worker busy and idle time and the time
+  // blocked on push and pop of each op
+  nlohmann::json Summary();
+
+  // Getter function
+  // @return The samples of the connectors in the chrome trace format
+  nlohmann::json Trace();
+
+  // Writes the summary and the trace into the profiling directory.
+  // @return Status - The error code return
+  Status SaveToFile();
+
+  // Getter function
+  // @return The path of the summary file
+  const std::string &summary_file() const { return summary_file_; }
+
+  // Getter function
+  // @return The path of the trace file
+  const std::string &trace_file() const { return trace_file_; }
+
+ private:
+  struct OpProfileInfo {
+    DatasetOp *op;
+    DbConnector *connector;        // The output connector of the op
+    DbConnector *input_connector;  // The connector the op pops from, null for a leaf
+    std::string name;
+  };
+
+  struct ConnectorSample {
+    int64_t time_us;  // Since the start of the profiling
+    std::vector<int32_t> depth;
+    std::vector<int64_t> rows;  // The rows pushed so far into the connector of each op
+  };
+
+  // @return The time in microseconds since the start of the profiling
+  int64_t ElapsedUs() const;
+
+  ExecutionTree *tree_;
+  std::string dir_;
+  std::string summary_file_;
+  std::string trace_file_;
+  int32_t sampling_interval_;
+  std::chrono::steady_clock::time_point start_;
+  std::mutex mux_;  // Guards the samples
+  std::vector<OpProfileInfo> ops_;
+  std::vector<ConnectorSample> samples_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_PIPELINE_PROFILER_H_
@@ -42,6 +42,10 @@ class TypeCastOp : public TensorOp {
   void Print(std::ostream &out) const override { out << "TypeCastOp"; }
   Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
 
+  // Getter function
+  // @return The datatype to cast to
+  const DataType &type() const { return type_; }
+
  private:
   DataType type_;
 };
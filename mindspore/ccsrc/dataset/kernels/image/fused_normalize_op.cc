@@ -0,0 +1,73 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/image/fused_normalize_op.h"
+
+#include "dataset/kernels/data/data_utils.h"
+#include "dataset/kernels/image/image_utils.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+FusedNormalizeOp::FusedNormalizeOp(float mean_r, float mean_g, float mean_b, float std_r, float std_g, float std_b,
+                                   bool hwc_to_chw, const DataType &output_type)
+    : mean_{mean_r, mean_g, mean_b},
+      std_{std_r, std_g, std_b},
+      hwc_to_chw_(hwc_to_chw),
+      output_type_(output_type),
+      normalize_(mean_r, mean_g, mean_b, std_r, std_g, std_b) {}
+
+Status FusedNormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  if (input->type() == DataType::DE_UINT8 && input->Rank() == 3 && input->shape()[2] == 3) {
+    return FusedNormalize(input, output, mean_, std_, hwc_to_chw_, output_type_);
+  }
+  // Other images take the steps of the ops this op replaces
+  std::shared_ptr<Tensor> normalized;
+  RETURN_IF_NOT_OK(normalize_.Compute(input, &normalized));
+  if (hwc_to_chw_) {
+    RETURN_IF_NOT_OK(HwcToChw(normalized, &normalized));
+  }
+  if (output_type_ != DataType::DE_FLOAT32) {
+    return TypeCast(normalized, output, output_type_);
+  }
+  *output = normalized;
+  return Status::OK();
+}
+
+Status FusedNormalizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  TensorShape in = inputs[0];
+  if (in.Rank() == 3) {
+    outputs.emplace_back(hwc_to_chw_ ? TensorShape{in[2], in[0], in[1]} : in);
+    return Status::OK();
+  }
+  return Status(StatusCode::kUnexpectedError, "Input has a wrong shape");
+}
+
+Status FusedNormalizeOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = output_type_;
+  return Status::OK();
+}
+
+void FusedNormalizeOp::Print(std::ostream &out) const {
+  out << "FusedNormalizeOp, mean: " << mean_[0] << ", " << mean_[1] << ", " << mean_[2] << " std: " << std_[0] << ", "
+      << std_[1] << ", " << std_[2] << " hwc to chw: " << hwc_to_chw_ << " output type: " << output_type_.ToString()
+      << std::endl;
+}
+}  // namespace dataset
+}  // namespace mindspore
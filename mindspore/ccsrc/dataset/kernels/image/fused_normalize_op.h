@@ -0,0 +1,58 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
+#define DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
+
+#include <memory>
+#include <vector>
+
+#include "dataset/core/tensor.h"
+#include "dataset/kernels/image/normalize_op.h"
+#include "dataset/kernels/tensor_op.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Does the work of a NormalizeOp, optionally followed by a HwcToChwOp and a cast to float16, in a single
+// pass over a uint8 image. The MapOp replaces such a chain of ops with this op.
+class FusedNormalizeOp : public TensorOp {
+ public:
+  // @param hwc_to_chw: Whether to write each channel as a plane, like HwcToChwOp
+  // @param output_type: DE_FLOAT32, or DE_FLOAT16 to cast the normalized image
+  FusedNormalizeOp(float mean_r, float mean_g, float mean_b, float std_r, float std_g, float std_b, bool hwc_to_chw,
+                   const DataType &output_type);
+
+  ~FusedNormalizeOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+ private:
+  float mean_[3];
+  float std_[3];
+  bool hwc_to_chw_;
+  DataType output_type_;
+  NormalizeOp normalize_;  // For the images the fused kernel does not handle
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
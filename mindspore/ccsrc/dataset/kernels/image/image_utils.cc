@@ -266,8 +266,23 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
   throw std::runtime_error(jpeg_last_error_msg);
 }
 
+int JpegScaleDenom(int crop_height, int crop_width, int target_height, int target_width) {
+  // The scaled IDCT of libjpeg averages the pixels it drops, so it is only used while the
+  // scaled crop still covers the target
+  constexpr int kMaxScaleDenom = 8;
+  for (int denom = kMaxScaleDenom; denom > 1; denom /= 2) {
+    if (crop_height / denom >= target_height && crop_width / denom >= target_width) {
+      return denom;
+    }
+  }
+  return 1;
+}
+
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int scale_denom) {
+  if (scale_denom != 1 && scale_denom != 2 && scale_denom != 4 && scale_denom != 8) {
+    RETURN_STATUS_UNEXPECTED("Jpeg scale denominator should be 1, 2, 4 or 8");
+  }
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -281,6 +296,8 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->StartAddr(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scale_denom;
     jpeg_calc_output_dimensions(&cinfo);
   } catch (std::runtime_error &e) {
     return DestroyDecompressAndReturnError(e.what());
@@ -288,9 +305,17 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   if (crop_x == 0 && crop_y == 0 && crop_w == 0 && crop_h == 0) {
     crop_w = cinfo.output_width;
     crop_h = cinfo.output_height;
-  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.output_width || crop_h == 0 ||
-             static_cast<unsigned int>(crop_h + crop_y) > cinfo.output_height) {
+  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.image_width || crop_h == 0 ||
+             static_cast<unsigned int>(crop_h + crop_y) > cinfo.image_height) {
     return DestroyDecompressAndReturnError("Crop window is not valid");
+  } else if (scale_denom > 1) {
+    // Map the crop window onto the scaled image, covering the whole window
+    int end_x = std::min((crop_x + crop_w + scale_denom - 1) / scale_denom, static_cast<int>(cinfo.output_width));
+    int end_y = std::min((crop_y + crop_h + scale_denom - 1) / scale_denom, static_cast<int>(cinfo.output_height));
+    crop_x /= scale_denom;
+    crop_y /= scale_denom;
+    crop_w = std::max(end_x - crop_x, 1);
+    crop_h = std::max(end_y - crop_y, 1);
   }
   const int mcu_size = cinfo.min_DCT_scaled_size;
   unsigned int crop_x_aligned = (crop_x / mcu_size) * mcu_size;
@@ -527,6 +552,71 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
   }
 }
 
+// The number of pixels FusedNormalizePixels widens to float at a time, small enough to stay in the L1 cache
+constexpr int64_t kFusedNormalizeChunk = 256;
+
+// The bytes are widened to float in a loop of their own, the conversion of uint8 does not vectorize on
+// plain SSE2 when mixed with the deinterleave. Both loops then vectorize without any intrinsics.
+template <typename T>
+static void FusedNormalizePixels(const uint8_t *in, T *out, int64_t num_pixels, const float *mean, const float *std,
+                                 bool hwc_to_chw) {
+  const float scale_r = 1.0f / std[0];
+  const float scale_g = 1.0f / std[1];
+  const float scale_b = 1.0f / std[2];
+  const float shift_r = -mean[0] * scale_r;
+  const float shift_g = -mean[1] * scale_g;
+  const float shift_b = -mean[2] * scale_b;
+  float widened[3 * kFusedNormalizeChunk];
+  for (int64_t start = 0; start < num_pixels; start += kFusedNormalizeChunk) {
+    int64_t count = std::min(kFusedNormalizeChunk, num_pixels - start);
+    const uint8_t *src = in + 3 * start;
+    for (int64_t k = 0; k < 3 * count; k++) {
+      widened[k] = src[k];
+    }
+    if (hwc_to_chw) {
+      T *out_r = out + start;
+      T *out_g = out_r + num_pixels;
+      T *out_b = out_g + num_pixels;
+      for (int64_t i = 0; i < count; i++) {
+        out_r[i] = static_cast<T>(widened[3 * i] * scale_r + shift_r);
+        out_g[i] = static_cast<T>(widened[3 * i + 1] * scale_g + shift_g);
+        out_b[i] = static_cast<T>(widened[3 * i + 2] * scale_b + shift_b);
+      }
+    } else {
+      T *dst = out + 3 * start;
+      for (int64_t i = 0; i < count; i++) {
+        dst[3 * i] = static_cast<T>(widened[3 * i] * scale_r + shift_r);
+        dst[3 * i + 1] = static_cast<T>(widened[3 * i + 1] * scale_g + shift_g);
+        dst[3 * i + 2] = static_cast<T>(widened[3 * i + 2] * scale_b + shift_b);
+      }
+    }
+  }
+}
+
+Status FusedNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const float *mean,
+                      const float *std, bool hwc_to_chw, const DataType &output_type) {
+  if (input->type() != DataType::DE_UINT8 || input->Rank() != 3 || input->shape()[2] != 3) {
+    RETURN_STATUS_UNEXPECTED("Fused normalize expects an image of shape <H,W,3> and type uint8");
+  }
+  if (output_type != DataType::DE_FLOAT32 && output_type != DataType::DE_FLOAT16) {
+    RETURN_STATUS_UNEXPECTED("Fused normalize only outputs float32 or float16");
+  }
+  dsize_t height = input->shape()[0];
+  dsize_t width = input->shape()[1];
+  TensorShape shape = hwc_to_chw ? TensorShape({3, height, width}) : input->shape();
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, shape, output_type));
+  const uint8_t *in = input->StartAddr();
+  unsigned char *out = (*output)->StartAddr();
+  RETURN_UNEXPECTED_IF_NULL(in);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  if (output_type == DataType::DE_FLOAT32) {
+    FusedNormalizePixels<float>(in, reinterpret_cast<float *>(out), height * width, mean, std, hwc_to_chw);
+  } else {
+    FusedNormalizePixels<float16>(in, reinterpret_cast<float16 *>(out), height * width, mean, std, hwc_to_chw);
+  }
+  return Status::OK();
+}
+
 Status AdjustBrightness(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const float &alpha) {
   try {
     std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
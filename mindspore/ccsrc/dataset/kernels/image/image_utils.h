@@ -96,8 +96,18 @@ bool HasJpegMagic(const unsigned char *data, size_t data_size);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+// Returns the decoded crop of a jpeg image, only the scanlines and the MCU columns covering the crop are decoded
+// @param input: Tensor containing the not decoded jpeg bytes
+// @param output: Decoded crop Tensor of shape <H,W,C> and type DE_UINT8. Pixel order is RGB
+// @param x, y, w, h: The crop window in the full resolution image, all 0 to decode the whole image
+// @param scale_denom: 1, 2, 4 or 8. The crop is decoded with the scaled IDCT of libjpeg at 1/scale_denom of its size
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int scale_denom = 1);
+
+// Returns the largest jpeg scale denominator (8, 4, 2 or 1) keeping the decoded crop at least as large as the target
+// @param crop_height, crop_width: The crop window in the full resolution image
+// @param target_height, target_width: The size the crop is resized to after decoding
+int JpegScaleDenom(int crop_height, int crop_width, int target_height, int target_width);
 // Returns Rescaled image
 // @param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
 // @param rescale: rescale parameter
@@ -157,6 +167,16 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                  const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std);
 
+// Returns Normalized image in a single pass over the input, optionally as planes and as float16
+// @param input: Tensor of shape <H,W,3> in RGB order and type DE_UINT8
+// @param output: Normalized image Tensor of shape <3,H,W> if hwc_to_chw else <H,W,3>, of type output_type
+// @param mean: Array of the 3 means of each channel in RGB order
+// @param std: Array of the 3 stds of each channel in RGB order
+// @param hwc_to_chw: Whether to write each channel as a plane
+// @param output_type: DE_FLOAT32 or DE_FLOAT16
+Status FusedNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const float *mean,
+                      const float *std, bool hwc_to_chw, const DataType &output_type);
+
 // Returns image with adjusted brightness.
 // @param input: Tensor of shape <H,W,3> in RGB order and any OpenCv compatible type, see CVTensor.
 // @param alpha: Alpha value to adjust brightness by. Should be a positive number.
@@ -35,6 +35,16 @@ class NormalizeOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  // Getter function
+  // @param channel - The index of the channel, 0 to 2
+  // @return The mean of the channel
+  float channel_mean(int32_t channel) const { return mean_->mat().at<float>(channel); }
+
+  // Getter function
+  // @param channel - The index of the channel, 0 to 2
+  // @return The standard deviation of the channel
+  float channel_std(int32_t channel) const { return std_->mat().at<float>(channel); }
+
  private:
   std::shared_ptr<CVTensor> mean_;
   std::shared_ptr<CVTensor> std_;
@@ -21,11 +21,14 @@
 
 namespace mindspore {
 namespace dataset {
+const bool RandomCropDecodeResizeOp::kDefDctScaling = true;
+
 RandomCropDecodeResizeOp::RandomCropDecodeResizeOp(int32_t target_height, int32_t target_width, float scale_lb,
                                                    float scale_ub, float aspect_lb, float aspect_ub,
-                                                   InterpolationMode interpolation, int32_t max_iter)
+                                                   InterpolationMode interpolation, int32_t max_iter, bool dct_scaling)
     : RandomCropAndResizeOp(target_height, target_width, scale_lb, scale_ub, aspect_lb, aspect_ub, interpolation,
-                            max_iter) {}
+                            max_iter),
+      dct_scaling_(dct_scaling) {}
 
 Status RandomCropDecodeResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   if (input == nullptr) {
@@ -60,8 +63,11 @@ Status RandomCropDecodeResizeOp::Compute(const std::shared_ptr<Tensor> &input, s
     int crop_width = 0;
     (void)GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width);
 
+    // A crop much larger than the target is decoded at a fraction of its size, which also skips
+    // most of the IDCT work
+    int scale_denom = dct_scaling_ ? JpegScaleDenom(crop_height, crop_width, target_height_, target_width_) : 1;
     std::shared_ptr<Tensor> decoded;
-    RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, x, y, crop_width, crop_height));
+    RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, x, y, crop_width, crop_height, scale_denom));
     return Resize(decoded, output, target_height_, target_width_, 0.0, 0.0, interpolation_);
   }
 }
@@ -31,9 +31,15 @@ namespace mindspore {
 namespace dataset {
 class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
  public:
+  // Default values, also used by python_bindings.cc
+  static const bool kDefDctScaling;
+
+  // @param dct_scaling: When the crop is at least twice the target size, decode a jpeg with the scaled IDCT of
+  //     libjpeg (1/2, 1/4 or 1/8) instead of decoding the crop at full size before the resize
   RandomCropDecodeResizeOp(int32_t target_height, int32_t target_width, float scale_lb = kDefScaleLb,
                            float scale_ub = kDefScaleUb, float aspect_lb = kDefAspectLb, float aspect_ub = kDefAspectUb,
-                           InterpolationMode interpolation = kDefInterpolation, int32_t max_iter = kDefMaxIter);
+                           InterpolationMode interpolation = kDefInterpolation, int32_t max_iter = kDefMaxIter,
+                           bool dct_scaling = kDefDctScaling);
 
   ~RandomCropDecodeResizeOp() override = default;
 
@@ -43,6 +49,9 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
   }
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+ private:
+  bool dct_scaling_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -14,13 +14,19 @@
  * limitations under the License.
  */
 #include "dataset/util/arena.h"
+#include <sys/mman.h>
 #include <unistd.h>
+#include <cerrno>
 #include <utility>
 #include "dataset/util/system_pool.h"
 #include "dataset/util/de_error.h"
 #include "./securec.h"
 #include "utils/log_adapter.h"
 
+#ifdef ENABLE_GPUQUE
+#include <cuda_runtime_api.h>
+#endif
+
 namespace mindspore {
 namespace dataset {
 struct MemHdr {
@@ -40,9 +46,35 @@ Status Arena::Init() {
   uint64_t num_blks = size_in_bytes_ / ARENA_BLK_SZ;
   MS_LOG(INFO) << "Size of memory pool is " << num_blks << ", number of blocks of size is " << ARENA_BLK_SZ << ".";
   tr_.Insert(0, num_blks);
+  if (pinned_) {
+    Pin();
+  }
   return Status::OK();
 }
 
+void Arena::Pin() {
+#ifdef ENABLE_GPUQUE
+  cudaError_t ret = cudaHostRegister(ptr_, size_in_bytes_, cudaHostRegisterDefault);
+  if (ret != cudaSuccess) {
+    MS_LOG(WARNING) << "Failed to pin " << size_in_MB_ << " MB of memory: " << cudaGetErrorString(ret) << ".";
+    pinned_ = false;
+  }
+#else
+  if (mlock(ptr_, size_in_bytes_) != 0) {
+    MS_LOG(WARNING) << "Failed to pin " << size_in_MB_ << " MB of memory, errno " << errno << ".";
+    pinned_ = false;
+  }
+#endif
+}
+
+void Arena::Unpin() {
+#ifdef ENABLE_GPUQUE
+  (void)cudaHostUnregister(ptr_);
+#else
+  (void)munlock(ptr_, size_in_bytes_);
+#endif
+}
+
 Status Arena::Allocate(size_t n, void **p) {
   if (n == 0) {
     *p = nullptr;
@@ -158,14 +190,15 @@ std::ostream &operator<<(std::ostream &os, const Arena &s) {
   return os;
 }
 
-Arena::Arena(size_t val_in_MB) : ptr_(nullptr), size_in_MB_(val_in_MB), size_in_bytes_(val_in_MB * 1048576L) {}
+Arena::Arena(size_t val_in_MB, bool pinned)
+    : ptr_(nullptr), size_in_MB_(val_in_MB), size_in_bytes_(val_in_MB * 1048576L), pinned_(pinned) {}
 
-Status Arena::CreateArena(std::shared_ptr<Arena> *p_ba, size_t val_in_MB) {
+Status Arena::CreateArena(std::shared_ptr<Arena> *p_ba, size_t val_in_MB, bool pinned) {
   if (p_ba == nullptr) {
     RETURN_STATUS_UNEXPECTED("p_ba is null");
   }
   Status rc;
-  auto ba = new (std::nothrow) Arena(val_in_MB);
+  auto ba = new (std::nothrow) Arena(val_in_MB, pinned);
   if (ba == nullptr) {
     return Status(StatusCode::kOutOfMemory);
   }
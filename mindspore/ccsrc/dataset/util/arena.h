@@ -41,6 +41,9 @@ namespace dataset {
 //
 // When a block of memory is freed. It is joined with the blocks before and after (if they are available) to
 // form a bigger block.
+//
+// A pinned arena page-locks its memory, so a device can copy from it without a staging buffer. The memory is
+// registered with the GPU driver when the device queue is built for GPU, and locked with mlock otherwise.
 class Arena : public MemoryPool {
  public:
   Arena(const Arena &) = delete;
@@ -49,6 +52,9 @@ class Arena : public MemoryPool {
 
   ~Arena() override {
     if (ptr_ != nullptr) {
+      if (pinned_) {
+        Unpin();
+      }
       free(ptr_);
       ptr_ = nullptr;
     }
@@ -74,9 +80,23 @@ class Arena : public MemoryPool {
 
   const void *get_base_addr() const { return ptr_; }
 
+  // @return True if the memory of the arena is page-locked
+  bool pinned() const { return pinned_; }
+
+  // @param p - An address
+  // @return True if p points into the memory of the arena
+  bool Contains(const void *p) const {
+    const char *base = static_cast<const char *>(ptr_);
+    return p >= base && p < base + size_in_bytes_;
+  }
+
   friend std::ostream &operator<<(std::ostream &os, const Arena &s);
 
-  static Status CreateArena(std::shared_ptr<Arena> *p_ba, size_t val_in_MB = 4096);
+  // @param p_ba - The created arena
+  // @param val_in_MB - The size of the arena
+  // @param pinned - Whether to page-lock the memory. If the memory cannot be locked, the arena is still created
+  //     and logs a warning.
+  static Status CreateArena(std::shared_ptr<Arena> *p_ba, size_t val_in_MB = 4096, bool pinned = false);
 
  private:
   std::mutex mux_;
@@ -84,13 +104,19 @@ class Arena : public MemoryPool {
   void *ptr_;
   size_t size_in_MB_;
   size_t size_in_bytes_;
+  bool pinned_;
 
-  explicit Arena(size_t val_in_MB = 4096);
+  explicit Arena(size_t val_in_MB = 4096, bool pinned = false);
 
   std::pair<std::pair<uint64_t, uint64_t>, bool> FindPrevBlk(uint64_t addr);
 
   Status Init();
 
+  // Page-locks the memory, clears pinned_ if it fails.
+  void Pin();
+
+  void Unpin();
+
   bool BlockEnlarge(uint64_t *addr, uint64_t old_sz, uint64_t new_sz);
 
   Status FreeAndAlloc(void **pp, size_t old_sz, size_t new_sz);
@@ -93,6 +93,12 @@ class Queue {
     return (v >= 0) ? v : 0;
   }
 
+  // The size seen by the threads other than the producers and consumers, such as the ones sampling the queue
+  int LockedSize() const {
+    std::unique_lock<std::mutex> _lock(mux_);
+    return size();
+  }
+
   int capacity() const { return sz_; }
 
   bool empty() const { return head_ == tail_; }
@@ -196,7 +202,7 @@ class Queue {
   uint64_t head_;
   uint64_t tail_;
   std::string my_name_;
-  std::mutex mux_;
+  mutable std::mutex mux_;
   CondVar empty_cv_;
   CondVar full_cv_;
   Allocator<T> alloc_;
@@ -230,6 +236,8 @@ class QueueList {
 
   std::unique_ptr<Queue<T>> &operator[](const int index) { return queue_list_[index]; }
 
+  const std::unique_ptr<Queue<T>> &operator[](const int index) const { return queue_list_[index]; }
+
   ~QueueList() = default;
 
  private:
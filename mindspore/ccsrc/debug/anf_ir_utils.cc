@@ -85,10 +85,13 @@ std::string AnfExporter::GetNodeType(const AnfNodePtr& nd) {
 }
 
 std::string AnfExporter::DumpObject(const py::object& obj, const std::string& category) const {
-  std::string pkl_path = GetMsIrPath();
-  // if not specified env 'MS_IR_PATH', do not create any files
-  if (pkl_path.empty() || (getenv("MS_IR_FILE") != nullptr)) {
-    return "null";
+  std::string pkl_path = object_path_;
+  if (pkl_path.empty()) {
+    pkl_path = GetMsIrPath();
+    // if not specified env 'MS_IR_PATH', do not create any files
+    if (pkl_path.empty() || (getenv("MS_IR_FILE") != nullptr)) {
+      return "null";
+    }
   }
   std::string file_prefix = id_ + "." + category;
   std::string file_name = dump_obj(obj, pkl_path + "/" + file_prefix);
@@ -462,7 +465,7 @@ void AnfExporter::OutputParameters(std::ofstream& ofs, const std::vector<AnfNode
     if (param_ptr == nullptr) {
       MS_LOG(EXCEPTION) << "Param could not cast to parameter";
     }
-    if (param_ptr->has_default()) {
+    if (param_ptr->has_default() && dump_default_param_) {
       ofs << " = @" << DumpObject(param_ptr->default_param(), "D");
     }
 
@@ -1058,12 +1061,13 @@ const unsigned Lexer::BUF_SIZE;
 
 class IrParser {
  public:
-  explicit IrParser(const char* filename) : lexer_(filename) {}
+  explicit IrParser(const char* filename, const std::string& object_path = "")
+      : lexer_(filename), object_path_(object_path) {}
 
   ~IrParser() {}
 
   py::object LoadObject(const std::string& file_name) const {
-    std::string pkl_path = GetMsIrPath();
+    std::string pkl_path = object_path_.empty() ? GetMsIrPath() : object_path_;
     py::object default_obj = load_obj(pkl_path + "/" + file_name);
     return default_obj;
   }
@@ -1213,6 +1217,7 @@ class IrParser {
     MS_EXCEPTION_IF_NULL(func_graph);
     cnodes_[var_name] = func_graph->NewCNode(inputs);
     MS_EXCEPTION_IF_NULL(cnodes_[var_name]);
+    cnodes_[var_name]->set_abstract(type);
     cnodes_[var_name]->set_debug_info(std::make_shared<NodeDebugInfo>(var_name + "@" + std::to_string(lineno)));
     return func_graph;
   }
@@ -1635,6 +1640,7 @@ class IrParser {
       if (tok == TOK_COLON) {
         AbstractBasePtr type = nullptr;
         tok = ParseType(func_graph, &type);
+        param->set_abstract(type);
       }
       // parse default value
       if (tok == TOK_EQUALITY) {
@@ -2206,6 +2212,7 @@ class IrParser {
 
  private:
   Lexer lexer_;
+  std::string object_path_;
   std::vector<FuncGraphPtr> func_graphs_;
   bool error_flag_ = false;
 
@@ -2220,8 +2227,8 @@ class IrParser {
   std::map<std::string, ParameterPtr> param_nodes_;  // map parameter name to parameter
 };
 
-std::vector<FuncGraphPtr> ImportIR(const std::string& filename) {
-  IrParser parser(filename.c_str());
+std::vector<FuncGraphPtr> ImportIR(const std::string& filename, const std::string& object_path) {
+  IrParser parser(filename.c_str(), object_path);
   parser.ParseFile();
   return parser.GetFuncGraphs();
 }
@@ -74,6 +74,11 @@ class AnfExporter {
   void ExportFuncGraph(const std::string& filename, const FuncGraphPtr& func_graph);
   void ExportFuncGraph(const std::string& filename, const std::vector<TaggedGraph>& graphs);
 
+  // dump the python objects to this directory instead of the one given by 'MS_IR_PATH'
+  void set_object_path(const std::string& path) { object_path_ = path; }
+  // the default values of the parameters are not dumped when the loader binds them itself
+  void set_dump_default_param(bool flag) { dump_default_param_ = flag; }
+
  protected:
   virtual std::string GetNodeType(const AnfNodePtr& nd);
   int GetParamIndex(const FuncGraphPtr& func_graph, const AnfNodePtr& param, bool throw_excp = true);
@@ -106,12 +111,15 @@ class AnfExporter {
   bool check_integrity_ = false;  // whether check integrity or not, when dumping ir for loading, must set it to true
   TaggedNodeMap tagged_cnodes_;
   abstract::AnfNodeConfigPtr node_cfg_ = nullptr;
+  std::string object_path_;
+  bool dump_default_param_ = true;
 };
 
 void ExportIR(const std::string& filename, const std::string& id, const FuncGraphPtr& func_graph);
 void ExportIR(const std::string& filename, const std::vector<TaggedGraph>& graphs);
 
-std::vector<FuncGraphPtr> ImportIR(const std::string& filename);
+// object_path is the directory of the python objects of the file, the one given by 'MS_IR_PATH' if empty
+std::vector<FuncGraphPtr> ImportIR(const std::string& filename, const std::string& object_path = "");
 
 std::string GetFuncGraphProtoString(const FuncGraphPtr& func_graph);
 
@@ -0,0 +1,161 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/cpu_kernel_build.h"
+#include <sys/time.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "device/cpu/cpu_kernel_factory.h"
+#include "session/anf_runtime_algorithm.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+struct KernelBuildTask {
+  CNodePtr kernel_node;
+  std::string kernel_name;
+  std::shared_ptr<CPUKernel> cpu_kernel;
+  size_t node_num{0};
+  uint64_t cost{0};
+  std::string error_msg;
+};
+
+// the nodes with the same key are built into the same kernel
+std::string GetKernelKey(const CNodePtr &kernel_node) {
+  std::ostringstream buffer;
+  buffer << AnfAlgo::GetCNodeName(kernel_node);
+  auto primitive = AnfAlgo::GetCNodePrimitive(kernel_node);
+  if (primitive != nullptr) {
+    buffer << primitive->GetAttrsText();
+  }
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  for (size_t input_index = 0; input_index < input_num; ++input_index) {
+    buffer << ";I" << AnfAlgo::GetInputDeviceDataType(kernel_node, input_index) << ":";
+    for (auto dim : AnfAlgo::GetInputDeviceShape(kernel_node, input_index)) {
+      buffer << dim << ",";
+    }
+  }
+  size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
+  for (size_t output_index = 0; output_index < output_num; ++output_index) {
+    buffer << ";O" << AnfAlgo::GetOutputDeviceDataType(kernel_node, output_index) << ":";
+    for (auto dim : AnfAlgo::GetOutputDeviceShape(kernel_node, output_index)) {
+      buffer << dim << ",";
+    }
+  }
+  return buffer.str();
+}
+
+void BuildTask(KernelBuildTask *task) {
+  struct timeval start_time, end_time;
+  (void)gettimeofday(&start_time, nullptr);
+  try {
+    task->cpu_kernel = CPUKernelFactory::Get().Create(task->kernel_name);
+    if (task->cpu_kernel == nullptr) {
+      task->error_msg = "Operator[" + task->kernel_name + "] is not support.";
+      return;
+    }
+    task->cpu_kernel->Init(task->kernel_node);
+  } catch (const std::exception &e) {
+    task->cpu_kernel = nullptr;
+    task->error_msg = "Build operator[" + task->kernel_name + "] failed: " + e.what();
+    return;
+  }
+  (void)gettimeofday(&end_time, nullptr);
+  const uint64_t kUSecondInSecond = 1000000;
+  task->cost = kUSecondInSecond * static_cast<uint64_t>(end_time.tv_sec - start_time.tv_sec);
+  task->cost += static_cast<uint64_t>(end_time.tv_usec - start_time.tv_usec);
+}
+
+void BuildTasks(std::vector<KernelBuildTask> *tasks, size_t thread_num) {
+  if (thread_num == 0) {
+    thread_num = std::thread::hardware_concurrency();
+  }
+  thread_num = std::min(thread_num, tasks->size());
+  if (thread_num <= 1) {
+    for (auto &task : *tasks) {
+      BuildTask(&task);
+    }
+    return;
+  }
+  // the kernels are independent, each thread takes the next one not taken yet
+  std::atomic<size_t> next_task(0);
+  auto worker = [tasks, &next_task]() {
+    for (size_t i = next_task++; i < tasks->size(); i = next_task++) {
+      BuildTask(&(*tasks)[i]);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+}  // namespace
+
+void KernelBuild(const session::KernelGraph *kernel_graph, size_t thread_num) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto &kernel_nodes = kernel_graph->execution_order();
+  std::vector<KernelBuildTask> tasks;
+  std::vector<size_t> node_tasks;
+  std::unordered_map<std::string, size_t> key_tasks;
+  for (const auto &kernel_node : kernel_nodes) {
+    MS_EXCEPTION_IF_NULL(kernel_node);
+    auto key = GetKernelKey(kernel_node);
+    auto iter = key_tasks.find(key);
+    if (iter == key_tasks.end()) {
+      iter = key_tasks.emplace(key, tasks.size()).first;
+      KernelBuildTask task;
+      task.kernel_node = kernel_node;
+      task.kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+      tasks.push_back(task);
+    }
+    tasks[iter->second].node_num++;
+    node_tasks.push_back(iter->second);
+  }
+
+  struct timeval start_time, end_time;
+  (void)gettimeofday(&start_time, nullptr);
+  BuildTasks(&tasks, thread_num);
+  (void)gettimeofday(&end_time, nullptr);
+  for (const auto &task : tasks) {
+    if (task.cpu_kernel == nullptr) {
+      MS_LOG(EXCEPTION) << task.error_msg;
+    }
+    MS_LOG(INFO) << "Cpu build success operator[" << task.kernel_name << "] in " << task.cost << " us, used by "
+                 << task.node_num << " nodes.";
+  }
+  for (size_t i = 0; i < kernel_nodes.size(); ++i) {
+    AnfAlgo::SetKernelMod(tasks[node_tasks[i]].cpu_kernel, kernel_nodes[i].get());
+  }
+  const uint64_t kUSecondInSecond = 1000000;
+  uint64_t cost = kUSecondInSecond * static_cast<uint64_t>(end_time.tv_sec - start_time.tv_sec);
+  cost += static_cast<uint64_t>(end_time.tv_usec - start_time.tv_usec);
+  MS_LOG(INFO) << "Cpu build " << tasks.size() << " kernels for " << kernel_nodes.size() << " nodes in " << cost
+               << " us.";
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,31 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_CPU_KERNEL_BUILD_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_CPU_KERNEL_BUILD_H_
+
+#include "session/kernel_graph.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// Builds the kernels of a graph. The nodes of the same op with the same shapes, types and attributes share one
+// kernel, and the distinct kernels are initialized on up to thread_num threads, 0 for as many as the cores.
+void KernelBuild(const session::KernelGraph *kernel_graph, size_t thread_num = 0);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_CPU_KERNEL_BUILD_H_
@@ -20,6 +20,7 @@
 #include <numeric>
 #include <utility>
 #include <functional>
+#include <thread>
 #include <unordered_map>
 #include "kernel/kernel.h"
 #include "device/cpu/cpu_device_address.h"
@@ -41,6 +42,54 @@ void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
   resource_manager_.MemMalloc(kernel_graph);
 }
 
+void CPUKernelRuntime::AssignRunOpKernelAddress(session::KernelGraph *kernel_graph) {
+  AssignValueNodeAddress(kernel_graph);
+  AssignInputNodeAddress(kernel_graph);
+  AssignKernelOutputAddress(kernel_graph);
+}
+
+void CPUKernelRuntime::ClearRunOpKernelAddress(const session::KernelGraph *kernel_graph,
+                                               const std::vector<tensor::TensorPtr> &inputs) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  for (const auto &kernel : kernel_graph->execution_order()) {
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(address);
+      if (address->ptr_ != nullptr) {
+        resource_manager_.MemFree(address->ptr_);
+        address->ptr_ = nullptr;
+      }
+    }
+  }
+  // the parameters of other types than float32 and int32 are copied to memory of their own when they are bound, the
+  // data is synced back to the input tensors, which then drop the address
+  auto &input_nodes = kernel_graph->inputs();
+  for (size_t i = 0; i < input_nodes.size() && i < inputs.size(); ++i) {
+    auto &item = input_nodes[i];
+    auto &tensor = inputs[i];
+    MS_EXCEPTION_IF_NULL(item);
+    MS_EXCEPTION_IF_NULL(tensor);
+    if (!item->isa<Parameter>()) {
+      continue;
+    }
+    auto address = AnfAlgo::GetMutableOutputAddr(item, 0);
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->ptr_ == nullptr || address->ptr_ == tensor->data_c(false)) {
+      continue;
+    }
+    if (!address->SyncDeviceToHost(tensor->shape(), LongToSize(tensor->data().nbytes()), tensor->data_type(),
+                                   tensor->data_c(true))) {
+      MS_LOG(EXCEPTION) << "Parameter node sync device to host failed!";
+    }
+    resource_manager_.MemFree(address->ptr_);
+    address->ptr_ = nullptr;
+    tensor->set_device_address(nullptr);
+  }
+  AssignInputNodeAddress(kernel_graph);
+}
+
 void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   size_t type_size = sizeof(float);
@@ -235,14 +284,15 @@ void CPUKernelRuntime::AddRuntimeAddress(DeviceAddress *address, std::vector<ker
   input_list->push_back(input);
 }
 
-bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph) {
-  MS_EXCEPTION_IF_NULL(kernel_graph);
-  resource_manager_.ResetAddressRefCount(kernel_graph);
-  auto kernels = kernel_graph->execution_order();
-  for (const auto &kernel : kernels) {
-    std::vector<kernel::AddressPtr> kernel_inputs;
-    std::vector<kernel::AddressPtr> kernel_workspaces;
-    std::vector<kernel::AddressPtr> kernel_outputs;
+void CPUKernelRuntime::LaunchKernel(const CNodePtr &kernel) {
+  MS_EXCEPTION_IF_NULL(kernel);
+  std::vector<kernel::AddressPtr> kernel_inputs;
+  std::vector<kernel::AddressPtr> kernel_workspaces;
+  std::vector<kernel::AddressPtr> kernel_outputs;
+  auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+  MS_EXCEPTION_IF_NULL(kernel_mod);
+  {
+    std::lock_guard<std::mutex> lock(resource_mutex_);
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
       auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
@@ -255,18 +305,60 @@ bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph) {
       MS_EXCEPTION_IF_NULL(device_address);
       AddRuntimeAddress(device_address, &kernel_outputs);
     }
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
     for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
       auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
       MS_EXCEPTION_IF_NULL(device_address);
       AddRuntimeAddress(device_address, &kernel_workspaces);
     }
-    auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+  }
+  auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+  {
+    std::lock_guard<std::mutex> lock(resource_mutex_);
     resource_manager_.DecreaseAddressRefCount(kernel);
-    if (!ret) {
-      MS_LOG(EXCEPTION) << "Launch kernel failed.";
+  }
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Launch kernel failed.";
+  }
+}
+
+size_t CPUKernelRuntime::GetInterOpParallelNum(const session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  size_t parallel_num = context_ptr->cpu_inter_op_parallel_num();
+  if (parallel_num <= 1) {
+    return 1;
+  }
+  // onednn is built with the sequential cpu runtime, so every kernel occupies one core and the inter op
+  // parallelism alone bounds the number of busy threads
+  size_t core_num = std::thread::hardware_concurrency();
+  if (core_num > 0 && parallel_num > core_num) {
+    parallel_num = core_num;
+  }
+  if (resource_manager_.IsGraphMemReused(kernel_graph)) {
+    if (sequential_graphs_.insert(kernel_graph->graph_id()).second) {
+      MS_LOG(WARNING) << "Graph " << kernel_graph->graph_id()
+                      << " reuses memory by the execution order, its kernels are launched sequentially.";
+    }
+    return 1;
+  }
+  return parallel_num;
+}
+
+bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  resource_manager_.ResetAddressRefCount(kernel_graph);
+  size_t parallel_num = GetInterOpParallelNum(kernel_graph);
+  if (parallel_num > 1) {
+    if (parallel_executor_ == nullptr || parallel_executor_->thread_num() != parallel_num) {
+      parallel_executor_ = std::make_unique<CPUParallelExecutor>(parallel_num);
     }
+    parallel_executor_->Run(kernel_graph, [this](const CNodePtr &kernel) { LaunchKernel(kernel); });
+    return true;
+  }
+  auto &kernels = kernel_graph->execution_order();
+  for (const auto &kernel : kernels) {
+    LaunchKernel(kernel);
   }
   return true;
 }
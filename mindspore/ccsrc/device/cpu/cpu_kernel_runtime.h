@@ -17,12 +17,15 @@
 #define MINDSPORE_CCSRC_DEVICE_CPU_CPU_KERNEL_RUNTIME_H_
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include "device/kernel_runtime.h"
 #include "session/kernel_graph.h"
 #include "device/cpu/cpu_resource_manager.h"
+#include "device/cpu/cpu_parallel_executor.h"
 #include "utils/any.h"
 namespace mindspore {
 namespace device {
@@ -35,6 +38,12 @@ class CPUKernelRuntime : public KernelRuntime {
   bool Init() override { return true; }
   bool Run(session::KernelGraph *graph) override;
   void AssignKernelAddress(session::KernelGraph *kernel_graph);
+  // the single op graphs of pynative are kept by the session and are not in the memory plan, their workspaces are
+  // allocated when they run
+  void AssignRunOpKernelAddress(session::KernelGraph *kernel_graph);
+  // free the workspaces and the converted inputs of a single op graph after it runs, and give its parameters new
+  // addresses, as the input tensors keep the addresses they were bound to
+  void ClearRunOpKernelAddress(const session::KernelGraph *kernel_graph, const std::vector<tensor::TensorPtr> &inputs);
   void BindInputOutput(const session::KernelGraph *kernel_graph, const std::vector<tensor::TensorPtr> &inputs,
                        VectorRef *outputs);
 
@@ -50,7 +59,14 @@ class CPUKernelRuntime : public KernelRuntime {
   void AssignInputNodeAddress(const session::KernelGraph *kernel_graph);
   void AssignKernelOutputAddress(const session::KernelGraph *kernel_graph);
   void AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list);
+  void LaunchKernel(const CNodePtr &kernel);
+  size_t GetInterOpParallelNum(const session::KernelGraph *kernel_graph);
   CPUResourceManager resource_manager_;
+  // guards resource_manager_ when kernels are launched by the parallel executor
+  std::mutex resource_mutex_;
+  std::unique_ptr<CPUParallelExecutor> parallel_executor_;
+  // the graphs warned of running sequentially as they reuse memory
+  std::unordered_set<uint32_t> sequential_graphs_;
 };
 }  // namespace cpu
 }  // namespace device
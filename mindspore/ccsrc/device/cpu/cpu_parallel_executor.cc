@@ -0,0 +1,234 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device/cpu/cpu_parallel_executor.h"
+#include <exception>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include "session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+CPUParallelExecutor::CPUParallelExecutor(size_t thread_num) {
+  for (size_t i = 0; i < thread_num; ++i) {
+    workers_.emplace_back(&CPUParallelExecutor::WorkerLoop, this);
+  }
+  MS_LOG(INFO) << "Create cpu parallel executor with " << thread_num << " threads";
+}
+
+CPUParallelExecutor::~CPUParallelExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exit_ = true;
+  }
+  task_cond_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+namespace {
+// the inputs a kernel writes in place, by the signature of its primitive, such as the variable of assign
+std::vector<bool> GetWrittenInputs(const CNodePtr &kernel) {
+  size_t input_num = kernel->inputs().size() - 1;
+  std::vector<bool> written(input_num, false);
+  auto prim = AnfAlgo::GetCNodePrimitive(kernel);
+  if (prim == nullptr) {
+    return written;
+  }
+  auto &signatures = prim->signatures();
+  if (signatures.empty()) {
+    // the optimizers without signatures update their parameter inputs in place
+    if (kOptOperatorSet.find(prim->name()) != kOptOperatorSet.end()) {
+      written.assign(input_num, true);
+    }
+    return written;
+  }
+  for (size_t i = 0; i < input_num && i < signatures.size(); ++i) {
+    written[i] = signatures[i].rw == SignatureEnumRW::kRWWrite || signatures[i].rw == SignatureEnumRW::kRWRef;
+  }
+  return written;
+}
+}  // namespace
+
+void CPUParallelExecutor::InitDependency(const std::vector<CNodePtr> &kernels) {
+  size_t kernel_num = kernels.size();
+  std::unordered_map<AnfNode *, size_t> kernel_index;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    kernel_index[kernels[i].get()] = i;
+  }
+  std::vector<std::set<size_t>> predecessors(kernel_num);
+  // the kernels writing parameters in place are ordered after the earlier readers and writers of the parameters
+  // and before the later ones
+  std::unordered_map<AnfNode *, size_t> last_writer;
+  std::unordered_map<AnfNode *, std::vector<size_t>> readers;
+  // the nodes built into the same kernel share the arguments kept in the kernel, so they run one by one
+  std::unordered_map<kernel::KernelMod *, size_t> last_launch;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    auto &kernel = kernels[i];
+    MS_EXCEPTION_IF_NULL(kernel);
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    auto launch_iter = last_launch.find(kernel_mod);
+    if (launch_iter != last_launch.end()) {
+      (void)predecessors[i].insert(launch_iter->second);
+    }
+    last_launch[kernel_mod] = i;
+    auto written_inputs = GetWrittenInputs(kernel);
+    std::vector<std::pair<AnfNodePtr, bool>> todo;
+    for (size_t j = 1; j < kernel->inputs().size(); ++j) {
+      todo.emplace_back(kernel->input(j), written_inputs[j - 1]);
+    }
+    std::set<std::pair<AnfNode *, bool>> visited;
+    // the parameters used by the kernel, and whether the kernel writes them
+    std::map<AnfNode *, bool> parameters;
+    // walk through the nodes which are not kernels, such as depend and tuple_getitem, to the real producers
+    while (!todo.empty()) {
+      auto node = todo.back().first;
+      bool is_written = todo.back().second;
+      todo.pop_back();
+      MS_EXCEPTION_IF_NULL(node);
+      if (!visited.emplace(node.get(), is_written).second) {
+        continue;
+      }
+      auto iter = kernel_index.find(node.get());
+      if (iter != kernel_index.end()) {
+        if (iter->second < i) {
+          (void)predecessors[i].insert(iter->second);
+        }
+        continue;
+      }
+      if (node->isa<Parameter>()) {
+        parameters[node.get()] = parameters[node.get()] || is_written;
+      } else if (node->isa<CNode>()) {
+        auto cnode = node->cast<CNodePtr>();
+        MS_EXCEPTION_IF_NULL(cnode);
+        auto &inputs = cnode->inputs();
+        for (size_t j = 1; j < inputs.size(); ++j) {
+          todo.emplace_back(inputs[j], is_written);
+        }
+      }
+    }
+
+    for (auto &item : parameters) {
+      auto parameter = item.first;
+      auto writer_iter = last_writer.find(parameter);
+      if (writer_iter != last_writer.end()) {
+        (void)predecessors[i].insert(writer_iter->second);
+      }
+      auto &parameter_readers = readers[parameter];
+      if (item.second) {
+        (void)predecessors[i].insert(parameter_readers.begin(), parameter_readers.end());
+        parameter_readers.clear();
+        last_writer[parameter] = i;
+      } else {
+        parameter_readers.push_back(i);
+      }
+    }
+  }
+
+  successors_.assign(kernel_num, {});
+  pending_inputs_.assign(kernel_num, 0);
+  for (size_t i = 0; i < kernel_num; ++i) {
+    pending_inputs_[i] = predecessors[i].size();
+    for (auto predecessor : predecessors[i]) {
+      successors_[predecessor].push_back(i);
+    }
+  }
+}
+
+void CPUParallelExecutor::Run(const session::KernelGraph *graph, const KernelLaunchFunc &launch_func) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto &kernels = graph->execution_order();
+  if (kernels.empty()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  InitDependency(kernels);
+  kernels_ = &kernels;
+  launch_func_ = &launch_func;
+  running_num_ = 0;
+  finished_num_ = 0;
+  failed_ = false;
+  error_msg_.clear();
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    if (pending_inputs_[i] == 0) {
+      ready_kernels_.push(i);
+    }
+  }
+  task_cond_.notify_all();
+  done_cond_.wait(lock, [this] { return finished_num_ == kernels_->size() || (failed_ && running_num_ == 0); });
+  std::queue<size_t>().swap(ready_kernels_);
+  kernels_ = nullptr;
+  launch_func_ = nullptr;
+  if (failed_) {
+    MS_LOG(EXCEPTION) << "Launch kernel failed in parallel executor: " << error_msg_;
+  }
+}
+
+void CPUParallelExecutor::WorkerLoop() {
+  while (true) {
+    size_t kernel_index = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cond_.wait(lock, [this] { return exit_ || (!failed_ && !ready_kernels_.empty()); });
+      if (exit_) {
+        return;
+      }
+      kernel_index = ready_kernels_.front();
+      ready_kernels_.pop();
+      running_num_++;
+    }
+    bool success = true;
+    std::string error_msg;
+    try {
+      (*launch_func_)((*kernels_)[kernel_index]);
+    } catch (const std::exception &e) {
+      success = false;
+      error_msg = e.what();
+    }
+    FinishKernel(kernel_index, success, error_msg);
+  }
+}
+
+void CPUParallelExecutor::FinishKernel(size_t kernel_index, bool success, const std::string &error_msg) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  running_num_--;
+  if (!success) {
+    if (!failed_) {
+      error_msg_ = error_msg;
+    }
+    failed_ = true;
+  } else {
+    finished_num_++;
+    for (auto successor : successors_[kernel_index]) {
+      if (--pending_inputs_[successor] == 0) {
+        ready_kernels_.push(successor);
+        task_cond_.notify_one();
+      }
+    }
+  }
+  if (finished_num_ == kernels_->size() || (failed_ && running_num_ == 0)) {
+    done_cond_.notify_one();
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_CPU_PARALLEL_EXECUTOR_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_CPU_PARALLEL_EXECUTOR_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "session/kernel_graph.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+using KernelLaunchFunc = std::function<void(const CNodePtr &)>;
+
+// Launches the kernels of a graph on a fixed pool of threads, a kernel becomes ready once all the kernels it
+// depends on in the execution order have finished.
+class CPUParallelExecutor {
+ public:
+  explicit CPUParallelExecutor(size_t thread_num);
+  ~CPUParallelExecutor();
+
+  size_t thread_num() const { return workers_.size(); }
+  void Run(const session::KernelGraph *graph, const KernelLaunchFunc &launch_func);
+
+ private:
+  void InitDependency(const std::vector<CNodePtr> &kernels);
+  void WorkerLoop();
+  void FinishKernel(size_t kernel_index, bool success, const std::string &error_msg);
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable task_cond_;
+  std::condition_variable done_cond_;
+  bool exit_{false};
+
+  // the state below is only valid during one Run
+  const std::vector<CNodePtr> *kernels_{nullptr};
+  const KernelLaunchFunc *launch_func_{nullptr};
+  std::vector<std::vector<size_t>> successors_;
+  std::vector<size_t> pending_inputs_;
+  std::queue<size_t> ready_kernels_;
+  size_t running_num_{0};
+  size_t finished_num_{0};
+  bool failed_{false};
+  std::string error_msg_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_CPU_PARALLEL_EXECUTOR_H_
@@ -35,6 +35,9 @@ class CPUResourceManager {
   void DecreaseAddressRefCount(const AnfNodePtr &kernel);
   void *MemMalloc(size_t mem_size);
   void MemFree(void *ptr);
+  bool IsGraphMemReused(const session::KernelGraph *graph) const {
+    return !dynamic_malloc_ && mem_plan_.IsGraphMemReused(graph);
+  }
 
  private:
   void MemFree();
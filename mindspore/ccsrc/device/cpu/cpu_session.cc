@@ -23,7 +23,7 @@
 #include "session/anf_runtime_algorithm.h"
 #include "device/kernel_runtime.h"
 #include "predict/predict.h"
-#include "device/cpu/cpu_kernel_factory.h"
+#include "device/cpu/cpu_kernel_build.h"
 
 namespace mindspore {
 namespace session {
@@ -36,6 +36,10 @@ GraphId CPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList
   predictmodel::StepConvertGraph(graph);
   MS_LOG(INFO) << "Build kernel";
   BuildKernel(graph.get());
+  // the memory plan reuses blocks by the execution order, so fix the order before assigning addresses
+  auto execution_order = graph->execution_order();
+  Reorder(&execution_order);
+  graph->set_execution_order(execution_order);
   MS_LOG(INFO) << "Assign kernel address";
   runtime_.AssignKernelAddress(graph.get());
   return graph_id;
@@ -48,9 +52,6 @@ void CPUSession::RunGraph(const GraphId &graph_id, const std::vector<tensor::Ten
   runtime_.BindInputOutput(kernel_graph.get(), inputs, outputs);
   MS_LOG(INFO) << "Run graph start";
   predictmodel::StepConvertWeight(inputs);
-  auto execution_order = kernel_graph->execution_order();
-  Reorder(&execution_order);
-  kernel_graph->set_execution_order(execution_order);
   bool ret = runtime_.Run(kernel_graph.get());
   if (!ret) {
     MS_LOG(EXCEPTION) << "Run graph failed";
@@ -58,6 +59,42 @@ void CPUSession::RunGraph(const GraphId &graph_id, const std::vector<tensor::Ten
   MS_LOG(INFO) << "Run graph end";
 }
 
+void CPUSession::BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info) {
+  // reuse the graph built for the same op and inputs
+  if (GetRunOpGraph(graph_info) != nullptr) {
+    return;
+  }
+  auto kernel_graph = ConstructSingleOpGraph(op_run_info);
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  SetKernelInfo(kernel_graph.get());
+  BuildKernel(kernel_graph.get());
+  runtime_.AssignRunOpKernelAddress(kernel_graph.get());
+  AddRunOpGraph(graph_info, kernel_graph);
+}
+
+py::tuple CPUSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info) {
+  auto kernel_graph = GetRunOpGraph(graph_info);
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  std::vector<tensor::TensorPtr> input_tensors = {};
+  std::vector<bool> tensors_mask = {};
+  ToTensorPtr(op_run_info, &input_tensors, &tensors_mask);
+  VectorRef outputs;
+  runtime_.BindInputOutput(kernel_graph.get(), input_tensors, &outputs);
+  bool ret = runtime_.Run(kernel_graph.get());
+  runtime_.ClearRunOpKernelAddress(kernel_graph.get(), input_tensors);
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Run op " << op_run_info.op_name << " failed";
+  }
+  // trans output to tuple
+  auto output_tensors = TransformBaseRefListToTuple(outputs);
+  if (!utils::isa<PyObjectRef>(output_tensors) ||
+      !py::isinstance<py::tuple>(utils::cast<PyObjectRef>(output_tensors).object_)) {
+    MS_EXCEPTION(NotSupportError) << "The output tensors should be a tuple !";
+  }
+  py::object tuple_obj = utils::cast<PyObjectRef>(output_tensors).object_;
+  return py::cast<py::tuple>(tuple_obj);
+}
+
 void CPUSession::SetKernelInfo(const KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   auto &kernel_nodes = kernel_graph->execution_order();
@@ -105,19 +142,7 @@ void CPUSession::SetKernelInfo(const KernelGraph *kernel_graph) {
 
 void CPUSession::BuildKernel(const KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
-  auto &kernel_nodes = kernel_graph->execution_order();
-  for (const auto &kernel_node : kernel_nodes) {
-    MS_EXCEPTION_IF_NULL(kernel_node);
-    std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
-    MS_LOG(INFO) << "Cpu building operator[" << kernel_name << "].";
-    std::shared_ptr<device::cpu::CPUKernel> cpu_kernel = device::cpu::CPUKernelFactory::Get().Create(kernel_name);
-    if (cpu_kernel == nullptr) {
-      MS_LOG(EXCEPTION) << "Operator[" << kernel_name << "] is not support.";
-    }
-    cpu_kernel->Init(kernel_node);
-    AnfAlgo::SetKernelMod(cpu_kernel, kernel_node.get());
-    MS_LOG(INFO) << "Cpu build success operator[" << kernel_name << "].";
-  }
+  device::cpu::KernelBuild(kernel_graph);
 }
 }  // namespace session
 }  // namespace mindspore
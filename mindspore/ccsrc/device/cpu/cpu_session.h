@@ -34,6 +34,8 @@ class CPUSession : public SessionBasic {
   }
   GraphId CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList &outputs) override;
   void RunGraph(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) override;
+  void BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info) override;
+  py::tuple RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info) override;
 
  private:
   void SetKernelInfo(const KernelGraph *kernel_graph);
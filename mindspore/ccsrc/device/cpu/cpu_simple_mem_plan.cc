@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 #include "device/cpu/cpu_simple_mem_plan.h"
+#include <memory>
 #include "session/anf_runtime_algorithm.h"
+#include "pre_activate/mem_reuse/mem_reuse_allocator.h"
+#include "utils/context/ms_context.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-void CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+size_t CPUSimpleMemPlan::NaiveMemPlan(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
   size_t total_mem_size = 0;
   auto kernels = graph->execution_order();
@@ -53,12 +56,91 @@ void CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
       }
     }
   }
-  graph_mem_size_[graph] = total_mem_size;
+  return total_mem_size;
+}
+
+void CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  size_t naive_mem_size = NaiveMemPlan(graph);
+  (void)graph_mem_reuse_.erase(graph);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // blocks are reused by the sequential execution order, which kernels launched in parallel do not follow
+  if (!context_ptr->enable_mem_reuse() || context_ptr->cpu_inter_op_parallel_num() > 1) {
+    graph_mem_size_[graph] = naive_mem_size;
+    (void)reused_graphs_.erase(graph);
+    return;
+  }
+  // graph inputs are bound to the input tensors before every run, so only kernel outputs and workspaces are
+  // planned here, reusing a block once the last consumer of its tensor in the execution order has launched
+  memreuse::MemReuseUtilPtr mem_reuse_util_ptr = std::make_shared<memreuse::MemReuseUtil>();
+  MS_EXCEPTION_IF_NULL(mem_reuse_util_ptr);
+  if (!mem_reuse_util_ptr->InitDynamicKernelRef(graph)) {
+    MS_LOG(EXCEPTION) << "Init kernel reference count failed";
+  }
+  mem_reuse_util_ptr->SetKernelDefMap();
+  mem_reuse_util_ptr->SetReuseRefCount();
+  memreuse::BestFitMemReuse bestfit_mem_reuse;
+  bestfit_mem_reuse.Reuse(mem_reuse_util_ptr.get());
+  size_t reuse_mem_size = bestfit_mem_reuse.GetAllocatedSize();
+  if (naive_mem_size > 0) {
+    MS_LOG(INFO) << "Graph " << graph->graph_id() << " memory plan: reused size [" << reuse_mem_size
+                 << "], naive size [" << naive_mem_size << "], ratio ["
+                 << static_cast<double>(reuse_mem_size) / static_cast<double>(naive_mem_size) << "]";
+  }
+  graph_mem_size_[graph] = reuse_mem_size;
+  graph_mem_reuse_[graph] = mem_reuse_util_ptr;
+  (void)reused_graphs_.insert(graph);
 }
 
 size_t CPUSimpleMemPlan::GetGraphMemSize(const session::KernelGraph *graph) { return graph_mem_size_[graph]; }
 
+bool CPUSimpleMemPlan::IsGraphMemReused(const session::KernelGraph *graph) const {
+  return reused_graphs_.find(graph) != reused_graphs_.end();
+}
+
 void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto iter = graph_mem_reuse_.find(graph);
+  if (iter == graph_mem_reuse_.end()) {
+    NaiveMemAssign(graph, base_ptr);
+    return;
+  }
+  ReuseMemAssign(graph, iter->second, base_ptr);
+  (void)graph_mem_reuse_.erase(iter);
+}
+
+void CPUSimpleMemPlan::ReuseMemAssign(const session::KernelGraph *graph,
+                                      const memreuse::MemReuseUtilPtr &mem_reuse_util_ptr, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(mem_reuse_util_ptr);
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  mem_reuse_util_ptr->set_mem_base(base_ptr);
+  auto kernels = graph->execution_order();
+  for (const auto &kernel : kernels) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(address);
+      if (address->ptr_ == nullptr) {
+        address->ptr_ = mem_reuse_util_ptr->GetNodeOutputPtr(kernel, i);
+      }
+    }
+
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(address);
+      if (address->ptr_ == nullptr) {
+        address->ptr_ = mem_reuse_util_ptr->GetNodeWorkSpacePtr(kernel, i);
+      }
+    }
+  }
+}
+
+void CPUSimpleMemPlan::NaiveMemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(base_ptr);
   uint8_t *mem_ptr = base_ptr;
@@ -18,8 +18,10 @@
 
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include "session/kernel_graph.h"
 #include "device/device_address.h"
+#include "pre_activate/mem_reuse/mem_reuse.h"
 
 namespace mindspore {
 namespace device {
@@ -32,9 +34,17 @@ class CPUSimpleMemPlan {
   void MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
   size_t GetGraphMemSize(const session::KernelGraph *graph);
+  bool IsGraphMemReused(const session::KernelGraph *graph) const;
 
  private:
+  size_t NaiveMemPlan(const session::KernelGraph *graph);
+  void NaiveMemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  void ReuseMemAssign(const session::KernelGraph *graph, const memreuse::MemReuseUtilPtr &mem_reuse_util_ptr,
+                      uint8_t *base_ptr);
   std::unordered_map<const session::KernelGraph *, size_t> graph_mem_size_;
+  // kernel output and workspace offsets planned by lifetime, released once the graph memory is assigned
+  std::unordered_map<const session::KernelGraph *, memreuse::MemReuseUtilPtr> graph_mem_reuse_;
+  std::unordered_set<const session::KernelGraph *> reused_graphs_;
 };
 }  // namespace cpu
 }  // namespace device
@@ -41,10 +41,9 @@ class MKLKernelEngine {
                const std::unordered_map<int, dnnl::memory> &arguments);
 
  private:
-  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
+  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0) {}
   ~MKLKernelEngine() = default;
   dnnl::engine engine_;
-  dnnl::stream stream_;
 };
 }  // namespace cpu
 }  // namespace device
@@ -51,18 +51,30 @@ BlockQueueStatus_T GpuQueue::Push(void *feature_addr, size_t feature_size, void
     MS_LOG(ERROR) << "feature start addr is nullptr";
     return INTERNAL_ERROR;
   }
-  CHECK_CUDA_RET_WITH_ERROR(
-    cudaMemcpyAsync(feature_start_addr, feature_addr, feature_size, cudaMemcpyHostToDevice, stream_),
-    "Cuda Memcpy Error");
+  if (cudaMemcpyAsync(feature_start_addr, feature_addr, feature_size, cudaMemcpyHostToDevice, stream_) != cudaSuccess) {
+    MS_LOG(ERROR) << "Cuda Memcpy Error";
+    return INTERNAL_ERROR;
+  }
   void *label_start_addr = reinterpret_cast<unsigned char *>(feature_start_addr) + feature_size;
   if (label_start_addr == nullptr) {
     MS_LOG(ERROR) << "label start addr is nullptr";
     return INTERNAL_ERROR;
   }
-  CHECK_CUDA_RET_WITH_ERROR(cudaMemcpyAsync(label_start_addr, label_addr, label_size, cudaMemcpyHostToDevice, stream_),
-                            "Cuda Memcpy Error");
+  if (cudaMemcpyAsync(label_start_addr, label_addr, label_size, cudaMemcpyHostToDevice, stream_) != cudaSuccess) {
+    MS_LOG(ERROR) << "Cuda Memcpy Error";
+    return INTERNAL_ERROR;
+  }
+  // the host buffers are released in Front once the event is reached, the copies must be done by then
   node_info_[tail_].event_.reset(new cudaEvent_t());
-  CHECK_CUDA_RET_WITH_ERROR(cudaEventCreate(&(*(node_info_[tail_].event_))), "Cuda Create Event Failed");
+  if (cudaEventCreate(&(*(node_info_[tail_].event_))) != cudaSuccess) {
+    MS_LOG(ERROR) << "Cuda Create Event Failed";
+    return INTERNAL_ERROR;
+  }
+  if (cudaEventRecord(*(node_info_[tail_].event_), stream_) != cudaSuccess) {
+    MS_LOG(ERROR) << "Cuda Record Event Failed";
+    (void)cudaEventDestroy(*(node_info_[tail_].event_));
+    return INTERNAL_ERROR;
+  }
   node_info_[tail_].host_feature_addr_ = feature_addr;
   node_info_[tail_].host_label_addr_ = label_addr;
   tail_ = (tail_ + 1) % (capacity_);
@@ -138,6 +138,31 @@ void KernelRuntime::RunOpAssignMemory(const std::vector<tensor::TensorPtr> &inpu
   UpdateRefNodeOutputMem(graph);
 }
 
+void KernelRuntime::RunOpClearMemory(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  // the output tensors keep the addresses they were given
+  for (const auto &item : graph->inputs()) {
+    MS_EXCEPTION_IF_NULL(item);
+    if (!item->isa<Parameter>()) {
+      continue;
+    }
+    for (size_t index = 0; index < AnfAlgo::GetOutputTensorNum(item); ++index) {
+      AnfAlgo::SetOutputAddr(nullptr, index, item.get());
+    }
+  }
+  for (const auto &cnode : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(cnode);
+    auto kernel_mod = AnfAlgo::GetKernelMod(cnode);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    for (size_t index = 0; index < kernel_mod->GetOutputSizeList().size(); ++index) {
+      AnfAlgo::SetOutputAddr(nullptr, index, cnode.get());
+    }
+    for (size_t index = 0; index < kernel_mod->GetWorkspaceSizeList().size(); ++index) {
+      AnfAlgo::SetWorkspaceAddr(nullptr, index, cnode.get());
+    }
+  }
+}
+
 void KernelRuntime::AssignStaticMemory(session::KernelGraph *graph) {
   AssignStaticMemoryInput(graph);
   AssignStaticMemoryValueNode(graph);
@@ -79,6 +79,7 @@ void FuncGraphManager::Reset() {
 
   signals_ = std::make_shared<Signals>();
   nodes_ = std::make_shared<NodesCollector>(this);
+  primitive_nodes_ = nullptr;
   valuenodes_ = std::make_shared<ValueNodesCollector>(this);
   free_variables_direct_ = std::make_shared<FVDirectCollector>(this);
   func_graph_valuenodes_ = std::make_shared<FuncGraphValueNodesCollector>(this);
@@ -196,6 +197,13 @@ bool FuncGraphManager::func_graph_j_total(const FuncGraphPtr& fg) const {
   return j_total_->j_total_analysis()[fg];
 }
 
+PrimitiveNodesMap& FuncGraphManager::primitive_nodes() {
+  if (primitive_nodes_ == nullptr) {
+    primitive_nodes_ = std::make_shared<PrimitiveNodesCollector>(this);
+  }
+  return primitive_nodes_->primitive_nodes_;
+}
+
 // add a func graph to this manager, optionally as a root func graph.
 void FuncGraphManager::AddFuncGraph(FuncGraphPtr func_graph, bool is_root) {
   MS_EXCEPTION_IF_NULL(func_graph);
@@ -652,6 +660,39 @@ void NodesCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
   (void)nodes_analysis_.erase(src);
 }
 
+PrimitiveNodesCollector::PrimitiveNodesCollector(const FuncGraphManager* const m) : DepCollector(m) {
+  // the nodes managed before the collector was made
+  for (auto& node : manager_->all_nodes_) {
+    auto cnode = node->cast<CNodePtr>();
+    if (cnode != nullptr && !cnode->inputs().empty()) {
+      OnModEdge(cnode, 0, cnode->input(0), kIncEdge);
+    }
+  }
+}
+
+void PrimitiveNodesCollector::OnModEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) {
+  if (index != 0 || !IsValueNode<Primitive>(inp)) {
+    return;
+  }
+  auto name = GetValueNode<PrimitivePtr>(inp)->name();
+  if (direction == kIncEdge) {
+    primitive_nodes_[name].add(node);
+    return;
+  }
+  // a new primitive of the same name is added before the old edge is dropped
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  auto current = cnode->inputs().empty() ? nullptr : cnode->input(0);
+  if (current != nullptr && current != inp && IsValueNode<Primitive>(current) &&
+      GetValueNode<PrimitivePtr>(current)->name() == name) {
+    return;
+  }
+  auto iter = primitive_nodes_.find(name);
+  if (iter != primitive_nodes_.end()) {
+    (void)iter->second.erase(node);
+  }
+}
+
 void DepCollector::OnAddEdge(AnfNodePtr node, int index, AnfNodePtr inp) { OnModEdge(node, index, inp, kIncEdge); }
 
 DepCollector::DepCollector(const FuncGraphManager* const manager) : FuncGraphAnalysis(manager) {
@@ -20,6 +20,7 @@
 #define MINDSPORE_CCSRC_IR_MANAGER_H_
 
 #include <unordered_set>
+#include <unordered_map>
 #include <set>
 #include <map>
 #include <list>
@@ -174,6 +175,23 @@ class NodesCollector final : public DepCollector {
   void OnDropNode(AnfNodePtr n) override;
 };
 
+using PrimitiveNodesMap = std::unordered_map<std::string, AnfNodeSet>;
+
+// cnodes applying a primitive, keyed by the name of the primitive, kept by the edges to input 0
+class PrimitiveNodesCollector final : public DepCollector {
+ public:
+  explicit PrimitiveNodesCollector(const FuncGraphManager* m);
+  ~PrimitiveNodesCollector() override = default;
+
+  size_t size() const override { return primitive_nodes_.size(); }
+
+  PrimitiveNodesMap primitive_nodes_;
+
+ protected:
+  void ExtraReset() override { primitive_nodes_.clear(); }
+  void OnModEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) override;
+};
+
 class CounterFuncGraphCollector : public DepCollector {
  public:
   explicit CounterFuncGraphCollector(const FuncGraphManager* m) : DepCollector(m) {}
@@ -559,6 +577,9 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager> {
 
   FuncGraphToAnfNodeMap& nodes() const { return nodes_->nodes_analysis_; }
 
+  // built on the first call, then updated with the graphs; managers never asking for it pay nothing
+  PrimitiveNodesMap& primitive_nodes();
+
   FuncGraphToAnfNodeCounterMap& valuenodes() const { return valuenodes_->count_nodes_map_; }
 
   FuncGraphToAnfNodeCounterMap& free_variables_direct() const { return free_variables_direct_->count_nodes_map_; }
@@ -606,6 +627,7 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager> {
   NodeUsersMap node_users_;
   AnfNodeSet all_nodes_;  // managed nodes
   std::shared_ptr<NodesCollector> nodes_;
+  std::shared_ptr<PrimitiveNodesCollector> primitive_nodes_;
   std::shared_ptr<ValueNodesCollector> valuenodes_;
   std::shared_ptr<FVDirectCollector> free_variables_direct_;
   std::shared_ptr<FuncGraphValueNodesCollector> func_graph_valuenodes_;
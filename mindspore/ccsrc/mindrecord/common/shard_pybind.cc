@@ -74,6 +74,8 @@ void BindShardWriter(py::module *m) {
     .def("open_for_append", &ShardWriter::OpenForAppend)
     .def("set_header_size", &ShardWriter::set_header_size)
     .def("set_page_size", &ShardWriter::set_page_size)
+    .def("set_compression", &ShardWriter::set_compression)
+    .def("set_raw_format", &ShardWriter::set_raw_format)
     .def("set_shard_header", &ShardWriter::SetShardHeader)
     .def("write_raw_data",
          (MSRStatus(ShardWriter::*)(std::map<uint64_t, std::vector<py::handle>> &, vector<vector<uint8_t>> &, bool)) &
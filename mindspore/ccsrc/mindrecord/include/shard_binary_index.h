@@ -0,0 +1,125 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
+#define MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "mindrecord/include/common/shard_utils.h"
+#include "mindrecord/include/shard_mapped_file.h"
+
+namespace mindspore {
+namespace mindrecord {
+const std::string kBinaryIndexSuffix = ".idx";
+
+// "MRBIDX01", the version is in the last two bytes
+const uint64_t kBinaryIndexMagic = 0x313058444942524dULL;
+
+// address columns of a row in the binary index, the index fields follow them
+enum BinaryIndexColumn {
+  kIndexRowId = 0,
+  kIndexRowGroupId,
+  kIndexPageIdRaw,
+  kIndexPageOffsetRaw,
+  kIndexPageOffsetRawEnd,
+  kIndexPageIdBlob,
+  kIndexPageOffsetBlob,
+  kIndexPageOffsetBlobEnd,
+  kIndexAddressColumns
+};
+
+enum BinaryIndexFieldType { kIndexFieldInteger = 0, kIndexFieldNumeric, kIndexFieldText };
+
+/// \brief a compact index of one shard, sorted by row ID, next to the SQLite index of the shard
+///
+/// The file is [header][rows][string heap], all in 8 bytes words, so it is read in place from a memory map.
+/// The header is the magic, the size of the shard file when it was indexed, the number of rows, the number of
+/// index fields, the name of the shard, then the type and the name of every field. A row is the address columns
+/// then one word per field: the value of an integer field, the bits of a double of a numeric field, or the offset
+/// of a text field in the string heap, where it is stored as [length][bytes].
+class ShardBinaryIndex {
+ public:
+  /// \brief one row of the index as built by the index generator
+  struct Row {
+    uint64_t address[kIndexAddressColumns];
+    std::vector<std::string> values;  // the index fields, as bound to the SQLite index
+  };
+
+  ShardBinaryIndex() = default;
+
+  ~ShardBinaryIndex() = default;
+
+  /// \brief write the index of one shard
+  /// \param[in] index_path the path of the index file
+  /// \param[in] shard_path the path of the shard file
+  /// \param[in] fields the SQL name and the SQL type of the index fields
+  /// \param[in] rows the rows of the shard, sorted by row ID in place
+  /// \return MSRStatus the status of MSRStatus
+  static MSRStatus Write(const std::string &index_path, const std::string &shard_path,
+                         const std::vector<std::pair<std::string, std::string>> &fields, std::vector<Row> *rows);
+
+  /// \brief map the index of one shard and check it belongs to the shard as it is now
+  /// \param[in] index_path the path of the index file
+  /// \param[in] shard_path the path of the shard file
+  /// \param[in] check_size false to load the index of a shard which was appended to since it was indexed
+  /// \return MSRStatus the status of MSRStatus, FAILED if the index is missing or stale
+  MSRStatus Load(const std::string &index_path, const std::string &shard_path, bool check_size = true);
+
+  uint64_t get_num_rows() const { return num_rows_; }
+
+  const std::vector<std::pair<std::string, BinaryIndexFieldType>> &get_fields() const { return fields_; }
+
+  /// \brief get a row as it was given to Write
+  Row GetRow(uint64_t row) const;
+
+  /// \brief get an address column of a row
+  uint64_t GetAddress(uint64_t row, BinaryIndexColumn column) const { return Word(row, column); }
+
+  /// \brief get the position of an index field
+  /// \param[in] name the SQL name of the field, like label_0
+  /// \return the position, -1 if the field is not indexed
+  int GetFieldId(const std::string &name) const;
+
+  /// \brief get the value of an index field of a row
+  /// \return json of a number or a string
+  json GetField(uint64_t row, int field_id) const;
+
+  /// \brief get the rows of one blob page, in the order of their row IDs
+  /// \param[in] page_id the ID of the blob page
+  /// \param[in] start_row_id the first row ID of the page
+  /// \param[in] end_row_id the row ID after the last row of the page
+  std::vector<uint64_t> GetRowsOfPage(uint64_t page_id, uint64_t start_row_id, uint64_t end_row_id) const;
+
+ private:
+  uint64_t Word(uint64_t row, uint64_t column) const { return rows_[row * row_width_ + column]; }
+
+  ShardMappedFile file_;
+  const uint64_t *rows_ = nullptr;
+  const uint8_t *heap_ = nullptr;
+  uint64_t heap_size_ = 0;
+  uint64_t num_rows_ = 0;
+  uint64_t row_width_ = 0;
+  std::vector<std::pair<std::string, BinaryIndexFieldType>> fields_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
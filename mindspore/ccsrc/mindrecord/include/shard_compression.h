@@ -0,0 +1,70 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDRECORD_INCLUDE_SHARD_COMPRESSION_H_
+#define MINDRECORD_INCLUDE_SHARD_COMPRESSION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mindrecord/include/common/shard_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+const std::string kCompressionNone = "NONE";
+const std::string kCompressionLz = "LZ";
+
+/// \brief the codecs of the blob rows
+///
+/// Each blob row is compressed on its own, so a row is still read and decompressed without its neighbours,
+/// and the offsets in the index and the pages stay the offsets of the stored rows.
+/// A compressed row is [raw size (8 bytes)][compressed bytes]. A row which does not get smaller is stored
+/// as [raw size (8 bytes)][raw bytes], the length of the stored row tells both apart.
+class ShardCompression {
+ public:
+  /// \brief check a codec name
+  /// \param[in] compression the name of the codec
+  /// \return true if the codec is built in
+  static bool IsSupported(const std::string &compression);
+
+  /// \brief compress a blob row
+  /// \param[in] compression the name of the codec, kCompressionNone copies the row
+  /// \param[in] data the raw row
+  /// \param[out] out the stored row
+  /// \return MSRStatus the status of MSRStatus
+  static MSRStatus Compress(const std::string &compression, const std::vector<uint8_t> &data,
+                            std::vector<uint8_t> *out);
+
+  /// \brief decompress a stored blob row
+  /// \param[in] compression the name of the codec, kCompressionNone copies the row
+  /// \param[in] data the stored row
+  /// \param[in] length the length of the stored row
+  /// \param[out] out the raw row
+  /// \return MSRStatus the status of MSRStatus
+  static MSRStatus Decompress(const std::string &compression, const uint8_t *data, uint64_t length,
+                              std::vector<uint8_t> *out);
+
+ private:
+  /// \brief the LZ77 block codec, a token byte holds the lengths of a literal run and of the match after it,
+  ///        the match is 2 bytes of offset back into the output
+  static void LzCompress(const uint8_t *data, uint64_t length, std::vector<uint8_t> *out);
+
+  static MSRStatus LzDecompress(const uint8_t *data, uint64_t length, uint8_t *out, uint64_t raw_size);
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDRECORD_INCLUDE_SHARD_COMPRESSION_H_
@@ -26,6 +26,7 @@
 #include "mindrecord/include/shard_error.h"
 #include "mindrecord/include/shard_index.h"
 #include "mindrecord/include/shard_page.h"
+#include "mindrecord/include/shard_raw_codec.h"
 #include "mindrecord/include/shard_schema.h"
 #include "mindrecord/include/shard_statistics.h"
 
@@ -117,7 +118,22 @@ class ShardHeader {
 
   void set_page_size(const uint64_t &page_size) { page_size_ = page_size; }
 
-  const string get_version() { return version_; }
+  /// \brief get the codec of the blob pages written into the shards
+  std::string get_compression() const { return compression_; }
+
+  void set_compression(const std::string &compression) { compression_ = compression; }
+
+  /// \brief get the format of the raw rows written into the shards
+  std::string get_raw_format() const { return raw_format_; }
+
+  void set_raw_format(const std::string &raw_format) { raw_format_ = raw_format; }
+
+  const string get_version() {
+    if (raw_format_ != kRawFormatMsgpack) {
+      return binary_raw_version_;
+    }
+    return compression_ == kCompressionNone ? version_ : compressed_version_;
+  }
 
   std::vector<std::string> SerializeHeader();
 
@@ -145,7 +161,7 @@ class ShardHeader {
 
   MSRStatus CheckIndexField(const std::string &field, const json &schema);
 
-  void ParsePage(const json &page);
+  MSRStatus ParsePage(const json &page);
 
   MSRStatus ParseStatistics(const json &statistics);
 
@@ -170,7 +186,13 @@ class ShardHeader {
   uint32_t shard_count_;
   uint64_t header_size_;
   uint64_t page_size_;
+  std::string compression_;
+  std::string raw_format_;
   string version_ = "2.0";
+  // the files of compressed blob pages are of a version of their own, which the readers of version_ refuse
+  string compressed_version_ = "2.1";
+  // so are the files of binary raw rows, compressed or not, which the readers of msgpack rows would misdecode
+  string binary_raw_version_ = "2.2";
 
   std::shared_ptr<Index> index_;
   std::vector<std::string> shard_addresses_;
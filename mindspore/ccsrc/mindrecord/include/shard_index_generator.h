@@ -25,7 +25,9 @@
 #include <tuple>
 #include <utility>
 #include <vector>
+#include "mindrecord/include/shard_binary_index.h"
 #include "mindrecord/include/shard_header.h"
+#include "mindrecord/include/shard_raw_codec.h"
 #include "./sqlite3.h"
 
 namespace mindspore {
@@ -77,22 +79,38 @@ class ShardIndexGenerator {
   /// \param blob_id_to_page_id
   /// \param raw_page_id
   /// \param in
+  /// \param first_row_id row groups starting before it are skipped
   /// \return field name, db type, field value
   ROW_DATA GenerateRowData(int shard_no, const std::map<int, int> &blob_id_to_page_id, int raw_page_id,
-                           std::fstream &in);
+                           std::fstream &in, uint64_t first_row_id = 0);
   ///
-  /// \param db
-  /// \param sql
+  /// \param stmt the prepared insert statement
   /// \param data
   /// \return
   MSRStatus BindParameterExecuteSQL(
-    sqlite3 *db, const std::string &sql,
-    const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data);
+    sqlite3_stmt *stmt, const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data);
 
   INDEX_FIELDS GenerateIndexFields(const std::vector<json> &schema_detail);
 
-  MSRStatus ExecuteTransaction(const int &shard_no, const std::pair<MSRStatus, sqlite3 *> &db,
-                               const std::vector<int> &raw_page_ids, const std::map<int, int> &blob_id_to_page_id);
+  /// \brief index the raw pages of one shard and close its database
+  MSRStatus ExecuteTransaction(const int &shard_no, sqlite3 *db, const std::vector<int> &raw_page_ids,
+                               const std::map<int, int> &blob_id_to_page_id, uint64_t first_row_id,
+                               std::vector<ShardBinaryIndex::Row> *binary_rows);
+
+  /// \brief open the index of a shard appended to, and drop the rows to index again
+  /// \param[out] first_row_id the first row to index
+  /// \param[out] rows the rows kept, for the binary index
+  /// \return the database, FAILED if the shard has to be indexed from scratch
+  std::pair<MSRStatus, sqlite3 *> OpenIncrementalDatabase(int shard_no, const std::map<int, int> &blob_id_to_page_id,
+                                                          uint64_t *first_row_id,
+                                                          std::vector<ShardBinaryIndex::Row> *rows);
+
+  /// \brief collect the rows bound to the SQLite index for the binary index
+  MSRStatus AddBinaryIndexRows(const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data,
+                               std::vector<ShardBinaryIndex::Row> *rows);
+
+  /// \brief write the binary index next to the shard file, see ShardBinaryIndex
+  MSRStatus WriteBinaryIndex(const std::string &shard_address, std::vector<ShardBinaryIndex::Row> *rows);
 
   MSRStatus CreateShardNameTable(sqlite3 *db, const std::string &shard_name);
 
@@ -111,6 +129,8 @@ class ShardIndexGenerator {
   uint64_t page_size_;
   uint64_t header_size_;
   int schema_count_;
+  unsigned int num_page_readers_;  // raw pages of one shard read at the same time
+  std::vector<std::shared_ptr<ShardRawCodec>> raw_codecs_;  // codecs of binary raw rows by schema, empty for msgpack
   std::atomic_int task_;
   std::atomic_bool write_success_;
   std::vector<std::pair<uint64_t, std::string>> fields_;
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+#define MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+
+#include <sys/mman.h>
+#include <cstdint>
+#include <string>
+#include "mindrecord/include/common/shard_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief a read-only memory map of a whole shard file
+class ShardMappedFile {
+ public:
+  ShardMappedFile() = default;
+
+  ~ShardMappedFile();
+
+  ShardMappedFile(const ShardMappedFile &) = delete;
+
+  ShardMappedFile &operator=(const ShardMappedFile &) = delete;
+
+  /// \brief map a file
+  /// \param[in] file_path the path of the file
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus Open(const std::string &file_path);
+
+  /// \brief unmap the file, the views returned before are invalid after
+  void Close();
+
+  /// \brief tell the kernel how the whole file is going to be read
+  /// \param[in] advice MADV_SEQUENTIAL, MADV_RANDOM or MADV_NORMAL
+  void Advise(int advice) const;
+
+  /// \brief start reading a range of the file in the background
+  /// \param[in] offset offset of the range in the file
+  /// \param[in] length length of the range
+  void WillNeed(uint64_t offset, uint64_t length) const;
+
+  /// \brief get a view into the file
+  /// \param[in] offset offset of the view in the file
+  /// \param[in] length length of the view
+  /// \return the address of the view, nullptr if the range is out of the file
+  const uint8_t *Data(uint64_t offset, uint64_t length) const;
+
+  uint64_t get_size() const { return size_; }
+
+ private:
+  uint8_t *addr_ = nullptr;
+  uint64_t size_ = 0;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 #include "mindrecord/include/common/shard_utils.h"
+#include "mindrecord/include/shard_compression.h"
 #include "pybind11/pybind11.h"
 #include "utils/log_adapter.h"
 
@@ -45,7 +46,8 @@ class Page {
         start_row_id_(start_row_id),
         end_row_id_(end_row_id),
         row_group_ids_(row_group_ids),
-        page_size_(page_size) {}
+        page_size_(page_size),
+        compression_(kCompressionNone) {}
 
   ~Page() = default;
 
@@ -71,6 +73,10 @@ class Page {
 
   void set_page_size(const uint64_t &page_size) { page_size_ = page_size; }
 
+  std::string get_compression() const { return compression_; }
+
+  void set_compression(const std::string &compression) { compression_ = compression; }
+
   std::pair<int, uint64_t> get_last_row_group_id() const { return row_group_ids_.back(); }
 
   std::vector<std::pair<int, uint64_t>> get_row_group_ids() const { return row_group_ids_; }
@@ -90,6 +96,7 @@ class Page {
   uint64_t end_row_id_;
   std::vector<std::pair<int, uint64_t>> row_group_ids_;
   uint64_t page_size_;
+  std::string compression_;
   // JSON page: {
   //            "page_id":X,
   //            "shard_id":X,
@@ -99,6 +106,7 @@ class Page {
   //            "end_row_id":X,
   //            "row_group_ids":[{"id":X, "offset":X}],
   //            "page_size":X,
+  //            "compression":"XXX", (only in blob pages, "LZ", missing if not compressed)
 };
 }  // namespace mindrecord
 }  // namespace mindspore
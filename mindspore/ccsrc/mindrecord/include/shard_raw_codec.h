@@ -0,0 +1,100 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDRECORD_INCLUDE_SHARD_RAW_CODEC_H_
+#define MINDRECORD_INCLUDE_SHARD_RAW_CODEC_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "mindrecord/include/common/shard_utils.h"
+#include "mindrecord/include/shard_schema.h"
+
+namespace mindspore {
+namespace mindrecord {
+const std::string kRawFormatMsgpack = "MSGPACK";
+const std::string kRawFormatBinary = "BINARY";
+
+enum RawFieldType { kRawFieldInt32 = 0, kRawFieldInt64, kRawFieldFloat32, kRawFieldFloat64, kRawFieldString };
+
+/// \brief the binary layout of the raw rows of a schema
+///
+/// A row is a fixed part then the bytes of the strings. The fixed part holds the raw fields in the order of their
+/// names, a number at its own width in the byte order of the host, a string as its 4 bytes length. The bytes of the
+/// strings follow in the same order. A number is read in place at an offset known from the schema, a string sums the
+/// lengths of the strings before it. Every raw field of the schema is in every row, as the writer checks it.
+class ShardRawCodec {
+ public:
+  struct Field {
+    std::string name;
+    RawFieldType type;
+    uint64_t offset;  // offset in the fixed part
+  };
+
+  /// \brief build the layout of the raw fields of a schema, the blob fields are not in the raw rows
+  explicit ShardRawCodec(const std::shared_ptr<Schema> &schema);
+
+  ~ShardRawCodec() = default;
+
+  /// \brief check a format name
+  /// \param[in] raw_format the name of the format
+  /// \return true if the raw rows can be written in the format
+  static bool IsSupported(const std::string &raw_format);
+
+  const std::vector<Field> &get_fields() const { return fields_; }
+
+  /// \brief get the position of a raw field
+  /// \return the position, -1 if the field is a blob field or not in the schema
+  int GetFieldId(const std::string &name) const;
+
+  /// \brief encode a raw row, the fields out of the schema are dropped
+  /// \param[in] row the row as given to the writer
+  /// \param[out] out the encoded row
+  /// \return MSRStatus the status of MSRStatus, FAILED if a field is missing or of another type
+  MSRStatus Encode(const json &row, std::vector<uint8_t> *out) const;
+
+  /// \brief decode a raw row
+  /// \param[in] data the encoded row
+  /// \param[in] length the length of the encoded row
+  /// \param[in] columns the fields to decode, all of them if empty
+  /// \param[out] row the fields as the writer was given them
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus Decode(const uint8_t *data, uint64_t length, const std::vector<std::string> &columns, json *row) const;
+
+  /// \brief view a field of an encoded row in place
+  /// \param[in] data the encoded row
+  /// \param[in] length the length of the encoded row
+  /// \param[in] field_id the position of the field
+  /// \param[out] value the bytes of the number or of the string
+  /// \param[out] size the width of the number or the length of the string
+  /// \return false if the row is too short
+  bool GetField(const uint8_t *data, uint64_t length, int field_id, const uint8_t **value, uint64_t *size) const;
+
+  /// \brief decode a raw row of either format
+  /// \param[in] codec the codec of a binary shard, nullptr for msgpack rows
+  static MSRStatus DecodeRow(const ShardRawCodec *codec, const uint8_t *data, uint64_t length,
+                             const std::vector<std::string> &columns, json *row);
+
+ private:
+  std::vector<Field> fields_;
+  std::vector<int> string_fields_;  // positions of the string fields, in the order of their bytes
+  uint64_t fixed_size_ = 0;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDRECORD_INCLUDE_SHARD_RAW_CODEC_H_
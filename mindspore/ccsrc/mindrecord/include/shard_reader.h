@@ -40,10 +40,14 @@
 #include <utility>
 #include <vector>
 #include "mindrecord/include/common/shard_utils.h"
+#include "mindrecord/include/shard_binary_index.h"
 #include "mindrecord/include/shard_category.h"
+#include "mindrecord/include/shard_compression.h"
 #include "mindrecord/include/shard_error.h"
 #include "mindrecord/include/shard_index_generator.h"
+#include "mindrecord/include/shard_mapped_file.h"
 #include "mindrecord/include/shard_operator.h"
+#include "mindrecord/include/shard_raw_codec.h"
 #include "mindrecord/include/shard_reader.h"
 #include "mindrecord/include/shard_sample.h"
 #include "mindrecord/include/shard_shuffle.h"
@@ -59,6 +63,17 @@ using TASK_RETURN_CONTENT = std::pair<MSRStatus, std::vector<std::tuple<std::vec
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
 const int kNumPageInBuffer = 16;  // page buffer size in block-reader mode
 
+// rows of the same file closer than this are read at once by the read ahead, the gap is read and dropped
+const uint64_t kReadAheadMaxGap = 1 << 12;  // 4KB
+// the most bytes read at once by one read ahead thread
+const uint64_t kReadAheadMaxSpan = 1 << 24;  // 16MB
+
+/// \brief a blob inside a mapped shard file, valid until the reader is closed
+struct ShardBlobView {
+  const uint8_t *data;
+  uint64_t size;
+};
+
 class ShardReader {
  public:
   ShardReader();
@@ -71,10 +86,12 @@ class ShardReader {
   /// \param[in] selected_columns column list to be populated
   /// \param[in] operators operators applied to data, operator type is shuffle, sample or category
   /// \param[in] block_reader block-reader mode if true, otherwise row-reader mode
+  /// \param[in] use_mmap read the shard files through memory maps instead of file streams
   /// \return MSRStatus the status of MSRStatus
   MSRStatus Open(const std::string &file_path, int n_consumer = 4,
                  const std::vector<std::string> &selected_columns = {},
-                 const std::vector<std::shared_ptr<ShardOperator>> &operators = {}, const bool &block_reader = false);
+                 const std::vector<std::shared_ptr<ShardOperator>> &operators = {}, const bool &block_reader = false,
+                 const bool &use_mmap = false);
 
   /// \brief open files and initialize reader, python API
   /// \param[in] file_path the path of ONE file, any file in dataset is fine
@@ -172,6 +189,10 @@ class ShardReader {
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<uint8_t>, json>> GetNextById(const int64_t &task_id, const int32_t &consumer_id);
 
+  /// \brief return a row by id without copying its blob, row-reader mode with memory maps only
+  /// \return a batch of views of the images in the mapped files and image data
+  std::vector<std::tuple<ShardBlobView, json>> GetNextViewById(const int64_t &task_id);
+
   /// \brief return a batch in block-reader mode, given that one is ready
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<uint8_t>, json>> GetBlockNext();
@@ -188,6 +209,30 @@ class ShardReader {
   /// \return null
   void Reset();
 
+  /// \brief set the budget of the read ahead in row-reader mode, must be called before opening the reader
+  /// \param[in] read_ahead_size the most bytes of rows read ahead of the consumers, 0 turns the read ahead off
+  /// \return null
+  void set_read_ahead_size(uint64_t read_ahead_size) { read_ahead_size_ = read_ahead_size; }
+
+  /// \brief keep the labels of binary raw rows encoded, must be called before opening the reader
+  ///        The labels of the tasks are then empty, the encoded rows are viewed by GetEncodedLabelView. It only
+  ///        applies to row-reader mode with memory maps, on shards of kRawFormatBinary.
+  /// \return null
+  void set_keep_encoded_labels(bool keep_encoded_labels) { keep_encoded_labels_ = keep_encoded_labels; }
+
+  /// \brief whether the labels of the tasks are kept encoded, valid once the reader is launched
+  /// \return true if the labels of the tasks are empty and their raw rows are viewed by GetEncodedLabelView
+  bool get_encoded_labels() const { return keep_encoded_labels_ && !all_in_index_; }
+
+  /// \brief view the encoded raw row of a task in the mapped file, valid until the reader is closed
+  /// \param[in] task_id task ID
+  /// \return the view, {nullptr, 0} if the label of the task is not kept encoded
+  ShardBlobView GetEncodedLabelView(const int64_t &task_id);
+
+  /// \brief get the codec of binary raw rows
+  /// \return the codec, nullptr if the raw rows are msgpack
+  const ShardRawCodec *get_raw_codec() const { return raw_codec_.get(); }
+
   /// \brief set flag of all-in-index
   /// \return null
   void set_all_in_index(bool all_in_index) { all_in_index_ = all_in_index; }
@@ -195,10 +240,23 @@ class ShardReader {
   /// \brief get NLP flag
   bool get_nlp_flag();
 
+  /// \brief get the flag of reading through memory maps
+  bool get_use_mmap() const { return use_mmap_; }
+
+  /// \brief get the codec of the blob pages, the rows of compressed pages cannot be viewed in the mapped files
+  std::string get_compression() const { return shard_header_->get_compression(); }
+
  protected:
   /// \brief sqlite call back function
   static int SelectCallback(void *p_data, int num_fields, char **p_fields, char **p_col_names);
 
+  /// \brief decompress a blob read from a compressed page, in place
+  static MSRStatus DecompressBlob(const std::string &compression, std::vector<uint8_t> *blob);
+
+  /// \brief get the SQLite index of a shard, opened at the first use when the shard has a binary index
+  /// \return the handle, nullptr if the index can not be opened
+  sqlite3 *GetDatabase(int shard_id);
+
  private:
   /// \brief wrap up labels to json format
   MSRStatus ConvertLabelToJson(const std::vector<std::vector<std::string>> &labels, std::shared_ptr<std::fstream> fs,
@@ -213,6 +271,25 @@ class ShardReader {
                                std::vector<std::vector<std::vector<uint64_t>>> &offsets,
                                std::vector<std::vector<json>> &column_values);
 
+  /// \brief read all rows in one shard from its binary index
+  MSRStatus ReadAllRowsInBinaryIndex(int shard_id, const std::vector<std::string> &columns,
+                                     std::vector<std::vector<std::vector<uint64_t>>> &offsets,
+                                     std::vector<std::vector<json>> &column_values);
+
+  /// \brief read the label of one row from its raw data page
+  MSRStatus ReadRawLabel(std::shared_ptr<std::fstream> fs, uint64_t raw_page_id, uint64_t label_start,
+                         uint64_t label_end, const std::vector<std::string> &columns, json *label);
+
+  /// \brief get the positions of the columns in the binary index of a shard
+  std::pair<MSRStatus, std::vector<int>> GetBinaryIndexFieldIds(int shard_id, const std::vector<std::string> &columns);
+
+  /// \brief get the rows of one blob page in the binary index of a shard
+  std::vector<uint64_t> GetBinaryIndexRowsOfPage(int page_id, int shard_id);
+
+  /// \brief get column values of one blob page from the binary index
+  std::pair<MSRStatus, std::vector<json>> GetLabelsFromBinaryIndex(int page_id, int shard_id,
+                                                                   const std::vector<std::string> &columns);
+
   /// \brief initialize reader
   MSRStatus Init(const std::string &file_path);
 
@@ -267,6 +344,33 @@ class ShardReader {
   /// \brief open multiple file handle
   void FileStreamsOperator();
 
+  /// \brief map all the shard files
+  /// \param[in] advice how the files are going to be read, see madvise
+  MSRStatus OpenMapped(int advice);
+
+  /// \brief get the shard and the position in the file of the blob of one task in row-reader mode
+  /// \param[out] compression the codec of the page of the blob, nullptr if not needed
+  MSRStatus GetTaskBlobAddress(int task_id, int *shard_id, uint64_t *file_offset, uint64_t *length,
+                               std::string *compression = nullptr);
+
+  /// \brief merge the selected blob fields of NLP data with the labels
+  json MergeBlobFields(const json &blob_fields, const json &labels);
+
+  /// \brief read the rows ahead of the consumers, following the order of the task list
+  MSRStatus ReadAhead(int thread_id);
+
+  /// \brief read a span of a shard file with the file handles of a read ahead thread
+  MSRStatus ReadAheadSpan(int thread_id, int shard_id, uint64_t offset, std::vector<uint8_t> *span);
+
+  /// \brief take the blob of one task if it is read ahead, wait for it if it is being read
+  /// \param[in] task_id task ID
+  /// \param[out] blob the blob, not set with memory maps since the read ahead only brings the blob in the page cache
+  /// \return true if the blob is set
+  bool TakeReadAhead(int task_id, std::vector<uint8_t> *blob);
+
+  /// \brief drop the rows read ahead and start again from the first task
+  void RestartReadAhead();
+
   /// \brief read one row by one task
   TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
 
@@ -274,7 +378,7 @@ class ShardReader {
   vector<std::string> GetAllColumns();
 
   /// \brief get one row from buffer in block-reader mode
-  std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>> GetRowFromBuffer(int bufId, int rowId);
+  TASK_RETURN_CONTENT GetRowFromBuffer(int bufId, int rowId);
 
   /// \brief get labels from binary file
   std::pair<MSRStatus, std::vector<json>> GetLabelsFromBinaryFile(
@@ -290,9 +394,14 @@ class ShardReader {
   bool nlp_ = false;                           // NLP data
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::mutex database_locker_;                                                   // locker of sqlite handle list
+  std::vector<std::shared_ptr<ShardBinaryIndex>> binary_indexes_;                // binary index list
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::shared_ptr<ShardMappedFile>> mapped_files_;                   // mapped file list
+  bool use_mmap_ = false;                                                        // read through mapped files
+  std::shared_ptr<ShardRawCodec> raw_codec_;                                     // codec of binary raw rows
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -303,8 +412,9 @@ class ShardReader {
   std::mutex shard_locker_;                                // locker of shard
 
   // flags
-  bool all_in_index_ = true;  // if all columns are stored in index-table
-  bool interrupt_ = false;    // reader interrupted
+  bool all_in_index_ = true;          // if all columns are stored in index-table
+  bool interrupt_ = false;            // reader interrupted
+  bool keep_encoded_labels_ = false;  // labels of binary raw rows are viewed in the mapped files
 
   // Delivery/Iterator mode begin
   const std::string kThreadName = "THRD_ITER_";  // prefix of thread name
@@ -319,6 +429,22 @@ class ShardReader {
   std::unordered_map<int, std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>>> delivery_map_;
   // Delivery/Iterator mode end
 
+  // Read ahead mode begin
+  uint64_t read_ahead_size_ = 0;                  // budget in bytes of the rows read ahead
+  int n_read_ahead_ = 0;                          // number of read ahead threads
+  std::vector<std::thread> read_ahead_set_;       // read ahead thread list
+  std::mutex mtx_read_ahead_;                     // locker for read ahead
+  std::condition_variable cv_read_ahead_;         // conditional variable for read ahead threads
+  std::condition_variable cv_read_ahead_done_;    // conditional variable for consumers waiting for rows in flight
+  int read_ahead_id_ = 0;                         // next task ID to read ahead
+  int read_ahead_epoch_ = 0;                      // incremented when the task list is shuffled again
+  uint64_t read_ahead_bytes_ = 0;                 // bytes of the rows in flight and read ahead
+  std::unordered_set<int> read_ahead_in_flight_;  // task IDs being read
+  std::unordered_set<int> read_ahead_skipped_;    // task IDs read by the consumers before the read ahead got to them
+  // map of the rows read ahead, task ID to the size and the blob of the row
+  std::unordered_map<int, std::pair<uint64_t, std::vector<uint8_t>>> read_ahead_rows_;
+  // Read ahead mode end
+
   // Block reader mode begin
   bool block_reader_;  // block-reader mode
   int row_id_;         // row id in one page
@@ -327,6 +453,8 @@ class ShardReader {
   std::vector<std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>> delivery_block_;
   std::unordered_set<int> delivery_block_set_;  // set of delivered pages
   std::vector<std::vector<uint8_t>> buf_;       // page buffer
+  std::vector<const uint8_t *> page_views_;     // pages in the mapped files, instead of the page buffer
+  std::vector<std::string> page_compressions_;  // codec of the pages in the buffer
   // Block reader mode end
 };
 }  // namespace mindrecord
@@ -38,6 +38,7 @@
 #include "mindrecord/include/shard_error.h"
 #include "mindrecord/include/shard_header.h"
 #include "mindrecord/include/shard_index.h"
+#include "mindrecord/include/shard_raw_codec.h"
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 #include "utils/log_adapter.h"
@@ -75,6 +76,18 @@ class ShardWriter {
   /// \return MSRStatus the status of MSRStatus
   MSRStatus set_page_size(const uint64_t &page_size);
 
+  /// \brief Set the codec of the blob pages
+  /// \param[in] compression kCompressionNone or kCompressionLz, each blob row is compressed on its own
+  ///        WARNING, only called before the header is set, the codec of an existing file does not change
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus set_compression(const std::string &compression);
+
+  /// \brief Set the format of the raw rows
+  /// \param[in] raw_format kRawFormatMsgpack or kRawFormatBinary, the binary rows are laid out by the schema
+  ///        WARNING, only called before the header is set, the format of an existing file does not change
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus set_raw_format(const std::string &raw_format);
+
   /// \brief Set shard header
   /// \param[in] header_data the info of header
   ///        WARNING, only called when file is empty
@@ -125,11 +138,24 @@ class ShardWriter {
 
   /// \brief fill data array in multiple thread run
   void FillArray(int start, int end, std::map<uint64_t, vector<json>> &raw_data,
-                 std::vector<std::vector<uint8_t>> &bin_data);
+                 std::vector<std::vector<uint8_t>> &bin_data, bool encode_raw);
 
   /// \brief serialized raw data
+  /// \param[in] encode_raw true to lay out the raw rows by their schemas, false for msgpack
   MSRStatus SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
-                             std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count);
+                             std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count,
+                             bool encode_raw = false);
+
+  /// \brief build the codecs of the raw rows from the schemas of the header
+  void InitRawCodecs();
+
+  /// \brief compress blob data in multiple thread run
+  void CompressArray(int start, int end, const std::vector<std::vector<uint8_t>> &blob_data,
+                     std::vector<std::vector<uint8_t>> &compressed_data);
+
+  /// \brief compress blob data row by row
+  MSRStatus CompressBlobData(const std::vector<std::vector<uint8_t>> &blob_data,
+                             std::vector<std::vector<uint8_t>> &compressed_data);
 
   /// \brief write all data parallel
   MSRStatus ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
@@ -202,11 +228,15 @@ class ShardWriter {
                                   std::map<int, std::string> &err_raw_data);
 
  private:
-  int shard_count_;        // number of files
-  uint64_t header_size_;   // header size
-  uint64_t page_size_;     // page size
-  uint32_t row_count_;     // count of rows
-  uint32_t schema_count_;  // count of schemas
+  int shard_count_;          // number of files
+  uint64_t header_size_;     // header size
+  uint64_t page_size_;       // page size
+  uint32_t row_count_;       // count of rows
+  uint32_t schema_count_;    // count of schemas
+  std::string compression_;  // codec of blob pages
+  std::string raw_format_;   // format of raw rows
+
+  std::map<uint64_t, std::shared_ptr<ShardRawCodec>> raw_codecs_;  // codecs of binary raw rows by schema id
 
   std::vector<uint64_t> raw_data_size_;   // Raw data size
   std::vector<uint64_t> blob_data_size_;  // Blob data size
@@ -0,0 +1,273 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mindrecord/include/shard_binary_index.h"
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "common/utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::DEBUG;
+using mindspore::MsLogLevel::ERROR;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+// number of words of a string stored as [length][bytes padded to 8]
+uint64_t StringWords(uint64_t length) { return 1 + (length + kInt64Len - 1) / kInt64Len; }
+
+void AppendString(const std::string &str, std::vector<uint64_t> *words) {
+  auto start = words->size();
+  words->resize(start + StringWords(str.size()), 0);
+  (*words)[start] = str.size();
+  if (!str.empty()) {
+    (void)memcpy(&(*words)[start + 1], str.data(), str.size());
+  }
+}
+
+bool ReadString(const uint64_t *words, uint64_t num_words, uint64_t *pos, std::string *str) {
+  if (*pos >= num_words) {
+    return false;
+  }
+  uint64_t length = words[*pos];
+  if (length > (num_words - *pos - 1) * kInt64Len) {
+    return false;
+  }
+  str->assign(reinterpret_cast<const char *>(&words[*pos + 1]), length);
+  *pos += StringWords(length);
+  return true;
+}
+
+std::pair<MSRStatus, uint64_t> GetFileSize(const std::string &path) {
+  struct stat st;
+  if (stat(common::SafeCStr(path), &st) != 0) {
+    return {FAILED, 0};
+  }
+  return {SUCCESS, static_cast<uint64_t>(st.st_size)};
+}
+
+BinaryIndexFieldType ConvertSQLType(const std::string &sql_type) {
+  if (sql_type == "INTEGER") return kIndexFieldInteger;
+  if (sql_type == "NUMERIC") return kIndexFieldNumeric;
+  return kIndexFieldText;
+}
+}  // namespace
+
+MSRStatus ShardBinaryIndex::Write(const std::string &index_path, const std::string &shard_path,
+                                  const std::vector<std::pair<std::string, std::string>> &fields,
+                                  std::vector<Row> *rows) {
+  auto shard_size = GetFileSize(shard_path);
+  if (shard_size.first != SUCCESS) {
+    MS_LOG(ERROR) << "Can not get the size of shard file: " << shard_path;
+    return FAILED;
+  }
+  std::stable_sort(rows->begin(), rows->end(),
+                   [](const Row &a, const Row &b) { return a.address[kIndexRowId] < b.address[kIndexRowId]; });
+
+  std::vector<uint64_t> words{kBinaryIndexMagic, shard_size.second, rows->size(), fields.size()};
+  AppendString(GetFileName(shard_path).second, &words);
+  std::vector<BinaryIndexFieldType> types;
+  for (const auto &field : fields) {
+    types.push_back(ConvertSQLType(field.second));
+    words.push_back(types.back());
+    AppendString(field.first, &words);
+  }
+
+  std::vector<uint64_t> heap;
+  for (const auto &row : *rows) {
+    if (row.values.size() != fields.size()) {
+      MS_LOG(ERROR) << "Row " << row.address[kIndexRowId] << " has " << row.values.size() << " index fields, expect "
+                    << fields.size();
+      return FAILED;
+    }
+    words.insert(words.end(), row.address, row.address + kIndexAddressColumns);
+    for (size_t i = 0; i < fields.size(); ++i) {
+      const auto &value = row.values[i];
+      if (types[i] == kIndexFieldInteger) {
+        words.push_back(static_cast<uint64_t>(std::stoll(value)));
+      } else if (types[i] == kIndexFieldNumeric) {
+        double number = std::stod(value);
+        uint64_t bits = 0;
+        (void)memcpy(&bits, &number, sizeof(bits));
+        words.push_back(bits);
+      } else {
+        words.push_back(heap.size() * kInt64Len);
+        AppendString(value, &heap);
+      }
+    }
+  }
+
+  // Write aside and rename, a reader never maps a file being written
+  std::string tmp_path = index_path + ".tmp";
+  std::ofstream out(common::SafeCStr(tmp_path), std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!out.good()) {
+    MS_LOG(ERROR) << "File could not opened: " << tmp_path;
+    return FAILED;
+  }
+  (void)out.write(reinterpret_cast<const char *>(words.data()), words.size() * kInt64Len);
+  (void)out.write(reinterpret_cast<const char *>(heap.data()), heap.size() * kInt64Len);
+  out.close();
+  if (out.fail() || std::rename(common::SafeCStr(tmp_path), common::SafeCStr(index_path)) != 0) {
+    MS_LOG(ERROR) << "File write failed: " << index_path;
+    (void)std::remove(common::SafeCStr(tmp_path));
+    return FAILED;
+  }
+  MS_LOG(INFO) << "Write " << rows->size() << " rows to binary index " << index_path;
+  return SUCCESS;
+}
+
+MSRStatus ShardBinaryIndex::Load(const std::string &index_path, const std::string &shard_path, bool check_size) {
+  std::ifstream fin(common::SafeCStr(index_path));
+  if (!fin.good()) {
+    MS_LOG(DEBUG) << "No binary index: " << index_path;
+    return FAILED;
+  }
+  fin.close();
+  if (file_.Open(index_path) != SUCCESS) {
+    return FAILED;
+  }
+  uint64_t num_words = file_.get_size() / kInt64Len;
+  const auto *words = reinterpret_cast<const uint64_t *>(file_.Data(0, num_words * kInt64Len));
+  const uint64_t kHeaderWords = 4;
+  if (words == nullptr || num_words < kHeaderWords || words[0] != kBinaryIndexMagic) {
+    MS_LOG(ERROR) << "Binary index is broken: " << index_path;
+    return FAILED;
+  }
+
+  // An index left from an older file with the same name must not be trusted
+  auto shard_size = GetFileSize(shard_path);
+  std::string shard_name;
+  uint64_t pos = kHeaderWords;
+  if (!ReadString(words, num_words, &pos, &shard_name) || shard_name != GetFileName(shard_path).second ||
+      shard_size.first != SUCCESS || (check_size && shard_size.second != words[1])) {
+    MS_LOG(INFO) << "Binary index does not match the shard file, ignore it: " << index_path;
+    return FAILED;
+  }
+
+  num_rows_ = words[2];
+  uint64_t num_fields = words[3];
+  if (num_fields > kMaxFieldCount) {
+    MS_LOG(ERROR) << "Binary index is broken: " << index_path;
+    return FAILED;
+  }
+  fields_.clear();
+  for (uint64_t i = 0; i < num_fields; ++i) {
+    std::string name;
+    if (pos >= num_words || words[pos] > kIndexFieldText) {
+      MS_LOG(ERROR) << "Binary index is broken: " << index_path;
+      return FAILED;
+    }
+    auto type = static_cast<BinaryIndexFieldType>(words[pos++]);
+    if (!ReadString(words, num_words, &pos, &name)) {
+      MS_LOG(ERROR) << "Binary index is broken: " << index_path;
+      return FAILED;
+    }
+    fields_.emplace_back(name, type);
+  }
+
+  row_width_ = kIndexAddressColumns + num_fields;
+  if (num_rows_ > (num_words - pos) / row_width_) {
+    MS_LOG(ERROR) << "Binary index is broken: " << index_path;
+    return FAILED;
+  }
+  rows_ = words + pos;
+  pos += num_rows_ * row_width_;
+  heap_ = reinterpret_cast<const uint8_t *>(words + pos);
+  heap_size_ = (num_words - pos) * kInt64Len;
+  MS_LOG(DEBUG) << "Load " << num_rows_ << " rows from binary index " << index_path;
+  return SUCCESS;
+}
+
+int ShardBinaryIndex::GetFieldId(const std::string &name) const {
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    if (fields_[i].first == name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+json ShardBinaryIndex::GetField(uint64_t row, int field_id) const {
+  uint64_t word = Word(row, kIndexAddressColumns + field_id);
+  switch (fields_[field_id].second) {
+    case kIndexFieldInteger:
+      return json(static_cast<int64_t>(word));
+    case kIndexFieldNumeric: {
+      double number = 0;
+      (void)memcpy(&number, &word, sizeof(number));
+      return json(number);
+    }
+    default: {
+      if (heap_size_ < kInt64Len || word > heap_size_ - kInt64Len) {
+        return json(std::string());
+      }
+      uint64_t length = 0;
+      (void)memcpy(&length, heap_ + word, kInt64Len);
+      length = std::min(length, heap_size_ - word - kInt64Len);
+      return json(std::string(reinterpret_cast<const char *>(heap_ + word + kInt64Len), length));
+    }
+  }
+}
+
+ShardBinaryIndex::Row ShardBinaryIndex::GetRow(uint64_t row) const {
+  Row res{};
+  for (uint64_t column = 0; column < kIndexAddressColumns; ++column) {
+    res.address[column] = Word(row, column);
+  }
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    auto value = GetField(row, static_cast<int>(i));
+    if (fields_[i].second == kIndexFieldNumeric) {
+      // enough digits to read the same double back
+      char buf[32] = {0};
+      (void)snprintf(buf, sizeof(buf), "%.17g", value.get<double>());
+      res.values.emplace_back(buf);
+    } else if (fields_[i].second == kIndexFieldInteger) {
+      res.values.push_back(std::to_string(value.get<int64_t>()));
+    } else {
+      res.values.push_back(value.get<std::string>());
+    }
+  }
+  return res;
+}
+
+std::vector<uint64_t> ShardBinaryIndex::GetRowsOfPage(uint64_t page_id, uint64_t start_row_id,
+                                                      uint64_t end_row_id) const {
+  // Rows are sorted by row ID, the rows of a blob page are a range of row IDs
+  uint64_t low = 0;
+  uint64_t high = num_rows_;
+  while (low < high) {
+    uint64_t mid = low + (high - low) / 2;
+    if (Word(mid, kIndexRowId) < start_row_id) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  std::vector<uint64_t> res;
+  for (uint64_t row = low; row < num_rows_ && Word(row, kIndexRowId) < end_row_id; ++row) {
+    if (Word(row, kIndexPageIdBlob) == page_id) {
+      res.push_back(row);
+    }
+  }
+  return res;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -0,0 +1,220 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mindrecord/include/shard_compression.h"
+#include <algorithm>
+#include <cstring>
+#include "common/utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const uint64_t kLzMinMatch = 4;
+const uint64_t kLzMaxOffset = 65535;
+const uint32_t kLzHashBits = 14;
+const uint32_t kLzRunMask = 15;
+const uint32_t kLzExtendByte = 255;
+// Each byte of the stream gives at most this many bytes of output, bounds the raw size of a corrupted row
+const uint64_t kLzMaxRatio = 256;
+
+inline uint32_t Read32(const uint8_t *p) {
+  uint32_t v = 0;
+  (void)memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t Hash32(uint32_t v) { return (v * 2654435761U) >> (32 - kLzHashBits); }
+
+void WriteLength(uint64_t length, std::vector<uint8_t> *out) {
+  for (; length >= kLzExtendByte; length -= kLzExtendByte) {
+    out->push_back(kLzExtendByte);
+  }
+  out->push_back(static_cast<uint8_t>(length));
+}
+
+bool ReadLength(const uint8_t **ip, const uint8_t *in_end, uint64_t *length) {
+  uint8_t b = 0;
+  do {
+    if (*ip >= in_end) {
+      return false;
+    }
+    b = *(*ip)++;
+    *length += b;
+  } while (b == kLzExtendByte);
+  return true;
+}
+
+void WriteSequence(const uint8_t *literals, uint64_t n_literals, uint64_t offset, uint64_t match_length,
+                   std::vector<uint8_t> *out) {
+  uint64_t match_code = match_length >= kLzMinMatch ? match_length - kLzMinMatch : 0;
+  uint8_t token = static_cast<uint8_t>((std::min<uint64_t>(n_literals, kLzRunMask) << 4) |
+                                       std::min<uint64_t>(match_code, kLzRunMask));
+  out->push_back(token);
+  if (n_literals >= kLzRunMask) {
+    WriteLength(n_literals - kLzRunMask, out);
+  }
+  out->insert(out->end(), literals, literals + n_literals);
+  if (match_length == 0) {
+    return;
+  }
+  out->push_back(static_cast<uint8_t>(offset & 0xff));
+  out->push_back(static_cast<uint8_t>(offset >> 8));
+  if (match_code >= kLzRunMask) {
+    WriteLength(match_code - kLzRunMask, out);
+  }
+}
+}  // namespace
+
+bool ShardCompression::IsSupported(const std::string &compression) {
+  return compression == kCompressionNone || compression == kCompressionLz;
+}
+
+MSRStatus ShardCompression::Compress(const std::string &compression, const std::vector<uint8_t> &data,
+                                     std::vector<uint8_t> *out) {
+  if (compression == kCompressionNone) {
+    *out = data;
+    return SUCCESS;
+  }
+  if (compression != kCompressionLz) {
+    MS_LOG(ERROR) << "Compression is not supported: " << compression;
+    return FAILED;
+  }
+  uint64_t raw_size = data.size();
+  out->resize(kInt64Len);
+  (void)memcpy(out->data(), &raw_size, kInt64Len);
+  LzCompress(data.data(), raw_size, out);
+  if (out->size() >= kInt64Len + raw_size) {
+    // Not worth it, keep the row as it is
+    out->resize(kInt64Len);
+    out->insert(out->end(), data.begin(), data.end());
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardCompression::Decompress(const std::string &compression, const uint8_t *data, uint64_t length,
+                                       std::vector<uint8_t> *out) {
+  if (compression == kCompressionNone) {
+    out->assign(data, data + length);
+    return SUCCESS;
+  }
+  if (compression != kCompressionLz) {
+    MS_LOG(ERROR) << "Compression is not supported: " << compression;
+    return FAILED;
+  }
+  if (length < kInt64Len) {
+    MS_LOG(ERROR) << "Compressed row is too short, length: " << length;
+    return FAILED;
+  }
+  uint64_t raw_size = 0;
+  (void)memcpy(&raw_size, data, kInt64Len);
+  if (raw_size == length - kInt64Len) {
+    out->assign(data + kInt64Len, data + length);
+    return SUCCESS;
+  }
+  if (raw_size > (length - kInt64Len) * kLzMaxRatio) {
+    MS_LOG(ERROR) << "Compressed row is corrupted, raw size: " << raw_size << ", length: " << length;
+    return FAILED;
+  }
+  out->resize(raw_size);
+  return LzDecompress(data + kInt64Len, length - kInt64Len, out->data(), raw_size);
+}
+
+void ShardCompression::LzCompress(const uint8_t *data, uint64_t length, std::vector<uint8_t> *out) {
+  std::vector<int64_t> table(1 << kLzHashBits, -1);
+  uint64_t anchor = 0;
+  uint64_t i = 0;
+  while (i + kLzMinMatch <= length) {
+    uint32_t seq = Read32(data + i);
+    uint32_t h = Hash32(seq);
+    int64_t candidate = table[h];
+    table[h] = static_cast<int64_t>(i);
+    if (candidate < 0 || i - candidate > kLzMaxOffset || Read32(data + candidate) != seq) {
+      // Move faster through the data which does not match
+      i += 1 + ((i - anchor) >> 6);
+      continue;
+    }
+    uint64_t match_length = kLzMinMatch;
+    while (i + match_length < length && data[candidate + match_length] == data[i + match_length]) {
+      match_length++;
+    }
+    WriteSequence(data + anchor, i - anchor, i - candidate, match_length, out);
+    i += match_length;
+    anchor = i;
+  }
+  WriteSequence(data + anchor, length - anchor, 0, 0, out);
+}
+
+MSRStatus ShardCompression::LzDecompress(const uint8_t *data, uint64_t length, uint8_t *out, uint64_t raw_size) {
+  const uint8_t *ip = data;
+  const uint8_t *in_end = data + length;
+  uint64_t op = 0;
+  while (ip < in_end) {
+    uint8_t token = *ip++;
+    uint64_t n_literals = token >> 4;
+    if (n_literals == kLzRunMask && !ReadLength(&ip, in_end, &n_literals)) {
+      MS_LOG(ERROR) << "Compressed row is truncated in a literal length.";
+      return FAILED;
+    }
+    if (n_literals > static_cast<uint64_t>(in_end - ip) || n_literals > raw_size - op) {
+      MS_LOG(ERROR) << "Compressed row is corrupted, literals: " << n_literals;
+      return FAILED;
+    }
+    (void)memcpy(out + op, ip, n_literals);
+    ip += n_literals;
+    op += n_literals;
+    if (ip == in_end) {
+      break;
+    }
+
+    if (in_end - ip < 2) {
+      MS_LOG(ERROR) << "Compressed row is truncated in a match offset.";
+      return FAILED;
+    }
+    uint64_t offset = ip[0] | (static_cast<uint64_t>(ip[1]) << 8);
+    ip += 2;
+    uint64_t match_length = token & kLzRunMask;
+    if (match_length == kLzRunMask && !ReadLength(&ip, in_end, &match_length)) {
+      MS_LOG(ERROR) << "Compressed row is truncated in a match length.";
+      return FAILED;
+    }
+    match_length += kLzMinMatch;
+    if (offset == 0 || offset > op || match_length > raw_size - op) {
+      MS_LOG(ERROR) << "Compressed row is corrupted, offset: " << offset << ", match: " << match_length;
+      return FAILED;
+    }
+    // The match may overlap the bytes it writes, it repeats the last offset bytes then
+    uint8_t *match = out + op - offset;
+    if (offset == 1) {
+      (void)memset(out + op, *match, match_length);
+    } else {
+      for (uint64_t copied = 0; copied < match_length; copied += offset) {
+        (void)memcpy(out + op + copied, match + copied, std::min(offset, match_length - copied));
+      }
+    }
+    op += match_length;
+  }
+  if (op != raw_size) {
+    MS_LOG(ERROR) << "Compressed row is corrupted, raw size: " << raw_size << ", decompressed: " << op;
+    return FAILED;
+  }
+  return SUCCESS;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
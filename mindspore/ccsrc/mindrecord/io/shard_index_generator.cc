@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <deque>
+#include <future>
 #include <thread>
 
 #include "mindrecord/include/shard_index_generator.h"
@@ -32,6 +34,7 @@ ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool appe
       page_size_(0),
       header_size_(0),
       schema_count_(0),
+      num_page_readers_(1),
       task_(0),
       write_success_(true) {}
 
@@ -255,21 +258,95 @@ std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CreateDatabase(int shard_no
   return {SUCCESS, db};
 }
 
+std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::OpenIncrementalDatabase(
+  int shard_no, const std::map<int, int> &blob_id_to_page_id, uint64_t *first_row_id,
+  std::vector<ShardBinaryIndex::Row> *rows) {
+  std::string shard_address = shard_header_.get_shard_address_by_id(shard_no);
+  ShardBinaryIndex index;
+  if (shard_address.empty() || index.Load(shard_address + kBinaryIndexSuffix, shard_address, false) != SUCCESS) {
+    return {FAILED, nullptr};
+  }
+  // The index fields can not change when appending, but an index written by another version is not trusted
+  const auto &index_fields = index.get_fields();
+  if (index_fields.size() != fields_.size()) {
+    return {FAILED, nullptr};
+  }
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    auto ret = GenerateFieldName(fields_[i]);
+    if (ret.first != SUCCESS || ret.second != index_fields[i].first) {
+      return {FAILED, nullptr};
+    }
+  }
+
+  sqlite3 *db = nullptr;
+  if (sqlite3_open_v2(common::SafeCStr(shard_address + ".db"), &db, SQLITE_OPEN_READWRITE, nullptr) != SQLITE_OK) {
+    (void)sqlite3_close(db);
+    return {FAILED, nullptr};
+  }
+  // Both indexes have to hold the same rows
+  sqlite3_stmt *stmt = nullptr;
+  bool match = false;
+  uint64_t num_rows = index.get_num_rows();
+  if (sqlite3_prepare_v2(db, "SELECT COUNT(*), MAX(ROW_ID) FROM INDEXES;", -1, &stmt, 0) == SQLITE_OK &&
+      sqlite3_step(stmt) == SQLITE_ROW) {
+    match = static_cast<uint64_t>(sqlite3_column_int64(stmt, 0)) == num_rows &&
+            (num_rows == 0 ||
+             static_cast<uint64_t>(sqlite3_column_int64(stmt, 1)) == index.GetAddress(num_rows - 1, kIndexRowId));
+  }
+  (void)sqlite3_finalize(stmt);
+  if (!match) {
+    (void)sqlite3_close(db);
+    return {FAILED, nullptr};
+  }
+
+  // The last row group indexed may have got more rows, and its raw data may have been shifted to a new raw page,
+  // so it is indexed again with the row groups after it
+  *first_row_id = 0;
+  if (num_rows > 0) {
+    auto group_id = static_cast<int>(index.GetAddress(num_rows - 1, kIndexRowGroupId));
+    auto it = blob_id_to_page_id.find(group_id);
+    if (it == blob_id_to_page_id.end()) {
+      (void)sqlite3_close(db);
+      return {FAILED, nullptr};
+    }
+    *first_row_id = shard_header_.GetPage(shard_no, it->second).first->get_start_row_id();
+  }
+  if (ExecuteSQL("DELETE FROM INDEXES WHERE ROW_ID >= " + std::to_string(*first_row_id) + ";", db,
+                 "delete rows to index again successfully.") != SUCCESS) {
+    (void)sqlite3_close(db);
+    return {FAILED, nullptr};
+  }
+  for (uint64_t i = 0; i < num_rows && index.GetAddress(i, kIndexRowId) < *first_row_id; ++i) {
+    rows->push_back(index.GetRow(i));
+  }
+  MS_LOG(INFO) << "Index shard " << shard_no << " from row " << *first_row_id << ", " << rows->size()
+               << " rows are indexed already.";
+  return {SUCCESS, db};
+}
+
 std::pair<MSRStatus, std::vector<json>> ShardIndexGenerator::GetSchemaDetails(const std::vector<uint64_t> &schema_lens,
                                                                               std::fstream &in) {
   std::vector<json> schema_details;
   if (schema_count_ <= kMaxSchemaCount) {
     for (int sc = 0; sc < schema_count_; ++sc) {
-      std::vector<char> schema_detail(schema_lens[sc]);
+      std::vector<uint8_t> schema_detail(schema_lens[sc]);
+
+      if (schema_lens[sc] > 0) {
+        auto &io_read = in.read(reinterpret_cast<char *>(&schema_detail[0]), schema_lens[sc]);
+        if (!io_read.good() || io_read.fail() || io_read.bad()) {
+          MS_LOG(ERROR) << "File read failed";
+          in.close();
+          return {FAILED, {}};
+        }
+      }
 
-      auto &io_read = in.read(&schema_detail[0], schema_lens[sc]);
-      if (!io_read.good() || io_read.fail() || io_read.bad()) {
-        MS_LOG(ERROR) << "File read failed";
+      json detail;
+      const ShardRawCodec *codec = raw_codecs_.empty() ? nullptr : raw_codecs_[sc].get();
+      if (ShardRawCodec::DecodeRow(codec, schema_detail.data(), schema_detail.size(), {}, &detail) != SUCCESS) {
         in.close();
         return {FAILED, {}};
       }
-
-      schema_details.emplace_back(json::from_msgpack(std::string(schema_detail.begin(), schema_detail.end())));
+      schema_details.emplace_back(std::move(detail));
     }
   }
 
@@ -306,13 +383,7 @@ std::pair<MSRStatus, std::string> ShardIndexGenerator::GenerateRawSQL(
 }
 
 MSRStatus ShardIndexGenerator::BindParameterExecuteSQL(
-  sqlite3 *db, const std::string &sql,
-  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data) {
-  sqlite3_stmt *stmt = nullptr;
-  if (sqlite3_prepare_v2(db, common::SafeCStr(sql), -1, &stmt, 0) != SQLITE_OK) {
-    MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << sql;
-    return FAILED;
-  }
+  sqlite3_stmt *stmt, const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data) {
   for (auto &row : data) {
     for (auto &field : row) {
       const auto &place_holder = std::get<0>(field);
@@ -350,7 +421,6 @@ MSRStatus ShardIndexGenerator::BindParameterExecuteSQL(
     }
     (void)sqlite3_reset(stmt);
   }
-  (void)sqlite3_finalize(stmt);
   return SUCCESS;
 }
 
@@ -398,7 +468,7 @@ void ShardIndexGenerator::AddIndexFieldByRawData(
 }
 
 ROW_DATA ShardIndexGenerator::GenerateRowData(int shard_no, const std::map<int, int> &blob_id_to_page_id,
-                                              int raw_page_id, std::fstream &in) {
+                                              int raw_page_id, std::fstream &in, uint64_t first_row_id) {
   std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> full_data;
 
   // current raw data page
@@ -412,6 +482,11 @@ ROW_DATA ShardIndexGenerator::GenerateRowData(int shard_no, const std::map<int,
     // get blob data page according to row_group id
     std::shared_ptr<Page> cur_blob_page = shard_header_.GetPage(shard_no, blob_id_to_page_id.at(blob_ids.first)).first;
 
+    // row group indexed already
+    if (cur_blob_page->get_start_row_id() < first_row_id) {
+      continue;
+    }
+
     // offset in current raw data page
     auto cur_raw_page_offset = static_cast<uint64_t>(blob_ids.second);
     uint64_t cur_blob_page_offset = 0;
@@ -500,9 +575,10 @@ INDEX_FIELDS ShardIndexGenerator::GenerateIndexFields(const std::vector<json> &s
   return {SUCCESS, std::move(fields)};
 }
 
-MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, const std::pair<MSRStatus, sqlite3 *> &db,
+MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
                                                   const std::vector<int> &raw_page_ids,
-                                                  const std::map<int, int> &blob_id_to_page_id) {
+                                                  const std::map<int, int> &blob_id_to_page_id, uint64_t first_row_id,
+                                                  std::vector<ShardBinaryIndex::Row> *binary_rows) {
   // Add index data to database
   std::string shard_address = shard_header_.get_shard_address_by_id(shard_no);
   if (shard_address.empty()) {
@@ -510,39 +586,130 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, const std
     return FAILED;
   }
 
-  std::fstream in;
-  in.open(common::SafeCStr(shard_address), std::ios::in | std::ios::binary);
-  (void)sqlite3_exec(db.second, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
-  for (int raw_page_id : raw_page_ids) {
-    auto sql = GenerateRawSQL(fields_);
-    if (sql.first != SUCCESS) {
-      return FAILED;
+  auto sql = GenerateRawSQL(fields_);
+  if (sql.first != SUCCESS) {
+    return FAILED;
+  }
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(db, common::SafeCStr(sql.second), -1, &stmt, 0) != SQLITE_OK) {
+    MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << sql.second;
+    return FAILED;
+  }
+
+  // Raw pages are read and decoded by helper threads, rows are inserted in page order by this thread
+  auto read_page = [this, shard_no, &blob_id_to_page_id, &shard_address, first_row_id](int raw_page_id) {
+    std::fstream in;
+    in.open(common::SafeCStr(shard_address), std::ios::in | std::ios::binary);
+    if (!in.good()) {
+      MS_LOG(ERROR) << "File could not opened: " << shard_address;
+      return ROW_DATA{FAILED, {}};
     }
-    auto data = GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in);
-    if (data.first != SUCCESS) {
-      return FAILED;
+    auto data = GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in, first_row_id);
+    in.close();
+    return data;
+  };
+  std::deque<std::future<ROW_DATA>> pending;
+  size_t next_page = 0;
+  MSRStatus ret = SUCCESS;
+  (void)sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+  while (ret == SUCCESS && (next_page < raw_page_ids.size() || !pending.empty())) {
+    while (next_page < raw_page_ids.size() && pending.size() < num_page_readers_) {
+      pending.push_back(std::async(std::launch::async, read_page, raw_page_ids[next_page++]));
     }
-    if (BindParameterExecuteSQL(db.second, sql.second, data.second) == FAILED) {
-      return FAILED;
+    auto data = pending.front().get();
+    pending.pop_front();
+    if (data.first != SUCCESS || BindParameterExecuteSQL(stmt, data.second) != SUCCESS ||
+        AddBinaryIndexRows(data.second, binary_rows) != SUCCESS) {
+      ret = FAILED;
+      break;
     }
     MS_LOG(INFO) << "Insert " << data.second.size() << " rows to index db.";
   }
-  (void)sqlite3_exec(db.second, "END TRANSACTION;", nullptr, nullptr, nullptr);
-  in.close();
+  // Let the helper threads still reading finish
+  for (auto &page : pending) {
+    page.wait();
+  }
+  (void)sqlite3_finalize(stmt);
+  if (ret != SUCCESS) {
+    (void)sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+    (void)sqlite3_close(db);
+    return FAILED;
+  }
+  (void)sqlite3_exec(db, "END TRANSACTION;", nullptr, nullptr, nullptr);
 
   // Close database
-  if (sqlite3_close(db.second) != SQLITE_OK) {
+  if (sqlite3_close(db) != SQLITE_OK) {
     MS_LOG(ERROR) << "Close database failed";
     return FAILED;
   }
+  return WriteBinaryIndex(shard_address, binary_rows);
+}
+
+MSRStatus ShardIndexGenerator::AddBinaryIndexRows(
+  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data,
+  std::vector<ShardBinaryIndex::Row> *rows) {
+  static const std::map<std::string, BinaryIndexColumn> kAddressPlaceHolders = {
+    {":ROW_ID", kIndexRowId},
+    {":ROW_GROUP_ID", kIndexRowGroupId},
+    {":PAGE_ID_RAW", kIndexPageIdRaw},
+    {":PAGE_OFFSET_RAW", kIndexPageOffsetRaw},
+    {":PAGE_OFFSET_RAW_END", kIndexPageOffsetRawEnd},
+    {":PAGE_ID_BLOB", kIndexPageIdBlob},
+    {":PAGE_OFFSET_BLOB", kIndexPageOffsetBlob},
+    {":PAGE_OFFSET_BLOB_END", kIndexPageOffsetBlobEnd}};
+  for (const auto &row_data : data) {
+    ShardBinaryIndex::Row row{};
+    for (const auto &field : row_data) {
+      const auto &place_holder = std::get<0>(field);
+      auto it = kAddressPlaceHolders.find(place_holder);
+      if (it != kAddressPlaceHolders.end()) {
+        row.address[it->second] = std::stoull(std::get<2>(field));
+      } else if (place_holder.compare(0, 5, ":INC_") != 0) {
+        row.values.push_back(std::get<2>(field));
+      }
+    }
+    if (row.values.size() != fields_.size()) {
+      MS_LOG(ERROR) << "Index fields of row " << row.address[kIndexRowId] << " are missing";
+      return FAILED;
+    }
+    rows->push_back(std::move(row));
+  }
   return SUCCESS;
 }
 
+MSRStatus ShardIndexGenerator::WriteBinaryIndex(const std::string &shard_address,
+                                                std::vector<ShardBinaryIndex::Row> *rows) {
+  std::vector<std::pair<std::string, std::string>> fields;
+  for (const auto &field : fields_) {
+    auto result = shard_header_.GetSchemaByID(field.first);
+    if (result.second != SUCCESS) {
+      return FAILED;
+    }
+    auto ret = GenerateFieldName(field);
+    if (ret.first != SUCCESS) {
+      return FAILED;
+    }
+    std::string field_type = ConvertJsonToSQL(TakeFieldType(field.second, result.first->GetSchema()["schema"]));
+    fields.emplace_back(ret.second, field_type);
+  }
+  return ShardBinaryIndex::Write(shard_address + kBinaryIndexSuffix, shard_address, fields, rows);
+}
+
 MSRStatus ShardIndexGenerator::WriteToDatabase() {
   fields_ = shard_header_.get_fields();
   page_size_ = shard_header_.get_page_size();
   header_size_ = shard_header_.get_header_size();
   schema_count_ = shard_header_.get_schema_count();
+  raw_codecs_.clear();
+  if (shard_header_.get_raw_format() == kRawFormatBinary) {
+    for (int sc = 0; sc < schema_count_; ++sc) {
+      auto schema = shard_header_.GetSchemaByID(sc);
+      if (schema.second != SUCCESS) {
+        return FAILED;
+      }
+      raw_codecs_.push_back(std::make_shared<ShardRawCodec>(schema.first));
+    }
+  }
   if (shard_header_.get_shard_count() > kMaxShardCount) {
     MS_LOG(ERROR) << "num shards: " << shard_header_.get_shard_count() << " exceeds max count:" << kMaxSchemaCount;
     return FAILED;
@@ -554,6 +721,9 @@ MSRStatus ShardIndexGenerator::WriteToDatabase() {
   const unsigned int num_workers =
     std::min(std::thread::hardware_concurrency() / 2 + 1, static_cast<unsigned int>(shard_header_.get_shard_count()));
 
+  // the threads left are shared by the shards to read their raw pages
+  num_page_readers_ = std::max(1u, std::thread::hardware_concurrency() / std::max(1u, num_workers));
+
   std::vector<std::thread> threads;
   threads.reserve(num_workers);
 
@@ -570,14 +740,6 @@ MSRStatus ShardIndexGenerator::WriteToDatabase() {
 void ShardIndexGenerator::DatabaseWriter() {
   int shard_no = task_++;
   while (shard_no < shard_header_.get_shard_count()) {
-    auto db = CreateDatabase(shard_no);
-    if (db.first != SUCCESS || db.second == nullptr || write_success_ == false) {
-      write_success_ = false;
-      return;
-    }
-
-    MS_LOG(INFO) << "Init index db for shard: " << shard_no << " successfully.";
-
     // Pre-processing page information
     auto total_pages = shard_header_.GetLastPageId(shard_no) + 1;
 
@@ -592,7 +754,41 @@ void ShardIndexGenerator::DatabaseWriter() {
       }
     }
 
-    if (ExecuteTransaction(shard_no, db, raw_page_ids, blob_id_to_page_id) != SUCCESS) {
+    // After an append only the new row groups are indexed, if the shard was indexed with its binary index
+    uint64_t first_row_id = 0;
+    std::vector<ShardBinaryIndex::Row> binary_rows;
+    std::pair<MSRStatus, sqlite3 *> db{FAILED, nullptr};
+    if (append_) {
+      db = OpenIncrementalDatabase(shard_no, blob_id_to_page_id, &first_row_id, &binary_rows);
+    }
+    if (db.first != SUCCESS) {
+      first_row_id = 0;
+      binary_rows.clear();
+      db = CreateDatabase(shard_no);
+    }
+    if (db.first != SUCCESS || db.second == nullptr || write_success_ == false) {
+      write_success_ = false;
+      return;
+    }
+
+    MS_LOG(INFO) << "Init index db for shard: " << shard_no << " successfully.";
+
+    // Skip the raw pages whose row groups are all indexed
+    auto has_new_rows = [this, shard_no, &blob_id_to_page_id, first_row_id](int raw_page_id) {
+      for (const auto &group : shard_header_.GetPage(shard_no, raw_page_id).first->get_row_group_ids()) {
+        auto blob_page = shard_header_.GetPage(shard_no, blob_id_to_page_id.at(group.first)).first;
+        if (blob_page->get_start_row_id() >= first_row_id) {
+          return true;
+        }
+      }
+      return false;
+    };
+    raw_page_ids.erase(
+      std::remove_if(raw_page_ids.begin(), raw_page_ids.end(), [&has_new_rows](int id) { return !has_new_rows(id); }),
+      raw_page_ids.end());
+
+    if (ExecuteTransaction(shard_no, db.second, raw_page_ids, blob_id_to_page_id, first_row_id, &binary_rows) !=
+        SUCCESS) {
       write_success_ = false;
       return;
     }
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mindrecord/include/shard_mapped_file.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include "common/utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+using mindspore::MsLogLevel::WARNING;
+
+namespace mindspore {
+namespace mindrecord {
+ShardMappedFile::~ShardMappedFile() { Close(); }
+
+MSRStatus ShardMappedFile::Open(const std::string &file_path) {
+  Close();
+  int fd = open(common::SafeCStr(file_path), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "File could not opened: " << file_path << ", error: " << strerror(errno);
+    return FAILED;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    MS_LOG(ERROR) << "File could not be mapped, it is empty or its size is unknown: " << file_path;
+    (void)close(fd);
+    return FAILED;
+  }
+  void *addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping keeps a reference to the file, the descriptor is not needed any more
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "File could not be mapped: " << file_path << ", error: " << strerror(errno);
+    return FAILED;
+  }
+  addr_ = static_cast<uint8_t *>(addr);
+  size_ = static_cast<uint64_t>(st.st_size);
+  return SUCCESS;
+}
+
+void ShardMappedFile::Close() {
+  if (addr_ != nullptr) {
+    (void)munmap(addr_, size_);
+    addr_ = nullptr;
+    size_ = 0;
+  }
+}
+
+void ShardMappedFile::Advise(int advice) const {
+  if (addr_ != nullptr && madvise(addr_, size_, advice) != 0) {
+    MS_LOG(WARNING) << "madvise " << advice << " failed, error: " << strerror(errno);
+  }
+}
+
+void ShardMappedFile::WillNeed(uint64_t offset, uint64_t length) const {
+  if (addr_ == nullptr || offset >= size_) {
+    return;
+  }
+  length = std::min(length, size_ - offset);
+  // madvise needs an address aligned to the page
+  auto page_mask = static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) - 1;
+  uint64_t start = offset & ~page_mask;
+  (void)madvise(addr_ + start, length + offset - start, MADV_WILLNEED);
+}
+
+const uint8_t *ShardMappedFile::Data(uint64_t offset, uint64_t length) const {
+  if (addr_ == nullptr || offset > size_ || length > size_ - offset) {
+    return nullptr;
+  }
+  return addr_ + offset;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
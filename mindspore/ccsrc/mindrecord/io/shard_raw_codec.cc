@@ -0,0 +1,248 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mindrecord/include/shard_raw_codec.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "common/utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const uint64_t kStringLengthSize = sizeof(uint32_t);
+
+uint64_t FieldWidth(RawFieldType type) {
+  switch (type) {
+    case kRawFieldInt64:
+    case kRawFieldFloat64:
+      return kInt64Len;
+    default:
+      return kStringLengthSize;
+  }
+}
+
+template <typename T>
+void Put(T value, uint8_t *out) {
+  (void)memcpy(out, &value, sizeof(T));
+}
+
+template <typename T>
+T Get(const uint8_t *data) {
+  T value = 0;
+  (void)memcpy(&value, data, sizeof(T));
+  return value;
+}
+}  // namespace
+
+ShardRawCodec::ShardRawCodec(const std::shared_ptr<Schema> &schema) {
+  json fields = schema->GetSchema()["schema"];
+  for (const auto &field : schema->get_blob_fields()) {
+    (void)fields.erase(field);
+  }
+  // The items of a json object are sorted by their names
+  for (auto it = fields.begin(); it != fields.end(); ++it) {
+    std::string type = it.value()["type"].get<std::string>();
+    RawFieldType raw_type;
+    if (type == "int32") {
+      raw_type = kRawFieldInt32;
+    } else if (type == "int64") {
+      raw_type = kRawFieldInt64;
+    } else if (type == "float32") {
+      raw_type = kRawFieldFloat32;
+    } else if (type == "float64") {
+      raw_type = kRawFieldFloat64;
+    } else if (type == "string") {
+      raw_type = kRawFieldString;
+      string_fields_.push_back(static_cast<int>(fields_.size()));
+    } else {
+      continue;
+    }
+    fields_.push_back(Field{it.key(), raw_type, fixed_size_});
+    fixed_size_ += FieldWidth(raw_type);
+  }
+}
+
+bool ShardRawCodec::IsSupported(const std::string &raw_format) {
+  return raw_format == kRawFormatMsgpack || raw_format == kRawFormatBinary;
+}
+
+int ShardRawCodec::GetFieldId(const std::string &name) const {
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    if (fields_[i].name == name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+MSRStatus ShardRawCodec::Encode(const json &row, std::vector<uint8_t> *out) const {
+  uint64_t size = fixed_size_;
+  for (int id : string_fields_) {
+    auto it = row.find(fields_[id].name);
+    if (it == row.end() || !it->is_string()) {
+      MS_LOG(ERROR) << "Field " << fields_[id].name << " is missing or is not a string.";
+      return FAILED;
+    }
+    size += it->get_ref<const std::string &>().size();
+  }
+  out->assign(size, 0);
+
+  uint64_t string_offset = fixed_size_;
+  for (const auto &field : fields_) {
+    auto it = row.find(field.name);
+    if (it == row.end() || (field.type != kRawFieldString && !it->is_number()) ||
+        ((field.type == kRawFieldInt32 || field.type == kRawFieldInt64) && !it->is_number_integer())) {
+      MS_LOG(ERROR) << "Field " << field.name << " is missing or does not match its type.";
+      return FAILED;
+    }
+    uint8_t *dst = out->data() + field.offset;
+    switch (field.type) {
+      case kRawFieldInt32: {
+        auto value = it->get<int64_t>();
+        if (value < std::numeric_limits<int32_t>::min() || value > std::numeric_limits<int32_t>::max()) {
+          MS_LOG(ERROR) << "Field " << field.name << " is out of the range of int32: " << value;
+          return FAILED;
+        }
+        Put(static_cast<int32_t>(value), dst);
+        break;
+      }
+      case kRawFieldInt64:
+        Put(it->get<int64_t>(), dst);
+        break;
+      case kRawFieldFloat32:
+        Put(it->get<float>(), dst);
+        break;
+      case kRawFieldFloat64:
+        Put(it->get<double>(), dst);
+        break;
+      default: {
+        const auto &str = it->get_ref<const std::string &>();
+        if (str.size() > std::numeric_limits<uint32_t>::max()) {
+          MS_LOG(ERROR) << "Field " << field.name << " is too long: " << str.size();
+          return FAILED;
+        }
+        Put(static_cast<uint32_t>(str.size()), dst);
+        (void)std::copy(str.begin(), str.end(), out->begin() + string_offset);
+        string_offset += str.size();
+        break;
+      }
+    }
+  }
+  return SUCCESS;
+}
+
+bool ShardRawCodec::GetField(const uint8_t *data, uint64_t length, int field_id, const uint8_t **value,
+                             uint64_t *size) const {
+  if (field_id < 0 || field_id >= static_cast<int>(fields_.size()) || length < fixed_size_) {
+    return false;
+  }
+  const auto &field = fields_[field_id];
+  if (field.type != kRawFieldString) {
+    *value = data + field.offset;
+    *size = FieldWidth(field.type);
+    return true;
+  }
+  uint64_t offset = fixed_size_;
+  for (int id : string_fields_) {
+    uint64_t string_size = Get<uint32_t>(data + fields_[id].offset);
+    if (string_size > length - offset) {
+      return false;
+    }
+    if (id == field_id) {
+      *value = data + offset;
+      *size = string_size;
+      return true;
+    }
+    offset += string_size;
+  }
+  return false;
+}
+
+MSRStatus ShardRawCodec::Decode(const uint8_t *data, uint64_t length, const std::vector<std::string> &columns,
+                                json *row) const {
+  json res = json::object();
+  auto decode_field = [this, data, length, &res](int field_id) {
+    const uint8_t *value = nullptr;
+    uint64_t size = 0;
+    if (!GetField(data, length, field_id, &value, &size)) {
+      MS_LOG(ERROR) << "Raw row is broken, length: " << length;
+      return false;
+    }
+    const auto &field = fields_[field_id];
+    switch (field.type) {
+      case kRawFieldInt32:
+        res[field.name] = Get<int32_t>(value);
+        break;
+      case kRawFieldInt64:
+        res[field.name] = Get<int64_t>(value);
+        break;
+      case kRawFieldFloat32:
+        res[field.name] = Get<float>(value);
+        break;
+      case kRawFieldFloat64:
+        res[field.name] = Get<double>(value);
+        break;
+      default:
+        res[field.name] = std::string(reinterpret_cast<const char *>(value), size);
+        break;
+    }
+    return true;
+  };
+
+  if (columns.empty()) {
+    for (size_t i = 0; i < fields_.size(); ++i) {
+      if (!decode_field(static_cast<int>(i))) {
+        return FAILED;
+      }
+    }
+  } else {
+    for (const auto &col : columns) {
+      int field_id = GetFieldId(col);
+      if (field_id >= 0 && !decode_field(field_id)) {
+        return FAILED;
+      }
+    }
+  }
+  *row = std::move(res);
+  return SUCCESS;
+}
+
+MSRStatus ShardRawCodec::DecodeRow(const ShardRawCodec *codec, const uint8_t *data, uint64_t length,
+                                   const std::vector<std::string> &columns, json *row) {
+  if (codec != nullptr) {
+    return codec->Decode(data, length, columns, row);
+  }
+  json label_json = json::from_msgpack(data, data + length);
+  if (columns.empty()) {
+    *row = std::move(label_json);
+    return SUCCESS;
+  }
+  json tmp;
+  for (auto &col : columns) {
+    if (label_json.find(col) != label_json.end()) {
+      tmp[col] = label_json[col];
+    }
+  }
+  *row = std::move(tmp);
+  return SUCCESS;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -34,6 +34,20 @@ Type StringToNum(const std::string &str) {
   return num;
 }
 
+// convert the value of an index field in the binary index to the type in schema
+json CastIndexField(const json &value, const json &type) {
+  if (type == "int32") {
+    return static_cast<int32_t>(value.get<int64_t>());
+  } else if (type == "int64") {
+    return value.get<int64_t>();
+  } else if (type == "float32") {
+    return static_cast<float>(value.get<double>());
+  } else if (type == "float64") {
+    return value.get<double>();
+  }
+  return value.is_string() ? value : json(value.dump());
+}
+
 ShardReader::ShardReader() {
   task_id_ = 0;
   deliver_id_ = 0;
@@ -59,38 +73,27 @@ MSRStatus ShardReader::Init(const std::string &file_path) {
   header_size_ = shard_header_->get_header_size();
   page_size_ = shard_header_->get_page_size();
   file_paths_ = shard_header_->get_shard_addresses();
-
-  for (const auto &file : file_paths_) {
-    sqlite3 *db = nullptr;
-    // sqlite3_open create a database if not found, use sqlite3_open_v2 instead of it
-    int rc = sqlite3_open_v2(common::SafeCStr(file + ".db"), &db, SQLITE_OPEN_READONLY, nullptr);
-    if (rc != SQLITE_OK) {
-      MS_LOG(ERROR) << "Can't open database, error: " << sqlite3_errmsg(db);
-      return FAILED;
-    }
-    MS_LOG(DEBUG) << "Opened database successfully";
-
-    string sql = "select NAME from SHARD_NAME;";
-    std::vector<std::vector<std::string>> name;
-    char *errmsg = nullptr;
-    rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &name, &errmsg);
-    if (rc != SQLITE_OK) {
-      MS_LOG(ERROR) << "Error in select statement, sql: " << sql << ", error: " << errmsg;
-      sqlite3_free(errmsg);
-      sqlite3_close(db);
+  // The raw rows are read with the first schema, as the labels are
+  raw_codec_ = nullptr;
+  if (shard_header_->get_raw_format() == kRawFormatBinary && !shard_header_->get_schemas().empty()) {
+    raw_codec_ = std::make_shared<ShardRawCodec>(shard_header_->get_schemas()[0]);
+  }
+
+  // Shards with a binary index open their database only for queries with criteria
+  database_paths_ = std::vector<sqlite3 *>(file_paths_.size(), nullptr);
+  binary_indexes_ = std::vector<std::shared_ptr<ShardBinaryIndex>>(file_paths_.size());
+  int num_binary_indexes = 0;
+  for (int shard_id = 0; shard_id < static_cast<int>(file_paths_.size()); ++shard_id) {
+    const auto &file = file_paths_[shard_id];
+    auto binary_index = std::make_shared<ShardBinaryIndex>();
+    if (binary_index->Load(file + kBinaryIndexSuffix, file) == SUCCESS) {
+      binary_indexes_[shard_id] = binary_index;
+      num_binary_indexes++;
+    } else if (GetDatabase(shard_id) == nullptr) {
       return FAILED;
-    } else {
-      MS_LOG(DEBUG) << "Get " << static_cast<int>(name.size()) << " records from index.";
-      string shardName = GetFileName(file).second;
-      if (name.empty() || name[0][0] != shardName) {
-        MS_LOG(ERROR) << "DB file can not match file " << file;
-        sqlite3_free(errmsg);
-        sqlite3_close(db);
-        return FAILED;
-      }
     }
-    database_paths_.push_back(db);
   }
+  MS_LOG(INFO) << "Load binary index of " << num_binary_indexes << " of " << file_paths_.size() << " shards.";
 
   num_rows_ = 0;
   auto row_group_summary = ReadRowGroupSummary();
@@ -103,6 +106,44 @@ MSRStatus ShardReader::Init(const std::string &file_path) {
   return SUCCESS;
 }
 
+sqlite3 *ShardReader::GetDatabase(int shard_id) {
+  std::lock_guard<std::mutex> lck(database_locker_);
+  if (database_paths_[shard_id] != nullptr) {
+    return database_paths_[shard_id];
+  }
+  const auto &file = file_paths_[shard_id];
+  sqlite3 *db = nullptr;
+  // sqlite3_open create a database if not found, use sqlite3_open_v2 instead of it
+  int rc = sqlite3_open_v2(common::SafeCStr(file + ".db"), &db, SQLITE_OPEN_READONLY, nullptr);
+  if (rc != SQLITE_OK) {
+    MS_LOG(ERROR) << "Can't open database, error: " << sqlite3_errmsg(db);
+    return nullptr;
+  }
+  MS_LOG(DEBUG) << "Opened database successfully";
+
+  string sql = "select NAME from SHARD_NAME;";
+  std::vector<std::vector<std::string>> name;
+  char *errmsg = nullptr;
+  rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &name, &errmsg);
+  if (rc != SQLITE_OK) {
+    MS_LOG(ERROR) << "Error in select statement, sql: " << sql << ", error: " << errmsg;
+    sqlite3_free(errmsg);
+    sqlite3_close(db);
+    return nullptr;
+  } else {
+    MS_LOG(DEBUG) << "Get " << static_cast<int>(name.size()) << " records from index.";
+    string shardName = GetFileName(file).second;
+    if (name.empty() || name[0][0] != shardName) {
+      MS_LOG(ERROR) << "DB file can not match file " << file;
+      sqlite3_free(errmsg);
+      sqlite3_close(db);
+      return nullptr;
+    }
+  }
+  database_paths_[shard_id] = db;
+  return db;
+}
+
 MSRStatus ShardReader::CheckColumnList(const std::vector<std::string> &selected_columns) {
   vector<int> inSchema(selected_columns.size(), 0);
   for (auto &p : get_shard_header()->get_schemas()) {
@@ -162,6 +203,20 @@ MSRStatus ShardReader::Open(int n_consumer) {
   return SUCCESS;
 }
 
+MSRStatus ShardReader::OpenMapped(int advice) {
+  mapped_files_.clear();
+  for (const auto &file : file_paths_) {
+    auto mapped_file = std::make_shared<ShardMappedFile>();
+    if (mapped_file->Open(file) == FAILED) {
+      return FAILED;
+    }
+    mapped_file->Advise(advice);
+    mapped_files_.push_back(mapped_file);
+  }
+  MS_LOG(INFO) << "Map " << mapped_files_.size() << " shard files successfully.";
+  return SUCCESS;
+}
+
 void ShardReader::FileStreamsOperator() {
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; --i) {
     if (file_streams_[i] != nullptr) {
@@ -178,8 +233,10 @@ void ShardReader::FileStreamsOperator() {
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
       (void)sqlite3_close(database_paths_[i]);
+      database_paths_[i] = nullptr;
     }
   }
+  mapped_files_.clear();
 }
 
 ShardReader::~ShardReader() { Close(); }
@@ -235,38 +292,21 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
     uint64_t offset_end = std::stoull(labels[i][2]);
     offsets[shard_id].emplace_back(
       std::vector<uint64_t>{static_cast<uint64_t>(shard_id), group_id, offset_start, offset_end});
-    if (!all_in_index_) {
+    if (!all_in_index_ && keep_encoded_labels_) {
+      // The raw row is decoded by the consumer, straight from the mapped file
+      offsets[shard_id].back().insert(offsets[shard_id].back().end(),
+                                      {std::stoull(labels[i][3]), std::stoull(labels[i][4]) + kInt64Len,
+                                       std::stoull(labels[i][5])});
+      column_values[shard_id].emplace_back(json{});
+    } else if (!all_in_index_) {
       int raw_page_id = std::stoi(labels[i][3]);
       uint64_t label_start = std::stoull(labels[i][4]) + kInt64Len;
       uint64_t label_end = std::stoull(labels[i][5]);
-      auto len = label_end - label_start;
-      auto label_raw = std::vector<uint8_t>(len);
-      auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-      if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-        MS_LOG(ERROR) << "File seekg failed";
-        fs->close();
+      json label;
+      if (ReadRawLabel(fs, raw_page_id, label_start, label_end, columns, &label) != SUCCESS) {
         return FAILED;
       }
-
-      auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-      if (!io_read.good() || io_read.fail() || io_read.bad()) {
-        MS_LOG(ERROR) << "File read failed";
-        fs->close();
-        return FAILED;
-      }
-
-      json label_json = json::from_msgpack(label_raw);
-      json tmp;
-      if (!columns.empty()) {
-        for (auto &col : columns) {
-          if (label_json.find(col) != label_json.end()) {
-            tmp[col] = label_json[col];
-          }
-        }
-      } else {
-        tmp = label_json;
-      }
-      column_values[shard_id].emplace_back(tmp);
+      column_values[shard_id].emplace_back(label);
     } else {
       json construct_json;
       for (unsigned int j = 0; j < columns.size(); ++j) {
@@ -293,10 +333,115 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
   return SUCCESS;
 }
 
+MSRStatus ShardReader::ReadRawLabel(std::shared_ptr<std::fstream> fs, uint64_t raw_page_id, uint64_t label_start,
+                                    uint64_t label_end, const std::vector<std::string> &columns, json *label) {
+  auto len = label_end - label_start;
+  auto label_raw = std::vector<uint8_t>(len);
+  // A binary row of a schema without raw fields is empty
+  if (len > 0) {
+    auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      MS_LOG(ERROR) << "File seekg failed";
+      fs->close();
+      return FAILED;
+    }
+
+    auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      MS_LOG(ERROR) << "File read failed";
+      fs->close();
+      return FAILED;
+    }
+  }
+  return ShardRawCodec::DecodeRow(raw_codec_.get(), label_raw.data(), len, columns, label);
+}
+
+std::pair<MSRStatus, std::vector<int>> ShardReader::GetBinaryIndexFieldIds(int shard_id,
+                                                                           const std::vector<std::string> &columns) {
+  std::vector<int> field_ids;
+  for (const auto &col : columns) {
+    auto it = column_schema_id_.find(col);
+    if (it == column_schema_id_.end()) {
+      MS_LOG(ERROR) << "Field " << col << " is not an index field";
+      return {FAILED, {}};
+    }
+    auto ret = ShardIndexGenerator::GenerateFieldName(std::make_pair(it->second, col));
+    int field_id = ret.first == SUCCESS ? binary_indexes_[shard_id]->GetFieldId(ret.second) : -1;
+    if (field_id < 0) {
+      MS_LOG(ERROR) << "Field " << col << " is not in the binary index of shard " << shard_id;
+      return {FAILED, {}};
+    }
+    field_ids.push_back(field_id);
+  }
+  return {SUCCESS, field_ids};
+}
+
+MSRStatus ShardReader::ReadAllRowsInBinaryIndex(int shard_id, const std::vector<std::string> &columns,
+                                                std::vector<std::vector<std::vector<uint64_t>>> &offsets,
+                                                std::vector<std::vector<json>> &column_values) {
+  const auto &index = binary_indexes_[shard_id];
+  std::vector<int> field_ids;
+  std::vector<json> types;
+  std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
+  if (all_in_index_) {
+    auto ret = GetBinaryIndexFieldIds(shard_id, columns);
+    if (ret.first != SUCCESS) {
+      return FAILED;
+    }
+    field_ids = std::move(ret.second);
+    auto schema = shard_header_->get_schemas()[0]->GetSchema()["schema"];
+    for (const auto &col : columns) {
+      types.push_back(schema[col]["type"]);
+    }
+  } else if (!keep_encoded_labels_) {
+    fs->open(common::SafeCStr(file_paths_[shard_id]), std::ios::in | std::ios::binary);
+    if (fs->fail()) {
+      MS_LOG(ERROR) << "File could not opened";
+      return FAILED;
+    }
+  }
+
+  uint64_t num_rows = index->get_num_rows();
+  offsets[shard_id].reserve(num_rows);
+  column_values[shard_id].reserve(num_rows);
+  for (uint64_t row = 0; row < num_rows; ++row) {
+    offsets[shard_id].emplace_back(std::vector<uint64_t>{static_cast<uint64_t>(shard_id),
+                                                         index->GetAddress(row, kIndexRowGroupId),
+                                                         index->GetAddress(row, kIndexPageOffsetBlob) + kInt64Len,
+                                                         index->GetAddress(row, kIndexPageOffsetBlobEnd)});
+    json label;
+    if (!all_in_index_ && keep_encoded_labels_) {
+      offsets[shard_id].back().insert(offsets[shard_id].back().end(),
+                                      {index->GetAddress(row, kIndexPageIdRaw),
+                                       index->GetAddress(row, kIndexPageOffsetRaw) + kInt64Len,
+                                       index->GetAddress(row, kIndexPageOffsetRawEnd)});
+    } else if (!all_in_index_) {
+      if (ReadRawLabel(fs, index->GetAddress(row, kIndexPageIdRaw),
+                       index->GetAddress(row, kIndexPageOffsetRaw) + kInt64Len,
+                       index->GetAddress(row, kIndexPageOffsetRawEnd), columns, &label) != SUCCESS) {
+        return FAILED;
+      }
+    } else {
+      for (size_t j = 0; j < columns.size(); ++j) {
+        label[columns[j]] = CastIndexField(index->GetField(row, field_ids[j]), types[j]);
+      }
+    }
+    column_values[shard_id].emplace_back(std::move(label));
+  }
+  MS_LOG(INFO) << "Get " << num_rows << " records from shard " << shard_id << " binary index.";
+  return SUCCESS;
+}
+
 MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
                                           std::vector<std::vector<std::vector<uint64_t>>> &offsets,
                                           std::vector<std::vector<json>> &column_values) {
-  auto db = database_paths_[shard_id];
+  if (binary_indexes_[shard_id] != nullptr) {
+    return ReadAllRowsInBinaryIndex(shard_id, columns, offsets, column_values);
+  }
+  auto db = GetDatabase(shard_id);
+  if (db == nullptr) {
+    return FAILED;
+  }
   std::vector<std::vector<std::string>> labels;
   char *errmsg = nullptr;
   int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
@@ -413,7 +558,19 @@ int ShardReader::SelectCallback(void *p_data, int num_fields, char **p_fields, c
 
 std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int shard_id,
                                                                const std::pair<std::string, std::string> &criteria) {
-  auto db = database_paths_[shard_id];
+  if (criteria.first.empty() && binary_indexes_[shard_id] != nullptr) {
+    const auto &index = binary_indexes_[shard_id];
+    std::vector<std::vector<uint64_t>> res;
+    for (auto row : GetBinaryIndexRowsOfPage(page_id, shard_id)) {
+      res.emplace_back(std::vector<uint64_t>{index->GetAddress(row, kIndexPageOffsetBlob) + kInt64Len,
+                                             index->GetAddress(row, kIndexPageOffsetBlobEnd)});
+    }
+    return res;
+  }
+  auto db = GetDatabase(shard_id);
+  if (db == nullptr) {
+    return std::vector<std::vector<uint64_t>>();
+  }
 
   std::string sql =
     "SELECT PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END FROM INDEXES WHERE PAGE_ID_BLOB = " + std::to_string(page_id);
@@ -454,6 +611,15 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
   return res;
 }
 
+std::vector<uint64_t> ShardReader::GetBinaryIndexRowsOfPage(int page_id, int shard_id) {
+  auto page = shard_header_->GetPage(shard_id, page_id);
+  if (page.second != SUCCESS) {
+    return {};
+  }
+  return binary_indexes_[shard_id]->GetRowsOfPage(page_id, page.first->get_start_row_id(),
+                                                  page.first->get_end_row_id());
+}
+
 void ShardReader::CheckNlp() {
   nlp_ = false;
   return;
@@ -538,28 +704,27 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromBinaryFile(
     int raw_page_id = std::stoi(labelOffset[0]);
     auto len = label_end - label_start;
     auto label_raw = std::vector<uint8_t>(len);
-    auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-      MS_LOG(ERROR) << "File seekg failed";
-      fs->close();
-      return {FAILED, {}};
+    if (len > 0) {
+      auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
+      if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+        MS_LOG(ERROR) << "File seekg failed";
+        fs->close();
+        return {FAILED, {}};
+      }
+
+      auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
+      if (!io_read.good() || io_read.fail() || io_read.bad()) {
+        MS_LOG(ERROR) << "File read failed";
+        fs->close();
+        return {FAILED, {}};
+      }
     }
 
-    auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-    if (!io_read.good() || io_read.fail() || io_read.bad()) {
-      MS_LOG(ERROR) << "File read failed";
+    // All the fields of the row are kept, as with msgpack rows
+    if (ShardRawCodec::DecodeRow(raw_codec_.get(), label_raw.data(), len, {}, &res[i]) != SUCCESS) {
       fs->close();
       return {FAILED, {}};
     }
-
-    json label_json = json::from_msgpack(label_raw);
-    json tmp = label_json;
-    for (auto &col : columns) {
-      if (label_json.find(col) != label_json.end()) {
-        tmp[col] = label_json[col];
-      }
-    }
-    res[i] = tmp;
   }
   return {SUCCESS, res};
 }
@@ -567,11 +732,24 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromBinaryFile(
 std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromPage(
   int page_id, int shard_id, const std::vector<std::string> &columns,
   const std::pair<std::string, std::string> &criteria) {
+  std::vector<std::vector<std::string>> label_offsets;
+  if (criteria.first.empty() && binary_indexes_[shard_id] != nullptr) {
+    const auto &index = binary_indexes_[shard_id];
+    for (auto row : GetBinaryIndexRowsOfPage(page_id, shard_id)) {
+      label_offsets.emplace_back(std::vector<std::string>{std::to_string(index->GetAddress(row, kIndexPageIdRaw)),
+                                                          std::to_string(index->GetAddress(row, kIndexPageOffsetRaw)),
+                                                          std::to_string(index->GetAddress(row, kIndexPageOffsetRawEnd))});
+    }
+    return GetLabelsFromBinaryFile(shard_id, columns, label_offsets);
+  }
+
   // get page info from sqlite
-  auto db = database_paths_[shard_id];
+  auto db = GetDatabase(shard_id);
+  if (db == nullptr) {
+    return {FAILED, {}};
+  }
   std::string sql = "SELECT PAGE_ID_RAW, PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END FROM INDEXES WHERE PAGE_ID_BLOB = " +
                     std::to_string(page_id);
-  std::vector<std::vector<std::string>> label_offsets;
   if (!criteria.first.empty()) {
     sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = :criteria";
     if (QueryWithCriteria(db, sql, criteria.second, label_offsets) == FAILED) {
@@ -597,8 +775,14 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromPage(
 std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabels(int page_id, int shard_id,
                                                                const std::vector<std::string> &columns,
                                                                const std::pair<std::string, std::string> &criteria) {
+  if (all_in_index_ && criteria.first.empty() && binary_indexes_[shard_id] != nullptr) {
+    return GetLabelsFromBinaryIndex(page_id, shard_id, columns);
+  }
   if (all_in_index_) {
-    auto db = database_paths_[shard_id];
+    auto db = GetDatabase(shard_id);
+    if (db == nullptr) {
+      return {FAILED, {}};
+    }
     std::string fields;
     for (unsigned int i = 0; i < columns.size(); ++i) {
       if (i > 0) fields += ',';
@@ -655,6 +839,25 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabels(int page_id, int
   return GetLabelsFromPage(page_id, shard_id, columns, criteria);
 }
 
+std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromBinaryIndex(int page_id, int shard_id,
+                                                                              const std::vector<std::string> &columns) {
+  auto field_ids = GetBinaryIndexFieldIds(shard_id, columns);
+  if (field_ids.first != SUCCESS) {
+    return {FAILED, {}};
+  }
+  auto schema = shard_header_->get_schemas()[0]->GetSchema()["schema"];
+  const auto &index = binary_indexes_[shard_id];
+  std::vector<json> ret;
+  for (auto row : GetBinaryIndexRowsOfPage(page_id, shard_id)) {
+    json construct_json;
+    for (size_t j = 0; j < columns.size(); ++j) {
+      construct_json[columns[j]] = CastIndexField(index->GetField(row, field_ids.second[j]), schema[columns[j]]["type"]);
+    }
+    ret.emplace_back(std::move(construct_json));
+  }
+  return {SUCCESS, ret};
+}
+
 bool ResortRowGroups(std::tuple<int, int, int, int> a, std::tuple<int, int, int, int> b) {
   return std::get<1>(a) < std::get<1>(b) || (std::get<1>(a) == std::get<1>(b) && std::get<0>(a) < std::get<0>(b));
 }
@@ -665,6 +868,12 @@ MSRStatus ShardReader::Finish() {
     interrupt_ = true;
   }
   cv_delivery_.notify_all();
+  {
+    // Take the lock so that no read ahead thread misses the notification between its check and its wait
+    std::lock_guard<std::mutex> lck(mtx_read_ahead_);
+  }
+  cv_read_ahead_.notify_all();
+  cv_read_ahead_done_.notify_all();
 
   // Wait for all threads to finish
   for (auto &i_thread : thread_set_) {
@@ -672,6 +881,11 @@ MSRStatus ShardReader::Finish() {
       i_thread.join();
     }
   }
+  for (auto &i_thread : read_ahead_set_) {
+    if (i_thread.joinable()) {
+      i_thread.join();
+    }
+  }
   return SUCCESS;
 }
 
@@ -685,7 +899,8 @@ MSRStatus ShardReader::CountTotalRows(const std::string &file_path, int64_t *cou
 
 MSRStatus ShardReader::Open(const std::string &file_path, int n_consumer,
                             const std::vector<std::string> &selected_columns,
-                            const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader) {
+                            const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader,
+                            const bool &use_mmap) {
   // Open file and set header by ShardReader
   if (Init(file_path) == FAILED) {
     return FAILED;
@@ -720,18 +935,39 @@ MSRStatus ShardReader::Open(const std::string &file_path, int n_consumer,
   n_consumer_ = n_consumer;
 
   operators_ = operators;
+  use_mmap_ = use_mmap;
+  keep_encoded_labels_ = keep_encoded_labels_ && use_mmap && !block_reader && !nlp_ && raw_codec_ != nullptr;
+  n_read_ahead_ = (!block_reader && read_ahead_size_ > 0) ? n_consumer : 0;
 
   if (block_reader) {
     block_reader_ = true;
-    if (Open() == FAILED) {
-      return FAILED;
+    if (use_mmap_) {
+      // Pages are read in order, let the kernel read ahead of them
+      if (OpenMapped(MADV_SEQUENTIAL) == FAILED) {
+        return FAILED;
+      }
+      page_views_ = std::vector<const uint8_t *>(kNumPageInBuffer, nullptr);
+    } else {
+      if (Open() == FAILED) {
+        return FAILED;
+      }
+      buf_ = std::vector<std::vector<uint8_t>>(kNumPageInBuffer, std::vector<uint8_t>(page_size_));
     }
+    page_compressions_ = std::vector<std::string>(kNumPageInBuffer, kCompressionNone);
     delivery_block_ = std::vector<std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>>(
       kNumPageInBuffer, std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>{});
-    buf_ = std::vector<std::vector<uint8_t>>(kNumPageInBuffer, std::vector<uint8_t>(page_size_));
   } else {
     block_reader_ = false;
-    if (Open(n_consumer) == FAILED) {
+    if (use_mmap_) {
+      // Rows shuffled or picked by category jump around the files, the read ahead would be wasted on them
+      auto is_random = [](const std::shared_ptr<ShardOperator> &op) {
+        return std::dynamic_pointer_cast<ShardShuffle>(op) || std::dynamic_pointer_cast<ShardCategory>(op);
+      };
+      bool random_access = std::any_of(operators.begin(), operators.end(), is_random);
+      if (OpenMapped(random_access ? MADV_RANDOM : MADV_SEQUENTIAL) == FAILED) {
+        return FAILED;
+      }
+    } else if (Open(n_consumer + n_read_ahead_) == FAILED) {  // the read ahead threads have their own handles
       return FAILED;
     }
   }
@@ -782,6 +1018,11 @@ MSRStatus ShardReader::Launch(bool isSimpleReader) {
   CreateTasks(row_group_summary, operators_);
   MS_LOG(INFO) << "Launching read threads";
 
+  read_ahead_set_ = std::vector<std::thread>(n_read_ahead_);
+  for (int x = 0; x < n_read_ahead_; ++x) {
+    read_ahead_set_[x] = std::thread(&ShardReader::ReadAhead, this, x);
+  }
+
   if (isSimpleReader) return SUCCESS;
 
   // Start provider consumer threads
@@ -886,8 +1127,9 @@ MSRStatus ShardReader::CreateTasksByRow(const std::vector<std::tuple<int, int, i
   if (shard_count_ <= kMaxShardCount) {
     for (int shard_id = 0; shard_id < shard_count_; shard_id++) {
       for (uint32_t i = 0; i < offsets[shard_id].size(); i += 1) {
+        // The blob offsets, then the address of the raw row if its label is kept encoded
         tasks_.InsertTask(offsets[shard_id][i][0], offsets[shard_id][i][1],
-                          std::vector<uint64_t>{offsets[shard_id][i][2], offsets[shard_id][i][3]},
+                          std::vector<uint64_t>(offsets[shard_id][i].begin() + 2, offsets[shard_id][i].end()),
                           local_columns[shard_id][i]);
       }
     }
@@ -927,62 +1169,110 @@ MSRStatus ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, u
   return SUCCESS;
 }
 
-TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id) {
+MSRStatus ShardReader::GetTaskBlobAddress(int task_id, int *shard_id, uint64_t *file_offset, uint64_t *length,
+                                          std::string *compression) {
   // All tasks are done
   if (task_id >= static_cast<int>(tasks_.Size())) {
-    return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    return FAILED;
   }
 
   // Pick up task from task list
-  auto task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
+  const auto &task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
 
-  auto shard_id = std::get<0>(std::get<0>(task));
+  *shard_id = std::get<0>(std::get<0>(task));
   auto group_id = std::get<1>(std::get<0>(task));
-  auto addr = std::get<1>(task);
-  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+  const auto &addr = std::get<1>(task);
+  const auto &ret = shard_header_->GetPageByGroupId(group_id, *shard_id);
   if (SUCCESS != ret.first) {
-    return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    return FAILED;
   }
   const std::shared_ptr<Page> &page = ret.second;
-  // Pack image list
-  std::vector<uint8_t> images(addr[1] - addr[0]);
-  auto file_offset = header_size_ + page_size_ * (page->get_page_id()) + addr[0];
+  *file_offset = header_size_ + page_size_ * (page->get_page_id()) + addr[0];
+  *length = addr[1] - addr[0];
+  if (compression != nullptr) {
+    *compression = page->get_compression();
+  }
+  return SUCCESS;
+}
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
+MSRStatus ShardReader::DecompressBlob(const std::string &compression, std::vector<uint8_t> *blob) {
+  if (compression == kCompressionNone) {
+    return SUCCESS;
+  }
+  std::vector<uint8_t> raw_blob;
+  if (ShardCompression::Decompress(compression, blob->data(), blob->size(), &raw_blob) != SUCCESS) {
+    MS_LOG(ERROR) << "Decompress blob failed";
+    return FAILED;
+  }
+  *blob = std::move(raw_blob);
+  return SUCCESS;
+}
+
+json ShardReader::MergeBlobFields(const json &blob_fields, const json &labels) {
+  json merge;
+  if (selected_columns_.size() > 0) {
+    for (auto &col : selected_columns_) {
+      if (blob_fields.find(col) != blob_fields.end()) {
+        merge[col] = blob_fields[col];
+      }
+    }
+  } else {
+    merge = blob_fields;
+  }
+  if (labels != nullptr) {
+    merge.update(labels);
+  }
+  return merge;
+}
+
+TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id) {
+  int shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t length = 0;
+  std::string compression;
+  if (GetTaskBlobAddress(task_id, &shard_id, &file_offset, &length, &compression) != SUCCESS) {
     return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
   }
+  auto task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
 
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), addr[1] - addr[0]);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
+  // Pack image list
+  std::vector<uint8_t> images;
+  if (TakeReadAhead(task_id, &images)) {
+    MS_LOG(DEBUG) << "Task " << task_id << " is read ahead.";
+  } else if (use_mmap_) {
+    images.resize(length);
+    const uint8_t *data = mapped_files_[shard_id]->Data(file_offset, length);
+    if (data == nullptr) {
+      MS_LOG(ERROR) << "Blob is out of the mapped file, offset: " << file_offset << ", length: " << length;
+      return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    }
+    (void)std::copy(data, data + length, images.begin());
+  } else {
+    images.resize(length);
+    auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      MS_LOG(ERROR) << "File seekg failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    }
+
+    auto &io_read = file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), length);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      MS_LOG(ERROR) << "File read failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    }
+  }
+
+  // The blobs are decompressed by the consumers, the read ahead only moves the compressed bytes
+  if (DecompressBlob(compression, &images) != SUCCESS) {
     return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
   }
 
   // Deliver batch data to output map
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
   if (nlp_) {
-    json blob_fields = json::from_msgpack(images);
-
-    json merge;
-    if (selected_columns_.size() > 0) {
-      for (auto &col : selected_columns_) {
-        if (blob_fields.find(col) != blob_fields.end()) {
-          merge[col] = blob_fields[col];
-        }
-      }
-    } else {
-      merge = blob_fields;
-    }
-    auto label_json = std::get<2>(task);
-    if (label_json != nullptr) {
-      merge.update(label_json);
-    }
-    batch.emplace_back(std::vector<uint8_t>{}, std::move(merge));
+    batch.emplace_back(std::vector<uint8_t>{}, MergeBlobFields(json::from_msgpack(images), std::get<2>(task)));
   } else {
     batch.emplace_back(std::move(images), std::move(std::get<2>(task)));
   }
@@ -1026,6 +1316,17 @@ MSRStatus ShardReader::ConsumerByRow(int consumer_id) {
 
 MSRStatus ShardReader::ReadBlob(const int &shard_id, const uint64_t &page_offset, const int &page_length,
                                 const int &buf_id) {
+  if (use_mmap_) {
+    // Keep the page in the mapped file, the kernel reads it in the background until the iterator gets to it
+    page_views_[buf_id] = mapped_files_[shard_id]->Data(page_offset, page_length);
+    if (page_views_[buf_id] == nullptr) {
+      MS_LOG(ERROR) << "Page is out of the mapped file, offset: " << page_offset << ", length: " << page_length;
+      return FAILED;
+    }
+    mapped_files_[shard_id]->WillNeed(page_offset, page_length);
+    return SUCCESS;
+  }
+
   auto &io_seekg = file_streams_[shard_id]->seekg(page_offset, std::ios::beg);
   if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
     MS_LOG(ERROR) << "File seekg failed";
@@ -1093,6 +1394,11 @@ MSRStatus ShardReader::ConsumerByBlock(int consumer_id) {
     }
 
     auto buf_id = task_id % kNumPageInBuffer;
+    const auto &blob_page = shard_header_->GetPageByGroupId(group_id, shard_id);
+    if (SUCCESS != blob_page.first) {
+      return FAILED;
+    }
+    page_compressions_[buf_id] = blob_page.second->get_compression();
     delivery_block_[buf_id] =
       std::make_shared<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>(offset_and_labels);
 
@@ -1109,17 +1415,19 @@ MSRStatus ShardReader::ConsumerByBlock(int consumer_id) {
   }
 }
 
-std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardReader::GetRowFromBuffer(int buf_id,
-                                                                                                   int rowId) {
-  auto &blob_page = buf_[buf_id];
+TASK_RETURN_CONTENT ShardReader::GetRowFromBuffer(int buf_id, int rowId) {
+  const uint8_t *blob_page = use_mmap_ ? page_views_[buf_id] : buf_[buf_id].data();
   auto &offsets = (*delivery_block_[buf_id]).first;
   auto &labels = (*delivery_block_[buf_id]).second;
   auto &addr_start = offsets[rowId][0];
   auto &addr_end = offsets[rowId][1];
-  std::vector<uint8_t> images(blob_page.begin() + addr_start, blob_page.begin() + addr_end);
+  std::vector<uint8_t> images(blob_page + addr_start, blob_page + addr_end);
+  if (DecompressBlob(page_compressions_[buf_id], &images) != SUCCESS) {
+    return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+  }
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
   batch.emplace_back(std::move(images), std::move(labels[rowId]));
-  return std::make_shared<std::vector<std::tuple<std::vector<uint8_t>, json>>>(std::move(batch));
+  return std::make_pair(SUCCESS, std::move(batch));
 }
 
 std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetBlockNext() {
@@ -1137,6 +1445,9 @@ std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetBlockNext()
   }
   auto buf_id = deliver_id_ % kNumPageInBuffer;
   auto res = GetRowFromBuffer(buf_id, row_id_);
+  if (SUCCESS != res.first) {
+    return std::vector<std::tuple<std::vector<uint8_t>, json>>();
+  }
 
   row_id_++;
   if (row_id_ == (*delivery_block_[buf_id]).first.size()) {
@@ -1148,7 +1459,7 @@ std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetBlockNext()
     cv_delivery_.notify_all();
   }
 
-  return *res;
+  return std::move(res.second);
 }
 
 std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetNext() {
@@ -1188,6 +1499,58 @@ std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetNextById(con
   return std::move(ret.second);
 }
 
+std::vector<std::tuple<ShardBlobView, json>> ShardReader::GetNextViewById(const int64_t &task_id) {
+  if (interrupt_ || block_reader_ || !use_mmap_) {
+    return std::vector<std::tuple<ShardBlobView, json>>();
+  }
+  int shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t length = 0;
+  std::string compression;
+  if (GetTaskBlobAddress(task_id, &shard_id, &file_offset, &length, &compression) != SUCCESS) {
+    return std::vector<std::tuple<ShardBlobView, json>>();
+  }
+  if (compression != kCompressionNone) {
+    MS_LOG(ERROR) << "The blobs of compressed pages cannot be viewed, get them by GetNextById.";
+    return std::vector<std::tuple<ShardBlobView, json>>();
+  }
+  (void)TakeReadAhead(task_id, nullptr);
+  const uint8_t *data = mapped_files_[shard_id]->Data(file_offset, length);
+  if (data == nullptr) {
+    MS_LOG(ERROR) << "Blob is out of the mapped file, offset: " << file_offset << ", length: " << length;
+    return std::vector<std::tuple<ShardBlobView, json>>();
+  }
+  const auto &labels = std::get<2>(tasks_.get_task_by_id(tasks_.permutation_[task_id]));
+  std::vector<std::tuple<ShardBlobView, json>> batch;
+  if (nlp_) {
+    batch.emplace_back(ShardBlobView{nullptr, 0}, MergeBlobFields(json::from_msgpack(data, data + length), labels));
+  } else {
+    batch.emplace_back(ShardBlobView{data, length}, labels);
+  }
+  return batch;
+}
+
+ShardBlobView ShardReader::GetEncodedLabelView(const int64_t &task_id) {
+  if (interrupt_ || !keep_encoded_labels_ || task_id >= static_cast<int64_t>(tasks_.Size())) {
+    return ShardBlobView{nullptr, 0};
+  }
+  const auto &task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
+  const auto &addr = std::get<1>(task);
+  // [blob start, blob end, raw page ID, raw start, raw end]
+  const size_t kEncodedLabelAddressSize = 5;
+  if (addr.size() < kEncodedLabelAddressSize) {
+    return ShardBlobView{nullptr, 0};
+  }
+  int shard_id = std::get<0>(std::get<0>(task));
+  uint64_t length = addr[4] - addr[3];
+  const uint8_t *data = mapped_files_[shard_id]->Data(header_size_ + page_size_ * addr[2] + addr[3], length);
+  if (data == nullptr) {
+    MS_LOG(ERROR) << "Raw row is out of the mapped file, page: " << addr[2] << ", offset: " << addr[3];
+    return ShardBlobView{nullptr, 0};
+  }
+  return ShardBlobView{data, length};
+}
+
 std::vector<std::tuple<std::vector<uint8_t>, pybind11::object>> ShardReader::GetNextPy() {
   auto res = GetNext();
   vector<std::tuple<std::vector<uint8_t>, pybind11::object>> jsonData;
@@ -1210,12 +1573,152 @@ void ShardReader::Reset() {
 }
 
 void ShardReader::ShuffleTask() {
+  // The read ahead threads look up the task list too
+  std::lock_guard<std::mutex> lck(mtx_read_ahead_);
   for (const auto &op : operators_) {
     if (block_reader_ || !std::dynamic_pointer_cast<ShardShuffle>(op)) continue;
     if (SUCCESS != (*op)(tasks_)) {
       MS_LOG(WARNING) << "Reshuffle reader tasks failed.";
     }
   }
+  RestartReadAhead();
+}
+
+void ShardReader::RestartReadAhead() {
+  read_ahead_epoch_++;
+  read_ahead_id_ = 0;
+  read_ahead_bytes_ = 0;
+  read_ahead_in_flight_.clear();
+  read_ahead_skipped_.clear();
+  read_ahead_rows_.clear();
+  cv_read_ahead_.notify_all();
+  cv_read_ahead_done_.notify_all();
+}
+
+MSRStatus ShardReader::ReadAheadSpan(int thread_id, int shard_id, uint64_t offset, std::vector<uint8_t> *span) {
+  if (use_mmap_) {
+    // The kernel reads the span into the page cache in the background, the consumers get it from the mapped file
+    mapped_files_[shard_id]->WillNeed(offset, span->size());
+    return SUCCESS;
+  }
+  auto &fs = file_streams_random_[n_consumer_ + thread_id][shard_id];
+  auto &io_seekg = fs->seekg(offset, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    MS_LOG(ERROR) << "File seekg failed";
+    return FAILED;
+  }
+  auto &io_read = fs->read(reinterpret_cast<char *>(span->data()), span->size());
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    MS_LOG(ERROR) << "File read failed";
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::ReadAhead(int thread_id) {
+  // Set thread name
+  auto thread_name = kThreadName + "RA_" + std::to_string(thread_id);
+  prctl(PR_SET_NAME, common::SafeCStr(thread_name), 0, 0, 0);
+
+  for (;;) {
+    // Take the next rows of the task list, as long as they follow each other in the same file and fit in the budget
+    std::vector<std::tuple<int, uint64_t, uint64_t>> group;  // task ID, offset in file, length
+    int shard_id = -1;
+    int epoch = 0;
+    {
+      std::unique_lock<std::mutex> lck(mtx_read_ahead_);
+      cv_read_ahead_.wait(lck, [this] {
+        return interrupt_ || (read_ahead_id_ < static_cast<int>(tasks_.Size()) && read_ahead_bytes_ < read_ahead_size_);
+      });
+      if (interrupt_) {
+        return SUCCESS;
+      }
+      epoch = read_ahead_epoch_;
+      while (read_ahead_id_ < static_cast<int>(tasks_.Size())) {
+        if (read_ahead_skipped_.erase(read_ahead_id_) > 0) {
+          read_ahead_id_++;
+          continue;
+        }
+        int task_shard_id = 0;
+        uint64_t file_offset = 0;
+        uint64_t length = 0;
+        if (GetTaskBlobAddress(read_ahead_id_, &task_shard_id, &file_offset, &length) != SUCCESS) {
+          // Leave it to the consumer, which reports the error
+          read_ahead_id_++;
+          continue;
+        }
+        if (!group.empty()) {
+          uint64_t group_begin = std::get<1>(group.front());
+          uint64_t group_end = std::get<1>(group.back()) + std::get<2>(group.back());
+          if (task_shard_id != shard_id || file_offset < group_end || file_offset - group_end > kReadAheadMaxGap ||
+              file_offset + length - group_begin > kReadAheadMaxSpan || read_ahead_bytes_ + length > read_ahead_size_) {
+            break;
+          }
+        }
+        shard_id = task_shard_id;
+        group.emplace_back(read_ahead_id_, file_offset, length);
+        read_ahead_bytes_ += length;
+        (void)read_ahead_in_flight_.insert(read_ahead_id_);
+        read_ahead_id_++;
+      }
+    }
+    if (group.empty()) {
+      continue;
+    }
+
+    uint64_t group_begin = std::get<1>(group.front());
+    std::vector<uint8_t> span(std::get<1>(group.back()) + std::get<2>(group.back()) - group_begin);
+    MSRStatus ret = ReadAheadSpan(thread_id, shard_id, group_begin, &span);
+
+    {
+      std::lock_guard<std::mutex> lck(mtx_read_ahead_);
+      // The rows of a previous epoch are dropped, the budget is already given back
+      if (epoch == read_ahead_epoch_) {
+        for (const auto &row : group) {
+          auto task_id = std::get<0>(row);
+          auto length = std::get<2>(row);
+          (void)read_ahead_in_flight_.erase(task_id);
+          if (ret != SUCCESS) {
+            // The consumer reads it itself
+            read_ahead_bytes_ -= length;
+            continue;
+          }
+          std::vector<uint8_t> blob;
+          if (!use_mmap_) {
+            auto begin = span.begin() + (std::get<1>(row) - group_begin);
+            blob.assign(begin, begin + length);
+          }
+          read_ahead_rows_[task_id] = std::make_pair(length, std::move(blob));
+        }
+      }
+    }
+    cv_read_ahead_done_.notify_all();
+  }
+}
+
+bool ShardReader::TakeReadAhead(int task_id, std::vector<uint8_t> *blob) {
+  if (n_read_ahead_ == 0) {
+    return false;
+  }
+  bool taken = false;
+  {
+    std::unique_lock<std::mutex> lck(mtx_read_ahead_);
+    cv_read_ahead_done_.wait(lck, [this, task_id] { return interrupt_ || read_ahead_in_flight_.count(task_id) == 0; });
+    auto it = read_ahead_rows_.find(task_id);
+    if (it != read_ahead_rows_.end()) {
+      read_ahead_bytes_ -= it->second.first;
+      if (!use_mmap_ && blob != nullptr) {
+        *blob = std::move(it->second.second);
+        taken = true;
+      }
+      (void)read_ahead_rows_.erase(it);
+    } else if (task_id >= read_ahead_id_) {
+      // The consumer is ahead of the read ahead, which skips the row when it gets to it
+      (void)read_ahead_skipped_.insert(task_id);
+    }
+  }
+  cv_read_ahead_.notify_all();
+  return taken;
 }
 
 }  // namespace mindrecord
@@ -37,12 +37,16 @@ std::pair<MSRStatus, vector<std::string>> ShardSegment::GetCategoryFields() {
   std::string sql = "PRAGMA table_info(INDEXES);";
   std::vector<std::vector<std::string>> field_names;
 
+  auto db = GetDatabase(0);
+  if (db == nullptr) {
+    return {FAILED, vector<std::string>{}};
+  }
   char *errmsg = nullptr;
-  int rc = sqlite3_exec(database_paths_[0], common::SafeCStr(sql), SelectCallback, &field_names, &errmsg);
+  int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &field_names, &errmsg);
   if (rc != SQLITE_OK) {
     MS_LOG(ERROR) << "Error in select statement, sql: " << sql << ", error: " << errmsg;
     sqlite3_free(errmsg);
-    sqlite3_close(database_paths_[0]);
+    sqlite3_close(db);
     return {FAILED, vector<std::string>{}};
   } else {
     MS_LOG(INFO) << "Get " << static_cast<int>(field_names.size()) << " records from index.";
@@ -52,7 +56,7 @@ std::pair<MSRStatus, vector<std::string>> ShardSegment::GetCategoryFields() {
   while (idx < field_names.size()) {
     if (field_names[idx].size() < 2) {
       sqlite3_free(errmsg);
-      sqlite3_close(database_paths_[0]);
+      sqlite3_close(db);
       return {FAILED, vector<std::string>{}};
     }
     candidate_category_fields_.push_back(field_names[idx][1]);
@@ -98,7 +102,11 @@ std::pair<MSRStatus, std::vector<std::tuple<int, std::string, int>>> ShardSegmen
   std::string sql = "SELECT " + current_category_field_ + ", COUNT(" + current_category_field_ +
                     ") AS `value_occurrence` FROM indexes GROUP BY " + current_category_field_ + ";";
 
-  for (auto &db : database_paths_) {
+  for (int shard_id = 0; shard_id < static_cast<int>(database_paths_.size()); ++shard_id) {
+    auto db = GetDatabase(shard_id);
+    if (db == nullptr) {
+      return {FAILED, std::vector<std::tuple<int, std::string, int>>()};
+    }
     std::vector<std::vector<std::string>> field_count;
 
     char *errmsg = nullptr;
@@ -225,6 +233,9 @@ std::pair<MSRStatus, std::vector<uint8_t>> ShardSegment::PackImages(int group_id
     file_streams_random_[0][shard_id]->close();
     return {FAILED, {}};
   }
+  if (DecompressBlob(blob_page->get_compression(), &images) != SUCCESS) {
+    return {FAILED, {}};
+  }
 
   return {SUCCESS, std::move(images)};
 }
@@ -17,6 +17,7 @@
 #include "mindrecord/include/shard_writer.h"
 #include "common/utils.h"
 #include "mindrecord/include/common/shard_utils.h"
+#include "mindrecord/include/shard_compression.h"
 #include "./securec.h"
 
 using mindspore::LogStream;
@@ -32,7 +33,9 @@ ShardWriter::ShardWriter()
       header_size_(kDefaultHeaderSize),
       page_size_(kDefaultPageSize),
       row_count_(0),
-      schema_count_(1) {}
+      schema_count_(1),
+      compression_(kCompressionNone),
+      raw_format_(kRawFormatMsgpack) {}
 
 ShardWriter::~ShardWriter() {
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; i--) {
@@ -113,6 +116,10 @@ MSRStatus ShardWriter::OpenForAppend(const std::string &path) {
   if (ret == FAILED) {
     return FAILED;
   }
+  // The appended blob pages keep the codec of the file
+  compression_ = shard_header_->get_compression();
+  raw_format_ = shard_header_->get_raw_format();
+  InitRawCodecs();
   ret = Open(paths, true);
   if (ret == FAILED) {
     MS_LOG(ERROR) << "Open file failed";
@@ -166,9 +173,48 @@ MSRStatus ShardWriter::SetShardHeader(std::shared_ptr<ShardHeader> header_data)
   shard_header_ = header_data;
   shard_header_->set_header_size(header_size_);
   shard_header_->set_page_size(page_size_);
+  shard_header_->set_compression(compression_);
+  shard_header_->set_raw_format(raw_format_);
+  InitRawCodecs();
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::set_compression(const std::string &compression) {
+  if (!ShardCompression::IsSupported(compression)) {
+    MS_LOG(ERROR) << "Compression is not supported: " << compression;
+    return FAILED;
+  }
+  if (shard_header_ != nullptr && shard_header_->get_compression() != compression) {
+    MS_LOG(ERROR) << "Compression should be set before the header, it is " << shard_header_->get_compression();
+    return FAILED;
+  }
+  compression_ = compression;
+  return SUCCESS;
+}
+
+MSRStatus ShardWriter::set_raw_format(const std::string &raw_format) {
+  if (!ShardRawCodec::IsSupported(raw_format)) {
+    MS_LOG(ERROR) << "Raw format is not supported: " << raw_format;
+    return FAILED;
+  }
+  if (shard_header_ != nullptr && shard_header_->get_raw_format() != raw_format) {
+    MS_LOG(ERROR) << "Raw format should be set before the header, it is " << shard_header_->get_raw_format();
+    return FAILED;
+  }
+  raw_format_ = raw_format;
+  return SUCCESS;
+}
+
+void ShardWriter::InitRawCodecs() {
+  raw_codecs_.clear();
+  if (raw_format_ != kRawFormatBinary) {
+    return;
+  }
+  for (const auto &schema : shard_header_->get_schemas()) {
+    raw_codecs_[schema->get_schema_id()] = std::make_shared<ShardRawCodec>(schema);
+  }
+}
+
 MSRStatus ShardWriter::set_header_size(const uint64_t &header_size) {
   // header_size [16KB, 128MB]
   if (header_size < kMinHeaderSize || header_size > kMaxHeaderSize) {
@@ -413,7 +459,7 @@ std::tuple<MSRStatus, int, int> ShardWriter::ValidateRawData(std::map<uint64_t,
 }
 
 void ShardWriter::FillArray(int start, int end, std::map<uint64_t, vector<json>> &raw_data,
-                            std::vector<std::vector<uint8_t>> &bin_data) {
+                            std::vector<std::vector<uint8_t>> &bin_data, bool encode_raw) {
   // Prevent excessive thread opening and cause cross-border
   if (start >= end) {
     flag_ = true;
@@ -425,10 +471,15 @@ void ShardWriter::FillArray(int start, int end, std::map<uint64_t, vector<json>>
     int cnt = 0;
     for (rawdata_iter = raw_data.begin(); rawdata_iter != raw_data.end(); ++rawdata_iter) {
       const json &line = raw_data.at(rawdata_iter->first)[x];
-      std::vector<std::uint8_t> bline = json::to_msgpack(line);
 
       // Storage form is [Sample1-Schema1, Sample1-Schema2, Sample2-Schema1, Sample2-Schema2]
-      bin_data[x * schema_count + cnt] = bline;
+      auto &bline = bin_data[x * schema_count + cnt];
+      if (!encode_raw) {
+        bline = json::to_msgpack(line);
+      } else if (raw_codecs_.at(rawdata_iter->first)->Encode(line, &bline) != SUCCESS) {
+        flag_ = true;
+        return;
+      }
       cnt++;
     }
   }
@@ -471,7 +522,7 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_d
   std::vector<std::vector<uint8_t>> bin_raw_data(row_count * schema_count);
 
   // Serialize raw data
-  if (SerializeRawData(raw_data, bin_raw_data, row_count) == FAILED) {
+  if (SerializeRawData(raw_data, bin_raw_data, row_count, raw_format_ == kRawFormatBinary) == FAILED) {
     MS_LOG(ERROR) << "Serialize raw data failed";
     return FAILED;
   }
@@ -482,14 +533,25 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_d
     return FAILED;
   }
 
+  // Compress blob data, the pages are cut by the size of the compressed rows
+  std::vector<std::vector<uint8_t>> compressed_blob_data;
+  if (compression_ != kCompressionNone) {
+    compressed_blob_data.resize(blob_data.size());
+    if (CompressBlobData(blob_data, compressed_blob_data) == FAILED) {
+      MS_LOG(ERROR) << "Compress blob data failed";
+      return FAILED;
+    }
+  }
+  const auto &stored_blob_data = compression_ != kCompressionNone ? compressed_blob_data : blob_data;
+
   // Set row size of blob data
-  if (SetBlobDataSize(blob_data) == FAILED) {
+  if (SetBlobDataSize(stored_blob_data) == FAILED) {
     MS_LOG(ERROR) << "Set blob data size failed";
     return FAILED;
   }
 
   // Write data to disk with multi threads
-  if (ParallelWriteData(blob_data, bin_raw_data) == FAILED) {
+  if (ParallelWriteData(stored_blob_data, bin_raw_data) == FAILED) {
     MS_LOG(ERROR) << "Parallel write data failed";
     return FAILED;
   }
@@ -718,6 +780,7 @@ MSRStatus ShardWriter::NewBlobPage(const int &shard_id, const std::vector<std::v
     auto start_row = current_row;
     auto end_row = start_row + blob_row.second - blob_row.first;
     auto page = Page(++page_id, shard_id, kPageTypeBlob, ++page_type_id, start_row, end_row, row_group_ids, page_size);
+    page.set_compression(compression_);
     (void)shard_header_->AddPage(std::make_shared<Page>(page));
     current_row = end_row;
   }
@@ -982,7 +1045,8 @@ MSRStatus ShardWriter::WriteShardHeader() {
 }
 
 MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
-                                        std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count) {
+                                        std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count,
+                                        bool encode_raw) {
   // define the number of thread
   uint32_t thread_num = std::thread::hardware_concurrency();
   if (thread_num == 0) thread_num = kThreadNumber;
@@ -997,8 +1061,8 @@ MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &r
       continue;
     }
     // Define the run boundary and start the child thread
-    thread_set[x] =
-      std::thread(&ShardWriter::FillArray, this, start_num, end_num, std::ref(raw_data), std::ref(bin_data));
+    thread_set[x] = std::thread(&ShardWriter::FillArray, this, start_num, end_num, std::ref(raw_data),
+                                std::ref(bin_data), encode_raw);
     work_thread_num++;
   }
   for (uint32_t x = 0; x < work_thread_num; ++x) {
@@ -1008,6 +1072,40 @@ MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &r
   return flag_ == true ? FAILED : SUCCESS;
 }
 
+void ShardWriter::CompressArray(int start, int end, const std::vector<std::vector<uint8_t>> &blob_data,
+                                std::vector<std::vector<uint8_t>> &compressed_data) {
+  for (int x = start; x < end; ++x) {
+    if (ShardCompression::Compress(compression_, blob_data[x], &compressed_data[x]) != SUCCESS) {
+      flag_ = true;
+      return;
+    }
+  }
+}
+
+MSRStatus ShardWriter::CompressBlobData(const std::vector<std::vector<uint8_t>> &blob_data,
+                                        std::vector<std::vector<uint8_t>> &compressed_data) {
+  // define the number of thread
+  uint32_t thread_num = std::thread::hardware_concurrency();
+  if (thread_num == 0) thread_num = kThreadNumber;
+  // Set the number of rows processed by each thread
+  uint32_t row_count = blob_data.size();
+  int group_num = ceil(row_count * 1.0 / thread_num);
+  std::vector<std::thread> thread_set;
+  for (uint32_t x = 0; x < thread_num; ++x) {
+    int start_num = x * group_num;
+    int end_num = ((x + 1) * group_num > row_count) ? row_count : (x + 1) * group_num;
+    if (start_num >= end_num) {
+      continue;
+    }
+    thread_set.emplace_back(&ShardWriter::CompressArray, this, start_num, end_num, std::ref(blob_data),
+                            std::ref(compressed_data));
+  }
+  for (auto &thread : thread_set) {
+    thread.join();
+  }
+  return flag_ == true ? FAILED : SUCCESS;
+}
+
 MSRStatus ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data) {
   raw_data_size_ = std::vector<uint64_t>(row_count_, 0);
   for (uint32_t i = 0; i < row_count_; ++i) {
@@ -23,8 +23,10 @@
 #include <vector>
 
 #include "common/utils.h"
+#include "mindrecord/include/shard_compression.h"
 #include "mindrecord/include/shard_error.h"
 #include "mindrecord/include/shard_page.h"
+#include "mindrecord/include/shard_raw_codec.h"
 
 using mindspore::LogStream;
 using mindspore::ExceptionType::NoExceptionType;
@@ -33,7 +35,10 @@ using mindspore::MsLogLevel::ERROR;
 namespace mindspore {
 namespace mindrecord {
 std::atomic<bool> thread_status(false);
-ShardHeader::ShardHeader() : shard_count_(0), header_size_(0), page_size_(0) { index_ = std::make_shared<Index>(); }
+ShardHeader::ShardHeader()
+    : shard_count_(0), header_size_(0), page_size_(0), compression_(kCompressionNone), raw_format_(kRawFormatMsgpack) {
+  index_ = std::make_shared<Index>();
+}
 
 MSRStatus ShardHeader::InitializeHeader(const std::vector<json> &headers) {
   shard_count_ = headers.size();
@@ -53,8 +58,26 @@ MSRStatus ShardHeader::InitializeHeader(const std::vector<json> &headers) {
       ParseShardAddress(header["shard_addresses"]);
       header_size_ = header["header_size"].get<uint64_t>();
       page_size_ = header["page_size"].get<uint64_t>();
+      // Files written before the blob pages could be compressed have no codec
+      if (header.find("compression") != header.end()) {
+        compression_ = header["compression"].get<std::string>();
+        if (!ShardCompression::IsSupported(compression_)) {
+          MS_LOG(ERROR) << "Compression is not supported: " << compression_;
+          return FAILED;
+        }
+      }
+      // Files written before the raw rows could be binary have msgpack rows
+      if (header.find("raw_format") != header.end()) {
+        raw_format_ = header["raw_format"].get<std::string>();
+        if (!ShardRawCodec::IsSupported(raw_format_)) {
+          MS_LOG(ERROR) << "Raw format is not supported: " << raw_format_;
+          return FAILED;
+        }
+      }
+    }
+    if (ParsePage(header["page"]) != SUCCESS) {
+      return FAILED;
     }
-    ParsePage(header["page"]);
   }
   return SUCCESS;
 }
@@ -200,7 +223,8 @@ void ShardHeader::GetHeadersOneTask(int start, int end, std::vector<json> &heade
     json header;
     header = ret.second;
     header["shard_addresses"] = realAddresses;
-    if (header["version"] != version_) {
+    if (header["version"] != version_ && header["version"] != compressed_version_ &&
+        header["version"] != binary_raw_version_) {
       MS_LOG(ERROR) << "Version wrong, file version is: " << header["version"].dump()
                     << ", lib version is: " << version_;
       thread_status = true;
@@ -247,7 +271,7 @@ MSRStatus ShardHeader::ParseIndexFields(const json &index_fields) {
   return SUCCESS;
 }
 
-void ShardHeader::ParsePage(const json &pages) {
+MSRStatus ShardHeader::ParsePage(const json &pages) {
   if (pages_.empty() && shard_count_ <= kMaxShardCount) {
     pages_.resize(shard_count_);
   }
@@ -267,8 +291,17 @@ void ShardHeader::ParsePage(const json &pages) {
 
     std::shared_ptr<Page> parsed_page = std::make_shared<Page>(page_id, shard_id, page_type, page_type_id, start_row_id,
                                                                end_row_id, row_group_ids, page_size);
+    if (page.find("compression") != page.end()) {
+      auto compression = page["compression"].get<std::string>();
+      if (!ShardCompression::IsSupported(compression)) {
+        MS_LOG(ERROR) << "Compression of page " << page_id << " is not supported: " << compression;
+        return FAILED;
+      }
+      parsed_page->set_compression(compression);
+    }
     pages_[shard_id].push_back(std::move(parsed_page));
   }
+  return SUCCESS;
 }
 
 MSRStatus ShardHeader::ParseStatistics(const json &statistics) {
@@ -325,15 +358,22 @@ std::vector<std::string> ShardHeader::SerializeHeader() {
   if (shard_count_ <= kMaxShardCount) {
     for (int shardId = 0; shardId < shard_count_; shardId++) {
       string s;
-      s += "{\"header_size\":" + std::to_string(header_size_) + ",";
+      s += "{";
+      if (compression_ != kCompressionNone) {
+        s += "\"compression\":\"" + compression_ + "\",";
+      }
+      s += "\"header_size\":" + std::to_string(header_size_) + ",";
       s += "\"index_fields\":" + index + ",";
       s += "\"page\":" + pages[shardId] + ",";
       s += "\"page_size\":" + std::to_string(page_size_) + ",";
+      if (raw_format_ != kRawFormatMsgpack) {
+        s += "\"raw_format\":\"" + raw_format_ + "\",";
+      }
       s += "\"schema\":" + schema + ",";
       s += "\"shard_addresses\":" + address + ",";
       s += "\"shard_id\":" + std::to_string(shardId) + ",";
       s += "\"statistics\":" + stats + ",";
-      s += "\"version\":\"" + version_ + "\"";
+      s += "\"version\":\"" + get_version() + "\"";
       s += "}";
       header.emplace_back(s);
     }
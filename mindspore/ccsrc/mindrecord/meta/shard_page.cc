@@ -41,6 +41,9 @@ json Page::GetPage() const {
     }
   }
   str_page["page_size"] = page_size_;
+  if (compression_ != kCompressionNone) {
+    str_page["compression"] = compression_;
+  }
   return str_page;
 }
 
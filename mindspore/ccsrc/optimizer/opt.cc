@@ -34,7 +34,9 @@ namespace opt {
 SubstitutionPtr MakeSubstitution(const TransformFuncType& transform, const std::string& name,
                                  const PrimitivePtr& prim) {
   auto fn = [prim](const AnfNodePtr& node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn);
+  substitution->primitives_ = {prim};
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const TransformFuncType& transform, const std::string& name,
@@ -52,7 +54,9 @@ SubstitutionPtr MakeSubstitution(const TransformFuncType& transform, const std::
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn);
+  substitution->primitives_ = prims;
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const TransformFuncType& transform, const std::string& name,
@@ -142,6 +146,70 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr& optimizer, const AnfNo
   return changes;
 }
 
+bool SubstitutionList::ApplyIndexedTransform(const OptimizerPtr& optimizer, const SubstitutionPtr& transform) const {
+  FuncGraphManagerPtr manager = optimizer->manager();
+  auto& primitive_nodes = manager->primitive_nodes();
+  std::unordered_set<AnfNodePtr> seen_node;
+  std::deque<AnfNodePtr> todo;
+  bool changes = false;
+
+  // the index is updated by the replacements, the nodes made by the transforms are found the next round
+  auto collect_candidates = [&primitive_nodes, &seen_node, &todo, &transform]() {
+    for (auto& prim : transform->primitives_) {
+      auto iter = primitive_nodes.find(prim->name());
+      if (iter == primitive_nodes.end()) {
+        continue;
+      }
+      for (auto& node : iter->second) {
+        if (seen_node.find(node) == seen_node.end()) {
+          todo.push_back(node);
+        }
+      }
+    }
+  };
+
+  collect_candidates();
+  while (!todo.empty()) {
+    while (!todo.empty()) {
+      AnfNodePtr node = todo.front();
+      todo.pop_front();
+
+      if (seen_node.find(node) != seen_node.end() || !manager->all_nodes().contains(node)) {
+        continue;
+      }
+      (void)seen_node.insert(node);
+      if (!transform->predicate_(node)) {
+        continue;
+      }
+
+      auto ret = (*transform)(optimizer, node);
+      if (ret == nullptr || ret == node) {
+        continue;
+      }
+      changes = true;
+#ifdef ENABLE_PROFILE
+      double t = GetTime();
+#endif
+      (void)manager->Replace(node, ret);
+#ifdef ENABLE_PROFILE
+      MsProfile::StatTime("replace." + transform->name_, GetTime() - t);
+#endif
+
+      // the users may match now their input is replaced
+      auto& node_users = manager->node_users();
+      if (node_users.find(ret) != node_users.end()) {
+        for (auto& use : node_users[ret]) {
+          todo.push_back(use.first);
+          (void)seen_node.erase(use.first);
+        }
+      }
+    }
+    collect_candidates();
+  }
+
+  return changes;
+}
+
 bool SubstitutionList::operator()(const FuncGraphPtr& func_graph, const OptimizerPtr& optimizer) const {
   MS_EXCEPTION_IF_NULL(optimizer);
   MS_EXCEPTION_IF_NULL(func_graph);
@@ -150,11 +218,18 @@ bool SubstitutionList::operator()(const FuncGraphPtr& func_graph, const Optimize
 
   bool loop = false;
   bool changes = false;
+  // the index holds every managed node, it is the nodes reachable from func_graph if that is the only root
+  bool use_index = manager->roots().size() == 1 && manager->roots().contains(func_graph);
 
   do {
     loop = false;
     for (auto const& transform : list_) {
-      auto change = ApplyTransform(optimizer, func_graph->output(), transform);
+      bool change = false;
+      if (use_index && !transform->primitives_.empty()) {
+        change = ApplyIndexedTransform(optimizer, transform);
+      } else {
+        change = ApplyTransform(optimizer, func_graph->output(), transform);
+      }
       changes = changes || change;
       loop = loop || change;
     }
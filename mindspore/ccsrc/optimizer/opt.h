@@ -41,6 +41,8 @@ class Substitution {
   TransformFuncType transform_{nullptr};
   std::string name_;
   PredicateFuncType predicate_{nullptr};
+  // the primitives the predicate matches, empty if the predicate is not on primitives
+  std::vector<PrimitivePtr> primitives_;
   explicit Substitution(const TransformFuncType &transform, const std::string &name, const PredicateFuncType &predicate)
       : transform_(transform), name_(name), predicate_(predicate) {}
   ~Substitution() = default;
@@ -65,6 +67,8 @@ class SubstitutionList {
 
  private:
   bool ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &transform) const;
+  // visit only the cnodes of the primitives of the transform, found by the primitive index of the manager
+  bool ApplyIndexedTransform(const OptimizerPtr &optimizer, const SubstitutionPtr &transform) const;
   std::vector<SubstitutionPtr> list_;
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
@@ -0,0 +1,529 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/compile_cache.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <unordered_set>
+
+#include "common/utils.h"
+#include "debug/anf_ir_utils.h"
+#include "ir/meta_func_graph.h"
+#include "ir/meta_tensor.h"
+#include "operator/ops.h"
+#include "parallel/context.h"
+#include "pipeline/parse/data_converter.h"
+#include "pipeline/parse/resolve.h"
+#include "pybind_api/export_flags.h"
+#include "utils/context/ms_context.h"
+#include "utils/graph_utils.h"
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+// bump it when the content of an entry changes
+const int kCompileCacheVersion = 1;
+const char kGraphFile[] = "graph.dat";
+const char kMetaFile[] = "meta";
+
+// Fingerprint of the graphs reachable from the top graph, by the order of a walk from the top graph, so it does not
+// depend on the ids of the graphs and the nodes of one process.
+class GraphFingerprint {
+ public:
+  GraphFingerprint() = default;
+  ~GraphFingerprint() = default;
+
+  bool Run(const FuncGraphPtr& top, std::ostringstream* oss) {
+    oss_ = oss;
+    (void)GraphIndex(top);
+    for (size_t i = 0; i < graphs_.size() && ok_; ++i) {
+      Graph(graphs_[i]);
+    }
+    return ok_;
+  }
+
+ private:
+  size_t GraphIndex(const FuncGraphPtr& fg) {
+    auto iter = graph_index_.find(fg);
+    if (iter != graph_index_.end()) {
+      return iter->second;
+    }
+    size_t index = graphs_.size();
+    graph_index_[fg] = index;
+    graphs_.push_back(fg);
+    return index;
+  }
+
+  void Graph(const FuncGraphPtr& fg) {
+    *oss_ << "G" << graph_index_[fg] << "(";
+    for (auto& node : fg->parameters()) {
+      auto param = node->cast<ParameterPtr>();
+      MS_EXCEPTION_IF_NULL(param);
+      node_index_[node] = node_index_.size();
+      *oss_ << param->name() << (param->has_default() ? "=D," : ",");
+    }
+    *oss_ << ")\n";
+    auto nodes = TopoSort(fg->get_return(), SuccIncoming, [&fg](const AnfNodePtr& node) -> IncludeType {
+      return node->func_graph() == fg ? FOLLOW : EXCLUDE;
+    });
+    for (auto& node : nodes) {
+      auto cnode = node->cast<CNodePtr>();
+      if (cnode == nullptr) {
+        continue;
+      }
+      node_index_[node] = node_index_.size();
+      *oss_ << "%" << node_index_[node] << "=";
+      for (auto& input : cnode->inputs()) {
+        Input(input);
+        *oss_ << ",";
+      }
+      *oss_ << "\n";
+    }
+  }
+
+  void Input(const AnfNodePtr& node) {
+    auto iter = node_index_.find(node);
+    if (iter != node_index_.end()) {
+      *oss_ << "%" << iter->second;
+    } else if (node->isa<ValueNode>()) {
+      Value(GetValueNode(node));
+    } else {
+      // a free variable of a graph not walked yet
+      MS_LOG(DEBUG) << "Can not fingerprint the node " << node->DebugString();
+      ok_ = false;
+    }
+  }
+
+  void Value(const ValuePtr& value) {
+    if (value == nullptr) {
+      *oss_ << "null";
+    } else if (value->isa<FuncGraph>()) {
+      *oss_ << "@G" << GraphIndex(value->cast<FuncGraphPtr>());
+    } else if (value->isa<Primitive>()) {
+      auto prim = value->cast<PrimitivePtr>();
+      *oss_ << prim->type_name() << "::" << prim->name() << prim->GetAttrsText();
+      if (prim->isa<prim::DoSignaturePrimitive>()) {
+        Value(prim->cast<prim::DoSignaturePrimitivePtr>()->function());
+      }
+    } else if (value->isa<tensor::Tensor>()) {
+      auto tensor = value->cast<tensor::TensorPtr>();
+      py::array data = tensor->data();
+      std::string bytes(static_cast<const char*>(tensor->data_c()), data.nbytes());
+      *oss_ << tensor->DumpText() << "#" << std::hash<std::string>()(bytes);
+    } else if (value->isa<ValueSequeue>()) {
+      *oss_ << value->type_name() << "(";
+      for (auto& elem : value->cast<ValueSequeuePtr>()->value()) {
+        Value(elem);
+        *oss_ << ",";
+      }
+      *oss_ << ")";
+    } else if (value->isa<ValueDictionary>()) {
+      *oss_ << "{";
+      for (auto& elem : value->cast<ValueDictionaryPtr>()->value()) {
+        *oss_ << elem.first << ":";
+        Value(elem.second);
+        *oss_ << ",";
+      }
+      *oss_ << "}";
+    } else if (value->isa<parse::NameSpace>() || value->isa<parse::PyObjectWrapper>()) {
+      // the python object behind it may change without changing the graph
+      MS_LOG(DEBUG) << "Can not fingerprint the value " << value->ToString();
+      ok_ = false;
+    } else {
+      *oss_ << value->type_name() << "[" << value->ToString() << "]";
+    }
+  }
+
+  std::ostringstream* oss_ = nullptr;
+  bool ok_ = true;
+  std::vector<FuncGraphPtr> graphs_;
+  std::unordered_map<FuncGraphPtr, size_t> graph_index_;
+  std::unordered_map<AnfNodePtr, size_t> node_index_;
+};
+
+std::string GetTypeText(const TypePtr& type) {
+  static const std::unordered_map<int, std::string> type_text = {
+    {kNumberTypeBool, "Bool"},   {kNumberTypeInt8, "I8"},     {kNumberTypeInt16, "I16"},   {kNumberTypeInt32, "I32"},
+    {kNumberTypeInt64, "I64"},   {kNumberTypeUInt8, "U8"},    {kNumberTypeUInt16, "U16"},  {kNumberTypeUInt32, "U32"},
+    {kNumberTypeUInt64, "U64"},  {kNumberTypeFloat16, "F16"}, {kNumberTypeFloat32, "F32"}, {kNumberTypeFloat64, "F64"},
+  };
+  if (type == nullptr) {
+    return "";
+  }
+  auto iter = type_text.find(static_cast<int>(type->type_id()));
+  return iter == type_text.end() ? "" : iter->second;
+}
+
+// Exporter writing the abstracts of the nodes in the syntax of the IR parser, so they are reloaded with the graph.
+class CompileCacheExporter : public AnfExporter {
+ public:
+  CompileCacheExporter() : AnfExporter("cache", true, true) {}
+  ~CompileCacheExporter() override = default;
+
+ protected:
+  std::string GetNodeType(const AnfNodePtr& nd) override {
+    std::string text = GetAbstractText(nd->abstract());
+    return text.empty() ? "Undefined" : text;
+  }
+
+ private:
+  std::string GetAbstractText(const AbstractBasePtr& abs) {
+    if (abs == nullptr) {
+      return "";
+    }
+    std::ostringstream oss;
+    if (abs->isa<abstract::AbstractTensor>()) {
+      auto element = abs->cast<abstract::AbstractTensorPtr>()->element();
+      auto shape = dyn_cast<abstract::Shape>(abs->BuildShape());
+      std::string elem_text = element == nullptr ? "" : GetTypeText(element->BuildType());
+      if (elem_text.empty() || shape == nullptr) {
+        return "";
+      }
+      oss << "Array(" << elem_text << ")[";
+      for (size_t i = 0; i < shape->shape().size(); ++i) {
+        oss << (i == 0 ? "" : ", ") << shape->shape()[i];
+      }
+      oss << "]";
+    } else if (abs->isa<abstract::AbstractScalar>()) {
+      return GetTypeText(abs->BuildType());
+    } else if (abs->isa<abstract::AbstractNone>()) {
+      oss << "NoneType";
+    } else if (abs->isa<abstract::AbstractTuple>() || abs->isa<abstract::AbstractList>()) {
+      oss << (abs->isa<abstract::AbstractTuple>() ? "Tuple[" : "List[");
+      auto& elements = abs->cast<abstract::AbstractSequeuePtr>()->elements();
+      for (size_t i = 0; i < elements.size(); ++i) {
+        std::string elem_text = GetAbstractText(elements[i]);
+        if (elem_text.empty()) {
+          return "";
+        }
+        oss << (i == 0 ? "" : ", ") << elem_text;
+      }
+      oss << "]";
+    } else {
+      return "";
+    }
+    return oss.str();
+  }
+};
+
+bool SameAbstract(const AbstractBasePtr& abs1, const AbstractBasePtr& abs2) {
+  if (abs1 == nullptr || abs2 == nullptr) {
+    return false;
+  }
+  return abs1->BuildType()->ToString() == abs2->BuildType()->ToString() &&
+         abs1->BuildShape()->ToString() == abs2->BuildShape()->ToString();
+}
+
+void RemoveDir(const std::string& dir) {
+  DIR* dp = opendir(common::SafeCStr(dir));
+  if (dp == nullptr) {
+    return;
+  }
+  struct dirent* entry = nullptr;
+  while ((entry = readdir(dp)) != nullptr) {
+    std::string name = entry->d_name;
+    if (name != "." && name != "..") {
+      (void)std::remove(common::SafeCStr(dir + "/" + name));
+    }
+  }
+  (void)closedir(dp);
+  (void)rmdir(common::SafeCStr(dir));
+}
+
+// The python objects of an entry are unpickled when it is loaded, so only the directories no other user may have
+// written are trusted: owned by the user and not writable by the group or the others, as are the files in them.
+bool IsPrivatePath(const std::string& path) {
+  struct stat st;
+  if (lstat(common::SafeCStr(path), &st) != 0 || st.st_uid != geteuid() || (st.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+    return false;
+  }
+  return S_ISDIR(st.st_mode) || S_ISREG(st.st_mode);
+}
+
+bool IsPrivateDir(const std::string& dir) {
+  if (!IsPrivatePath(dir)) {
+    return false;
+  }
+  DIR* dp = opendir(common::SafeCStr(dir));
+  if (dp == nullptr) {
+    return false;
+  }
+  bool ok = true;
+  struct dirent* entry = nullptr;
+  while (ok && (entry = readdir(dp)) != nullptr) {
+    std::string name = entry->d_name;
+    if (name != "." && name != "..") {
+      ok = IsPrivatePath(dir + "/" + name);
+    }
+  }
+  (void)closedir(dp);
+  return ok;
+}
+
+std::string GetPackageVersion() {
+  try {
+    return py::str(py::module::import("mindspore").attr("__version__"));
+  } catch (const std::exception&) {
+    return "";
+  }
+}
+}  // namespace
+
+CompileCachePtr CompileCache::Create(const std::vector<ActionItem>& actions) {
+  std::string path = common::GetEnv("MS_COMPILE_CACHE_PATH");
+  if (path.empty()) {
+    return nullptr;
+  }
+  // the graph loaded from 'MS_IR_FILE' is not the parsed one
+  if (getenv("MS_IR_FILE") != nullptr) {
+    return nullptr;
+  }
+  // only the vm pipeline, the ge pipeline converts the graph to a ge graph
+  auto is_task_emit = [](const ActionItem& action) { return action.first == "task_emit"; };
+  if (std::none_of(actions.begin(), actions.end(), is_task_emit)) {
+    return nullptr;
+  }
+  // the parallel pipeline keeps the parameter layout graph besides the compiled one
+  if (parallel::ParallelContext::GetInstance()->parallel_mode() != parallel::STAND_ALONE) {
+    return nullptr;
+  }
+  (void)mkdir(common::SafeCStr(path), S_IRWXU);
+  char real_path[PATH_MAX] = {0};
+  if (path.size() > PATH_MAX || realpath(common::SafeCStr(path), real_path) == nullptr) {
+    MS_LOG(WARNING) << "Compile cache path error, " << path;
+    return nullptr;
+  }
+  if (!IsPrivatePath(real_path)) {
+    MS_LOG(WARNING) << "Compile cache path " << real_path
+                    << " is not owned by the user or is writable by other users, the cache is disabled.";
+    return nullptr;
+  }
+  return std::make_shared<CompileCache>(real_path);
+}
+
+bool CompileCache::Fingerprint(const ResourcePtr& res, const std::vector<ActionItem>& actions) {
+  MS_EXCEPTION_IF_NULL(res);
+  FuncGraphPtr func_graph = res->func_graph();
+  if (func_graph == nullptr) {
+    return false;
+  }
+  std::ostringstream oss;
+  oss << "version:" << kCompileCacheVersion << "," << GetPackageVersion() << "\n";
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  oss << "context:" << context->device_target() << "," << context->execution_mode() << ","
+      << context->backend_policy() << "," << context->auto_mixed_precision_flag() << ","
+      << context->enable_reduce_precision() << "\n";
+  oss << "actions:";
+  for (auto& action : actions) {
+    oss << action.first << ",";
+  }
+  oss << "\nargs:";
+  for (auto& arg : res->args_spec()) {
+    oss << arg->ToString() << ",";
+  }
+  oss << "\nweights:";
+  parameters_.clear();
+  for (auto& node : func_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    parameters_[param->name()] = param;
+    if (param->has_default()) {
+      auto abs = abstract::FromValue(parse::data_converter::PyDataToValue(param->default_param()), true);
+      oss << param->name() << ":" << abs->ToString() << ",";
+    }
+  }
+  oss << "\n";
+  if (!GraphFingerprint().Run(func_graph, &oss)) {
+    MS_LOG(INFO) << "The graph " << func_graph->ToString() << " can not be cached.";
+    return false;
+  }
+  fingerprint_ = oss.str();
+  std::ostringstream key;
+  key << std::hex << std::hash<std::string>()(fingerprint_);
+  key_ = key.str();
+  return true;
+}
+
+bool CompileCache::BindParameters(const FuncGraphPtr& func_graph, const std::vector<std::string>& names) const {
+  auto& params = func_graph->parameters();
+  if (params.size() != names.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < params.size(); ++i) {
+    auto param = params[i]->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    param->set_name(names[i]);
+    auto iter = parameters_.find(names[i]);
+    if (iter != parameters_.end() && iter->second->has_default()) {
+      param->set_default_param(iter->second->default_param());
+    }
+  }
+  return true;
+}
+
+bool CompileCache::Load(const ResourcePtr& res) {
+  MS_EXCEPTION_IF_NULL(res);
+  std::string dir = path_ + "/" + key_;
+  std::ifstream meta(dir + "/" + kMetaFile);
+  if (!meta.good()) {
+    MS_LOG(INFO) << "Compile cache miss, key " << key_;
+    return false;
+  }
+  size_t num_params = 0;
+  meta >> num_params;
+  std::vector<std::string> names(num_params);
+  std::string line;
+  (void)std::getline(meta, line);
+  for (auto& name : names) {
+    (void)std::getline(meta, name);
+  }
+  std::string fingerprint((std::istreambuf_iterator<char>(meta)), std::istreambuf_iterator<char>());
+  if (fingerprint != fingerprint_) {
+    MS_LOG(INFO) << "Compile cache entry " << dir << " is of another graph, ignore it.";
+    return false;
+  }
+
+  if (!IsPrivatePath(path_) || !IsPrivateDir(dir)) {
+    MS_LOG(WARNING) << "Compile cache entry " << dir
+                    << " is not owned by the user or is writable by other users, ignore it.";
+    return false;
+  }
+
+  std::vector<FuncGraphPtr> graphs;
+  try {
+    graphs = ImportIR(dir + "/" + kGraphFile, dir);
+  } catch (const std::exception& ex) {
+    MS_LOG(WARNING) << "Load compile cache entry " << dir << " failed: " << ex.what();
+    return false;
+  }
+  if (graphs.empty() || !BindParameters(graphs[0], names)) {
+    MS_LOG(WARNING) << "Compile cache entry " << dir << " is broken, ignore it.";
+    return false;
+  }
+  // the abstracts of the value nodes and of the returns are not in the file
+  for (auto& fg : graphs) {
+    for (auto& node : TopoSort(fg->get_return())) {
+      if (node->isa<ValueNode>() && node->abstract() == nullptr) {
+        node->set_abstract(GetValueNode(node)->ToAbstract());
+      }
+    }
+    fg->get_return()->set_abstract(fg->output()->abstract());
+  }
+
+  auto manager = res->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  manager->KeepRoots({graphs[0]});
+  res->set_func_graph(graphs[0]);
+  MS_LOG(INFO) << "Compile cache hit, load the graph from " << dir;
+  return true;
+}
+
+bool CompileCache::CheckReloaded(const FuncGraphPtr& func_graph, const std::string& dir) const {
+  auto graphs = ImportIR(dir + "/" + kGraphFile, dir);
+  if (graphs.empty()) {
+    return false;
+  }
+  FuncGraphPairMapEquiv equiv_graph;
+  NodeMapEquiv equiv_node;
+  if (!Isomorphic(func_graph, graphs[0], &equiv_graph, &equiv_node)) {
+    return false;
+  }
+  // the abstract of a return is the one of its input
+  return std::all_of(equiv_node.begin(), equiv_node.end(), [](const std::pair<const AnfNodePtr, AnfNodePtr>& nodes) {
+    return nodes.first->isa<ValueNode>() || IsPrimitiveCNode(nodes.first, prim::kPrimReturn) ||
+           SameAbstract(nodes.first->abstract(), nodes.second->abstract());
+  });
+}
+
+void CompileCache::Store(const ResourcePtr& res) {
+  MS_EXCEPTION_IF_NULL(res);
+  FuncGraphPtr func_graph = res->func_graph();
+  MS_EXCEPTION_IF_NULL(func_graph);
+  // the order of the side effects is not in the file
+  auto& used = func_graph->func_graphs_used_total();
+  auto has_effect = [](const FuncGraphPtr& fg) { return fg->has_flag(GRAPH_FLAG_HAS_EFFECT); };
+  if (has_effect(func_graph) || std::any_of(used.begin(), used.end(), has_effect)) {
+    MS_LOG(INFO) << "The graph " << func_graph->ToString() << " has side effects, it is not cached.";
+    return;
+  }
+  std::vector<std::string> names;
+  std::unordered_set<std::string> name_set;
+  for (auto& node : func_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    if (param->name().empty() || !name_set.insert(param->name()).second ||
+        (param->has_default() && parameters_.count(param->name()) == 0)) {
+      MS_LOG(INFO) << "The parameters of the graph " << func_graph->ToString() << " can not be bound by name.";
+      return;
+    }
+    names.push_back(param->name());
+  }
+
+  // Write aside and rename, a loader never reads an entry being written
+  std::string dir = path_ + "/" + key_;
+  std::string tmp_dir = dir + ".tmp" + std::to_string(getpid());
+  RemoveDir(tmp_dir);
+  if (mkdir(common::SafeCStr(tmp_dir), S_IRWXU) != 0) {
+    MS_LOG(WARNING) << "Create compile cache entry " << tmp_dir << " failed.";
+    return;
+  }
+  try {
+    CompileCacheExporter exporter;
+    exporter.set_object_path(tmp_dir);
+    exporter.set_dump_default_param(false);
+    exporter.ExportFuncGraph(tmp_dir + "/" + kGraphFile, func_graph);
+    if (!CheckReloaded(func_graph, tmp_dir)) {
+      MS_LOG(INFO) << "The graph " << func_graph->ToString() << " does not reload the same, it is not cached.";
+      RemoveDir(tmp_dir);
+      return;
+    }
+  } catch (const std::exception& ex) {
+    MS_LOG(INFO) << "The graph " << func_graph->ToString() << " can not be exported, it is not cached: " << ex.what();
+    RemoveDir(tmp_dir);
+    return;
+  }
+
+  std::ofstream meta(tmp_dir + "/" + kMetaFile);
+  meta << names.size() << "\n";
+  for (auto& name : names) {
+    meta << name << "\n";
+  }
+  meta << fingerprint_;
+  meta.close();
+  // the loader refuses the files other users may write, whatever the umask is
+  (void)chmod(common::SafeCStr(tmp_dir + "/" + kGraphFile), S_IRUSR | S_IWUSR);
+  (void)chmod(common::SafeCStr(tmp_dir + "/" + kMetaFile), S_IRUSR | S_IWUSR);
+  if (meta.fail() || rename(common::SafeCStr(tmp_dir), common::SafeCStr(dir)) != 0) {
+    // another process may have stored the same entry
+    MS_LOG(INFO) << "Store compile cache entry " << dir << " failed.";
+    RemoveDir(tmp_dir);
+    return;
+  }
+  MS_LOG(INFO) << "Store the graph " << func_graph->ToString() << " to compile cache " << dir;
+}
+}  // namespace pipeline
+}  // namespace mindspore
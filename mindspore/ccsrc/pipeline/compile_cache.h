@@ -0,0 +1,74 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_COMPILE_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_COMPILE_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ir/anf.h"
+#include "pipeline/action.h"
+#include "pipeline/resource.h"
+
+namespace mindspore {
+namespace pipeline {
+// the action after which the graph is fingerprinted, and the one from which a cached graph runs again
+const char kCompileCacheKeyAction[] = "symbol_resolve";
+const char kCompileCacheResumeAction[] = "validate";
+
+// A cache of the optimized graphs of the vm pipeline on local disk, enabled by env 'MS_COMPILE_CACHE_PATH'.
+//
+// The graph after symbol resolving is fingerprinted with the input abstracts and the context options. An entry is
+// the optimized graph in the reloadable IR format with its python objects, in a directory named by the hash of the
+// fingerprint. A hit skips the actions until validate. The weights are not stored, they are bound by name to the
+// parameters of the resolved graph. The kernels are cached by the kernel build in kernel_meta already.
+class CompileCache {
+ public:
+  explicit CompileCache(const std::string& path) : path_(path) {}
+  ~CompileCache() = default;
+
+  // return nullptr if the cache is not enabled or the pipeline can not use it
+  static std::shared_ptr<CompileCache> Create(const std::vector<ActionItem>& actions);
+
+  // fingerprint the resolved graph of the resource, false if the graph can not be cached
+  bool Fingerprint(const ResourcePtr& res, const std::vector<ActionItem>& actions);
+
+  // the key of the fingerprint, empty if the graph can not be cached
+  const std::string& key() const { return key_; }
+
+  // set the cached graph of the fingerprint to the resource, false on a miss
+  bool Load(const ResourcePtr& res);
+
+  // store the validated graph of the resource, a graph which does not reload the same is not stored
+  void Store(const ResourcePtr& res);
+
+ private:
+  bool BindParameters(const FuncGraphPtr& func_graph, const std::vector<std::string>& names) const;
+  bool CheckReloaded(const FuncGraphPtr& func_graph, const std::string& dir) const;
+
+  std::string path_;
+  std::string fingerprint_;
+  std::string key_;
+  // the parameters of the resolved graph, by name
+  std::unordered_map<std::string, ParameterPtr> parameters_;
+};
+using CompileCachePtr = std::shared_ptr<CompileCache>;
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_COMPILE_CACHE_H_
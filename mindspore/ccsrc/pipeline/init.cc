@@ -148,6 +148,10 @@ PYBIND11_MODULE(_c_expression, m) {
          "Get whether to enable dynamic mem pool.")
     .def("set_enable_dynamic_mem_pool", &mindspore::MsContext::set_enable_dynamic_mem_pool,
          "Set whether to enable dynamic mem pool.")
+    .def("get_cpu_inter_op_parallel_num", &mindspore::MsContext::cpu_inter_op_parallel_num,
+         "Get the number of kernels launched in parallel on CPU.")
+    .def("set_cpu_inter_op_parallel_num", &mindspore::MsContext::set_cpu_inter_op_parallel_num,
+         "Set the number of kernels launched in parallel on CPU.")
     .def("set_graph_memory_max_size", &mindspore::MsContext::set_graph_memory_max_size, "set graph memory max size.")
     .def("set_variable_memory_max_size", &mindspore::MsContext::set_variable_memory_max_size,
          "set variable memory max size");
@@ -25,6 +25,7 @@
 #include <algorithm>
 
 #include "pipeline/pass.h"
+#include "pipeline/compile_cache.h"
 #include "pipeline/parse/data_converter.h"
 #include "optimizer/ad/dfunctor.h"
 #include "debug/anf_ir_dump.h"
@@ -38,6 +39,7 @@
 #include "parallel/graph_util/get_parallel_info.h"
 #include "device/kernel_runtime_manager.h"
 #include "debug/trace.h"
+#include "pynative/pynative_execute.h"
 
 #if (ENABLE_GE || ENABLE_D)
 #include "pipeline/pipeline_ge.h"
@@ -488,10 +490,18 @@ void Pipeline::Run() {
   MS_LOG(INFO) << "Pipeline run";
   MS_EXCEPTION_IF_NULL(resource_);
   FuncGraphPtr user_graph = nullptr;
+  CompileCachePtr compile_cache = CompileCache::Create(actions_);
+  bool cache_hit = false;
 
-  WITH(MsProfile::GetProfile())[&user_graph, this]() {
+  WITH(MsProfile::GetProfile())[&user_graph, &compile_cache, &cache_hit, this]() {
     int i = 0;
     for (auto& action : actions_) {
+      if (cache_hit && action.first != kCompileCacheResumeAction) {
+        MS_LOG(DEBUG) << "Action " << action.first << " is skipped as the graph is loaded from compile cache.";
+        i++;
+        continue;
+      }
+      cache_hit = false;
 #ifdef ENABLE_TIMELINE
       DumpTime& dump_time = DumpTime::GetInstance();
       dump_time.Record(action.first, GetTime(), true);
@@ -509,6 +519,15 @@ void Pipeline::Run() {
       if (!result) {
         MS_LOG(EXCEPTION) << "Pipeline running to end, failed in step:" << action.first;
       }
+      if (compile_cache != nullptr && action.first == kCompileCacheKeyAction) {
+        cache_hit = compile_cache->Fingerprint(resource_, actions_) && compile_cache->Load(resource_);
+        // a graph which can not be fingerprinted is not stored, nor is the loaded one
+        if (cache_hit || compile_cache->key().empty()) {
+          compile_cache = nullptr;
+        }
+      } else if (compile_cache != nullptr && action.first == kCompileCacheResumeAction) {
+        compile_cache->Store(resource_);
+      }
       if (MsContext::GetInstance()->save_graphs_flag() && resource_->func_graph() != nullptr) {
         auto graph = resource_->func_graph();
         if (graph != nullptr) {
@@ -808,6 +827,7 @@ void FinalizeGe() {
 
 void ClearResAtexit() {
   MS_LOG(DEBUG) << "Pipeline clear all resource";
+  pynative::ClearPyNativeSession();
   device::KernelRuntimeManager::Instance().ClearRuntimeResource();
 
   ad::g_k_prims.clear();
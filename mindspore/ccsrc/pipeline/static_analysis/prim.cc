@@ -19,6 +19,7 @@
 #include "pipeline/static_analysis/prim.h"
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <mutex>
 #include <set>
@@ -39,6 +40,7 @@
 #include "pipeline/parse/data_converter.h"
 #include "pipeline/static_analysis/param_validator.h"
 #include "common/utils.h"
+#include "utils/context/ms_context.h"
 
 namespace mindspore {
 namespace abstract {
@@ -389,11 +391,88 @@ AbstractBasePtr PyInferRes2Abstract(const PrimitivePyPtr &prim_py, const py::dic
   }
   return res_spec;
 }
+
+// the infer results kept, the nodes of a few large networks
+const size_t kPyInferCacheSize = 4096;
 }  // end anonymous namespace
 
+PyInferCache &PyInferCache::GetInstance() {
+  static PyInferCache py_infer_cache(kPyInferCacheSize);
+  return py_infer_cache;
+}
+
+std::size_t PyInferCache::KeyHasher::operator()(const Key &key) const {
+  return hash_combine({std::hash<const Primitive *>()(key.prim), std::hash<std::string>()(key.attrs),
+                       AbstractBasePtrListHash(key.args)});
+}
+
+bool PyInferCache::KeyEqual::operator()(const Key &lhs, const Key &rhs) const {
+  return lhs.prim == rhs.prim && lhs.attrs == rhs.attrs && AbstractBasePtrListDeepEqual(lhs.args, rhs.args);
+}
+
+AbstractBasePtr PyInferCache::Get(const PrimitivePtr &prim, const std::string &attrs,
+                                  const AbstractBasePtrList &args) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = index_.find(Key{prim.get(), attrs, args});
+  if (iter == index_.end()) {
+    return nullptr;
+  }
+  auto entry = iter->second;
+  // the primitive of the entry is dead and another one is at its address
+  if (entry->prim.lock() != prim) {
+    (void)index_.erase(iter);
+    (void)entries_.erase(entry);
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, entry);
+  return entry->result->Clone();
+}
+
+void PyInferCache::Put(const PrimitivePtr &prim, const std::string &attrs, const AbstractBasePtrList &args,
+                       const AbstractBasePtr &result) {
+  if (capacity_ == 0) {
+    return;
+  }
+  AbstractBasePtrList args_key;
+  (void)std::transform(args.begin(), args.end(), std::back_inserter(args_key),
+                       [](const AbstractBasePtr &arg) -> AbstractBasePtr { return arg->Clone(); });
+  Key key{prim.get(), attrs, args_key};
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = index_.find(key);
+  if (iter != index_.end()) {
+    (void)entries_.erase(iter->second);
+    (void)index_.erase(iter);
+  }
+  entries_.push_front(Entry{key, prim, result->Clone()});
+  index_[key] = entries_.begin();
+  if (entries_.size() > capacity_) {
+    (void)index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+void PyInferCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  index_.clear();
+  entries_.clear();
+}
+
 AbstractBasePtr PythonPrimEvaluator::EvalPrim(const AnalysisEnginePtr &, const AbstractBasePtrList &args) {
   MS_LOG(DEBUG) << "Eval for:" << prim_py_->ToString();
 
+  // the eager ops of pynative create primitives and constants all the time, which would only fill the cache
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  bool use_cache = context->execution_mode() != kPynativeMode;
+  std::string attrs_text = prim_py_->GetAttrsText();
+  if (use_cache) {
+    auto res = PyInferCache::GetInstance().Get(prim_py_, attrs_text, args);
+    if (res != nullptr) {
+      MS_LOG(DEBUG) << "Python InferTensor result spec from cache: " << res->ToString() << ".";
+      return res;
+    }
+  }
+
   auto py_args = PreparePyInputs(prim_py_, args);
 
   auto pyobj = prim_py_->GetPyObj();
@@ -407,6 +486,10 @@ AbstractBasePtr PythonPrimEvaluator::EvalPrim(const AnalysisEnginePtr &, const A
   auto res_spec = PyInferRes2Abstract(prim_py_, output);
 
   MS_LOG(DEBUG) << "Python InferTensor result spec: " << res_spec->ToString() << ".";
+  // an infer which sets the attributes of the primitive is not cached, as a hit would not set them
+  if (use_cache && prim_py_->GetAttrsText() == attrs_text) {
+    PyInferCache::GetInstance().Put(prim_py_, attrs_text, args, res_spec);
+  }
   return res_spec;
 }
 
@@ -1032,6 +1115,7 @@ void ClearPrimEvaluatorMap() {
   PrimEvaluatorConstructors.clear();
   GetPrimitiveToEvalImplMap().clear();
   GetUniformPrimitiveToImplMap().clear();
+  PyInferCache::GetInstance().Clear();
 }
 
 bool IsInWhiteList(const PrimitivePtr primitive) {
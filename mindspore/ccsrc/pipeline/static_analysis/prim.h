@@ -20,7 +20,9 @@
 #define PIPELINE_STATIC_ANALYSIS_PRIM_H_
 
 #include <algorithm>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -72,6 +74,50 @@ class PythonPrimEvaluator : public TrivialPrimEvaluator {
   PrimitivePyPtr prim_py_;
 };
 
+// The infer results of the python primitives, by the primitive, the text of its attributes and the arguments. It
+// is kept across analyses, so the renormalize and the compiles of a network for other input shapes only call python
+// for the nodes whose arguments changed. It holds the last capacity results only, and the primitives weakly, so a
+// primitive is not kept alive by its results and a result is not returned for another primitive at its address.
+class PyInferCache {
+ public:
+  explicit PyInferCache(size_t capacity) : capacity_(capacity) {}
+  ~PyInferCache() = default;
+
+  static PyInferCache &GetInstance();
+
+  // return nullptr on a miss
+  AbstractBasePtr Get(const PrimitivePtr &prim, const std::string &attrs, const AbstractBasePtrList &args);
+  void Put(const PrimitivePtr &prim, const std::string &attrs, const AbstractBasePtrList &args,
+           const AbstractBasePtr &result);
+  size_t size() const { return entries_.size(); }
+  void Clear();
+
+ private:
+  struct Key {
+    const Primitive *prim;
+    std::string attrs;
+    AbstractBasePtrList args;
+  };
+  struct KeyHasher {
+    std::size_t operator()(const Key &key) const;
+  };
+  struct KeyEqual {
+    bool operator()(const Key &lhs, const Key &rhs) const;
+  };
+  struct Entry {
+    Key key;
+    std::weak_ptr<Primitive> prim;
+    AbstractBasePtr result;
+  };
+  using EntryList = std::list<Entry>;
+
+  size_t capacity_;
+  std::mutex mutex_;
+  // the most recently used first
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, KeyHasher, KeyEqual> index_;
+};
+
 class DoSignatureEvaluator : public Evaluator {
  public:
   explicit DoSignatureEvaluator(const PrimitivePtr primitive) : Evaluator("DoSignatureEvaluator"), prim_(primitive) {}
@@ -0,0 +1,350 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "predict/converter/graph_fusion.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include "./securec.h"
+#include "predict/converter/executor_tensor.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace executor {
+namespace {
+using predict::ActivationType;
+using predict::OpT;
+
+constexpr size_t kConvWeightIndex = 1;
+constexpr size_t kConvBiasIndex = 2;
+constexpr size_t kBatchNormInputNum = 5;
+
+OpT NodeType(const NodeDef *node) { return node->opDef->attr.type; }
+
+size_t ElementNum(const TensorDefT &tensor) {
+  size_t num = 1;
+  for (auto dim : tensor.dims) {
+    num *= static_cast<size_t>(std::max(dim, 0));
+  }
+  return num;
+}
+
+bool GetFloatData(const TensorDefT &tensor, size_t size, std::vector<float> *data) {
+  if (tensor.dataType != predict::DataType_DT_FLOAT || size == 0 || tensor.data.size() != size * sizeof(float)) {
+    return false;
+  }
+  data->resize(size);
+  return memcpy_s(data->data(), size * sizeof(float), tensor.data.data(), tensor.data.size()) == 0;
+}
+
+bool SetFloatData(const std::vector<float> &data, TensorDefT *tensor) {
+  tensor->data.resize(data.size() * sizeof(float));
+  return memcpy_s(tensor->data.data(), tensor->data.size(), data.data(), data.size() * sizeof(float)) == 0;
+}
+
+// the activations the runtime applies in the kernels of Conv2D and MatMul
+bool IsFusibleActivation(ActivationType type) {
+  return type == predict::ActivationType_RELU || type == predict::ActivationType_RELU6;
+}
+
+ActivationType GetActivationType(const NodeDef *node) {
+  if (NodeType(node) == predict::OpT_Conv2D) {
+    return node->opDef->attr.AsConv2D()->activationType;
+  }
+  return node->opDef->attr.AsMatMul()->activationType;
+}
+}  // namespace
+
+int GraphFusion::Run() {
+  MS_EXCEPTION_IF_NULL(sub_graph_);
+  users_.assign(sub_graph_->allTensors.size(), {});
+  graph_outputs_.assign(sub_graph_->allTensors.size(), false);
+  for (auto &node : sub_graph_->nodes) {
+    MS_EXCEPTION_IF_NULL(node->opDef);
+    for (auto idx : node->opDef->inputIndex) {
+      if (idx < users_.size()) {
+        users_[idx].push_back(node.get());
+      }
+    }
+  }
+  for (auto idx : sub_graph_->outputIndex) {
+    if (idx < graph_outputs_.size()) {
+      graph_outputs_[idx] = true;
+    }
+  }
+  fused_nodes_.clear();
+  for (auto &node : sub_graph_->nodes) {
+    auto type = NodeType(node.get());
+    if (type != predict::OpT_Conv2D && type != predict::OpT_MatMul) {
+      continue;
+    }
+    if (std::find(fused_nodes_.begin(), fused_nodes_.end(), node.get()) != fused_nodes_.end()) {
+      continue;
+    }
+    // fuse the chain after the node, as conv, batch norm, bias add, relu
+    while (node->opDef->outputIndex.size() == 1) {
+      auto next = SingleUser(node->opDef->outputIndex[0]);
+      if (next == nullptr || !Fuse(node.get(), next)) {
+        break;
+      }
+      MS_LOG(INFO) << "fuse node " << next->opDef->name << " into " << node->opDef->name;
+      node->opDef->outputIndex = {next->opDef->outputIndex[0]};
+      fused_nodes_.push_back(next);
+      for (auto idx : next->opDef->inputIndex) {
+        if (idx < users_.size()) {
+          auto &users = users_[idx];
+          (void)users.erase(std::remove(users.begin(), users.end(), next), users.end());
+        }
+      }
+    }
+  }
+  Compact();
+  return static_cast<int>(fused_nodes_.size());
+}
+
+NodeDef *GraphFusion::SingleUser(uint32_t tensor_idx) const {
+  if (tensor_idx >= users_.size() || graph_outputs_[tensor_idx] || users_[tensor_idx].size() != 1) {
+    return nullptr;
+  }
+  auto user = users_[tensor_idx].front();
+  if (user->opDef->inputIndex.empty() || user->opDef->inputIndex[0] != tensor_idx) {
+    return nullptr;
+  }
+  return user;
+}
+
+bool GraphFusion::IsOnlyUser(uint32_t tensor_idx, const NodeDef *node) const {
+  return tensor_idx < users_.size() && !graph_outputs_[tensor_idx] && users_[tensor_idx].size() == 1 &&
+         users_[tensor_idx].front() == node;
+}
+
+bool GraphFusion::Fuse(NodeDef *node, NodeDef *next) {
+  // the node after must have one output, the other outputs of a batch norm are checked when it is folded
+  if (next->opDef->outputIndex.empty()) {
+    return false;
+  }
+  if (GetActivationType(node) != predict::ActivationType_NO_ACTIVATION) {
+    return false;
+  }
+  switch (NodeType(next)) {
+    case predict::OpT_FusedBatchNorm:
+      return NodeType(node) == predict::OpT_Conv2D && FoldBatchNorm(node, next);
+    case predict::OpT_BiasAdd:
+      return FoldBiasAdd(node, next);
+    case predict::OpT_Activation:
+      return next->opDef->outputIndex.size() == 1 && FoldActivation(node, next);
+    default:
+      return false;
+  }
+}
+
+size_t GraphFusion::BiasSize(const NodeDef *node) const {
+  if (NodeType(node) == predict::OpT_Conv2D) {
+    return static_cast<size_t>(std::max(node->opDef->attr.AsConv2D()->channelOut, 0));
+  }
+  // the columns of the output of a matmul
+  auto output_idx = node->opDef->outputIndex[0];
+  if (output_idx >= sub_graph_->allTensors.size() || sub_graph_->allTensors[output_idx]->dims.empty()) {
+    return 0;
+  }
+  return static_cast<size_t>(std::max(sub_graph_->allTensors[output_idx]->dims.back(), 0));
+}
+
+bool GraphFusion::FoldBatchNorm(NodeDef *conv, NodeDef *batch_norm) {
+  auto attr = conv->opDef->attr.AsConv2D();
+  auto &inputs = conv->opDef->inputIndex;
+  auto &bn_inputs = batch_norm->opDef->inputIndex;
+  auto &tensors = sub_graph_->allTensors;
+  size_t channel = BiasSize(conv);
+  size_t input_num = attr->hasBias ? kConvBiasIndex + 1 : kConvBiasIndex;
+  if (bn_inputs.size() != kBatchNormInputNum || inputs.size() != input_num || channel == 0) {
+    return false;
+  }
+  // the outputs of the batch statistics are not used in an inference graph
+  for (size_t i = 1; i < batch_norm->opDef->outputIndex.size(); ++i) {
+    auto idx = batch_norm->opDef->outputIndex[i];
+    if (idx < users_.size() && (graph_outputs_[idx] || !users_[idx].empty())) {
+      return false;
+    }
+  }
+  // the weights of the conv are changed, no other node may use them
+  if (!IsOnlyUser(inputs[kConvWeightIndex], conv) || (attr->hasBias && !IsOnlyUser(inputs[kConvBiasIndex], conv))) {
+    return false;
+  }
+  // the weight is in [channelOut, channelIn / group, kernelH, kernelW]
+  auto &weight_dims = tensors[inputs[kConvWeightIndex]]->dims;
+  if (weight_dims.empty() || static_cast<size_t>(weight_dims[0]) != channel) {
+    return false;
+  }
+  std::vector<float> weight;
+  std::vector<float> bias(channel, 0.0f);
+  size_t weight_size = ElementNum(*tensors[inputs[kConvWeightIndex]]);
+  if (!GetFloatData(*tensors[inputs[kConvWeightIndex]], weight_size, &weight) ||
+      (attr->hasBias && !GetFloatData(*tensors[inputs[kConvBiasIndex]], channel, &bias))) {
+    return false;
+  }
+  // inputs of the batch norm: x, scale, offset, mean, variance
+  std::vector<std::vector<float>> params(kBatchNormInputNum - 1);
+  for (size_t i = 1; i < kBatchNormInputNum; ++i) {
+    if (bn_inputs[i] >= tensors.size() || !GetFloatData(*tensors[bn_inputs[i]], channel, &params[i - 1])) {
+      return false;
+    }
+  }
+  const auto &scale = params[0];
+  const auto &offset = params[1];
+  const auto &mean = params[2];
+  const auto &variance = params[3];
+  float epsilon = batch_norm->opDef->attr.AsFusedBatchNorm()->epsilon;
+  size_t kernel_size = weight_size / channel;
+  for (size_t c = 0; c < channel; ++c) {
+    float factor = scale[c] / std::sqrt(variance[c] + epsilon);
+    for (size_t i = 0; i < kernel_size; ++i) {
+      weight[c * kernel_size + i] *= factor;
+    }
+    bias[c] = (bias[c] - mean[c]) * factor + offset[c];
+  }
+  if (!SetFloatData(weight, tensors[inputs[kConvWeightIndex]].get())) {
+    return false;
+  }
+  if (attr->hasBias) {
+    return SetFloatData(bias, tensors[inputs[kConvBiasIndex]].get());
+  }
+  auto bias_idx = AddTensor(bias);
+  inputs.push_back(bias_idx);
+  users_[bias_idx].push_back(conv);
+  attr->hasBias = true;
+  return true;
+}
+
+bool GraphFusion::FoldBiasAdd(NodeDef *node, NodeDef *bias_add) {
+  auto &inputs = node->opDef->inputIndex;
+  auto &tensors = sub_graph_->allTensors;
+  size_t channel = BiasSize(node);
+  if (bias_add->opDef->inputIndex.size() != 2 || bias_add->opDef->outputIndex.size() != 1 || channel == 0) {
+    return false;
+  }
+  auto bias_idx = bias_add->opDef->inputIndex[1];
+  if (bias_idx >= tensors.size() || ElementNum(*tensors[bias_idx]) != channel) {
+    return false;
+  }
+  bool has_bias = NodeType(node) == predict::OpT_Conv2D ? node->opDef->attr.AsConv2D()->hasBias
+                                                         : node->opDef->attr.AsMatMul()->hasBias;
+  if (has_bias) {
+    // add the bias to the one of the node, which are both weights
+    auto node_bias_idx = inputs.back();
+    std::vector<float> node_bias;
+    std::vector<float> bias;
+    if (!IsOnlyUser(node_bias_idx, node) || !GetFloatData(*tensors[node_bias_idx], channel, &node_bias) ||
+        !GetFloatData(*tensors[bias_idx], channel, &bias)) {
+      return false;
+    }
+    for (size_t c = 0; c < channel; ++c) {
+      node_bias[c] += bias[c];
+    }
+    return SetFloatData(node_bias, tensors[node_bias_idx].get());
+  }
+  // the bias of the bias add becomes the bias of the node
+  if (tensors[bias_idx]->dataType != predict::DataType_DT_FLOAT) {
+    return false;
+  }
+  inputs.push_back(bias_idx);
+  users_[bias_idx].push_back(node);
+  if (NodeType(node) == predict::OpT_Conv2D) {
+    node->opDef->attr.AsConv2D()->hasBias = true;
+  } else {
+    node->opDef->attr.AsMatMul()->hasBias = true;
+  }
+  return true;
+}
+
+bool GraphFusion::FoldActivation(NodeDef *node, NodeDef *activation) {
+  auto type = activation->opDef->attr.AsActivation()->type;
+  if (!IsFusibleActivation(type)) {
+    return false;
+  }
+  if (NodeType(node) == predict::OpT_Conv2D) {
+    node->opDef->attr.AsConv2D()->activationType = type;
+  } else {
+    node->opDef->attr.AsMatMul()->activationType = type;
+  }
+  return true;
+}
+
+uint32_t GraphFusion::AddTensor(const std::vector<float> &data) {
+  std::unique_ptr<TensorDefT> tensor(new TensorDefT());
+  tensor->dataType = predict::DataType_DT_FLOAT;
+  tensor->dims = {static_cast<int>(data.size())};
+  tensor->format = predict::Format_NCHW;
+  tensor->refCount = MS_MAX_REFCOUNT;
+  tensor->offset = 0;
+  (void)SetFloatData(data, tensor.get());
+  sub_graph_->allTensors.push_back(std::move(tensor));
+  users_.emplace_back();
+  graph_outputs_.push_back(false);
+  return static_cast<uint32_t>(sub_graph_->allTensors.size() - 1);
+}
+
+void GraphFusion::Compact() {
+  auto &nodes = sub_graph_->nodes;
+  (void)nodes.erase(std::remove_if(nodes.begin(), nodes.end(),
+                                   [this](const std::unique_ptr<NodeDef> &node) {
+                                     return std::find(fused_nodes_.begin(), fused_nodes_.end(), node.get()) !=
+                                            fused_nodes_.end();
+                                   }),
+                    nodes.end());
+  // renumber the tensors still used
+  auto &tensors = sub_graph_->allTensors;
+  std::vector<bool> used(tensors.size(), false);
+  auto mark = [&used](const std::vector<uint32_t> &indexes) {
+    for (auto idx : indexes) {
+      if (idx < used.size()) {
+        used[idx] = true;
+      }
+    }
+  };
+  mark(sub_graph_->inputIndex);
+  mark(sub_graph_->outputIndex);
+  for (auto &node : nodes) {
+    mark(node->opDef->inputIndex);
+    mark(node->opDef->outputIndex);
+  }
+  std::vector<uint32_t> new_index(tensors.size(), 0);
+  size_t count = 0;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    if (used[i]) {
+      new_index[i] = static_cast<uint32_t>(count);
+      tensors[count++] = std::move(tensors[i]);
+    }
+  }
+  tensors.resize(count);
+  auto remap = [&new_index](std::vector<uint32_t> *indexes) {
+    for (auto &idx : *indexes) {
+      if (idx < new_index.size()) {
+        idx = new_index[idx];
+      }
+    }
+  };
+  remap(&sub_graph_->inputIndex);
+  remap(&sub_graph_->outputIndex);
+  for (auto &node : nodes) {
+    remap(&node->opDef->inputIndex);
+    remap(&node->opDef->outputIndex);
+  }
+  users_.clear();
+  graph_outputs_.clear();
+}
+}  // namespace executor
+}  // namespace mindspore
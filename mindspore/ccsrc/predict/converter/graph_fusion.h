@@ -0,0 +1,60 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_MINDSPORE_CCSRC_PREDICT_CONVERTER_GRAPH_FUSION_H_
+#define MINDSPORE_MINDSPORE_CCSRC_PREDICT_CONVERTER_GRAPH_FUSION_H_
+
+#include <vector>
+#include "predict/schema/inner/ms_generated.h"
+#include "predict/converter/attr_utils/convert_util.h"
+
+namespace mindspore {
+namespace executor {
+// Fuse the nodes of a converted graph into the nodes before them, so that the runtime does not read and write the
+// tensor between them again. FusedBatchNorm is folded into the weight and the bias of the Conv2D before it, BiasAdd
+// into the bias of a Conv2D or a MatMul, and ReLU/ReLU6 into their activationType. A node is fused only if the
+// output of the node before it has no other user, and a batch norm is folded only if the data of the weights is in
+// the graph. The tensors no node uses any more are removed.
+class GraphFusion {
+ public:
+  explicit GraphFusion(SubGraphDefT *sub_graph) : sub_graph_(sub_graph) {}
+  ~GraphFusion() = default;
+
+  // return the number of the nodes fused
+  int Run();
+
+ private:
+  // the node using the tensor as its first input, if it is the only user and the tensor is not an output of the graph
+  NodeDef *SingleUser(uint32_t tensor_idx) const;
+  bool IsOnlyUser(uint32_t tensor_idx, const NodeDef *node) const;
+  bool Fuse(NodeDef *node, NodeDef *next);
+  bool FoldBatchNorm(NodeDef *conv, NodeDef *batch_norm);
+  bool FoldBiasAdd(NodeDef *node, NodeDef *bias_add);
+  bool FoldActivation(NodeDef *node, NodeDef *activation);
+  // the channels the bias of a node is added to, 0 if the node has no bias
+  size_t BiasSize(const NodeDef *node) const;
+  uint32_t AddTensor(const std::vector<float> &data);
+  void Compact();
+
+  SubGraphDefT *sub_graph_;
+  // the nodes using each tensor as an input
+  std::vector<std::vector<NodeDef *>> users_;
+  std::vector<bool> graph_outputs_;
+  std::vector<const NodeDef *> fused_nodes_;
+};
+}  // namespace executor
+}  // namespace mindspore
+#endif  // MINDSPORE_MINDSPORE_CCSRC_PREDICT_CONVERTER_GRAPH_FUSION_H_
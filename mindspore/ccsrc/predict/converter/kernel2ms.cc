@@ -17,6 +17,7 @@
 #include "predict/converter/kernel2ms.h"
 #include <algorithm>
 #include "ir/anf.h"
+#include "predict/converter/graph_fusion.h"
 #include "predict/converter/lite_model/op_attr_packer.h"
 #include "mindspore/ccsrc/operator/ops.h"
 
@@ -558,6 +559,11 @@ bool Kernel2Ms::KernelInput2MS(const std::vector<TensorPtr> &input_tensors) {
 
 bool Kernel2Ms::SaveDeviceModel(const std::shared_ptr<GraphDefT> &new_ms_graph_ptr, const std::string &save_path_name) {
   MS_EXCEPTION_IF_NULL(new_ms_graph_ptr);
+  if (sub_ms_graph_ != nullptr) {
+    // the weights are in the graph now, which the batch norms are folded into
+    GraphFusion fusion(sub_ms_graph_.get());
+    MS_LOG(INFO) << "fuse " << fusion.Run() << " nodes";
+  }
   return predict::utils::SaveDeviceModelUtil(new_ms_graph_ptr, save_path_name, sub_ms_graph_.release());
 }
 }  // namespace executor
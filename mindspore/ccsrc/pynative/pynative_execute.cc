@@ -28,6 +28,7 @@
 #include "pipeline/parse/data_converter.h"
 #include "pipeline/static_analysis/prim.h"
 #include "session/session_factory.h"
+#include "device/device_address.h"
 
 #include "pynative/base.h"
 
@@ -41,6 +42,9 @@ const std::unordered_set<std::string> vm_operators = {"partial", "depend"};
 
 namespace mindspore {
 namespace pynative {
+// the sessions which run the ops, by device target, they keep the graphs built for the ops
+static std::unordered_map<std::string, session::SessionPtr> session_map;
+
 inline ValuePtr PyAttrValue(const py::object& obj) {
   ValuePtr converted_ret = nullptr;
   bool converted = parse::ConvertData(obj, &converted_ret);
@@ -102,23 +106,56 @@ OpExecInfoPtr GenerateOpExecInfo(const py::args& args) {
   return op_exec_info;
 }
 
+// the signature of an input: the dtype, shape and device format of a tensor, the signatures of the items of a tuple
+// or a list, and the repr of a constant, which is converted to an attr of the op
+void AppendInputInfo(const py::object& input, std::string* graph_info) {
+  MS_EXCEPTION_IF_NULL(graph_info);
+  // the python type tells 1, 1.0 and True apart
+  (void)graph_info->append(std::string(Py_TYPE(input.ptr())->tp_name) + ":");
+  if (py::isinstance<tensor::Tensor>(input)) {
+    auto tensor_ptr = py::cast<tensor::TensorPtr>(input);
+    MS_EXCEPTION_IF_NULL(tensor_ptr);
+    (void)graph_info->append(tensor_ptr->GetShapeAndDataTypeInfo());
+    // the parameter of the graph takes the format and the type of the device address of the tensor
+    auto device_address = tensor_ptr->device_address();
+    if (device_address != nullptr) {
+      (void)graph_info->append("@" + device_address->format() + ":" +
+                               std::to_string(static_cast<int>(device_address->type_id())));
+    }
+  } else if (py::isinstance<py::tuple>(input) || py::isinstance<py::list>(input)) {
+    (void)graph_info->append("(");
+    for (auto& item : input) {
+      AppendInputInfo(py::cast<py::object>(item), graph_info);
+      (void)graph_info->append(",");
+    }
+    (void)graph_info->append(")");
+  } else {
+    (void)graph_info->append(std::string(py::repr(input)));
+  }
+}
+
+// the key of the graph built for an op, the full signature of the op: its name, its attrs, its inputs and its output
+// abstract, so only the ops which build the same graph share it
 std::string GetSingleOpGraphInfo(const OpExecInfoPtr& op_exec_info) {
   MS_EXCEPTION_IF_NULL(op_exec_info);
-  std::string graph_info;
   MS_EXCEPTION_IF_NULL(op_exec_info->abstract);
-  // get input tensor info
+  std::string graph_info = op_exec_info->op_name + "_";
+  if (op_exec_info->py_primitive != nullptr) {
+    // the order of a hash map is not stable, the attrs are sorted by name
+    std::map<std::string, ValuePtr> attrs(op_exec_info->py_primitive->attrs().begin(),
+                                          op_exec_info->py_primitive->attrs().end());
+    for (auto& attr : attrs) {
+      MS_EXCEPTION_IF_NULL(attr.second);
+      (void)graph_info.append(attr.first + "=" + attr.second->ToString() + ";");
+    }
+  }
   size_t input_num = op_exec_info->op_inputs.size();
   for (size_t index = 0; index < input_num; ++index) {
-    if (py::isinstance<tensor::Tensor>(op_exec_info->op_inputs[index])) {
-      auto tensor_ptr = py::cast<tensor::TensorPtr>(op_exec_info->op_inputs[index]);
-      MS_EXCEPTION_IF_NULL(tensor_ptr);
-      (void)graph_info.append(tensor_ptr->GetShapeAndDataTypeInfo() + "_");
-    }
+    bool is_weight = index < op_exec_info->inputs_mask.size() && py::cast<bool>(op_exec_info->inputs_mask[index]);
+    (void)graph_info.append(is_weight ? "_w_" : "_");
+    AppendInputInfo(op_exec_info->op_inputs[index], &graph_info);
   }
-  // get prim and abstract info
-  (void)graph_info.append(std::to_string((uintptr_t)(op_exec_info->py_primitive.get())) + "_" +
-                          op_exec_info->abstract->ToString());
-  MS_LOG(INFO) << "graph info [" << graph_info << "]";
+  (void)graph_info.append("_" + op_exec_info->abstract->ToString());
   return graph_info;
 }
 
@@ -150,12 +187,15 @@ py::object RunOpInMs(const OpExecInfoPtr& op_exec_info, PynativeStatusCode* stat
   MS_EXCEPTION_IF_NULL(ms_context);
   ms_context->set_enable_pynative_infer(true);
   std::string device_target = ms_context->device_target();
-  if (device_target != kAscendDevice && device_target != kGPUDevice) {
+  if (device_target != kAscendDevice && device_target != kGPUDevice && device_target != kCPUDevice) {
     MS_EXCEPTION(ArgumentError) << "Device target [" << device_target << "] is not supported in Pynative mode";
   }
-  std::shared_ptr<session::SessionBasic> session = session::SessionFactory::Get().Create(device_target);
-  MS_EXCEPTION_IF_NULL(session);
-  session->Init(ms_context->device_id());
+  auto& session = session_map[device_target];
+  if (session == nullptr) {
+    session = session::SessionFactory::Get().Create(device_target);
+    MS_EXCEPTION_IF_NULL(session);
+    session->Init(ms_context->device_id());
+  }
 
   std::string graph_info = GetSingleOpGraphInfo(op_exec_info);
   session->BuildOp(*op_exec_info, graph_info);
@@ -202,6 +242,8 @@ py::object RunOpWithBackendPolicy(MsBackendPolicy backend_policy, const OpExecIn
   return result;
 }
 
+void ClearPyNativeSession() { session_map.clear(); }
+
 py::tuple RunOp(const py::args& args) {
   py::object result;
   // returns a null py::tuple on error
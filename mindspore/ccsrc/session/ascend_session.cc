@@ -205,6 +205,10 @@ void AscendSession::RunOpExecTask(const std::shared_ptr<KernelGraph> &kernel_gra
 
 void AscendSession::BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info) {
   MS_LOG(INFO) << "Build op " << op_run_info.op_name << " start !";
+  if (GetRunOpGraph(graph_info) != nullptr) {
+    MS_LOG(INFO) << "Build op " << op_run_info.op_name << " finish, the graph is cached !";
+    return;
+  }
   // construct graph include one op
   auto graph = ConstructSingleOpGraph(op_run_info);
   MS_EXCEPTION_IF_NULL(graph);
@@ -218,11 +222,11 @@ void AscendSession::BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph
   // build kernel
   RunOpAdjustKernel(graph);
   BuildKernel(graph);
-  run_op_graphs_[graph_info] = graph;
+  AddRunOpGraph(graph_info, graph);
 }
 
 py::tuple AscendSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info) {
-  auto graph = run_op_graphs_[graph_info];
+  auto graph = GetRunOpGraph(graph_info);
   MS_EXCEPTION_IF_NULL(graph);
   MS_LOG(INFO) << "Run op " << op_run_info.op_name << " start!";
   // malloc mem
@@ -245,7 +249,7 @@ py::tuple AscendSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &gr
   }
   py::object tuple_obj = utils::cast<PyObjectRef>(output_tensors).object_;
   py::tuple tuple_tensors = py::cast<py::tuple>(tuple_obj);
-  run_op_graphs_.clear();
+  RunOpMemoryClear(graph.get());
   MS_LOG(INFO) << "Run op " << op_run_info.op_name << " finish!";
   return tuple_tensors;
 }
@@ -354,6 +358,13 @@ void AscendSession::RunOpMemoryAlloc(const std::vector<tensor::TensorPtr> &input
   MS_LOG(INFO) << "Finish!";
 }
 
+void AscendSession::RunOpMemoryClear(const KernelGraph *kernel_graph) const {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto runtime_instance = device::KernelRuntimeManager::Instance().GetKernelRuntime(kAscendDevice, device_id_);
+  MS_EXCEPTION_IF_NULL(runtime_instance);
+  runtime_instance->RunOpClearMemory(kernel_graph);
+}
+
 void AscendSession::GenerateTaskInfo(const std::shared_ptr<KernelGraph> &kernel_graph) const {
   MS_LOG(INFO) << "Start!";
   (void)device::KernelAdjust::GetInstance().StepLoadCtrlInputs(context_, kernel_graph);
@@ -33,6 +33,8 @@ namespace mindspore {
 namespace session {
 namespace {
 const int kSummaryGetItem = 2;
+// the number of single op graphs a session keeps built
+const size_t kRunOpGraphCacheSize = 1024;
 void GetSummaryNodes(const KernelGraph *graph, std::unordered_map<std::string, std::pair<AnfNodePtr, int>> *summary) {
   MS_LOG(DEBUG) << "Update summary Start";
   MS_EXCEPTION_IF_NULL(graph);
@@ -719,6 +721,38 @@ std::shared_ptr<KernelGraph> SessionBasic::ConstructSingleOpGraph(const OpRunInf
   return graph;
 }
 
+std::shared_ptr<KernelGraph> SessionBasic::GetRunOpGraph(const GraphInfo &graph_info) {
+  auto iter = run_op_graphs_.find(graph_info);
+  if (iter == run_op_graphs_.end()) {
+    return nullptr;
+  }
+  run_op_graph_list_.splice(run_op_graph_list_.begin(), run_op_graph_list_, iter->second);
+  return iter->second->second;
+}
+
+void SessionBasic::AddRunOpGraph(const GraphInfo &graph_info, const std::shared_ptr<KernelGraph> &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto iter = run_op_graphs_.find(graph_info);
+  if (iter != run_op_graphs_.end()) {
+    run_op_graph_list_.erase(iter->second);
+  }
+  run_op_graph_list_.emplace_front(graph_info, graph);
+  run_op_graphs_[graph_info] = run_op_graph_list_.begin();
+  while (run_op_graph_list_.size() > kRunOpGraphCacheSize) {
+    auto &dropped = run_op_graph_list_.back();
+    MS_LOG(INFO) << "Drop the single op graph [" << dropped.first << "]";
+    // the graph was added to the manager of the session when it was constructed
+    auto manager = dropped.second->manager();
+    if (manager != nullptr) {
+      FuncGraphSet func_graphs;
+      func_graphs.add(dropped.second);
+      manager->MaybeDropFuncGraphs(func_graphs);
+    }
+    (void)run_op_graphs_.erase(dropped.first);
+    run_op_graph_list_.pop_back();
+  }
+}
+
 BaseRef SessionBasic::TransformBaseRefListToTuple(const BaseRef &base_ref) {
   if (utils::isa<VectorRef>(base_ref)) {
     auto ref_list = utils::cast<VectorRef>(base_ref);
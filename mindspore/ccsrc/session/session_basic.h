@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_SESSION_SESSION_BASIC_H
 
 #include <vector>
+#include <list>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -47,7 +48,6 @@ class SessionBasic {
  public:
   SessionBasic() : device_id_(0) {
     graphs_ = {};
-    run_op_graphs_ = {};
     summary_callback_ = nullptr;
   }
 
@@ -101,9 +101,16 @@ class SessionBasic {
                    std::vector<bool> *tensor_mask);
   // trans BaseRef list to py::tuple
   BaseRef TransformBaseRefListToTuple(const BaseRef &base_ref);
+  // get a built single op graph and mark it as the most recently used, nullptr if it is not cached
+  std::shared_ptr<KernelGraph> GetRunOpGraph(const GraphInfo &graph_info);
+  // cache a built single op graph, the least recently used one is dropped when the cache is full
+  void AddRunOpGraph(const GraphInfo &graph_info, const std::shared_ptr<KernelGraph> &graph);
 
   std::unordered_map<GraphId, std::shared_ptr<KernelGraph>> graphs_;
-  std::unordered_map<GraphInfo, std::shared_ptr<KernelGraph>> run_op_graphs_;
+  // the single op graphs of pynative, the most recently used first
+  using RunOpGraphList = std::list<std::pair<GraphInfo, std::shared_ptr<KernelGraph>>>;
+  RunOpGraphList run_op_graph_list_;
+  std::unordered_map<GraphInfo, RunOpGraphList::iterator> run_op_graphs_;
   std::shared_ptr<Context> context_;
   CallBackFunc summary_callback_;
   static GraphId graph_sum_;
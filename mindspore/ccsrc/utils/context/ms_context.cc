@@ -76,6 +76,7 @@ MsContext::MsContext(const std::string& policy, const std::string& target) {
   auto_mixed_precision_flag_ = true;
   enable_pynative_infer_ = false;
   enable_dynamic_mem_pool_ = false;
+  cpu_inter_op_parallel_num_ = 1;
   graph_memory_max_size_ = "0";
   variable_memory_max_size_ = "0";
   MS_LOG(INFO) << "Create context with backend policy:" << policy << ", device target:" << target << ".";
@@ -128,6 +128,9 @@ class MsContext {
   void set_enable_dynamic_mem_pool(bool enable_dynamic_mem_pool) { enable_dynamic_mem_pool_ = enable_dynamic_mem_pool; }
   bool enable_dynamic_mem_pool() const { return enable_dynamic_mem_pool_; }
 
+  void set_cpu_inter_op_parallel_num(uint32_t parallel_num) { cpu_inter_op_parallel_num_ = parallel_num; }
+  uint32_t cpu_inter_op_parallel_num() const { return cpu_inter_op_parallel_num_; }
+
   void set_graph_memory_max_size(const std::string& graph_memory_max_size) {
     graph_memory_max_size_ = graph_memory_max_size;
   }
@@ -169,6 +172,7 @@ class MsContext {
   bool is_multi_graph_sink_;
   bool is_pynative_ge_init_;
   bool enable_dynamic_mem_pool_;
+  uint32_t cpu_inter_op_parallel_num_;
   std::string graph_memory_max_size_;
   std::string variable_memory_max_size_;
   std::thread tdt_print_;
@@ -19,6 +19,7 @@
 #include "vm/vm.h"
 
 #include <algorithm>
+#include <iterator>
 
 #include "vm/vmimpl.h"
 #include "vm/backend.h"
@@ -59,19 +60,72 @@ std::ostream& operator<<(std::ostream& os, const SwitchCondStatus& other) {
   return os;
 }
 
+namespace {
+using InstHandler = void (FinalVM::*)(const FinalInst&);
+
+InstHandler GetInstHandler(Instruction inst) {
+  switch (inst) {
+    case Instruction::kCall:
+      return &FinalVM::InstCall;
+    case Instruction::kTailCall:
+      return &FinalVM::InstTailCall;
+    case Instruction::kReturn:
+      return &FinalVM::InstReturn;
+    case Instruction::kPartial:
+      return &FinalVM::InstPartial;
+    case Instruction::kSwitch:
+      return &FinalVM::InstSwitch;
+    case Instruction::kSwitchReturn:
+      return &FinalVM::InstSwitchReturn;
+    case Instruction::kTuple:
+      return &FinalVM::InstTuple;
+    case Instruction::kInput:
+      return &FinalVM::InstInput;
+    case Instruction::kExternal:
+      return &FinalVM::InstExternal;
+    case Instruction::kPush:
+      return &FinalVM::InstPush;
+    case Instruction::kPrim:
+      return &FinalVM::InstPushPrim;
+    case Instruction::kPadStack:
+      return &FinalVM::InstPadStack;
+    default:
+      // kGraph is replaced when the graphs are linked
+      return nullptr;
+  }
+}
+
+FinalInst DecodeInst(const InstType& inst) {
+  FinalInst final_inst{inst.first, GetInstHandler(inst.first), inst.second, std::vector<int>(inst.second.size(), 0)};
+  for (size_t i = 0; i < inst.second.size(); ++i) {
+    if (utils::isa<int>(inst.second[i])) {
+      final_inst.ints[i] = utils::cast<int>(inst.second[i]);
+    }
+  }
+  return final_inst;
+}
+}  // namespace
+
 // Follow the specified instructions to create a VM.
 // Arguments:
-//   insts_: std::vector<std::map<std::string, VectorRef>>
+//   insts_: the instructions, decoded for the dispatch loop
 //   insts_stack_: The value stack.
 //   retp_: The call stack.
 //   pc_: program counter (next instruction)
 //   sp_: stack pointer (for the value stack)
-FinalVM::FinalVM(const InstSet& insts, const BackendPtr& backend) : insts_(insts), pc_(0), sp_(0), backend_(backend) {
+FinalVM::FinalVM(const InstSet& insts, const BackendPtr& backend) : pc_(0), sp_(0), backend_(backend) {
+  set_insts(insts);
   MS_LOG(DEBUG) << "InstSet size:" << insts_.size();
   insts_stack_.emplace_back(BaseRef());
   retp_.push(-1);
 }
 
+void FinalVM::set_insts(const InstSet& value) {
+  insts_.clear();
+  insts_.reserve(value.size());
+  (void)std::transform(value.begin(), value.end(), std::back_inserter(insts_), DecodeInst);
+}
+
 void FinalVM::Push(const BaseRef& v) {
   MS_LOG(DEBUG) << "Push " << v.ToString() << " sp_:" << sp_;
   insts_stack_[IntToSize(sp_++)] = v;
@@ -116,6 +170,16 @@ BaseRef FinalVM::Ref(int i) {
   MS_LOG(EXCEPTION) << "IndexError: index(" << sp_next << ") out of range [0, " << insts_stack_.size() << ").";
 }
 
+void FinalVM::PadStack(int sz) {
+  MS_LOG(DEBUG) << "" << insts_stack_.size() << " need padstack " << sz << " sp_ " << sp_;
+  size_t stack_size = insts_stack_.size();
+  int need = sz - (static_cast<int>(stack_size) - sp_);
+  if (need > 0) {
+    MS_LOG(DEBUG) << "InstPadStack resize: size:" << insts_stack_.size() << " need pad:" << need;
+    insts_stack_.resize(stack_size + IntToSize(need));
+  }
+}
+
 void FinalVM::Pushp() { retp_.push(pc_); }
 
 void FinalVM::Popp() {
@@ -157,7 +221,7 @@ void FinalVM::DoJmp(const BaseRef& jmp_orig) {
     MS_LOG(DEBUG) << "Start jump StructPartial";
     auto new_jmp = utils::cast<std::shared_ptr<StructPartial>>(jmp);
     auto args = new_jmp->args_;
-    InstPadStack(VectorRef(std::vector<BaseRef>{static_cast<int>(args.size())}));
+    PadStack(static_cast<int>(args.size()));
     auto iter = args.rbegin();
     for (; iter != args.rend(); ++iter) {
       Push(*iter);
@@ -177,7 +241,7 @@ BaseRef FinalVM::Eval(const VectorRef& args) {
   MS_LOG(DEBUG) << "Start: " << args.size();
   insts_stack_.clear();
   insts_stack_.resize(args.size());
-  std::stack<int>().swap(retp_);
+  std::stack<int, std::vector<int>>().swap(retp_);
   retp_.push(-1);
   pc_ = 0;
   sp_ = 0;
@@ -197,49 +261,47 @@ BaseRef FinalVM::Eval(const VectorRef& args) {
   }
 
   while (pc_ >= 0) {
-    auto inst = insts_[IntToSize(pc_)];
-    MS_LOG(DEBUG) << "Loop " << insts_.size() << ", pc:" << pc_ << ", inst:" << inst_str[inst.first];
+    const auto& inst = insts_[IntToSize(pc_)];
+    MS_LOG(DEBUG) << "Loop " << insts_.size() << ", pc:" << pc_ << ", inst:" << inst_str[inst.inst];
     ++pc_;
-    auto iter = inst_function_map.find(inst.first);
-    if (iter != inst_function_map.end()) {
-      iter->second(inst.second);
-    } else {
-      MS_LOG(EXCEPTION) << "Unknown instruction {" << inst_str[inst.first] << "}";
+    if (inst.handler == nullptr) {
+      MS_LOG(EXCEPTION) << "Unknown instruction {" << inst_str[inst.inst] << "}";
     }
+    (this->*inst.handler)(inst);
   }
 
   MS_LOG(DEBUG) << "End";
   return insts_stack_[0];
 }
 
-void FinalVM::InstCall(const VectorRef& args) {
+void FinalVM::InstCall(const FinalInst& inst) {
   MS_LOG(DEBUG) << "Start";
   const size_t args_size = 1;
-  if (args.size() != args_size) {
+  if (inst.args.size() != args_size) {
     MS_LOG(ERROR) << "" << __FUNCTION__ << " requires " << args_size << " parameter, while the input size is "
-                  << args.size() << ".";
+                  << inst.args.size() << ".";
     return;
   }
 
-  int jmp = utils::cast<int>(args[0]);
+  int jmp = inst.ints[0];
   MS_LOG(DEBUG) << "Call pushp:" << pc_ << ", jmp:" << jmp << ", sp:" << sp_;
   Pushp();
   DoJmp(Ref(jmp));
   MS_LOG(DEBUG) << "Instcall end sp :" << sp_;
 }
 
-void FinalVM::InstTailCall(const VectorRef& args) {
+void FinalVM::InstTailCall(const FinalInst& inst) {
   MS_LOG(DEBUG) << "Start";
   const size_t args_size = 3;
-  if (args.size() != args_size) {
+  if (inst.args.size() != args_size) {
     MS_LOG(ERROR) << "" << __FUNCTION__ << " requires " << args_size << " parameters, while the input size is "
-                  << args.size() << ".";
+                  << inst.args.size() << ".";
     return;
   }
 
-  int jmp = utils::cast<int>(args[0]);
-  int height = utils::cast<int>(args[1]);
-  int nargs = utils::cast<int>(args[2]);
+  int jmp = inst.ints[0];
+  int height = inst.ints[1];
+  int nargs = inst.ints[2];
 
   auto new_jmp = Ref(jmp);
 
@@ -258,27 +320,28 @@ void FinalVM::InstTailCall(const VectorRef& args) {
   MS_LOG(DEBUG) << "End";
 }
 
-void FinalVM::InstSwitchReturn(const VectorRef& args) {
+void FinalVM::InstSwitchReturn(const FinalInst& inst) {
   MS_LOG(DEBUG) << "Start";
-  if (args.size() != 1) {
-    MS_LOG(ERROR) << "" << __FUNCTION__ << " requires one parameter, while the input size is " << args.size() << ".";
+  if (inst.args.size() != 1) {
+    MS_LOG(ERROR) << "" << __FUNCTION__ << " requires one parameter, while the input size is " << inst.args.size()
+                  << ".";
     return;
   }
   Pop(1);
   Popsp();
 }
 
-void FinalVM::InstReturn(const VectorRef& args) {
+void FinalVM::InstReturn(const FinalInst& inst) {
   MS_LOG(DEBUG) << "Start";
   const size_t args_size = 2;
-  if (args.size() != args_size) {
+  if (inst.args.size() != args_size) {
     MS_LOG(ERROR) << "" << __FUNCTION__ << " requires " << args_size << " parameters, while the input size is "
-                  << args.size() << ".";
+                  << inst.args.size() << ".";
     return;
   }
 
-  int rpos = utils::cast<int>(args[0]);
-  int height = utils::cast<int>(args[1]);
+  int rpos = inst.ints[0];
+  int height = inst.ints[1];
 
   auto rv = Ref(rpos);
   if (backend_->simu_flag() && backend_->is_switch_call()) {
@@ -291,37 +354,36 @@ void FinalVM::InstReturn(const VectorRef& args) {
   MS_LOG(DEBUG) << "End";
 }
 
-void FinalVM::InstPartial(const VectorRef& args) {
+void FinalVM::InstPartial(const FinalInst& inst) {
   MS_LOG(DEBUG) << "Start";
   const size_t args_size = 1;
-  if (args.size() < args_size) {
+  if (inst.args.size() < args_size) {
     MS_LOG(ERROR) << "" << __FUNCTION__ << " requires " << args_size << " or more parameters, while the input size is "
-                  << args.size() << ".";
+                  << inst.args.size() << ".";
     return;
   }
 
-  int fn_ = utils::cast<int>(args[0]);
+  int fn_ = inst.ints[0];
   auto fn = utils::cast<int>(Ref(fn_));
-  MS_LOG(DEBUG) << "Partial argssize:" << args.size();
-  std::vector<BaseRef> outs(args.size() - 1);
+  MS_LOG(DEBUG) << "Partial argssize:" << inst.args.size();
+  std::vector<BaseRef> outs(inst.args.size() - 1);
 
-  (void)std::transform(args.begin() + 1, args.end(), outs.begin(),
-                       [&, this](const BaseRef& a) { return Ref(utils::cast<int>(a)); });
+  (void)std::transform(inst.ints.begin() + 1, inst.ints.end(), outs.begin(), [this](int a) { return Ref(a); });
   Push(std::make_shared<StructPartial>(fn, VectorRef(outs)));
   MS_LOG(DEBUG) << "End";
 }
 
-void FinalVM::InstSimuSwitch(const VectorRef& args) {
+void FinalVM::InstSimuSwitch(const FinalInst& inst) {
   const size_t args_size = 4;
-  if (args.size() != args_size) {
+  if (inst.args.size() != args_size) {
     MS_LOG(ERROR) << "" << __FUNCTION__ << " requires " << args_size << " parameters, while the input size is "
-                  << args.size() << ".";
+                  << inst.args.size() << ".";
     return;
   }
-  bool cond = utils::cast<bool>(args[0]);
-  int cond_node = utils::cast<int>(args[1]);
-  int vtrue = utils::cast<int>(args[2]);
-  int vfalse = utils::cast<int>(args[3]);
+  bool cond = utils::cast<bool>(inst.args[0]);
+  int cond_node = inst.ints[1];
+  int vtrue = inst.ints[2];
+  int vfalse = inst.ints[3];
 
   MS_LOG(DEBUG) << "Simu switch cond:" << cond;
   BaseRef c = Ref(cond_node);
@@ -365,17 +427,17 @@ void FinalVM::InstSimuSwitch(const VectorRef& args) {
   }
 }
 
-void FinalVM::InstRealSwitch(const VectorRef& args) {
+void FinalVM::InstRealSwitch(const FinalInst& inst) {
   const size_t args_size = 3;
-  if (args.size() != args_size) {
+  if (inst.args.size() != args_size) {
     MS_LOG(ERROR) << "" << __FUNCTION__ << " requires " << args_size << " parameters, while the input size is "
-                  << args.size() << ".";
+                  << inst.args.size() << ".";
     return;
   }
 
-  int cond = utils::cast<int>(args[0]);
-  int vtrue = utils::cast<int>(args[1]);
-  int vfalse = utils::cast<int>(args[2]);
+  int cond = inst.ints[0];
+  int vtrue = inst.ints[1];
+  int vfalse = inst.ints[2];
 
   BaseRef c = Ref(cond);
   MS_LOG(DEBUG) << "" << vtrue << " false:" << vfalse << " InstSwitch: " << c.ToString();
@@ -392,95 +454,85 @@ void FinalVM::InstRealSwitch(const VectorRef& args) {
   }
 }
 
-void FinalVM::InstSwitch(const VectorRef& args) {
+void FinalVM::InstSwitch(const FinalInst& inst) {
   MS_LOG(DEBUG) << "Start";
   if (backend_->is_multi_graph_sink()) {
-    InstSimuSwitch(args);
+    InstSimuSwitch(inst);
   } else {
-    InstRealSwitch(args);
+    InstRealSwitch(inst);
   }
 }
 
-void FinalVM::InstTuple(const VectorRef& args) {
+void FinalVM::InstTuple(const FinalInst& inst) {
   MS_LOG(DEBUG) << "Start";
   VectorRef tuple;
-  auto iter = args.begin();
-  for (; iter != args.end(); ++iter) {
-    auto a = utils::cast<int>(*iter);
+  for (auto a : inst.ints) {
     tuple.push_back(Ref(a));
   }
   Push(tuple);
   MS_LOG(DEBUG) << "End";
 }
 
-void FinalVM::InstPush(const VectorRef& args) {
+void FinalVM::InstPush(const FinalInst& inst) {
   MS_LOG(DEBUG) << "Start";
   const size_t args_size = 1;
-  if (args.size() != args_size) {
+  if (inst.args.size() != args_size) {
     MS_LOG(ERROR) << "" << __FUNCTION__ << " requires " << args_size << " parameter, while the input size is "
-                  << args.size() << ".";
+                  << inst.args.size() << ".";
     return;
   }
 
-  auto v = args[0];
-  Push(v);
+  Push(inst.args[0]);
   MS_LOG(DEBUG) << "End";
 }
 
-void FinalVM::InstInput(const VectorRef& args) {
+void FinalVM::InstInput(const FinalInst& inst) {
   MS_LOG(DEBUG) << "Start";
   const size_t args_size = 1;
-  if (args.size() != args_size) {
+  if (inst.args.size() != args_size) {
     MS_LOG(ERROR) << "" << __FUNCTION__ << " requires " << args_size << " parameter, while the input size is "
-                  << args.size() << ".";
+                  << inst.args.size() << ".";
     return;
   }
 
-  int rpos = utils::cast<int>(args[0]);
+  int rpos = inst.ints[0];
   Push(Ref(rpos));
   MS_LOG(DEBUG) << "End";
 }
 
-void FinalVM::InstPadStack(const VectorRef& args) {
+void FinalVM::InstPadStack(const FinalInst& inst) {
   MS_LOG(DEBUG) << "Start";
   const size_t args_size = 1;
-  if (args.size() != args_size) {
+  if (inst.args.size() != args_size) {
     MS_LOG(ERROR) << "" << __FUNCTION__ << " requires " << args_size << " parameter, while the input size is "
-                  << args.size() << ".";
+                  << inst.args.size() << ".";
     return;
   }
 
-  int sz = utils::cast<int>(args[0]);
-  MS_LOG(DEBUG) << "" << insts_stack_.size() << " need padstack " << sz << " sp_ " << sp_;
-  size_t stack_size = insts_stack_.size();
-  int need = sz - (static_cast<int>(stack_size) - sp_);
-  if (need > 0) {
-    MS_LOG(DEBUG) << "InstPadStack resize: size:" << insts_stack_.size() << " need pad:" << need;
-    insts_stack_.resize(stack_size + IntToSize(need));
-  }
+  PadStack(inst.ints[0]);
   MS_LOG(DEBUG) << "End";
 }
 
-void FinalVM::InstExternal(const VectorRef& args) {
-  MS_LOG(DEBUG) << "Start:" << args.size();
+void FinalVM::InstExternal(const FinalInst& inst) {
+  MS_LOG(DEBUG) << "Start:" << inst.args.size();
 
-  if (args.empty()) {
+  if (inst.args.empty()) {
     MS_LOG(EXCEPTION) << "Args is empty!";
   }
 
   VectorRef tuple;
-  RunFunctionRef run_ref = utils::cast<RunFunctionRef>(args[0]);
+  RunFunctionRef run_ref = utils::cast<RunFunctionRef>(inst.args[0]);
   compile::RunFuncPtr fn = run_ref.func_;
   if (backend_->simu_flag()) {
     MS_LOG(DEBUG) << "Simu run";
-    if (args.size() == 1) {
+    if (inst.args.size() == 1) {
       MS_LOG(EXCEPTION) << "The number of args should be greater than 1, but got 1";
     }
-    auto simu_run_ref = utils::cast<RunFunctionRef>(args[1]);
+    auto simu_run_ref = utils::cast<RunFunctionRef>(inst.args[1]);
     fn = simu_run_ref.func_;
   }
-  for (size_t i = 2; i < args.size(); ++i) {
-    auto index = utils::cast<int>(args[i]);
+  for (size_t i = 2; i < inst.args.size(); ++i) {
+    auto index = inst.ints[i];
     tuple.push_back(Ref(index));
   }
 
@@ -497,19 +549,19 @@ void FinalVM::InstExternal(const VectorRef& args) {
   MS_LOG(DEBUG) << "End";
 }
 
-void FinalVM::InstPushPrim(const VectorRef& args) {
-  MS_LOG(DEBUG) << "Start: " << args.size();
+void FinalVM::InstPushPrim(const FinalInst& inst) {
+  MS_LOG(DEBUG) << "Start: " << inst.args.size();
   const size_t args_size = 2;
-  if (args.size() < args_size) {
+  if (inst.args.size() < args_size) {
     MS_LOG(ERROR) << "" << __FUNCTION__ << " requires " << args_size << " or more parameters, while the input size is "
-                  << args.size() << ".";
+                  << inst.args.size() << ".";
     return;
   }
 
   VectorRef tuple;
-  auto prim = utils::cast<PrimitivePtr>(args[0]);
-  for (size_t i = 1; i < args.size(); ++i) {
-    auto index = utils::cast<int>(args[1]);
+  auto prim = utils::cast<PrimitivePtr>(inst.args[0]);
+  for (size_t i = 1; i < inst.args.size(); ++i) {
+    auto index = inst.ints[i];
     tuple.push_back(Ref(index));
   }
 
@@ -26,7 +26,6 @@
 #include <tuple>
 #include <utility>
 #include <vector>
-#include <deque>
 #include "utils/base_ref.h"
 
 namespace mindspore {
@@ -53,7 +52,6 @@ enum Instruction {
 
 using InstType = std::pair<Instruction, VectorRef>;
 using InstSet = std::vector<InstType>;
-using InstFunctionMap = std::map<Instruction, std::function<void(const VectorRef&)>>;
 
 const std::vector<std::string> inst_str{"call",  "tail_call", "return", "partial",   "switch", "switch_return", "tuple",
                                         "input", "external",  "push",   "primitive", "graph",  "pad_stack"};
@@ -86,6 +84,18 @@ class StructSimuSwitch : public Base {
 std::ostream& operator<<(std::ostream& os, const StructSimuSwitch& other);
 bool operator==(const StructSimuSwitch& lhs, const StructSimuSwitch& rhs);
 
+class FinalVM;
+
+// An instruction decoded for the dispatch loop of FinalVM. The handler of the instruction is resolved and the int
+// operands, the stack positions and counts, are cast from the BaseRef operands once when the VM is created.
+struct FinalInst {
+  Instruction inst;
+  void (FinalVM::*handler)(const FinalInst&);
+  VectorRef args;
+  // ints[i] is args[i] if it is an int, 0 if not
+  std::vector<int> ints;
+};
+
 class FinalVM {
  public:
   // Create a VM with the specified instructions and backend.
@@ -94,27 +104,28 @@ class FinalVM {
   virtual ~FinalVM() = default;
 
   BaseRef Eval(const VectorRef& args);
-  void InstCall(const VectorRef& args);
-  void InstTailCall(const VectorRef& args);
-  void InstReturn(const VectorRef& args);
-  void InstPartial(const VectorRef& args);
-  void InstSwitch(const VectorRef& args);
-  void InstSimuSwitch(const VectorRef& args);
-  void InstRealSwitch(const VectorRef& args);
-  void InstTuple(const VectorRef& args);
-  void InstPush(const VectorRef& args);
-  void InstInput(const VectorRef& args);
-  void InstPadStack(const VectorRef& args);
-  void InstExternal(const VectorRef& args);
-  void InstPushPrim(const VectorRef& args);
-  void InstSwitchReturn(const VectorRef& args);
-  void set_insts(const InstSet& value) { insts_ = value; }
+  void InstCall(const FinalInst& inst);
+  void InstTailCall(const FinalInst& inst);
+  void InstReturn(const FinalInst& inst);
+  void InstPartial(const FinalInst& inst);
+  void InstSwitch(const FinalInst& inst);
+  void InstSimuSwitch(const FinalInst& inst);
+  void InstRealSwitch(const FinalInst& inst);
+  void InstTuple(const FinalInst& inst);
+  void InstPush(const FinalInst& inst);
+  void InstInput(const FinalInst& inst);
+  void InstPadStack(const FinalInst& inst);
+  void InstExternal(const FinalInst& inst);
+  void InstPushPrim(const FinalInst& inst);
+  void InstSwitchReturn(const FinalInst& inst);
+  void set_insts(const InstSet& value);
 
  protected:
   BaseRef Ref(int i);
   void Push(const BaseRef& v);
   void Pop(int n = 1);
   void MoveStack(int nitems, int height);
+  void PadStack(int sz);
   void Pushp();
   void Popp();
   void Pushsp();
@@ -122,27 +133,13 @@ class FinalVM {
   void DoJmp(const BaseRef& jmp);
 
  private:
-  InstSet insts_;
-  std::deque<BaseRef> insts_stack_;
-  std::stack<int> retp_;
-  std::stack<int> retsp_;
+  std::vector<FinalInst> insts_;
+  std::vector<BaseRef> insts_stack_;
+  std::stack<int, std::vector<int>> retp_;
+  std::stack<int, std::vector<int>> retsp_;
   int pc_;
   int sp_;
   BackendPtr backend_;
-  const InstFunctionMap inst_function_map = {
-    {Instruction::kCall, [this](const VectorRef& args) { InstCall(args); }},
-    {Instruction::kTailCall, [this](const VectorRef& args) { InstTailCall(args); }},
-    {Instruction::kReturn, [this](const VectorRef& args) { InstReturn(args); }},
-    {Instruction::kPartial, [this](const VectorRef& args) { InstPartial(args); }},
-    {Instruction::kSwitch, [this](const VectorRef& args) { InstSwitch(args); }},
-    {Instruction::kTuple, [this](const VectorRef& args) { InstTuple(args); }},
-    {Instruction::kPush, [this](const VectorRef& args) { InstPush(args); }},
-    {Instruction::kInput, [this](const VectorRef& args) { InstInput(args); }},
-    {Instruction::kPadStack, [this](const VectorRef& args) { InstPadStack(args); }},
-    {Instruction::kExternal, [this](const VectorRef& args) { InstExternal(args); }},
-    {Instruction::kPrim, [this](const VectorRef& args) { InstPushPrim(args); }},
-    {Instruction::kSwitchReturn, [this](const VectorRef& args) { InstSwitchReturn(args); }},
-  };
 };
 
 using FinalVMPtr = std::shared_ptr<FinalVM>;
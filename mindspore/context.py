@@ -303,6 +303,17 @@ class _Context:
     def enable_dynamic_memory(self, enable_dynamic_memory):
         self._context_handle.set_enable_dynamic_mem_pool(enable_dynamic_memory)
 
+    @property
+    def cpu_inter_op_parallel_num(self):
+        return self._context_handle.get_cpu_inter_op_parallel_num()
+
+    @cpu_inter_op_parallel_num.setter
+    def cpu_inter_op_parallel_num(self, cpu_inter_op_parallel_num):
+        if cpu_inter_op_parallel_num < 1 or cpu_inter_op_parallel_num > 1024:
+            raise ValueError("Cpu inter op parallel num must be in [1, 1024], but got {}"
+                             .format(cpu_inter_op_parallel_num))
+        self._context_handle.set_cpu_inter_op_parallel_num(cpu_inter_op_parallel_num)
+
     @property
     def graph_memory_max_size(self):
         return None
@@ -455,7 +466,7 @@ def reset_auto_parallel_context():
                  enable_mem_reuse=bool, save_ms_model=bool, save_ms_model_path=str, enable_gpu_summary=bool,
                  enable_auto_mixed_precision=bool, enable_dump=bool, save_dump_path=str,
                  enable_reduce_precision=bool, enable_dynamic_memory=bool, graph_memory_max_size=str,
-                 variable_memory_max_size=str)
+                 variable_memory_max_size=str, cpu_inter_op_parallel_num=int)
 def set_context(**kwargs):
     """
     Set context for running environment.
@@ -499,6 +510,9 @@ def set_context(**kwargs):
         enable_dynamic_memory (bool): Whether to enable dynamic memory. Default: False.
         graph_memory_max_size (str): Set graph memory max size. Default: "26GB".
         variable_memory_max_size (str): Set variable memory max size. Default: "5GB".
+        cpu_inter_op_parallel_num (int): Number of independent kernels launched in parallel on CPU, the value
+                    must be in [1, 1024]. Memory reuse is not applied to graphs compiled with a value greater
+                    than 1. Default: 1.
 
     Raises:
         ValueError: If input key is not an attribute in context.
@@ -519,6 +533,7 @@ def set_context(**kwargs):
         >>> context.set_context(enable_dynamic_memory=True)
         >>> context.set_context(graph_memory_max_size="25GB")
         >>> context.set_context(variable_memory_max_size="6GB")
+        >>> context.set_context(cpu_inter_op_parallel_num=4)
         >>> context.set_context(mode=context.GRAPH_MODE,
         >>>                     device_target="Ascend",device_id=0, save_graphs=True,
         >>>                     save_graphs_path="/mindspore")
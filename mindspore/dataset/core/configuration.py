@@ -115,6 +115,155 @@ class ConfigurationManager:
         """
         return self.config.get_num_parallel_workers()
 
+    def set_auto_num_workers(self, enable):
+        """
+        Set whether the pipeline tunes the number of running workers of each operation at runtime.
+
+        The operations keep the number of workers they are created with, the auto tune moves the
+        permission to run between them, toward the operation which is the bottleneck of the pipeline.
+        The operations should be created with more workers than needed to let the bottleneck grow.
+
+        Args:
+            enable (bool): whether to auto tune the number of workers.
+
+        Raises:
+            TypeError: If enable is not a bool.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # the pipelines created after this call share 8 running workers between their operations.
+            >>> con.set_num_parallel_workers(8)
+            >>> con.set_cpu_budget(8)
+            >>> con.set_auto_num_workers(True)
+        """
+        if not isinstance(enable, bool):
+            raise TypeError("enable should be a bool")
+        self.config.set_auto_num_workers(enable)
+
+    def get_auto_num_workers(self):
+        """
+        Get whether the pipeline tunes the number of running workers of each operation.
+
+        Returns:
+            Bool, whether to auto tune the number of workers.
+        """
+        return self.config.get_auto_num_workers()
+
+    def set_cpu_budget(self, num):
+        """
+        Set the number of workers allowed to run at the same time in a pipeline when auto tuning.
+
+        Args:
+            num: number of running workers shared by all the operations, 0 means the number of cpus.
+
+        Raises:
+            ValueError: If num is invalid (< 0 or > MAX_INT_32).
+        """
+        if num < 0 or num > INT32_MAX:
+            raise ValueError("Cpu budget given is not within the required range")
+        self.config.set_cpu_budget(num)
+
+    def get_cpu_budget(self):
+        """
+        Get the number of workers allowed to run at the same time in a pipeline when auto tuning.
+
+        Returns:
+            Int, number of running workers shared by all the operations.
+        """
+        return self.config.get_cpu_budget()
+
+    def set_profiling_dir(self, path):
+        """
+        Set the directory the pipeline profiling is written to.
+
+        When set, each pipeline records the rows per second of its operations, the busy time of
+        their workers, the time they are blocked on their connectors and the depth of the connectors.
+        The directory is created if it does not exist. The summary and a chrome trace are written to it
+        when the pipeline is stopped.
+
+        Args:
+            path (str): directory of the profiling files, an empty string turns off the profiling.
+
+        Raises:
+            TypeError: If path is not a str.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # the pipelines created after this call are profiled into /tmp/profiling.
+            >>> con.set_profiling_dir("/tmp/profiling")
+        """
+        if not isinstance(path, str):
+            raise TypeError("path should be a str")
+        self.config.set_profiling_dir(path)
+
+    def get_profiling_dir(self):
+        """
+        Get the directory the pipeline profiling is written to.
+
+        Returns:
+            Str, directory of the profiling files, empty if the profiling is off.
+        """
+        return self.config.get_profiling_dir()
+
+    def set_monitor_sampling_interval(self, interval):
+        """
+        Set the interval between two samples of the connectors of a profiled pipeline.
+
+        Args:
+            interval: interval in milliseconds.
+
+        Raises:
+            ValueError: If interval is invalid (<= 0 or > MAX_INT_32).
+        """
+        if interval <= 0 or interval > INT32_MAX:
+            raise ValueError("Interval given is not within the required range")
+        self.config.set_monitor_sampling_interval(interval)
+
+    def get_monitor_sampling_interval(self):
+        """
+        Get the interval between two samples of the connectors of a profiled pipeline.
+
+        Returns:
+            Int, interval in milliseconds.
+        """
+        return self.config.get_monitor_sampling_interval()
+
+    def set_pinned_pool_size(self, size):
+        """
+        Set the size of the pinned memory pool the batches are allocated from.
+
+        When set, the batch operations allocate their batches from a pool of page-locked memory,
+        and the device queue hands the batches to the device without copying them again. A batch
+        which does not fit in the pool is allocated from the regular memory.
+
+        Args:
+            size: size of the pool in MB, 0 means the batches are not pinned. The pool is created the
+                first time a pipeline uses it, later changes of the size other than 0 have no effect.
+
+        Raises:
+            ValueError: If size is invalid (< 0 or > MAX_INT_32).
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # the batches of the pipelines created after this call are allocated from 2 GB of pinned memory.
+            >>> con.set_pinned_pool_size(2048)
+        """
+        if size < 0 or size > INT32_MAX:
+            raise ValueError("Pinned pool size given is not within the required range")
+        self.config.set_pinned_pool_size(size)
+
+    def get_pinned_pool_size(self):
+        """
+        Get the size of the pinned memory pool the batches are allocated from.
+
+        Returns:
+            Int, size of the pool in MB, 0 if the batches are not pinned.
+        """
+        return self.config.get_pinned_pool_size()
+
     def __str__(self):
         """
         String representation of the configurations.
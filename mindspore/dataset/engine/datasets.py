@@ -36,7 +36,7 @@ from mindspore import log as logger
 from . import samplers
 from .iterators import DictIterator, TupleIterator
 from .validators import check, check_batch, check_shuffle, check_map, check_repeat, check_zip, check_rename, \
-    check_project, check_imagefolderdatasetv2, check_mnist_cifar_dataset, check_manifestdataset, \
+    check_cache, check_project, check_imagefolderdatasetv2, check_mnist_cifar_dataset, check_manifestdataset, \
     check_tfrecorddataset, check_vocdataset, check_celebadataset, check_minddataset, check_generatordataset, \
     check_zip_dataset, check_add_column
 from ..core.datatypes import mstype_to_detype, mstypelist_to_detypelist
@@ -385,6 +385,37 @@ class Dataset:
         """
         return MapDataset(self, input_columns, operations, output_columns, columns_order, num_parallel_workers)
 
+    @check_cache
+    def cache(self, cache_mem_size=0, spill_dir=None):
+        """
+        Caches the rows of this dataset during the first epoch and replays them in the later epochs.
+
+        The operations before the cache only run once, so it should be placed after the reading,
+        decoding and deterministic augmentations. Operations with random behaviour, such as shuffle
+        and random augmentations, should be placed after the cache, otherwise every epoch replays
+        the same result.
+
+        Args:
+            cache_mem_size (int, optional): Bytes of tensor data to keep in memory, 0 means no
+                limit (default=0).
+            spill_dir (str, optional): Directory to store the rows which exceed cache_mem_size,
+                mandatory if cache_mem_size is not 0 (default=None).
+
+        Returns:
+            CacheDataset, dataset cached.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> # data is an instance of Dataset object.
+            >>> # decodes the images once, keeps up to 8GB in memory and spills the rest to disk,
+            >>> # then shuffles the cached rows differently in each of the 50 epochs
+            >>> data = data.map(input_columns="image", operations=decode_op)
+            >>> data = data.cache(8 * 1024 * 1024 * 1024, "/tmp/cache")
+            >>> data = data.shuffle(10)
+            >>> data = data.repeat(50)
+        """
+        return CacheDataset(self, cache_mem_size, spill_dir)
+
     @check_repeat
     def repeat(self, count=None):
         """
@@ -987,6 +1018,31 @@ class MapDataset(DatasetOp):
         return self.input[0].get_dataset_size()
 
 
+class CacheDataset(DatasetOp):
+    """
+    The result of applying Cache operator to the input Dataset.
+
+    Args:
+        input_dataset (Dataset): Input Dataset to be cached.
+        cache_mem_size (int): Bytes of tensor data to keep in memory, 0 means no limit.
+        spill_dir (str): Directory to store the rows which exceed cache_mem_size.
+    """
+
+    def __init__(self, input_dataset, cache_mem_size, spill_dir):
+        super().__init__()
+        self.cache_mem_size = cache_mem_size
+        self.spill_dir = spill_dir
+        self.input.append(input_dataset)
+        input_dataset.output.append(self)
+        self._input_indexs = input_dataset.input_indexs
+
+    def get_args(self):
+        args = super().get_args()
+        args["cache_mem_size"] = self.cache_mem_size
+        args["spill_dir"] = self.spill_dir
+        return args
+
+
 class RepeatDataset(DatasetOp):
     """
     The result of applying Repeat operator to the input Dataset.
@@ -1621,16 +1677,22 @@ class MindDataset(SourceDataset):
         shard_id (int, optional): The shard ID within num_shards (default=None). This
             argument should be specified only when num_shards is also specified.
         block_reader (bool, optional): Whether read data by block mode (default=False).
+        use_mmap (bool, optional): Whether read the files through memory maps instead of file reads (default=False).
+            The samples are copied straight from the page cache, it saves the read calls and one copy per sample.
+        read_ahead_size (int, optional): Size in MB of the samples read ahead of the workers, in the order
+            they are sampled, 0 turns the read ahead off (default=None, 64 MB). Not used by the block reader.
 
     Raises:
         ValueError: If num_shards is specified but shard_id is None.
         ValueError: If shard_id is specified but num_shards is None.
         ValueError: If block reader is true but partition is specified.
+        ValueError: If read_ahead_size is negative.
     """
 
     @check_minddataset
     def __init__(self, dataset_file, columns_list=None, num_parallel_workers=None,
-                 shuffle=None, num_shards=None, shard_id=None, block_reader=False):
+                 shuffle=None, num_shards=None, shard_id=None, block_reader=False, use_mmap=False,
+                 read_ahead_size=None):
         super().__init__(num_parallel_workers)
         self.dataset_file = dataset_file
         self.columns_list = columns_list
@@ -1651,6 +1713,8 @@ class MindDataset(SourceDataset):
         self.num_shards = num_shards
         self.shard_id = shard_id
         self.block_reader = block_reader
+        self.use_mmap = use_mmap
+        self.read_ahead_size = read_ahead_size
 
     def get_args(self):
         args = super().get_args()
@@ -1659,6 +1723,8 @@ class MindDataset(SourceDataset):
         args["global_shuffle"] = self.global_shuffle
         args["partitions"] = self.partitions
         args["block_reader"] = self.block_reader
+        args["use_mmap"] = self.use_mmap
+        args["read_ahead_size"] = self.read_ahead_size
         args["num_shards"] = self.num_shards
         args["shard_id"] = self.shard_id
         return args
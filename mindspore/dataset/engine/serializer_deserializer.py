@@ -255,7 +255,8 @@ def create_node(node):
     elif dataset_op == 'MindDataset':
         pyobj = pyclass(node['dataset_file'], node.get('column_list'),
                         node.get('num_parallel_workers'), node.get('seed'), node.get('num_shards'),
-                        node.get('shard_id'), node.get('block_reader'))
+                        node.get('shard_id'), node.get('block_reader'), node.get('use_mmap'),
+                        node.get('read_ahead_size'))
 
     elif dataset_op == 'TFRecordDataset':
         pyobj = pyclass(node['dataset_files'], node.get('schema'), node.get('column_list'),
@@ -309,8 +310,7 @@ def create_node(node):
         pyobj = de.Dataset().batch(node['batch_size'], node.get('drop_remainder'))
 
     elif dataset_op == 'CacheDataset':
-        # Member function cache() is not defined in class Dataset yet.
-        raise RuntimeError(dataset_op + " is not yet supported")
+        pyobj = de.Dataset().cache(node.get('cache_mem_size'), node.get('spill_dir'))
 
     elif dataset_op == 'FilterDataset':
         # Member function filter() is not defined in class Dataset yet.
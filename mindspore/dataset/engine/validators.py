@@ -512,9 +512,9 @@ def check_minddataset(method):
     def new_method(*args, **kwargs):
         param_dict = make_param_dict(method, args, kwargs)
 
-        nreq_param_int = ['num_samples', 'num_parallel_workers', 'seed', 'num_shards', 'shard_id']
+        nreq_param_int = ['num_samples', 'num_parallel_workers', 'seed', 'num_shards', 'shard_id', 'read_ahead_size']
         nreq_param_list = ['columns_list']
-        nreq_param_bool = ['block_reader']
+        nreq_param_bool = ['block_reader', 'use_mmap']
 
         # check dataset_file; required argument
         dataset_file = param_dict.get('dataset_file')
@@ -532,6 +532,10 @@ def check_minddataset(method):
         if (num_shards is not None and shard_id is None) or (num_shards is None and shard_id is not None):
             raise ValueError("num_shards and shard_id need to be set or not set at the same time")
 
+        read_ahead_size = param_dict.get('read_ahead_size')
+        if read_ahead_size is not None and read_ahead_size < 0:
+            raise ValueError("read_ahead_size should not be negative")
+
         return method(*args, **kwargs)
 
     return new_method
@@ -653,6 +657,29 @@ def check_shuffle(method):
     return new_method
 
 
+def check_cache(method):
+    """check the input arguments of cache."""
+    @wraps(method)
+    def new_method(*args, **kwargs):
+        param_dict = make_param_dict(method, args, kwargs)
+
+        cache_mem_size = param_dict.get('cache_mem_size')
+        if cache_mem_size is not None:
+            check_type(cache_mem_size, 'cache_mem_size', int)
+            if cache_mem_size < 0:
+                raise ValueError("cache_mem_size should not be negative.")
+
+        spill_dir = param_dict.get('spill_dir')
+        if spill_dir is not None:
+            check_type(spill_dir, 'spill_dir', str)
+        elif cache_mem_size:
+            raise ValueError("spill_dir is not provided while cache_mem_size is limited.")
+
+        return method(*args, **kwargs)
+
+    return new_method
+
+
 def check_map(method):
     """check the input arguments of map."""
     @wraps(method)
@@ -60,6 +60,8 @@ EXCEPTIONS = dict(
     MRMFetchCandidateFieldsError=[118, 'Failed to fetch candidate category fields.'],
     MRMReadCategoryInfoError=[119, 'Failed to read category information.'],
     MRMFetchDataError=[120, 'Failed to fetch data by category.'],
+    MRMInvalidCompressionError=[121, 'Failed to set compression.'],
+    MRMInvalidRawFormatError=[122, 'Failed to set raw format.'],
 
 
     # MindRecord error 200-299 for File* and MindPage
@@ -206,6 +208,12 @@ class MRMInvalidPageSizeError(MindRecordException):
 class MRMInvalidHeaderSizeError(MindRecordException):
     pass
 
+class MRMInvalidCompressionError(MindRecordException):
+    pass
+
+class MRMInvalidRawFormatError(MindRecordException):
+    pass
+
 class MRMSetHeaderError(MindRecordException):
     pass
 
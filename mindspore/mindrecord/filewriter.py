@@ -301,6 +301,43 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_compression(self, compression):
+        """
+        Set the codec of the blob data, must be called before writing raw data.
+
+        The blob data of each sample is compressed on its own, so a sample is still read alone.
+        A file opened for append keeps its codec.
+
+        Args:
+           compression (str): "NONE" or "LZ", the built-in LZ77 codec.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMInvalidCompressionError: If failed to set compression.
+        """
+        return self._writer.set_compression(compression)
+
+    def set_raw_format(self, raw_format):
+        """
+        Set the format of the raw data, must be called before writing raw data.
+
+        The binary format lays out the fields which are not blobs by the schema, so they are read
+        without being parsed. A float32 field keeps the precision of a float32.
+        A file opened for append keeps its format.
+
+        Args:
+           raw_format (str): "MSGPACK" or "BINARY".
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMInvalidRawFormatError: If failed to set raw format.
+        """
+        return self._writer.set_raw_format(raw_format)
+
     def commit(self):
         """
         Flush data to disk and generate the correspond db files.
@@ -336,10 +373,10 @@ class FileWriter:
             if os.path.exists(item):
                 os.chmod(item, stat.S_IRUSR | stat.S_IWUSR)
                 mindrecord_files.append(item)
-            index_file = item + ".db"
-            if os.path.exists(index_file):
-                os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
-                index_files.append(index_file)
+            for index_file in (item + ".db", item + ".idx"):
+                if os.path.exists(index_file):
+                    os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
+                    index_files.append(index_file)
 
         logger.info("The list of mindrecord files created are: {}, and the list of index files are: {}".format(
             mindrecord_files, index_files))
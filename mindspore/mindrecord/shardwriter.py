@@ -19,7 +19,8 @@ import numpy as np
 import mindspore._c_mindrecord as ms
 from mindspore import log as logger
 from .common.exceptions import MRMOpenError, MRMOpenForAppendError, MRMInvalidHeaderSizeError, \
-    MRMInvalidPageSizeError, MRMSetHeaderError, MRMWriteDatasetError, MRMCommitError
+    MRMInvalidPageSizeError, MRMInvalidCompressionError, MRMInvalidRawFormatError, MRMSetHeaderError, \
+    MRMWriteDatasetError, MRMCommitError
 
 __all__ = ['ShardWriter']
 
@@ -112,6 +113,44 @@ class ShardWriter:
             raise MRMInvalidPageSizeError
         return ret
 
+    def set_compression(self, compression):
+        """
+        Set the codec of the blob pages.
+
+        Args:
+           compression (str): "NONE" or "LZ", each blob row is compressed on its own.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMInvalidCompressionError: If failed to set compression.
+        """
+        ret = self._writer.set_compression(compression)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to set compression.")
+            raise MRMInvalidCompressionError
+        return ret
+
+    def set_raw_format(self, raw_format):
+        """
+        Set the format of the raw rows.
+
+        Args:
+           raw_format (str): "MSGPACK" or "BINARY", the binary rows are laid out by the schema.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMInvalidRawFormatError: If failed to set raw format.
+        """
+        ret = self._writer.set_raw_format(raw_format)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to set raw format.")
+            raise MRMInvalidRawFormatError
+        return ret
+
     def set_shard_header(self, shard_header):
         """
         Set header which contains schema and index before write raw data.
@@ -107,6 +107,11 @@ class MSPREDICT_API Session {
   /// The caller needs to free memory of outputs.
   std::map<std::string, std::vector<Tensor *>> GetAllOutput();
 
+  ///\brief Get the size of the workspace of the intermediate tensors.
+  ///
+  ///\return The peak memory of the intermediate tensors in bytes, 0 if they are allocated on demand.
+  size_t GetWorkspaceSize();
+
  protected:
   ///\brief Init the executor.
   ///
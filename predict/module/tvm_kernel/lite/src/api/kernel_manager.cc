@@ -135,11 +135,13 @@ void ConfigThreadPool(int mode = 1, int nthreads = 0, bool execute_self = true)
 
 #include <lite/api/km_api.h>
 #include <tvm/runtime/packed_func.h>
+#include <algorithm>
 #include <bitset>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <shared_mutex>
 #include <string>
@@ -410,6 +412,51 @@ static runnerType Pack_NCHW2NHWC(runnerType fun) {
   return runner;
 }
 
+// the matmul kernels do not take a bias or an activation, the ones fused into a matmul by the converter run after it
+static runnerType Pack_MatMulBiasAct(runnerType fun, bool hasBias, mindspore::predict::ActivationType actType) {
+  if (fun == nullptr) {
+    MS_LOGE("input fun is nullptr");
+    return nullptr;
+  }
+  float minValue = -std::numeric_limits<float>::max();
+  float maxValue = std::numeric_limits<float>::max();
+  if (actType == mindspore::predict::ActivationType_RELU) {
+    minValue = 0.0f;
+  } else if (actType == mindspore::predict::ActivationType_RELU6) {
+    minValue = 0.0f;
+    maxValue = 6.0f;
+  } else if (actType != mindspore::predict::ActivationType_NO_ACTIVATION) {
+    MS_LOGE("matmul activation %d is not supported", actType);
+    return nullptr;
+  }
+  auto runner = [fun, hasBias, minValue, maxValue](const std::vector<DLTensor *> &tensors) -> int {
+    if (tensors.size() != (hasBias ? 4u : 3u) || tensors.back() == nullptr || tensors.back()->ndim != 2) {
+      MS_LOGE("matmul with bias or activation gets %zu tensors", tensors.size());
+      return 1;
+    }
+    int ret = fun({tensors[0], tensors[1], tensors.back()});
+    if (ret != 0) {
+      return ret;
+    }
+    auto output = tensors.back();
+    auto c = reinterpret_cast<float *>(static_cast<char *>(output->data) + output->byte_offset);
+    const float *bias = nullptr;
+    if (hasBias) {
+      bias = reinterpret_cast<const float *>(static_cast<char *>(tensors[2]->data) + tensors[2]->byte_offset);
+    }
+    int64_t m = output->shape[0];
+    int64_t n = output->shape[1];
+    for (int64_t i = 0; i < m; ++i) {
+      for (int64_t j = 0; j < n; ++j) {
+        float value = c[i * n + j] + (bias == nullptr ? 0.0f : bias[j]);
+        c[i * n + j] = std::min(std::max(value, minValue), maxValue);
+      }
+    }
+    return 0;
+  };
+  return runner;
+}
+
 runnerType __attribute__((noinline)) GetKernel_Insert_vector_int32(const std::string &fid,
                                                                    const std::vector<int32_t> &vec) {
   auto f = GetFunction(fid);
@@ -1561,7 +1608,14 @@ static runnerType GetKernel_MatMul(const mindspore::predict::OpDef &opdef, const
   std::string fid = "MatMul_ndimA2_ndimB2_" + opAttr.dtype;
   fid += (op->transposeA()) ? "_1" : "_0";
   fid += (op->transposeB()) ? "_1" : "_0";
-  return GetKernel(fid);
+  if (!op->hasBias() && op->activationType() == mindspore::predict::ActivationType_NO_ACTIVATION) {
+    return GetKernel(fid);
+  }
+  if (opAttr.dtype != "float32") {
+    MS_LOGE("matmul with bias or activation of %s is not supported", opAttr.dtype.c_str());
+    return nullptr;
+  }
+  return Pack_MatMulBiasAct(GetKernel(fid), op->hasBias(), op->activationType());
 }
 
 static runnerType GetKernel_Softmax(const mindspore::predict::OpDef &opdef, const std::vector<DLTensor *> &tensors,
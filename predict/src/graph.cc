@@ -58,6 +58,10 @@ Graph *Graph::CreateFromBuf(const char *buf, size_t size, const Context &ctx) {
 Graph::Graph() = default;
 
 Graph::~Graph() {
+  if (memoryPlan != nullptr) {
+    delete memoryPlan;
+    memoryPlan = nullptr;
+  }
   for (auto &subgraph : subgraphs) {
     delete subgraph;
   }
@@ -88,6 +92,24 @@ int Graph::Build(const GraphDef &graphDef, const Context &ctx) {
     }
   }
 
+  // the tensors of a subgraph are not planned with the tensors of another one
+  if (subgraphs.size() == 1) {
+    memoryPlan = new (std::nothrow) MemoryPlan();
+    if (memoryPlan == nullptr) {
+      MS_LOGE("new MemoryPlan fail");
+      return RET_ERROR;
+    }
+    // the outputs are moved out of the graph after a run, they are not planned
+    auto outputs = GetOutputs();
+    for (auto &outputNode : GetOutputsMap()) {
+      outputs.insert(outputs.end(), outputNode.second.begin(), outputNode.second.end());
+    }
+    if (memoryPlan->Build(readyQue, depends, GetInputs(), outputs) != RET_OK) {
+      MS_LOGW("build memory plan failed, the tensors are allocated on demand");
+      delete memoryPlan;
+      memoryPlan = nullptr;
+    }
+  }
   return RET_OK;
 }
 
@@ -114,6 +136,8 @@ void Graph::FreeAllTensors() {
 
 std::vector<SubGraph *> *Graph::Subgraphs() { return &subgraphs; }
 
+size_t Graph::GetWorkspaceSize() { return memoryPlan == nullptr ? 0 : memoryPlan->GetWorkspaceSize(); }
+
 SubGraph::SubGraph() = default;
 
 SubGraph::~SubGraph() {
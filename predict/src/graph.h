@@ -27,6 +27,7 @@
 #include "common/graph_util.h"
 #include "include/tensor.h"
 #include "src/node.h"
+#include "src/memory_plan.h"
 
 #define MSPREDICT_API __attribute__((visibility("default")))
 
@@ -88,12 +89,15 @@ class MSPREDICT_API Graph {
   int Build(const GraphDef &def, const Context &ctx);
   std::vector<SubGraph *> *Subgraphs();
 
+  size_t GetWorkspaceSize();
+
  protected:
   friend class GraphExecution;
 
   std::vector<SubGraph *> subgraphs;
   std::unordered_map<Node *, std::unordered_set<Node *>> depends;  // records the dependencies
   std::deque<Node *> readyQue;  // the nodes which can execute without any dependencies
+  MemoryPlan *memoryPlan = nullptr;  // the intermediate tensors are allocated on demand without a plan
 };
 }  // namespace predict
 }  // namespace mindspore
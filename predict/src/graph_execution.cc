@@ -114,6 +114,30 @@ int GraphExecution::MallocOutput() {
       return RET_ERROR;
     }
   }
+  if (graph->memoryPlan == nullptr) {
+    return RET_OK;
+  }
+  // with a memory plan the nodes do not allocate their outputs, the outputs of the graph are allocated here
+  for (auto &outputNode : graph->GetOutputsMap()) {
+    for (auto tensor : outputNode.second) {
+      auto ret = tensor->MallocData();
+      if (ret != RET_OK) {
+        MS_LOGE("malloc output data failed");
+        return RET_ERROR;
+      }
+    }
+  }
+  return RET_OK;
+}
+
+int GraphExecution::RunPlan() {
+  for (auto node : graph->memoryPlan->GetNodes()) {
+    auto ret = node->Execute();
+    if (ret != RET_OK) {
+      MS_LOGE("node (%s) failed to run op (%s). error code:%d", node->ID().c_str(), node->Type().c_str(), ret);
+      return ret;
+    }
+  }
   return RET_OK;
 }
 
@@ -263,6 +287,15 @@ int GraphExecution::Run(const std::vector<Tensor *> &inputs) {
     return ret;
   }
 
+  if (graph->memoryPlan != nullptr) {
+    ret = RunPlan();
+    ResetInputData();
+    if (ret != RET_OK) {
+      FreeAllTensors();
+    }
+    return ret;
+  }
+
   while (!readyQue.empty()) {
     auto *node = readyQue.front();
     readyQue.pop_front();
@@ -50,6 +50,7 @@ class GraphExecution {
  private:
   void ResetInputData();
   int MallocOutput();
+  int RunPlan();
   void FreeTensors(std::vector<Tensor *> *tensors);
   int TransInputDataToNc4hw4(const Tensor &src, Tensor *dst);
   int CopyOutputTensors(const std::vector<Tensor *> &refOutputs, std::vector<Tensor *> *outputs);
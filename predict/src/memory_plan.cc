@@ -0,0 +1,203 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/memory_plan.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include "common/mslog.h"
+#include "include/errorcode.h"
+#include "schema/inner/ms_generated.h"
+
+namespace mindspore {
+namespace predict {
+namespace {
+const size_t WORKSPACE_ALIGN = 64;
+
+// the ops whose output element i only depends on the input elements i, which can write over their first input
+const std::unordered_set<std::string> IN_PLACE_OPS = {"Activation", "BiasAdd", "Scale", "Eltwise", "Add", "Mul",
+                                                     "Maximum", "Power", "Exp", "CaffePReLU", "FusedBatchNorm",
+                                                     "CaffeBatchNorm"};
+
+size_t Align(size_t size) { return (size + WORKSPACE_ALIGN - 1) / WORKSPACE_ALIGN * WORKSPACE_ALIGN; }
+}  // namespace
+
+MemoryPlan::~MemoryPlan() { Release(); }
+
+int MemoryPlan::InitNodes(std::deque<Node *> readyQue,
+                          std::unordered_map<Node *, std::unordered_set<Node *>> depends) {
+  // the same order as GraphExecution::Run takes the nodes from the ready queue
+  while (!readyQue.empty()) {
+    auto *node = readyQue.front();
+    readyQue.pop_front();
+    nodes.push_back(node);
+    for (auto outNode : node->GetAllOutEdges()) {
+      auto nodeDepend = depends.find(outNode);
+      if (nodeDepend == depends.end()) {
+        continue;
+      }
+      nodeDepend->second.erase(node);
+      if (nodeDepend->second.empty()) {
+        depends.erase(nodeDepend);
+        readyQue.push_back(outNode);
+      }
+    }
+  }
+  if (!depends.empty()) {
+    MS_LOGE("%zu nodes are never ready to run", depends.size());
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+bool MemoryPlan::IsInPlace(Node *node, size_t index, const std::unordered_map<Tensor *, size_t> &lastUses) {
+  auto &inputs = node->GetInputTensors();
+  auto &outputs = node->GetOutputTensors();
+  if (outputs.size() != 1 || inputs.empty() || IN_PLACE_OPS.find(node->Type()) == IN_PLACE_OPS.end()) {
+    return false;
+  }
+  auto input = inputs.front();
+  auto output = outputs.front();
+  auto bufferIter = tensorBuffers.find(input);
+  if (bufferIter == tensorBuffers.end()) {
+    return false;
+  }
+  auto useIter = lastUses.find(input);
+  if (useIter == lastUses.end() || useIter->second != index) {
+    return false;
+  }
+  // a buffer which an earlier op took in place already lives until this op
+  if (buffers[bufferIter->second].end != index) {
+    return false;
+  }
+  return input->GetDataSize() == output->GetDataSize() && input->GetFormat() == output->GetFormat() &&
+         input->GetDataType() == output->GetDataType();
+}
+
+int MemoryPlan::Build(const std::deque<Node *> &readyQue,
+                      const std::unordered_map<Node *, std::unordered_set<Node *>> &depends,
+                      const std::vector<Tensor *> &graphInputs, const std::vector<Tensor *> &graphOutputs) {
+  auto ret = InitNodes(readyQue, depends);
+  if (ret != RET_OK) {
+    return ret;
+  }
+
+  std::unordered_set<Tensor *> excluded(graphInputs.begin(), graphInputs.end());
+  excluded.insert(graphOutputs.begin(), graphOutputs.end());
+  std::unordered_map<Tensor *, size_t> lastUses;
+  for (size_t i = 0; i < nodes.size(); i++) {
+    for (auto tensor : nodes[i]->GetInputTensors()) {
+      lastUses[tensor] = i;
+    }
+  }
+
+  for (size_t i = 0; i < nodes.size(); i++) {
+    auto node = nodes[i];
+    for (auto tensor : node->GetOutputTensors()) {
+      if (tensor == nullptr) {
+        MS_LOGE("tensor in outputs of node %s is nullptr", node->ID().c_str());
+        return RET_ERROR;
+      }
+      if (excluded.find(tensor) != excluded.end() || tensor->GetData() != nullptr ||
+          tensor->RefCount() == MSConst_WEIGHT_REFCOUNT) {
+        continue;
+      }
+      if (tensorBuffers.find(tensor) != tensorBuffers.end()) {
+        MS_LOGE("tensor is the output of more than one node, node %s", node->ID().c_str());
+        return RET_ERROR;
+      }
+      auto useIter = lastUses.find(tensor);
+      size_t end = useIter == lastUses.end() ? i : std::max(useIter->second, i);
+      if (IsInPlace(node, i, lastUses)) {
+        auto bufferId = tensorBuffers[node->GetInputTensors().front()];
+        buffers[bufferId].end = end;
+        tensorBuffers[tensor] = bufferId;
+        continue;
+      }
+      tensorBuffers[tensor] = buffers.size();
+      buffers.push_back(Buffer{Align(tensor->GetDataSize()), i, end, 0});
+    }
+  }
+
+  AssignOffsets();
+  if (workspaceSize > 0) {
+    workspace = malloc(workspaceSize + WORKSPACE_ALIGN);
+    if (workspace == nullptr) {
+      MS_LOGE("malloc workspace of %zu bytes failed", workspaceSize);
+      return RET_ERROR;
+    }
+  }
+  auto base = reinterpret_cast<uintptr_t>(workspace);
+  base = (base + WORKSPACE_ALIGN - 1) / WORKSPACE_ALIGN * WORKSPACE_ALIGN;
+  for (auto &iter : tensorBuffers) {
+    auto tensor = iter.first;
+    refCounts[tensor] = tensor->RefCount();
+    tensor->SetData(reinterpret_cast<void *>(base + buffers[iter.second].offset));
+    // the planned tensors are never freed by their consumers, as the weights
+    tensor->AddRef(MSConst_WEIGHT_REFCOUNT - tensor->RefCount());
+  }
+  MS_LOGI("memory plan of %zu nodes: %zu tensors in %zu buffers, workspace %zu bytes", nodes.size(),
+          tensorBuffers.size(), buffers.size(), workspaceSize);
+  return RET_OK;
+}
+
+void MemoryPlan::AssignOffsets() {
+  // the larger buffers first, each at the lowest offset which does not overlap the buffers alive with it
+  std::vector<size_t> order(buffers.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [this](size_t a, size_t b) { return buffers[a].size > buffers[b].size; });
+  std::vector<size_t> placed;
+  for (auto id : order) {
+    auto &buffer = buffers[id];
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (auto other : placed) {
+      auto &otherBuffer = buffers[other];
+      if (otherBuffer.start <= buffer.end && buffer.start <= otherBuffer.end) {
+        ranges.emplace_back(otherBuffer.offset, otherBuffer.offset + otherBuffer.size);
+      }
+    }
+    std::sort(ranges.begin(), ranges.end());
+    size_t offset = 0;
+    for (auto &range : ranges) {
+      if (offset + buffer.size <= range.first) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+    buffer.offset = offset;
+    workspaceSize = std::max(workspaceSize, offset + buffer.size);
+    placed.push_back(id);
+  }
+}
+
+void MemoryPlan::Release() {
+  for (auto &iter : refCounts) {
+    iter.first->SetData(nullptr);
+    iter.first->AddRef(iter.second - iter.first->RefCount());
+  }
+  refCounts.clear();
+  if (workspace != nullptr) {
+    free(workspace);
+    workspace = nullptr;
+  }
+}
+}  // namespace predict
+}  // namespace mindspore
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREDICT_SRC_MEMORY_PLAN_H_
+#define PREDICT_SRC_MEMORY_PLAN_H_
+
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "include/tensor.h"
+#include "src/node.h"
+
+namespace mindspore {
+namespace predict {
+// The static memory plan of the intermediate tensors of a graph, built once with the graph.
+//
+// The nodes are ordered as the graph execution runs them, and a tensor which a node produces and which is not an
+// output of the graph lives from its producer to its last consumer. The tensors get offsets in one workspace, so
+// that the tensors alive at the same time do not overlap. The output of an elementwise op takes the memory of its
+// first input when the op is the last consumer of that input.
+class MemoryPlan {
+ public:
+  MemoryPlan() = default;
+  ~MemoryPlan();
+
+  int Build(const std::deque<Node *> &readyQue, const std::unordered_map<Node *, std::unordered_set<Node *>> &depends,
+            const std::vector<Tensor *> &graphInputs, const std::vector<Tensor *> &graphOutputs);
+
+  // the nodes in the order of execution
+  const std::vector<Node *> &GetNodes() const { return nodes; }
+
+  // the peak memory of the intermediate tensors
+  size_t GetWorkspaceSize() const { return workspaceSize; }
+
+ private:
+  struct Buffer {
+    size_t size;
+    size_t start;  // index of the producer
+    size_t end;    // index of the last consumer
+    size_t offset;
+  };
+
+  int InitNodes(std::deque<Node *> readyQue, std::unordered_map<Node *, std::unordered_set<Node *>> depends);
+  bool IsInPlace(Node *node, size_t index, const std::unordered_map<Tensor *, size_t> &lastUses);
+  void AssignOffsets();
+  void Release();
+
+  std::vector<Node *> nodes;
+  std::vector<Buffer> buffers;
+  std::unordered_map<Tensor *, size_t> tensorBuffers;
+  std::unordered_map<Tensor *, int> refCounts;  // the reference counts of the planned tensors before the plan
+  void *workspace = nullptr;
+  size_t workspaceSize = 0;
+};
+}  // namespace predict
+}  // namespace mindspore
+
+#endif  // PREDICT_SRC_MEMORY_PLAN_H_
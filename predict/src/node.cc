@@ -106,11 +106,7 @@ int Node::Run(const Context &ctx) {
     MS_LOGE("MallocOutput failed: %d", ret);
     return ret;
   }
-  if (op == nullptr) {
-    MS_LOGE("op is nullptr.");
-    return RET_ERROR;
-  }
-  ret = op->Execute(inputs, outputs);
+  ret = Execute();
   if (ret != RET_OK) {
     return ret;
   }
@@ -118,6 +114,14 @@ int Node::Run(const Context &ctx) {
   return RET_OK;
 }
 
+int Node::Execute() {
+  if (op == nullptr) {
+    MS_LOGE("op is nullptr.");
+    return RET_ERROR;
+  }
+  return op->Execute(inputs, outputs);
+}
+
 int Node::MallocOutput(const Context &ctx) {
   size_t refCount = outEdges.size();
   for (auto tensor : outputs) {
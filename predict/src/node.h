@@ -48,6 +48,7 @@ class Node {
 
   int InitOp(const OpDef &opDef, const Context &ctx);
   int Run(const Context &ctx);
+  int Execute();
   int MallocOutput(const Context &ctx);
   void FreeInput();
 
@@ -34,7 +34,7 @@ struct MSPREDICT_API OpDesc {
   OP_ARCH arch;
   OpT type;
 
-  bool operator<(const OpDesc &dst) const { return (arch < dst.arch) || (type < dst.type); }
+  bool operator<(const OpDesc &dst) const { return (arch < dst.arch) || (arch == dst.arch && type < dst.type); }
 };
 
 class MSPREDICT_API OpBase {
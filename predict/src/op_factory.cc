@@ -29,19 +29,23 @@ OpFactory *OpFactory::GetInstance() {
 
 OpBase *OpFactory::GetOp(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs, const OpDef &opDef,
                          const Context &ctx, const OpDesc &desc) {
+  // the builtin ops first, their creators return nullptr for what they do not support
+  MS_ASSERT(OpRegistry::GetInstance() != nullptr);
+  auto creator = OpRegistry::GetInstance()->GetOpCreator(desc);
+  if (creator) {
+    auto op = creator(inputs, outputs, opDef, ctx, desc);
+    if (op != nullptr) {
+      return op;
+    }
+  }
   MS_ASSERT(GetRegistryInstance() != nullptr);
   auto *reg = GetRegistryInstance()->GetInstance<OpRegistry>(MODULE_REG_NAME_OP_REGISTRY);
   if (reg != nullptr) {
-    auto creator = reg->GetOpCreator(desc);
+    creator = reg->GetOpCreator(desc);
     if (creator) {
       return creator(inputs, outputs, opDef, ctx, desc);
     }
   }
-  MS_ASSERT(OpRegistry::GetInstance() != nullptr);
-  auto creator = OpRegistry::GetInstance()->GetOpCreator(desc);
-  if (creator) {
-    return creator(inputs, outputs, opDef, ctx, desc);
-  }
   return nullptr;
 }
 }  // namespace predict
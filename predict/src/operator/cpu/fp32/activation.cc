@@ -0,0 +1,90 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/mslog.h"
+#include "src/op_registry.h"
+#include "src/operator/cpu/include/fp32_op_base.h"
+
+namespace mindspore {
+namespace predict {
+namespace {
+const size_t kActivationBlock = 4096;
+}  // namespace
+
+// Activation of fp32 tensors of any layout but NC4HW4, split in blocks of elements for the threads
+class ActivationFp32 : public Fp32OpBase {
+ public:
+  ActivationFp32(const OpDef &opDef, const Context &ctx)
+      : Fp32OpBase(opDef, ctx), type(opDef.attr_as_Activation()->type()) {}
+  ~ActivationFp32() override = default;
+
+  int Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+  int Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+ private:
+  ActivationType type;
+};
+
+int ActivationFp32::Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  if (!MSIsActSupported(type)) {
+    MS_LOGI("%s: activation type %d is not supported", name.c_str(), type);
+    return RET_ERROR;
+  }
+  if (!CheckTensors(inputs, outputs, 1, 1)) {
+    return RET_ERROR;
+  }
+  if (inputs[0]->GetElementSize() != outputs[0]->GetElementSize()) {
+    MS_LOGE("%s: output size %zu is not the input size %zu", name.c_str(), outputs[0]->GetElementSize(),
+            inputs[0]->GetElementSize());
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int ActivationFp32::Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  auto input = static_cast<const float *>(inputs[0]->GetData());
+  auto output = static_cast<float *>(outputs[0]->GetData());
+  if (input == nullptr || output == nullptr) {
+    MS_LOGE("%s: data of tensors is nullptr", name.c_str());
+    return RET_ERROR;
+  }
+  return ParallelRange(inputs[0]->GetElementSize(), kActivationBlock, [&](size_t begin, size_t end) {
+    MSActivationFp32(input + begin, output + begin, end - begin, type);
+  });
+}
+
+OpBase *CreateActivationFp32(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                             const OpDef &opDef, const Context &ctx, const OpDesc &desc) {
+  if (opDef.attr_as_Activation() == nullptr) {
+    MS_LOGE("opDef.attr_as_Activation() is nullptr");
+    return nullptr;
+  }
+  auto op = std::unique_ptr<ActivationFp32>(new (std::nothrow) ActivationFp32(opDef, ctx));
+  if (op == nullptr) {
+    MS_LOGE("new ActivationFp32 failed");
+    return nullptr;
+  }
+  if (op->Init(inputs, outputs) != RET_OK) {
+    return nullptr;
+  }
+  return op.release();
+}
+
+REG_OP(X86_FP32, OpT_Activation, CreateActivationFp32)
+}  // namespace predict
+}  // namespace mindspore
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "common/mslog.h"
+#include "src/op_registry.h"
+#include "src/operator/cpu/include/fp32_op_base.h"
+
+namespace mindspore {
+namespace predict {
+namespace {
+// the im2col columns of a tile are at most this many floats, to stay in the l2 cache with the weights
+const size_t kConvColBlockSize = 128 * 1024;
+const size_t kConvMinTile = 64;
+}  // namespace
+
+// Conv2D of NCHW fp32 tensors as a gemm of the weights and the im2col matrix of the input, the weights in
+// [outChannel, inChannel / group, kernelH, kernelW]. A 1x1 convolution with no stride and no pad takes the input as
+// the matrix. The work is split in tiles of the output pixels of each image and group, and a tile is im2col'ed right
+// before its gemm, so the columns are still in the cache.
+class ConvolutionFp32 : public Fp32OpBase {
+ public:
+  ConvolutionFp32(const OpDef &opDef, const Context &ctx) : Fp32OpBase(opDef, ctx), attr(opDef.attr_as_Conv2D()) {}
+  ~ConvolutionFp32() override = default;
+
+  int Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+  int Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+ private:
+  void RunTile(const float *input, const float *weight, const float *bias, float *output, size_t unit, float *col);
+
+  const Conv2D *attr;
+  MSConvParam param{};
+  size_t batch = 0;
+  size_t inChannel = 0;
+  size_t outChannel = 0;
+  size_t group = 1;
+  size_t tileSize = 0;
+  size_t tileNum = 0;
+  bool direct = false;
+  std::vector<float> colBuf;
+};
+
+int ConvolutionFp32::Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  if (!CheckTensors(inputs, outputs, attr->hasBias() ? 3 : 2, 1) || !MSIsActSupported(attr->activationType())) {
+    return RET_ERROR;
+  }
+  std::vector<size_t> inDims;
+  std::vector<size_t> outDims;
+  std::vector<size_t> weightDims;
+  if (!GetNchwDims(inputs[0], false, &inDims) || !GetNchwDims(outputs[0], isLastConv, &outDims) ||
+      !GetNchwDims(inputs[1], false, &weightDims)) {
+    return RET_ERROR;
+  }
+  batch = inDims[0];
+  inChannel = inDims[1];
+  outChannel = outDims[1];
+  group = attr->group() > 1 ? static_cast<size_t>(attr->group()) : 1;
+  if (outDims[0] != batch || inChannel % group != 0 || outChannel % group != 0 || weightDims[0] != outChannel ||
+      weightDims[1] != inChannel / group) {
+    MS_LOGE("%s: weight shape does not match the input and output channels", name.c_str());
+    return RET_ERROR;
+  }
+  if (attr->hasBias() && inputs[2]->GetElementSize() != outChannel) {
+    MS_LOGE("%s: bias size %zu is not the output channels %zu", name.c_str(), inputs[2]->GetElementSize(), outChannel);
+    return RET_ERROR;
+  }
+  param = {inDims[2],
+           inDims[3],
+           outDims[2],
+           outDims[3],
+           weightDims[2],
+           weightDims[3],
+           static_cast<size_t>(std::max(attr->strideH(), 1)),
+           static_cast<size_t>(std::max(attr->strideW(), 1)),
+           static_cast<size_t>(std::max(attr->dilateH(), 1)),
+           static_cast<size_t>(std::max(attr->dilateW(), 1)),
+           static_cast<size_t>(std::max(attr->padUp(), 0)),
+           static_cast<size_t>(std::max(attr->padLeft(), 0))};
+  direct = param.kernelH == 1 && param.kernelW == 1 && param.strideH == 1 && param.strideW == 1 && param.padUp == 0 &&
+           param.padLeft == 0 && param.outH == param.inH && param.outW == param.inW;
+  size_t plane = param.outH * param.outW;
+  size_t depth = inChannel / group * param.kernelH * param.kernelW;
+  tileSize = direct ? (plane + threadNum - 1) / threadNum : kConvColBlockSize / std::max<size_t>(depth, 1);
+  tileSize = std::min(std::max(tileSize, kConvMinTile), std::max<size_t>(plane, 1));
+  tileNum = (plane + tileSize - 1) / tileSize;
+  return RET_OK;
+}
+
+void ConvolutionFp32::RunTile(const float *input, const float *weight, const float *bias, float *output, size_t unit,
+                              float *col) {
+  const size_t plane = param.outH * param.outW;
+  const size_t inPlane = param.inH * param.inW;
+  const size_t groupIn = inChannel / group;
+  const size_t groupOut = outChannel / group;
+  const size_t depth = groupIn * param.kernelH * param.kernelW;
+  size_t n = unit / (group * tileNum);
+  size_t g = unit / tileNum % group;
+  size_t begin = unit % tileNum * tileSize;
+  size_t end = std::min(begin + tileSize, plane);
+  const float *src = input + (n * inChannel + g * groupIn) * inPlane;
+  float *dst = output + (n * outChannel + g * groupOut) * plane + begin;
+  const float *groupWeight = weight + g * groupOut * depth;
+  if (direct) {
+    MSGemmFp32(false, false, groupOut, end - begin, depth, groupWeight, depth, src + begin, inPlane, dst, plane);
+  } else {
+    MSIm2ColFp32(src, col, groupIn, param, begin, end);
+    MSGemmFp32(false, false, groupOut, end - begin, depth, groupWeight, depth, col, end - begin, dst, plane);
+  }
+  for (size_t c = 0; c < groupOut; ++c) {
+    MSBiasActFp32(dst + c * plane, bias == nullptr ? nullptr : bias + g * groupOut + c, 1, end - begin,
+                  attr->activationType());
+  }
+}
+
+int ConvolutionFp32::Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  auto input = static_cast<const float *>(inputs[0]->GetData());
+  auto weight = static_cast<const float *>(inputs[1]->GetData());
+  auto bias = attr->hasBias() ? static_cast<const float *>(inputs[2]->GetData()) : nullptr;
+  auto output = static_cast<float *>(outputs[0]->GetData());
+  if (input == nullptr || weight == nullptr || output == nullptr || (attr->hasBias() && bias == nullptr)) {
+    MS_LOGE("%s: data of tensors is nullptr", name.c_str());
+    return RET_ERROR;
+  }
+  size_t units = batch * group * tileNum;
+  size_t colSize = direct ? 0 : inChannel / group * param.kernelH * param.kernelW * tileSize;
+  colBuf.resize(colSize * threadNum);
+  auto ret = ParallelFor(units, 1, [&](int slot, size_t begin, size_t end) {
+    for (size_t unit = begin; unit < end; ++unit) {
+      RunTile(input, weight, bias, output, unit, colBuf.data() + colSize * slot);
+    }
+    return RET_OK;
+  });
+  if (ret != RET_OK) {
+    return ret;
+  }
+  return isLastConv ? ToNhwc(outputs[0]) : RET_OK;
+}
+
+OpBase *CreateConvolutionFp32(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                              const OpDef &opDef, const Context &ctx, const OpDesc &desc) {
+  if (opDef.attr_as_Conv2D() == nullptr) {
+    MS_LOGE("opDef.attr_as_Conv2D() is nullptr");
+    return nullptr;
+  }
+  auto op = std::unique_ptr<ConvolutionFp32>(new (std::nothrow) ConvolutionFp32(opDef, ctx));
+  if (op == nullptr) {
+    MS_LOGE("new ConvolutionFp32 failed");
+    return nullptr;
+  }
+  if (op->Init(inputs, outputs) != RET_OK) {
+    return nullptr;
+  }
+  return op.release();
+}
+
+REG_OP(X86_FP32, OpT_Conv2D, CreateConvolutionFp32)
+}  // namespace predict
+}  // namespace mindspore
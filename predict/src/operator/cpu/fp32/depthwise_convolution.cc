@@ -0,0 +1,132 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "common/mslog.h"
+#include "src/op_registry.h"
+#include "src/operator/cpu/include/fp32_op_base.h"
+
+namespace mindspore {
+namespace predict {
+// DepthwiseConv2D of NCHW fp32 tensors, the weights in [inChannel, channelMultiplier, kernelH, kernelW]. Output
+// channel c * channelMultiplier + m is the convolution of input channel c, a plane for each task at a time.
+class DepthwiseConvolutionFp32 : public Fp32OpBase {
+ public:
+  DepthwiseConvolutionFp32(const OpDef &opDef, const Context &ctx)
+      : Fp32OpBase(opDef, ctx), attr(opDef.attr_as_DepthwiseConv2D()) {}
+  ~DepthwiseConvolutionFp32() override = default;
+
+  int Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+  int Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+ private:
+  const DepthwiseConv2D *attr;
+  MSConvParam param{};
+  size_t batch = 0;
+  size_t inChannel = 0;
+  size_t multiplier = 1;
+};
+
+int DepthwiseConvolutionFp32::Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  if (!CheckTensors(inputs, outputs, attr->hasBias() ? 3 : 2, 1) || !MSIsActSupported(attr->activationType())) {
+    return RET_ERROR;
+  }
+  std::vector<size_t> inDims;
+  std::vector<size_t> outDims;
+  std::vector<size_t> weightDims;
+  if (!GetNchwDims(inputs[0], false, &inDims) || !GetNchwDims(outputs[0], isLastConv, &outDims) ||
+      !GetNchwDims(inputs[1], false, &weightDims)) {
+    return RET_ERROR;
+  }
+  batch = inDims[0];
+  inChannel = inDims[1];
+  multiplier = weightDims[1];
+  if (outDims[0] != batch || weightDims[0] != inChannel || outDims[1] != inChannel * multiplier) {
+    MS_LOGE("%s: weight shape does not match the input and output channels", name.c_str());
+    return RET_ERROR;
+  }
+  if (attr->hasBias() && inputs[2]->GetElementSize() != outDims[1]) {
+    MS_LOGE("%s: bias size %zu is not the output channels %zu", name.c_str(), inputs[2]->GetElementSize(),
+            outDims[1]);
+    return RET_ERROR;
+  }
+  param = {inDims[2],
+           inDims[3],
+           outDims[2],
+           outDims[3],
+           weightDims[2],
+           weightDims[3],
+           static_cast<size_t>(std::max(attr->strideH(), 1)),
+           static_cast<size_t>(std::max(attr->strideW(), 1)),
+           static_cast<size_t>(std::max(attr->dilateH(), 1)),
+           static_cast<size_t>(std::max(attr->dilateW(), 1)),
+           static_cast<size_t>(std::max(attr->padUp(), 0)),
+           static_cast<size_t>(std::max(attr->padLeft(), 0))};
+  return RET_OK;
+}
+
+int DepthwiseConvolutionFp32::Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  auto input = static_cast<const float *>(inputs[0]->GetData());
+  auto weight = static_cast<const float *>(inputs[1]->GetData());
+  auto bias = attr->hasBias() ? static_cast<const float *>(inputs[2]->GetData()) : nullptr;
+  auto output = static_cast<float *>(outputs[0]->GetData());
+  if (input == nullptr || weight == nullptr || output == nullptr || (attr->hasBias() && bias == nullptr)) {
+    MS_LOGE("%s: data of tensors is nullptr", name.c_str());
+    return RET_ERROR;
+  }
+  const size_t inPlane = param.inH * param.inW;
+  const size_t outPlane = param.outH * param.outW;
+  const size_t kernelSize = param.kernelH * param.kernelW;
+  const size_t outChannel = inChannel * multiplier;
+  size_t units = batch * outChannel;
+  auto ret = ParallelRange(units, 1, [&](size_t begin, size_t end) {
+    for (size_t unit = begin; unit < end; ++unit) {
+      size_t n = unit / outChannel;
+      size_t oc = unit % outChannel;
+      float *dst = output + unit * outPlane;
+      MSDepthwiseFp32(input + (n * inChannel + oc / multiplier) * inPlane, weight + oc * kernelSize,
+                      bias == nullptr ? 0.0f : bias[oc], dst, param);
+      MSBiasActFp32(dst, nullptr, 1, outPlane, attr->activationType());
+    }
+  });
+  if (ret != RET_OK) {
+    return ret;
+  }
+  return isLastConv ? ToNhwc(outputs[0]) : RET_OK;
+}
+
+OpBase *CreateDepthwiseConvolutionFp32(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                                       const OpDef &opDef, const Context &ctx, const OpDesc &desc) {
+  if (opDef.attr_as_DepthwiseConv2D() == nullptr) {
+    MS_LOGE("opDef.attr_as_DepthwiseConv2D() is nullptr");
+    return nullptr;
+  }
+  auto op = std::unique_ptr<DepthwiseConvolutionFp32>(new (std::nothrow) DepthwiseConvolutionFp32(opDef, ctx));
+  if (op == nullptr) {
+    MS_LOGE("new DepthwiseConvolutionFp32 failed");
+    return nullptr;
+  }
+  if (op->Init(inputs, outputs) != RET_OK) {
+    return nullptr;
+  }
+  return op.release();
+}
+
+REG_OP(X86_FP32, OpT_DepthwiseConv2D, CreateDepthwiseConvolutionFp32)
+}  // namespace predict
+}  // namespace mindspore
@@ -0,0 +1,209 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "common/mslog.h"
+#include "src/op_registry.h"
+#include "src/operator/cpu/include/fp32_op_base.h"
+
+namespace mindspore {
+namespace predict {
+namespace {
+const size_t kEltwiseBlock = 4096;
+
+// How a binary op broadcasts its inputs to the output, as numpy does. The trailing dims where the inputs are both
+// whole, or one of them is a single value, are one run of the isa kernel, and the leading dims step through the runs.
+struct BroadcastPlan {
+  std::vector<size_t> outerDims;
+  std::vector<size_t> aStrides;
+  std::vector<size_t> bStrides;
+  size_t outerSize = 1;
+  size_t run = 1;
+  bool scalarA = false;
+  bool scalarB = false;
+};
+
+bool BuildBroadcastPlan(std::vector<int64_t> aShape, std::vector<int64_t> bShape, const std::vector<int64_t> &outShape,
+                        BroadcastPlan *plan) {
+  const size_t ndim = outShape.size();
+  if (aShape.size() > ndim || bShape.size() > ndim) {
+    return false;
+  }
+  (void)aShape.insert(aShape.begin(), ndim - aShape.size(), 1);
+  (void)bShape.insert(bShape.begin(), ndim - bShape.size(), 1);
+  for (size_t i = 0; i < ndim; ++i) {
+    if ((aShape[i] != outShape[i] && aShape[i] != 1) || (bShape[i] != outShape[i] && bShape[i] != 1)) {
+      return false;
+    }
+  }
+  // the run takes the trailing dims of one kind, a dim of size 1 in the output is of any kind
+  size_t cut = ndim;
+  int kind = -1;
+  for (; cut > 0; --cut) {
+    size_t i = cut - 1;
+    if (outShape[i] == 1) {
+      continue;
+    }
+    int dimKind = (aShape[i] == outShape[i] ? 1 : 0) | (bShape[i] == outShape[i] ? 2 : 0);
+    if (kind != -1 && dimKind != kind) {
+      break;
+    }
+    kind = dimKind;
+    plan->run *= static_cast<size_t>(outShape[i]);
+  }
+  plan->scalarA = kind == 2;
+  plan->scalarB = kind == 1;
+  size_t aStride = plan->scalarA ? 1 : plan->run;
+  size_t bStride = plan->scalarB ? 1 : plan->run;
+  plan->outerDims.assign(outShape.begin(), outShape.begin() + cut);
+  plan->aStrides.resize(cut);
+  plan->bStrides.resize(cut);
+  for (size_t i = cut; i > 0; --i) {
+    plan->aStrides[i - 1] = aShape[i - 1] == 1 ? 0 : aStride;
+    plan->bStrides[i - 1] = bShape[i - 1] == 1 ? 0 : bStride;
+    aStride *= static_cast<size_t>(aShape[i - 1]);
+    bStride *= static_cast<size_t>(bShape[i - 1]);
+    plan->outerSize *= plan->outerDims[i - 1];
+  }
+  return true;
+}
+}  // namespace
+
+// Eltwise, Add and Mul of fp32 tensors of any layout but NC4HW4, the inputs broadcast to the output. An Eltwise of
+// more inputs folds them one by one into the output. The runs, or the blocks of a long run, are split for the threads.
+class EltwiseFp32 : public Fp32OpBase {
+ public:
+  EltwiseFp32(const OpDef &opDef, const Context &ctx, MSBinaryMode mode) : Fp32OpBase(opDef, ctx), mode(mode) {}
+  ~EltwiseFp32() override = default;
+
+  int Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+  int Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+ private:
+  void RunBlock(const float *a, const float *b, float *dst, const BroadcastPlan &plan, size_t unit) const;
+
+  MSBinaryMode mode;
+  // the plan of inputs[i + 1] with the output, or with inputs[0] for the first one
+  std::vector<BroadcastPlan> plans;
+};
+
+int EltwiseFp32::Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  if (!CheckTensors(inputs, outputs, 2, inputs.size())) {
+    return RET_ERROR;
+  }
+  auto outShape = outputs[0]->GetDims();
+  plans.resize(inputs.size() - 1);
+  for (size_t i = 1; i < inputs.size(); ++i) {
+    auto aShape = i == 1 ? inputs[0]->GetDims() : outShape;
+    if (!BuildBroadcastPlan(aShape, inputs[i]->GetDims(), outShape, &plans[i - 1])) {
+      MS_LOGE("%s: input %zu can not broadcast to the output", name.c_str(), i);
+      return RET_ERROR;
+    }
+  }
+  return RET_OK;
+}
+
+void EltwiseFp32::RunBlock(const float *a, const float *b, float *dst, const BroadcastPlan &plan, size_t unit) const {
+  size_t blocks = (plan.run + kEltwiseBlock - 1) / kEltwiseBlock;
+  size_t outer = unit / blocks;
+  size_t begin = unit % blocks * kEltwiseBlock;
+  size_t end = std::min(begin + kEltwiseBlock, plan.run);
+  size_t aOffset = 0;
+  size_t bOffset = 0;
+  for (size_t i = plan.outerDims.size(), index = outer; i > 0; --i) {
+    size_t coord = index % plan.outerDims[i - 1];
+    index /= plan.outerDims[i - 1];
+    aOffset += coord * plan.aStrides[i - 1];
+    bOffset += coord * plan.bStrides[i - 1];
+  }
+  a += aOffset + (plan.scalarA ? 0 : begin);
+  b += bOffset + (plan.scalarB ? 0 : begin);
+  dst += outer * plan.run + begin;
+  // the ops are commutative, a single value goes second
+  if (plan.scalarA) {
+    MSBinaryFp32(b, a, dst, end - begin, true, mode);
+  } else {
+    MSBinaryFp32(a, b, dst, end - begin, plan.scalarB, mode);
+  }
+}
+
+int EltwiseFp32::Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  auto output = static_cast<float *>(outputs[0]->GetData());
+  if (output == nullptr) {
+    MS_LOGE("%s: data of output is nullptr", name.c_str());
+    return RET_ERROR;
+  }
+  for (size_t i = 1; i < inputs.size(); ++i) {
+    auto a = i == 1 ? static_cast<const float *>(inputs[0]->GetData()) : output;
+    auto b = static_cast<const float *>(inputs[i]->GetData());
+    if (a == nullptr || b == nullptr) {
+      MS_LOGE("%s: data of inputs is nullptr", name.c_str());
+      return RET_ERROR;
+    }
+    const BroadcastPlan &plan = plans[i - 1];
+    size_t units = plan.outerSize * ((plan.run + kEltwiseBlock - 1) / kEltwiseBlock);
+    auto ret = ParallelRange(units, 1, [&](size_t begin, size_t end) {
+      for (size_t unit = begin; unit < end; ++unit) {
+        RunBlock(a, b, output, plan, unit);
+      }
+    });
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+OpBase *CreateEltwiseFp32(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                          const OpDef &opDef, const Context &ctx, const OpDesc &desc) {
+  MSBinaryMode mode;
+  switch (desc.type) {
+    case OpT_Add:
+      mode = BINARY_ADD;
+      break;
+    case OpT_Mul:
+      mode = BINARY_MUL;
+      break;
+    default:
+      if (opDef.attr_as_Eltwise() == nullptr) {
+        MS_LOGE("opDef.attr_as_Eltwise() is nullptr");
+        return nullptr;
+      }
+      mode = static_cast<MSBinaryMode>(opDef.attr_as_Eltwise()->mode());
+      if (mode < BINARY_MUL || mode >= BINARY_MODE_NUM) {
+        MS_LOGE("eltwise mode %d is invalid", mode);
+        return nullptr;
+      }
+      break;
+  }
+  auto op = std::unique_ptr<EltwiseFp32>(new (std::nothrow) EltwiseFp32(opDef, ctx, mode));
+  if (op == nullptr) {
+    MS_LOGE("new EltwiseFp32 failed");
+    return nullptr;
+  }
+  if (op->Init(inputs, outputs) != RET_OK) {
+    return nullptr;
+  }
+  return op.release();
+}
+
+REG_OP(X86_FP32, OpT_Eltwise, CreateEltwiseFp32)
+REG_OP(X86_FP32, OpT_Add, CreateEltwiseFp32)
+REG_OP(X86_FP32, OpT_Mul, CreateEltwiseFp32)
+}  // namespace predict
+}  // namespace mindspore
@@ -0,0 +1,226 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "src/operator/cpu/include/fp32_func.h"
+
+namespace mindspore {
+namespace predict {
+namespace {
+// the outputs [begin, end) of a row whose inputs out * stride + offset are in [0, size)
+void ValidRange(int offset, size_t stride, size_t size, size_t outSize, size_t *begin, size_t *end) {
+  int s = static_cast<int>(stride);
+  int first = offset >= 0 ? 0 : (-offset + s - 1) / s;
+  int last = static_cast<int>(size) - offset <= 0 ? 0 : (static_cast<int>(size) - offset + s - 1) / s;
+  *begin = std::min(static_cast<size_t>(first), outSize);
+  *end = std::max(*begin, std::min(static_cast<size_t>(last), outSize));
+}
+
+// the bounds of a clamp activation, false for the others
+bool GetClampRange(ActivationType actType, float *minValue, float *maxValue) {
+  const float inf = std::numeric_limits<float>::infinity();
+  switch (actType) {
+    case ActivationType_NO_ACTIVATION:
+      *minValue = -inf;
+      *maxValue = inf;
+      return true;
+    case ActivationType_RELU:
+      *minValue = 0.0f;
+      *maxValue = inf;
+      return true;
+    case ActivationType_RELU6:
+      *minValue = 0.0f;
+      *maxValue = 6.0f;
+      return true;
+    case ActivationType_RELU1:
+      *minValue = -1.0f;
+      *maxValue = 1.0f;
+      return true;
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+void MSIm2ColFp32(const float *src, float *col, size_t channel, const MSConvParam &param, size_t begin, size_t end) {
+  const size_t cols = end - begin;
+  for (size_t c = 0; c < channel; ++c) {
+    const float *plane = src + c * param.inH * param.inW;
+    for (size_t kh = 0; kh < param.kernelH; ++kh) {
+      for (size_t kw = 0; kw < param.kernelW; ++kw) {
+        float *dst = col + ((c * param.kernelH + kh) * param.kernelW + kw) * cols;
+        int offsetH = static_cast<int>(kh * param.dilateH) - static_cast<int>(param.padUp);
+        int offsetW = static_cast<int>(kw * param.dilateW) - static_cast<int>(param.padLeft);
+        size_t owBegin = 0;
+        size_t owEnd = 0;
+        ValidRange(offsetW, param.strideW, param.inW, param.outW, &owBegin, &owEnd);
+        size_t j = begin;
+        while (j < end) {
+          size_t oh = j / param.outW;
+          size_t ow = j % param.outW;
+          size_t rowEnd = std::min(end, (oh + 1) * param.outW);
+          int ih = static_cast<int>(oh * param.strideH) + offsetH;
+          if (ih < 0 || ih >= static_cast<int>(param.inH)) {
+            std::fill(dst, dst + (rowEnd - j), 0.0f);
+            dst += rowEnd - j;
+            j = rowEnd;
+            continue;
+          }
+          const float *row = plane + ih * param.inW;
+          for (; j < rowEnd; ++j, ++ow) {
+            *dst++ = (ow >= owBegin && ow < owEnd) ? row[static_cast<int>(ow * param.strideW) + offsetW] : 0.0f;
+          }
+        }
+      }
+    }
+  }
+}
+
+void MSDepthwiseFp32(const float *src, const float *weight, float bias, float *dst, const MSConvParam &param) {
+  std::fill(dst, dst + param.outH * param.outW, bias);
+  for (size_t kw = 0; kw < param.kernelW; ++kw) {
+    int offsetW = static_cast<int>(kw * param.dilateW) - static_cast<int>(param.padLeft);
+    size_t owBegin = 0;
+    size_t owEnd = 0;
+    ValidRange(offsetW, param.strideW, param.inW, param.outW, &owBegin, &owEnd);
+    for (size_t oh = 0; oh < param.outH; ++oh) {
+      float *out = dst + oh * param.outW;
+      for (size_t kh = 0; kh < param.kernelH; ++kh) {
+        int ih = static_cast<int>(oh * param.strideH + kh * param.dilateH) - static_cast<int>(param.padUp);
+        if (ih < 0 || ih >= static_cast<int>(param.inH)) {
+          continue;
+        }
+        const float w = weight[kh * param.kernelW + kw];
+        const float *in = src + ih * param.inW;
+        if (param.strideW == 1) {
+          for (size_t ow = owBegin; ow < owEnd; ++ow) {
+            out[ow] += w * in[static_cast<int>(ow) + offsetW];
+          }
+        } else {
+          for (size_t ow = owBegin; ow < owEnd; ++ow) {
+            out[ow] += w * in[static_cast<int>(ow * param.strideW) + offsetW];
+          }
+        }
+      }
+    }
+  }
+}
+
+void MSPoolingFp32(const float *src, float *dst, const MSConvParam &param, size_t padDown, size_t padRight,
+                   bool isMax, bool caffeMode) {
+  for (size_t oh = 0; oh < param.outH; ++oh) {
+    int hStart = static_cast<int>(oh * param.strideH) - static_cast<int>(param.padUp);
+    int hEnd = std::min(hStart + static_cast<int>(param.kernelH), static_cast<int>(param.inH + padDown));
+    int hCaffe = hEnd - hStart;
+    hStart = std::max(hStart, 0);
+    hEnd = std::min(hEnd, static_cast<int>(param.inH));
+    for (size_t ow = 0; ow < param.outW; ++ow) {
+      int wStart = static_cast<int>(ow * param.strideW) - static_cast<int>(param.padLeft);
+      int wEnd = std::min(wStart + static_cast<int>(param.kernelW), static_cast<int>(param.inW + padRight));
+      int wCaffe = wEnd - wStart;
+      wStart = std::max(wStart, 0);
+      wEnd = std::min(wEnd, static_cast<int>(param.inW));
+      float value = isMax ? -FLT_MAX : 0.0f;
+      for (int ih = hStart; ih < hEnd; ++ih) {
+        const float *row = src + ih * param.inW;
+        for (int iw = wStart; iw < wEnd; ++iw) {
+          value = isMax ? std::max(value, row[iw]) : value + row[iw];
+        }
+      }
+      if (!isMax) {
+        int count = caffeMode ? hCaffe * wCaffe : (hEnd - hStart) * (wEnd - wStart);
+        value = count > 0 ? value / count : 0.0f;
+      }
+      dst[oh * param.outW + ow] = value;
+    }
+  }
+}
+
+void MSSoftmaxFp32(const float *src, float *dst, size_t outer, size_t axis, size_t inner) {
+  for (size_t o = 0; o < outer; ++o) {
+    for (size_t i = 0; i < inner; ++i) {
+      const float *in = src + o * axis * inner + i;
+      float *out = dst + o * axis * inner + i;
+      float maxValue = -FLT_MAX;
+      for (size_t a = 0; a < axis; ++a) {
+        maxValue = std::max(maxValue, in[a * inner]);
+      }
+      float sum = 0.0f;
+      for (size_t a = 0; a < axis; ++a) {
+        out[a * inner] = expf(in[a * inner] - maxValue);
+        sum += out[a * inner];
+      }
+      for (size_t a = 0; a < axis; ++a) {
+        out[a * inner] /= sum;
+      }
+    }
+  }
+}
+
+bool MSIsActSupported(ActivationType actType) {
+  float minValue = 0.0f;
+  float maxValue = 0.0f;
+  return GetClampRange(actType, &minValue, &maxValue) || actType == ActivationType_SIGMOID ||
+         actType == ActivationType_TANH || actType == ActivationType_ABS;
+}
+
+void MSActivationFp32(const float *src, float *dst, size_t size, ActivationType actType) {
+  if (src != dst) {
+    (void)memcpy(dst, src, size * sizeof(float));
+  }
+  MSBiasActFp32(dst, nullptr, 1, size, actType);
+}
+
+void MSBiasActFp32(float *data, const float *bias, size_t channel, size_t plane, ActivationType actType) {
+  const MSIsaKernels *kernels = MSGetIsaKernels();
+  float minValue = 0.0f;
+  float maxValue = 0.0f;
+  bool isClamp = GetClampRange(actType, &minValue, &maxValue);
+  if (isClamp && bias == nullptr && actType == ActivationType_NO_ACTIVATION) {
+    return;
+  }
+  if (!isClamp) {
+    (void)GetClampRange(ActivationType_NO_ACTIVATION, &minValue, &maxValue);
+  }
+  for (size_t c = 0; c < channel; ++c) {
+    float *p = data + c * plane;
+    if (isClamp || bias != nullptr) {
+      kernels->biasClamp(p, bias == nullptr ? 0.0f : bias[c], plane, minValue, maxValue);
+    }
+    if (isClamp) {
+      continue;
+    }
+    for (size_t i = 0; i < plane; ++i) {
+      if (actType == ActivationType_SIGMOID) {
+        p[i] = 1.0f / (1.0f + expf(-p[i]));
+      } else if (actType == ActivationType_TANH) {
+        p[i] = tanhf(p[i]);
+      } else if (actType == ActivationType_ABS) {
+        p[i] = fabsf(p[i]);
+      }
+    }
+  }
+}
+
+void MSBinaryFp32(const float *a, const float *b, float *dst, size_t size, bool scalarB, MSBinaryMode mode) {
+  MSGetIsaKernels()->binary[mode](a, b, dst, size, scalarB);
+}
+}  // namespace predict
+}  // namespace mindspore
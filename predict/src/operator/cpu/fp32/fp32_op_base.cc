@@ -0,0 +1,113 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/operator/cpu/include/fp32_op_base.h"
+#include <algorithm>
+#include <string>
+#include "common/common.h"
+#include "common/mslog.h"
+#include "src/op_common.h"
+#include "src/runtime/thread_pool.h"
+
+namespace mindspore {
+namespace predict {
+namespace {
+// the chunks of a parallel for per thread, more than one so that the threads steal the chunks of the slow ones
+const size_t kParallelChunksPerThread = 4;
+}  // namespace
+
+Fp32OpBase::Fp32OpBase(const OpDef &opDef, const Context &ctx)
+    : threadNum(ctx.threadNum > 1 ? ctx.threadNum : 1), isLastConv(opDef.isLastConv()) {
+  if (opDef.name() != nullptr) {
+    name = opDef.name()->str();
+  }
+}
+
+bool Fp32OpBase::CheckTensors(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                              size_t inputNum, size_t nchwNum) const {
+  if (inputs.size() < inputNum || outputs.empty()) {
+    MS_LOGI("%s: %zu inputs and %zu outputs are not supported", name.c_str(), inputs.size(), outputs.size());
+    return false;
+  }
+  for (size_t i = 0; i < inputs.size() + outputs.size(); ++i) {
+    auto tensor = i < inputs.size() ? inputs[i] : outputs[i - inputs.size()];
+    if (tensor == nullptr) {
+      MS_LOGE("%s: tensor %zu is nullptr", name.c_str(), i);
+      return false;
+    }
+    if (tensor->GetDataType() != DataType_DT_FLOAT) {
+      MS_LOGI("%s: data type %d is not supported", name.c_str(), tensor->GetDataType());
+      return false;
+    }
+    if ((i < nchwNum || i >= inputs.size()) && tensor->GetFormat() == Format_NC4HW4) {
+      MS_LOGI("%s: format NC4HW4 is not supported", name.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Fp32OpBase::GetNchwDims(const Tensor *tensor, bool isNhwc, std::vector<size_t> *dims) const {
+  auto shape = tensor->GetDims();
+  if (shape.size() != static_cast<size_t>(DIM_DEFAULT_SIZE)) {
+    MS_LOGI("%s: %zu dims are not supported", name.c_str(), shape.size());
+    return false;
+  }
+  if (isNhwc) {
+    *dims = {static_cast<size_t>(shape[NHWC_N]), static_cast<size_t>(shape[NHWC_C]),
+             static_cast<size_t>(shape[NHWC_H]), static_cast<size_t>(shape[NHWC_W])};
+  } else {
+    *dims = {static_cast<size_t>(shape[NCHW_N]), static_cast<size_t>(shape[NCHW_C]),
+             static_cast<size_t>(shape[NCHW_H]), static_cast<size_t>(shape[NCHW_W])};
+  }
+  return true;
+}
+
+int Fp32OpBase::ParallelFor(size_t size, size_t block, const ParallelForFunc &func) const {
+  block = std::max<size_t>(block, 1);
+  size_t grain = (size + threadNum * kParallelChunksPerThread - 1) / (threadNum * kParallelChunksPerThread);
+  grain = std::max((grain + block - 1) / block * block, block);
+  if (!ThreadPool::GetInstance()->ParallelFor(size, grain, threadNum, func)) {
+    MS_LOGE("%s: parallel for of %zu items failed", name.c_str(), size);
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int Fp32OpBase::ParallelRange(size_t size, size_t block, const std::function<void(size_t, size_t)> &func) const {
+  return ParallelFor(size, block, [&func](int slot, size_t begin, size_t end) {
+    func(begin, end);
+    return RET_OK;
+  });
+}
+
+int Fp32OpBase::ToNhwc(Tensor *output) {
+  std::vector<size_t> dims;
+  if (!GetNchwDims(output, true, &dims)) {
+    return RET_ERROR;
+  }
+  auto data = static_cast<float *>(output->GetData());
+  size_t size = dims[1] * dims[2] * dims[3];
+  nhwcBuf.resize(size);
+  for (size_t n = 0; n < dims[0]; ++n) {
+    float *image = data + n * size;
+    (void)std::copy(image, image + size, nhwcBuf.begin());
+    Nchw2Nhwc(nhwcBuf.data(), image, dims[2], dims[3], dims[1]);
+  }
+  return RET_OK;
+}
+}  // namespace predict
+}  // namespace mindspore
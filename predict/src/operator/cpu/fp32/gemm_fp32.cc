@@ -0,0 +1,141 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "src/operator/cpu/include/fp32_func.h"
+
+namespace mindspore {
+namespace predict {
+namespace {
+// the blocks of a, b and c packed at a time, a block of b stays in the l2 cache while the panels of a go through it
+const size_t kGemmBlockM = 96;
+const size_t kGemmBlockN = 512;
+const size_t kGemmBlockK = 256;
+
+// panels of mr rows of the block of a, each of k columns of mr values, the rows past m are zeros
+void PackA(bool transA, const float *a, size_t lda, size_t m, size_t k, size_t mr, float *pack) {
+  for (size_t i0 = 0; i0 < m; i0 += mr) {
+    size_t rows = std::min(mr, m - i0);
+    for (size_t p = 0; p < k; ++p) {
+      for (size_t i = 0; i < rows; ++i) {
+        pack[i] = transA ? a[p * lda + i0 + i] : a[(i0 + i) * lda + p];
+      }
+      std::fill(pack + rows, pack + mr, 0.0f);
+      pack += mr;
+    }
+  }
+}
+
+// panels of nr columns of the block of b, each of k rows of nr values, the columns past n are zeros
+void PackB(bool transB, const float *b, size_t ldb, size_t k, size_t n, size_t nr, float *pack) {
+  for (size_t j0 = 0; j0 < n; j0 += nr) {
+    size_t cols = std::min(nr, n - j0);
+    for (size_t p = 0; p < k; ++p) {
+      if (transB) {
+        for (size_t j = 0; j < cols; ++j) {
+          pack[j] = b[(j0 + j) * ldb + p];
+        }
+      } else {
+        (void)memcpy(pack, b + p * ldb + j0, cols * sizeof(float));
+      }
+      std::fill(pack + cols, pack + nr, 0.0f);
+      pack += nr;
+    }
+  }
+}
+
+// a row of c, as axpys of the rows of b or as dots with the columns of b
+void GemvRow(const MSIsaKernels *kernels, bool transA, bool transB, size_t n, size_t k, const float *a, size_t lda,
+             const float *b, size_t ldb, float *c) {
+  std::vector<float> row;
+  if (transA && lda != 1) {
+    row.resize(k);
+    for (size_t p = 0; p < k; ++p) {
+      row[p] = a[p * lda];
+    }
+    a = row.data();
+  }
+  if (transB) {
+    for (size_t j = 0; j < n; ++j) {
+      c[j] = kernels->dot(a, b + j * ldb, k);
+    }
+    return;
+  }
+  std::fill(c, c + n, 0.0f);
+  for (size_t p = 0; p < k; ++p) {
+    kernels->axpy(a[p], b + p * ldb, c, n);
+  }
+}
+}  // namespace
+
+void MSGemmFp32(bool transA, bool transB, size_t m, size_t n, size_t k, const float *a, size_t lda, const float *b,
+                size_t ldb, float *c, size_t ldc) {
+  if (m == 0 || n == 0) {
+    return;
+  }
+  if (k == 0) {
+    for (size_t i = 0; i < m; ++i) {
+      std::fill(c + i * ldc, c + i * ldc + n, 0.0f);
+    }
+    return;
+  }
+  const MSIsaKernels *kernels = MSGetIsaKernels();
+  if (m == 1) {
+    GemvRow(kernels, transA, transB, n, k, a, lda, b, ldb, c);
+    return;
+  }
+  const size_t mr = kernels->mr;
+  const size_t nr = kernels->nr;
+  const size_t blockK = std::min(k, kGemmBlockK);
+  std::vector<float> packA((std::min(m, kGemmBlockM) + mr - 1) / mr * mr * blockK);
+  std::vector<float> packB((std::min(n, kGemmBlockN) + nr - 1) / nr * nr * blockK);
+  std::vector<float> tile(mr * nr);
+  for (size_t j0 = 0; j0 < n; j0 += kGemmBlockN) {
+    size_t nc = std::min(kGemmBlockN, n - j0);
+    for (size_t p0 = 0; p0 < k; p0 += kGemmBlockK) {
+      size_t kc = std::min(kGemmBlockK, k - p0);
+      PackB(transB, transB ? b + j0 * ldb + p0 : b + p0 * ldb + j0, ldb, kc, nc, nr, packB.data());
+      for (size_t i0 = 0; i0 < m; i0 += kGemmBlockM) {
+        size_t mc = std::min(kGemmBlockM, m - i0);
+        PackA(transA, transA ? a + p0 * lda + i0 : a + i0 * lda + p0, lda, mc, kc, mr, packA.data());
+        for (size_t i = 0; i < mc; i += mr) {
+          for (size_t j = 0; j < nc; j += nr) {
+            const float *panelA = packA.data() + i * kc;
+            const float *panelB = packB.data() + j * kc;
+            float *dst = c + (i0 + i) * ldc + j0 + j;
+            if (i + mr <= mc && j + nr <= nc) {
+              kernels->gemm(kc, panelA, panelB, dst, ldc, p0 > 0);
+              continue;
+            }
+            // an edge tile, computed aside and stored in part
+            kernels->gemm(kc, panelA, panelB, tile.data(), nr, false);
+            size_t rows = std::min(mr, mc - i);
+            size_t cols = std::min(nr, nc - j);
+            for (size_t ii = 0; ii < rows; ++ii) {
+              for (size_t jj = 0; jj < cols; ++jj) {
+                dst[ii * ldc + jj] = (p0 > 0 ? dst[ii * ldc + jj] : 0.0f) + tile[ii * nr + jj];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+}  // namespace predict
+}  // namespace mindspore
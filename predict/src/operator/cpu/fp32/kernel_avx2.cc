@@ -0,0 +1,202 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// built with -mavx2 -mfma, see fp32_isa.h for what this file may include
+#include <immintrin.h>
+#include "src/operator/cpu/include/fp32_isa.h"
+
+namespace mindspore {
+namespace predict {
+namespace {
+const size_t kAvx2Mr = 6;
+const size_t kAvx2Nr = 16;
+const size_t kAvx2Lanes = 8;
+
+void Avx2Gemm(size_t k, const float *a, const float *b, float *c, size_t ldc, bool accumulate) {
+  // the 6 x 2 vectors of c stay in registers, named so that the compiler does not spill them
+  __m256 c00 = _mm256_setzero_ps();
+  __m256 c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps();
+  __m256 c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps();
+  __m256 c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps();
+  __m256 c31 = _mm256_setzero_ps();
+  __m256 c40 = _mm256_setzero_ps();
+  __m256 c41 = _mm256_setzero_ps();
+  __m256 c50 = _mm256_setzero_ps();
+  __m256 c51 = _mm256_setzero_ps();
+  for (size_t p = 0; p < k; ++p) {
+    __m256 b0 = _mm256_loadu_ps(b);
+    __m256 b1 = _mm256_loadu_ps(b + kAvx2Lanes);
+    __m256 a0 = _mm256_broadcast_ss(a + 0);
+    c00 = _mm256_fmadd_ps(a0, b0, c00);
+    c01 = _mm256_fmadd_ps(a0, b1, c01);
+    __m256 a1 = _mm256_broadcast_ss(a + 1);
+    c10 = _mm256_fmadd_ps(a1, b0, c10);
+    c11 = _mm256_fmadd_ps(a1, b1, c11);
+    __m256 a2 = _mm256_broadcast_ss(a + 2);
+    c20 = _mm256_fmadd_ps(a2, b0, c20);
+    c21 = _mm256_fmadd_ps(a2, b1, c21);
+    __m256 a3 = _mm256_broadcast_ss(a + 3);
+    c30 = _mm256_fmadd_ps(a3, b0, c30);
+    c31 = _mm256_fmadd_ps(a3, b1, c31);
+    __m256 a4 = _mm256_broadcast_ss(a + 4);
+    c40 = _mm256_fmadd_ps(a4, b0, c40);
+    c41 = _mm256_fmadd_ps(a4, b1, c41);
+    __m256 a5 = _mm256_broadcast_ss(a + 5);
+    c50 = _mm256_fmadd_ps(a5, b0, c50);
+    c51 = _mm256_fmadd_ps(a5, b1, c51);
+    a += kAvx2Mr;
+    b += kAvx2Nr;
+  }
+  if (accumulate) {
+    c00 = _mm256_add_ps(c00, _mm256_loadu_ps(c));
+    c01 = _mm256_add_ps(c01, _mm256_loadu_ps(c + kAvx2Lanes));
+    c10 = _mm256_add_ps(c10, _mm256_loadu_ps(c + 1 * ldc));
+    c11 = _mm256_add_ps(c11, _mm256_loadu_ps(c + 1 * ldc + kAvx2Lanes));
+    c20 = _mm256_add_ps(c20, _mm256_loadu_ps(c + 2 * ldc));
+    c21 = _mm256_add_ps(c21, _mm256_loadu_ps(c + 2 * ldc + kAvx2Lanes));
+    c30 = _mm256_add_ps(c30, _mm256_loadu_ps(c + 3 * ldc));
+    c31 = _mm256_add_ps(c31, _mm256_loadu_ps(c + 3 * ldc + kAvx2Lanes));
+    c40 = _mm256_add_ps(c40, _mm256_loadu_ps(c + 4 * ldc));
+    c41 = _mm256_add_ps(c41, _mm256_loadu_ps(c + 4 * ldc + kAvx2Lanes));
+    c50 = _mm256_add_ps(c50, _mm256_loadu_ps(c + 5 * ldc));
+    c51 = _mm256_add_ps(c51, _mm256_loadu_ps(c + 5 * ldc + kAvx2Lanes));
+  }
+  _mm256_storeu_ps(c, c00);
+  _mm256_storeu_ps(c + kAvx2Lanes, c01);
+  _mm256_storeu_ps(c + 1 * ldc, c10);
+  _mm256_storeu_ps(c + 1 * ldc + kAvx2Lanes, c11);
+  _mm256_storeu_ps(c + 2 * ldc, c20);
+  _mm256_storeu_ps(c + 2 * ldc + kAvx2Lanes, c21);
+  _mm256_storeu_ps(c + 3 * ldc, c30);
+  _mm256_storeu_ps(c + 3 * ldc + kAvx2Lanes, c31);
+  _mm256_storeu_ps(c + 4 * ldc, c40);
+  _mm256_storeu_ps(c + 4 * ldc + kAvx2Lanes, c41);
+  _mm256_storeu_ps(c + 5 * ldc, c50);
+  _mm256_storeu_ps(c + 5 * ldc + kAvx2Lanes, c51);
+}
+
+void Avx2Mul(const float *a, const float *b, float *dst, size_t size, bool scalarB) {
+  size_t i = 0;
+  if (scalarB) {
+    __m256 vb = _mm256_set1_ps(b[0]);
+    for (; i + kAvx2Lanes <= size; i += kAvx2Lanes) {
+      _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), vb));
+    }
+  } else {
+    for (; i + kAvx2Lanes <= size; i += kAvx2Lanes) {
+      _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+  }
+  for (; i < size; ++i) {
+    dst[i] = a[i] * (scalarB ? b[0] : b[i]);
+  }
+}
+
+void Avx2Add(const float *a, const float *b, float *dst, size_t size, bool scalarB) {
+  size_t i = 0;
+  if (scalarB) {
+    __m256 vb = _mm256_set1_ps(b[0]);
+    for (; i + kAvx2Lanes <= size; i += kAvx2Lanes) {
+      _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(a + i), vb));
+    }
+  } else {
+    for (; i + kAvx2Lanes <= size; i += kAvx2Lanes) {
+      _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+  }
+  for (; i < size; ++i) {
+    dst[i] = a[i] + (scalarB ? b[0] : b[i]);
+  }
+}
+
+void Avx2Max(const float *a, const float *b, float *dst, size_t size, bool scalarB) {
+  size_t i = 0;
+  if (scalarB) {
+    __m256 vb = _mm256_set1_ps(b[0]);
+    for (; i + kAvx2Lanes <= size; i += kAvx2Lanes) {
+      _mm256_storeu_ps(dst + i, _mm256_max_ps(_mm256_loadu_ps(a + i), vb));
+    }
+  } else {
+    for (; i + kAvx2Lanes <= size; i += kAvx2Lanes) {
+      _mm256_storeu_ps(dst + i, _mm256_max_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+  }
+  for (; i < size; ++i) {
+    float vb = scalarB ? b[0] : b[i];
+    dst[i] = a[i] > vb ? a[i] : vb;
+  }
+}
+
+void Avx2BiasClamp(float *data, float bias, size_t size, float minValue, float maxValue) {
+  __m256 vbias = _mm256_set1_ps(bias);
+  __m256 vmin = _mm256_set1_ps(minValue);
+  __m256 vmax = _mm256_set1_ps(maxValue);
+  size_t i = 0;
+  for (; i + kAvx2Lanes <= size; i += kAvx2Lanes) {
+    __m256 v = _mm256_add_ps(_mm256_loadu_ps(data + i), vbias);
+    _mm256_storeu_ps(data + i, _mm256_min_ps(_mm256_max_ps(v, vmin), vmax));
+  }
+  for (; i < size; ++i) {
+    float v = data[i] + bias;
+    v = v > minValue ? v : minValue;
+    data[i] = v < maxValue ? v : maxValue;
+  }
+}
+
+void Avx2Axpy(float alpha, const float *x, float *y, size_t size) {
+  __m256 valpha = _mm256_set1_ps(alpha);
+  size_t i = 0;
+  for (; i + kAvx2Lanes <= size; i += kAvx2Lanes) {
+    _mm256_storeu_ps(y + i, _mm256_fmadd_ps(valpha, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+  }
+  for (; i < size; ++i) {
+    y[i] += alpha * x[i];
+  }
+}
+
+float Avx2Dot(const float *a, const float *b, size_t size) {
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 2 * kAvx2Lanes <= size; i += 2 * kAvx2Lanes) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + kAvx2Lanes), _mm256_loadu_ps(b + i + kAvx2Lanes), acc1);
+  }
+  for (; i + kAvx2Lanes <= size; i += kAvx2Lanes) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+  }
+  acc0 = _mm256_add_ps(acc0, acc1);
+  __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  float result = _mm_cvtss_f32(sum);
+  for (; i < size; ++i) {
+    result += a[i] * b[i];
+  }
+  return result;
+}
+}  // namespace
+
+const MSIsaKernels *MSGetAvx2Kernels() {
+  static const MSIsaKernels kernels = {
+    CPU_ISA_AVX2, kAvx2Mr, kAvx2Nr, Avx2Gemm, {Avx2Mul, Avx2Add, Avx2Max}, Avx2BiasClamp, Avx2Axpy, Avx2Dot};
+  return &kernels;
+}
+}  // namespace predict
+}  // namespace mindspore
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// built with -mavx512f -mfma, see fp32_isa.h for what this file may include
+#include <immintrin.h>
+#include "src/operator/cpu/include/fp32_isa.h"
+
+namespace mindspore {
+namespace predict {
+namespace {
+const size_t kAvx512Mr = 6;
+const size_t kAvx512Nr = 32;
+const size_t kAvx512Lanes = 16;
+
+// the lanes of a tail of size elements, size < kAvx512Lanes
+__mmask16 TailMask(size_t size) { return static_cast<__mmask16>((1u << size) - 1); }
+
+void Avx512Gemm(size_t k, const float *a, const float *b, float *c, size_t ldc, bool accumulate) {
+  // the 6 x 2 vectors of c stay in registers, named so that the compiler does not spill them
+  __m512 c00 = _mm512_setzero_ps();
+  __m512 c01 = _mm512_setzero_ps();
+  __m512 c10 = _mm512_setzero_ps();
+  __m512 c11 = _mm512_setzero_ps();
+  __m512 c20 = _mm512_setzero_ps();
+  __m512 c21 = _mm512_setzero_ps();
+  __m512 c30 = _mm512_setzero_ps();
+  __m512 c31 = _mm512_setzero_ps();
+  __m512 c40 = _mm512_setzero_ps();
+  __m512 c41 = _mm512_setzero_ps();
+  __m512 c50 = _mm512_setzero_ps();
+  __m512 c51 = _mm512_setzero_ps();
+  for (size_t p = 0; p < k; ++p) {
+    __m512 b0 = _mm512_loadu_ps(b);
+    __m512 b1 = _mm512_loadu_ps(b + kAvx512Lanes);
+    __m512 a0 = _mm512_set1_ps(a[0]);
+    c00 = _mm512_fmadd_ps(a0, b0, c00);
+    c01 = _mm512_fmadd_ps(a0, b1, c01);
+    __m512 a1 = _mm512_set1_ps(a[1]);
+    c10 = _mm512_fmadd_ps(a1, b0, c10);
+    c11 = _mm512_fmadd_ps(a1, b1, c11);
+    __m512 a2 = _mm512_set1_ps(a[2]);
+    c20 = _mm512_fmadd_ps(a2, b0, c20);
+    c21 = _mm512_fmadd_ps(a2, b1, c21);
+    __m512 a3 = _mm512_set1_ps(a[3]);
+    c30 = _mm512_fmadd_ps(a3, b0, c30);
+    c31 = _mm512_fmadd_ps(a3, b1, c31);
+    __m512 a4 = _mm512_set1_ps(a[4]);
+    c40 = _mm512_fmadd_ps(a4, b0, c40);
+    c41 = _mm512_fmadd_ps(a4, b1, c41);
+    __m512 a5 = _mm512_set1_ps(a[5]);
+    c50 = _mm512_fmadd_ps(a5, b0, c50);
+    c51 = _mm512_fmadd_ps(a5, b1, c51);
+    a += kAvx512Mr;
+    b += kAvx512Nr;
+  }
+  if (accumulate) {
+    c00 = _mm512_add_ps(c00, _mm512_loadu_ps(c));
+    c01 = _mm512_add_ps(c01, _mm512_loadu_ps(c + kAvx512Lanes));
+    c10 = _mm512_add_ps(c10, _mm512_loadu_ps(c + 1 * ldc));
+    c11 = _mm512_add_ps(c11, _mm512_loadu_ps(c + 1 * ldc + kAvx512Lanes));
+    c20 = _mm512_add_ps(c20, _mm512_loadu_ps(c + 2 * ldc));
+    c21 = _mm512_add_ps(c21, _mm512_loadu_ps(c + 2 * ldc + kAvx512Lanes));
+    c30 = _mm512_add_ps(c30, _mm512_loadu_ps(c + 3 * ldc));
+    c31 = _mm512_add_ps(c31, _mm512_loadu_ps(c + 3 * ldc + kAvx512Lanes));
+    c40 = _mm512_add_ps(c40, _mm512_loadu_ps(c + 4 * ldc));
+    c41 = _mm512_add_ps(c41, _mm512_loadu_ps(c + 4 * ldc + kAvx512Lanes));
+    c50 = _mm512_add_ps(c50, _mm512_loadu_ps(c + 5 * ldc));
+    c51 = _mm512_add_ps(c51, _mm512_loadu_ps(c + 5 * ldc + kAvx512Lanes));
+  }
+  _mm512_storeu_ps(c, c00);
+  _mm512_storeu_ps(c + kAvx512Lanes, c01);
+  _mm512_storeu_ps(c + 1 * ldc, c10);
+  _mm512_storeu_ps(c + 1 * ldc + kAvx512Lanes, c11);
+  _mm512_storeu_ps(c + 2 * ldc, c20);
+  _mm512_storeu_ps(c + 2 * ldc + kAvx512Lanes, c21);
+  _mm512_storeu_ps(c + 3 * ldc, c30);
+  _mm512_storeu_ps(c + 3 * ldc + kAvx512Lanes, c31);
+  _mm512_storeu_ps(c + 4 * ldc, c40);
+  _mm512_storeu_ps(c + 4 * ldc + kAvx512Lanes, c41);
+  _mm512_storeu_ps(c + 5 * ldc, c50);
+  _mm512_storeu_ps(c + 5 * ldc + kAvx512Lanes, c51);
+}
+
+void Avx512Mul(const float *a, const float *b, float *dst, size_t size, bool scalarB) {
+  __m512 vb = _mm512_set1_ps(b[0]);
+  size_t i = 0;
+  for (; i + kAvx512Lanes <= size; i += kAvx512Lanes) {
+    __m512 v = scalarB ? vb : _mm512_loadu_ps(b + i);
+    _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), v));
+  }
+  if (i < size) {
+    __mmask16 mask = TailMask(size - i);
+    __m512 v = scalarB ? vb : _mm512_maskz_loadu_ps(mask, b + i);
+    _mm512_mask_storeu_ps(dst + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, a + i), v));
+  }
+}
+
+void Avx512Add(const float *a, const float *b, float *dst, size_t size, bool scalarB) {
+  __m512 vb = _mm512_set1_ps(b[0]);
+  size_t i = 0;
+  for (; i + kAvx512Lanes <= size; i += kAvx512Lanes) {
+    __m512 v = scalarB ? vb : _mm512_loadu_ps(b + i);
+    _mm512_storeu_ps(dst + i, _mm512_add_ps(_mm512_loadu_ps(a + i), v));
+  }
+  if (i < size) {
+    __mmask16 mask = TailMask(size - i);
+    __m512 v = scalarB ? vb : _mm512_maskz_loadu_ps(mask, b + i);
+    _mm512_mask_storeu_ps(dst + i, mask, _mm512_add_ps(_mm512_maskz_loadu_ps(mask, a + i), v));
+  }
+}
+
+void Avx512Max(const float *a, const float *b, float *dst, size_t size, bool scalarB) {
+  __m512 vb = _mm512_set1_ps(b[0]);
+  size_t i = 0;
+  for (; i + kAvx512Lanes <= size; i += kAvx512Lanes) {
+    __m512 v = scalarB ? vb : _mm512_loadu_ps(b + i);
+    _mm512_storeu_ps(dst + i, _mm512_max_ps(_mm512_loadu_ps(a + i), v));
+  }
+  if (i < size) {
+    __mmask16 mask = TailMask(size - i);
+    __m512 v = scalarB ? vb : _mm512_maskz_loadu_ps(mask, b + i);
+    _mm512_mask_storeu_ps(dst + i, mask, _mm512_max_ps(_mm512_maskz_loadu_ps(mask, a + i), v));
+  }
+}
+
+void Avx512BiasClamp(float *data, float bias, size_t size, float minValue, float maxValue) {
+  __m512 vbias = _mm512_set1_ps(bias);
+  __m512 vmin = _mm512_set1_ps(minValue);
+  __m512 vmax = _mm512_set1_ps(maxValue);
+  size_t i = 0;
+  for (; i + kAvx512Lanes <= size; i += kAvx512Lanes) {
+    __m512 v = _mm512_add_ps(_mm512_loadu_ps(data + i), vbias);
+    _mm512_storeu_ps(data + i, _mm512_min_ps(_mm512_max_ps(v, vmin), vmax));
+  }
+  if (i < size) {
+    __mmask16 mask = TailMask(size - i);
+    __m512 v = _mm512_add_ps(_mm512_maskz_loadu_ps(mask, data + i), vbias);
+    _mm512_mask_storeu_ps(data + i, mask, _mm512_min_ps(_mm512_max_ps(v, vmin), vmax));
+  }
+}
+
+void Avx512Axpy(float alpha, const float *x, float *y, size_t size) {
+  __m512 valpha = _mm512_set1_ps(alpha);
+  size_t i = 0;
+  for (; i + kAvx512Lanes <= size; i += kAvx512Lanes) {
+    _mm512_storeu_ps(y + i, _mm512_fmadd_ps(valpha, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+  }
+  if (i < size) {
+    __mmask16 mask = TailMask(size - i);
+    __m512 v = _mm512_fmadd_ps(valpha, _mm512_maskz_loadu_ps(mask, x + i), _mm512_maskz_loadu_ps(mask, y + i));
+    _mm512_mask_storeu_ps(y + i, mask, v);
+  }
+}
+
+float Avx512Dot(const float *a, const float *b, size_t size) {
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  size_t i = 0;
+  for (; i + 2 * kAvx512Lanes <= size; i += 2 * kAvx512Lanes) {
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + kAvx512Lanes), _mm512_loadu_ps(b + i + kAvx512Lanes), acc1);
+  }
+  for (; i + kAvx512Lanes <= size; i += kAvx512Lanes) {
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+  }
+  if (i < size) {
+    __mmask16 mask = TailMask(size - i);
+    acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i), acc1);
+  }
+  return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+}  // namespace
+
+const MSIsaKernels *MSGetAvx512Kernels() {
+  static const MSIsaKernels kernels = {CPU_ISA_AVX512, kAvx512Mr, kAvx512Nr, Avx512Gemm,
+                                       {Avx512Mul, Avx512Add, Avx512Max}, Avx512BiasClamp, Avx512Axpy, Avx512Dot};
+  return &kernels;
+}
+}  // namespace predict
+}  // namespace mindspore
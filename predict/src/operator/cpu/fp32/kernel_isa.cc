@@ -0,0 +1,126 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include "src/operator/cpu/include/fp32_isa.h"
+
+namespace mindspore {
+namespace predict {
+namespace {
+const size_t kScalarMr = 4;
+const size_t kScalarNr = 8;
+
+void ScalarGemm(size_t k, const float *a, const float *b, float *c, size_t ldc, bool accumulate) {
+  float acc[kScalarMr][kScalarNr] = {{0}};
+  for (size_t p = 0; p < k; ++p) {
+    for (size_t i = 0; i < kScalarMr; ++i) {
+      for (size_t j = 0; j < kScalarNr; ++j) {
+        acc[i][j] += a[i] * b[j];
+      }
+    }
+    a += kScalarMr;
+    b += kScalarNr;
+  }
+  for (size_t i = 0; i < kScalarMr; ++i) {
+    float *dst = c + i * ldc;
+    for (size_t j = 0; j < kScalarNr; ++j) {
+      dst[j] = accumulate ? dst[j] + acc[i][j] : acc[i][j];
+    }
+  }
+}
+
+void ScalarMul(const float *a, const float *b, float *dst, size_t size, bool scalarB) {
+  for (size_t i = 0; i < size; ++i) {
+    dst[i] = a[i] * (scalarB ? b[0] : b[i]);
+  }
+}
+
+void ScalarAdd(const float *a, const float *b, float *dst, size_t size, bool scalarB) {
+  for (size_t i = 0; i < size; ++i) {
+    dst[i] = a[i] + (scalarB ? b[0] : b[i]);
+  }
+}
+
+void ScalarMax(const float *a, const float *b, float *dst, size_t size, bool scalarB) {
+  for (size_t i = 0; i < size; ++i) {
+    dst[i] = std::max(a[i], scalarB ? b[0] : b[i]);
+  }
+}
+
+void ScalarBiasClamp(float *data, float bias, size_t size, float minValue, float maxValue) {
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = std::min(std::max(data[i] + bias, minValue), maxValue);
+  }
+}
+
+void ScalarAxpy(float alpha, const float *x, float *y, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    y[i] += alpha * x[i];
+  }
+}
+
+float ScalarDot(const float *a, const float *b, size_t size) {
+  float sum = 0;
+  for (size_t i = 0; i < size; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+MSCpuIsa DetectCpuIsa() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return CPU_ISA_AVX512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return CPU_ISA_AVX2;
+  }
+#endif
+  return CPU_ISA_SCALAR;
+}
+
+std::atomic<int> gIsaLimit(CPU_ISA_AVX512);
+}  // namespace
+
+const MSIsaKernels *MSGetScalarKernels() {
+  static const MSIsaKernels kernels = {CPU_ISA_SCALAR, kScalarMr, kScalarNr, ScalarGemm,
+                                       {ScalarMul, ScalarAdd, ScalarMax}, ScalarBiasClamp, ScalarAxpy, ScalarDot};
+  return &kernels;
+}
+
+MSCpuIsa MSGetCpuIsa() {
+  static const MSCpuIsa detected = DetectCpuIsa();
+  return static_cast<MSCpuIsa>(std::min(static_cast<int>(detected), gIsaLimit.load()));
+}
+
+void MSSetCpuIsa(MSCpuIsa isa) { gIsaLimit.store(isa); }
+
+const MSIsaKernels *MSGetIsaKernels() {
+  switch (MSGetCpuIsa()) {
+#if defined(__x86_64__) || defined(__i386__)
+    case CPU_ISA_AVX512:
+      return MSGetAvx512Kernels();
+    case CPU_ISA_AVX2:
+      return MSGetAvx2Kernels();
+#endif
+    default:
+      return MSGetScalarKernels();
+  }
+}
+}  // namespace predict
+}  // namespace mindspore
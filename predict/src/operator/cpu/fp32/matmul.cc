@@ -0,0 +1,186 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "common/mslog.h"
+#include "src/op_registry.h"
+#include "src/operator/cpu/include/fp32_op_base.h"
+
+namespace mindspore {
+namespace predict {
+namespace {
+// the rows or the columns of c split for the threads, the gemm of each part packs its own blocks
+const size_t kGemmSplitBlock = 64;
+}  // namespace
+
+// The ops of one gemm of fp32 tensors: MatMul of 2d tensors with the bias and the activation fused into it by the
+// converter, and FullConnection of the input flattened from its axis with the weights in [outChannel, inChannel]. c is
+// split by its longer side for the threads.
+class GemmOpFp32 : public Fp32OpBase {
+ public:
+  GemmOpFp32(const OpDef &opDef, const Context &ctx, OpT type);
+  ~GemmOpFp32() override = default;
+
+  int Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+  int Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+ private:
+  int InitMatMul(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs);
+  int InitFullConnection(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs);
+
+  OpT type;
+  bool transA = false;
+  bool transB = false;
+  bool hasBias = false;
+  ActivationType actType = ActivationType_NO_ACTIVATION;
+  int axis = 1;
+  size_t m = 0;
+  size_t n = 0;
+  size_t k = 0;
+};
+
+GemmOpFp32::GemmOpFp32(const OpDef &opDef, const Context &ctx, OpT type) : Fp32OpBase(opDef, ctx), type(type) {
+  if (type == OpT_MatMul) {
+    transA = opDef.attr_as_MatMul()->transposeA();
+    transB = opDef.attr_as_MatMul()->transposeB();
+    hasBias = opDef.attr_as_MatMul()->hasBias();
+    actType = opDef.attr_as_MatMul()->activationType();
+  } else {
+    transB = true;
+    hasBias = opDef.attr_as_FullConnection()->hasBias();
+    axis = opDef.attr_as_FullConnection()->axis();
+  }
+}
+
+int GemmOpFp32::Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  auto ret = type == OpT_MatMul ? InitMatMul(inputs, outputs) : InitFullConnection(inputs, outputs);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  if (m == 0 || n == 0 || outputs[0]->GetElementSize() != m * n) {
+    MS_LOGE("%s: output size %zu is not %zu x %zu", name.c_str(), outputs[0]->GetElementSize(), m, n);
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int GemmOpFp32::InitMatMul(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  if (!CheckTensors(inputs, outputs, hasBias ? 3 : 2, 2)) {
+    return RET_ERROR;
+  }
+  if (!MSIsActSupported(actType)) {
+    MS_LOGI("%s: activation %d is not supported", name.c_str(), actType);
+    return RET_ERROR;
+  }
+  auto aDims = inputs[0]->GetDims();
+  auto bDims = inputs[1]->GetDims();
+  if (aDims.size() != 2 || bDims.size() != 2) {
+    MS_LOGI("%s: matmul of %zu and %zu dims is not supported", name.c_str(), aDims.size(), bDims.size());
+    return RET_ERROR;
+  }
+  m = static_cast<size_t>(transA ? aDims[1] : aDims[0]);
+  k = static_cast<size_t>(transA ? aDims[0] : aDims[1]);
+  n = static_cast<size_t>(transB ? bDims[0] : bDims[1]);
+  if (static_cast<size_t>(transB ? bDims[1] : bDims[0]) != k) {
+    MS_LOGE("%s: inner dims of matmul do not match", name.c_str());
+    return RET_ERROR;
+  }
+  if (hasBias && inputs[2]->GetElementSize() != n) {
+    MS_LOGE("%s: bias size %zu is not %zu", name.c_str(), inputs[2]->GetElementSize(), n);
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int GemmOpFp32::InitFullConnection(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  if (!CheckTensors(inputs, outputs, hasBias ? 3 : 2, 1)) {
+    return RET_ERROR;
+  }
+  auto dims = inputs[0]->GetDims();
+  int ndim = static_cast<int>(dims.size());
+  axis = (axis <= 0 || axis >= ndim) ? 1 : axis;
+  m = 1;
+  for (int i = 0; i < axis && i < ndim; ++i) {
+    m *= static_cast<size_t>(dims[i]);
+  }
+  k = m == 0 ? 0 : inputs[0]->GetElementSize() / m;
+  auto weightDims = inputs[1]->GetDims();
+  n = weightDims.empty() ? 0 : static_cast<size_t>(weightDims[0]);
+  if (inputs[1]->GetElementSize() != n * k || (hasBias && inputs[2]->GetElementSize() != n)) {
+    MS_LOGE("%s: weight or bias shape does not match the input", name.c_str());
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int GemmOpFp32::Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  auto a = static_cast<const float *>(inputs[0]->GetData());
+  auto b = static_cast<const float *>(inputs[1]->GetData());
+  auto bias = hasBias ? static_cast<const float *>(inputs[2]->GetData()) : nullptr;
+  auto c = static_cast<float *>(outputs[0]->GetData());
+  if (a == nullptr || b == nullptr || c == nullptr || (hasBias && bias == nullptr)) {
+    MS_LOGE("%s: data of tensors is nullptr", name.c_str());
+    return RET_ERROR;
+  }
+  const size_t lda = transA ? m : k;
+  const size_t ldb = transB ? k : n;
+  if (n >= m) {
+    return ParallelRange(n, kGemmSplitBlock, [&](size_t begin, size_t end) {
+      MSGemmFp32(transA, transB, m, end - begin, k, a, lda, transB ? b + begin * ldb : b + begin, ldb, c + begin, n);
+      for (size_t i = 0; i < m; ++i) {
+        float *row = c + i * n + begin;
+        if (bias != nullptr) {
+          MSBinaryFp32(row, bias + begin, row, end - begin, false, BINARY_ADD);
+        }
+        MSActivationFp32(row, row, end - begin, actType);
+      }
+    });
+  }
+  return ParallelRange(m, kGemmSplitBlock, [&](size_t begin, size_t end) {
+    MSGemmFp32(transA, transB, end - begin, n, k, transA ? a + begin : a + begin * lda, lda, b, ldb, c + begin * n, n);
+    for (size_t i = begin; i < end; ++i) {
+      if (bias != nullptr) {
+        MSBinaryFp32(c + i * n, bias, c + i * n, n, false, BINARY_ADD);
+      }
+      MSActivationFp32(c + i * n, c + i * n, n, actType);
+    }
+  });
+}
+
+OpBase *CreateGemmOpFp32(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                         const OpDef &opDef, const Context &ctx, const OpDesc &desc) {
+  if ((desc.type == OpT_MatMul && opDef.attr_as_MatMul() == nullptr) ||
+      (desc.type == OpT_FullConnection && opDef.attr_as_FullConnection() == nullptr)) {
+    MS_LOGE("attr of %s is nullptr", EnumNameOpT(desc.type));
+    return nullptr;
+  }
+  auto op = std::unique_ptr<GemmOpFp32>(new (std::nothrow) GemmOpFp32(opDef, ctx, desc.type));
+  if (op == nullptr) {
+    MS_LOGE("new GemmOpFp32 failed");
+    return nullptr;
+  }
+  if (op->Init(inputs, outputs) != RET_OK) {
+    return nullptr;
+  }
+  return op.release();
+}
+
+REG_OP(X86_FP32, OpT_MatMul, CreateGemmOpFp32)
+REG_OP(X86_FP32, OpT_FullConnection, CreateGemmOpFp32)
+}  // namespace predict
+}  // namespace mindspore
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "common/mslog.h"
+#include "src/op_registry.h"
+#include "src/operator/cpu/include/fp32_op_base.h"
+
+namespace mindspore {
+namespace predict {
+// max and mean Pooling of NCHW fp32 tensors, a plane for each task at a time. The pads of a padMode other than VALID
+// are the ones of the output shape, as the kernel module takes them.
+class PoolingFp32 : public Fp32OpBase {
+ public:
+  PoolingFp32(const OpDef &opDef, const Context &ctx) : Fp32OpBase(opDef, ctx), attr(opDef.attr_as_Pooling()) {}
+  ~PoolingFp32() override = default;
+
+  int Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+  int Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+ private:
+  const Pooling *attr;
+  MSConvParam param{};
+  size_t planeNum = 0;
+  size_t padDown = 0;
+  size_t padRight = 0;
+};
+
+int PoolingFp32::Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  if (attr->poolingMode() != PoolMode_MAX_POOLING && attr->poolingMode() != PoolMode_MEAN_POOLING) {
+    MS_LOGI("%s: pooling mode %d is not supported", name.c_str(), attr->poolingMode());
+    return RET_ERROR;
+  }
+  if (!CheckTensors(inputs, outputs, 1, 1)) {
+    return RET_ERROR;
+  }
+  std::vector<size_t> inDims;
+  std::vector<size_t> outDims;
+  if (!GetNchwDims(inputs[0], false, &inDims) || !GetNchwDims(outputs[0], isLastConv, &outDims)) {
+    return RET_ERROR;
+  }
+  if (inDims[0] != outDims[0] || inDims[1] != outDims[1] || attr->windowH() <= 0 || attr->windowW() <= 0) {
+    MS_LOGE("%s: output shape does not match the input", name.c_str());
+    return RET_ERROR;
+  }
+  planeNum = inDims[0] * inDims[1];
+  int strideH = std::max(attr->strideH(), 1);
+  int strideW = std::max(attr->strideW(), 1);
+  int padUp = attr->padUp();
+  int padLeft = attr->padLeft();
+  int padBottom = attr->padDown();
+  int padEnd = attr->padRight();
+  if (attr->padMode() != PadMode_VALID) {
+    int dHeight = (static_cast<int>(outDims[2]) - 1) * strideH + attr->windowH() - static_cast<int>(inDims[2]);
+    int dWidth = (static_cast<int>(outDims[3]) - 1) * strideW + attr->windowW() - static_cast<int>(inDims[3]);
+    padUp = dHeight / 2;
+    padBottom = dHeight - dHeight / 2;
+    padLeft = dWidth / 2;
+    padEnd = dWidth - dWidth / 2;
+  }
+  param = {inDims[2],
+           inDims[3],
+           outDims[2],
+           outDims[3],
+           static_cast<size_t>(attr->windowH()),
+           static_cast<size_t>(attr->windowW()),
+           static_cast<size_t>(strideH),
+           static_cast<size_t>(strideW),
+           1,
+           1,
+           static_cast<size_t>(std::max(padUp, 0)),
+           static_cast<size_t>(std::max(padLeft, 0))};
+  padDown = static_cast<size_t>(std::max(padBottom, 0));
+  padRight = static_cast<size_t>(std::max(padEnd, 0));
+  return RET_OK;
+}
+
+int PoolingFp32::Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  auto input = static_cast<const float *>(inputs[0]->GetData());
+  auto output = static_cast<float *>(outputs[0]->GetData());
+  if (input == nullptr || output == nullptr) {
+    MS_LOGE("%s: data of tensors is nullptr", name.c_str());
+    return RET_ERROR;
+  }
+  const size_t inPlane = param.inH * param.inW;
+  const size_t outPlane = param.outH * param.outW;
+  const bool isMax = attr->poolingMode() == PoolMode_MAX_POOLING;
+  auto ret = ParallelRange(planeNum, 1, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      MSPoolingFp32(input + i * inPlane, output + i * outPlane, param, padDown, padRight, isMax, attr->caffeMode());
+    }
+  });
+  if (ret != RET_OK) {
+    return ret;
+  }
+  return isLastConv ? ToNhwc(outputs[0]) : RET_OK;
+}
+
+OpBase *CreatePoolingFp32(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                          const OpDef &opDef, const Context &ctx, const OpDesc &desc) {
+  if (opDef.attr_as_Pooling() == nullptr) {
+    MS_LOGE("opDef.attr_as_Pooling() is nullptr");
+    return nullptr;
+  }
+  auto op = std::unique_ptr<PoolingFp32>(new (std::nothrow) PoolingFp32(opDef, ctx));
+  if (op == nullptr) {
+    MS_LOGE("new PoolingFp32 failed");
+    return nullptr;
+  }
+  if (op->Init(inputs, outputs) != RET_OK) {
+    return nullptr;
+  }
+  return op.release();
+}
+
+REG_OP(X86_FP32, OpT_Pooling, CreatePoolingFp32)
+}  // namespace predict
+}  // namespace mindspore
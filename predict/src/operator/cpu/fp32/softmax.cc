@@ -0,0 +1,97 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/mslog.h"
+#include "src/op_registry.h"
+#include "src/operator/cpu/include/fp32_op_base.h"
+
+namespace mindspore {
+namespace predict {
+// SoftMax of fp32 tensors of any layout but NC4HW4 along one axis, the last one by default, split by the dims before
+// the axis for the threads
+class SoftmaxFp32 : public Fp32OpBase {
+ public:
+  SoftmaxFp32(const OpDef &opDef, const Context &ctx) : Fp32OpBase(opDef, ctx), attr(opDef.attr_as_SoftMax()) {}
+  ~SoftmaxFp32() override = default;
+
+  int Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+  int Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) override;
+
+ private:
+  const SoftMax *attr;
+  size_t outer = 1;
+  size_t axisSize = 1;
+  size_t inner = 1;
+};
+
+int SoftmaxFp32::Init(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  if (!CheckTensors(inputs, outputs, 1, 1)) {
+    return RET_ERROR;
+  }
+  auto dims = inputs[0]->GetDims();
+  int ndim = static_cast<int>(dims.size());
+  int axis = (attr->axis() != nullptr && attr->axis()->size() > 0) ? attr->axis()->Get(0) : -1;
+  axis = axis < 0 ? axis + ndim : axis;
+  if (axis < 0 || axis >= ndim || outputs[0]->GetElementSize() != inputs[0]->GetElementSize()) {
+    MS_LOGE("%s: axis %d of %d dims is invalid", name.c_str(), axis, ndim);
+    return RET_ERROR;
+  }
+  for (int i = 0; i < ndim; ++i) {
+    if (i < axis) {
+      outer *= dims[i];
+    } else if (i > axis) {
+      inner *= dims[i];
+    }
+  }
+  axisSize = dims[axis];
+  return RET_OK;
+}
+
+int SoftmaxFp32::Execute(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
+  auto input = static_cast<const float *>(inputs[0]->GetData());
+  auto output = static_cast<float *>(outputs[0]->GetData());
+  if (input == nullptr || output == nullptr) {
+    MS_LOGE("%s: data of tensors is nullptr", name.c_str());
+    return RET_ERROR;
+  }
+  const size_t size = axisSize * inner;
+  return ParallelRange(outer, 1, [&](size_t begin, size_t end) {
+    MSSoftmaxFp32(input + begin * size, output + begin * size, end - begin, axisSize, inner);
+  });
+}
+
+OpBase *CreateSoftmaxFp32(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                          const OpDef &opDef, const Context &ctx, const OpDesc &desc) {
+  if (opDef.attr_as_SoftMax() == nullptr) {
+    MS_LOGE("opDef.attr_as_SoftMax() is nullptr");
+    return nullptr;
+  }
+  auto op = std::unique_ptr<SoftmaxFp32>(new (std::nothrow) SoftmaxFp32(opDef, ctx));
+  if (op == nullptr) {
+    MS_LOGE("new SoftmaxFp32 failed");
+    return nullptr;
+  }
+  if (op->Init(inputs, outputs) != RET_OK) {
+    return nullptr;
+  }
+  return op.release();
+}
+
+REG_OP(X86_FP32, OpT_SoftMax, CreateSoftmaxFp32)
+}  // namespace predict
+}  // namespace mindspore
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREDICT_SRC_OPERATOR_CPU_INCLUDE_FP32_FUNC_H_
+#define PREDICT_SRC_OPERATOR_CPU_INCLUDE_FP32_FUNC_H_
+
+#include <cstddef>
+#include "schema/inner/ms_generated.h"
+#include "src/operator/cpu/include/fp32_isa.h"
+
+namespace mindspore {
+namespace predict {
+// the shape of a 2d convolution or pooling of one image, the pads at the bottom and the right are implied by the
+// output size
+struct MSConvParam {
+  size_t inH;
+  size_t inW;
+  size_t outH;
+  size_t outW;
+  size_t kernelH;
+  size_t kernelW;
+  size_t strideH;
+  size_t strideW;
+  size_t dilateH;
+  size_t dilateW;
+  size_t padUp;
+  size_t padLeft;
+};
+
+// c(m x n) = op(a)(m x k) * op(b)(k x n), row major, lda, ldb and ldc are the strides of the rows as stored
+void MSGemmFp32(bool transA, bool transB, size_t m, size_t n, size_t k, const float *a, size_t lda, const float *b,
+                size_t ldb, float *c, size_t ldc);
+
+// the columns [begin, end) of the im2col matrix of the channels of src, a row for each channel and kernel position
+void MSIm2ColFp32(const float *src, float *col, size_t channel, const MSConvParam &param, size_t begin, size_t end);
+
+// one output plane of a depthwise convolution of one input plane, initialized with bias
+void MSDepthwiseFp32(const float *src, const float *weight, float bias, float *dst, const MSConvParam &param);
+
+// one output plane of a pooling of one input plane, padDown and padRight for the caffe average
+void MSPoolingFp32(const float *src, float *dst, const MSConvParam &param, size_t padDown, size_t padRight,
+                   bool isMax, bool caffeMode);
+
+void MSSoftmaxFp32(const float *src, float *dst, size_t outer, size_t axis, size_t inner);
+
+bool MSIsActSupported(ActivationType actType);
+
+// dst = act(src), dst may be src
+void MSActivationFp32(const float *src, float *dst, size_t size, ActivationType actType);
+
+// data = act(data + bias) for the planes of the channels, bias may be nullptr
+void MSBiasActFp32(float *data, const float *bias, size_t channel, size_t plane, ActivationType actType);
+
+// dst = a op b, b is one value for all of a if scalarB
+void MSBinaryFp32(const float *a, const float *b, float *dst, size_t size, bool scalarB, MSBinaryMode mode);
+}  // namespace predict
+}  // namespace mindspore
+
+#endif  // PREDICT_SRC_OPERATOR_CPU_INCLUDE_FP32_FUNC_H_
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREDICT_SRC_OPERATOR_CPU_INCLUDE_FP32_ISA_H_
+#define PREDICT_SRC_OPERATOR_CPU_INCLUDE_FP32_ISA_H_
+
+#include <cstddef>
+
+// The inner loops of the fp32 kernels for one instruction set. Each set is built in its own file with the compiler
+// flags of the set and selected at runtime from the features of the cpu, so the files of the wider sets include
+// nothing but this header and the intrinsics: an inline function of another header instantiated there could be
+// picked by the linker for the whole library and fault on a cpu without the set.
+namespace mindspore {
+namespace predict {
+enum MSCpuIsa { CPU_ISA_SCALAR = 0, CPU_ISA_AVX2 = 1, CPU_ISA_AVX512 = 2 };
+
+// the binary ops of the kernels, in the order of EltwiseMode
+enum MSBinaryMode { BINARY_MUL = 0, BINARY_ADD = 1, BINARY_MAX = 2, BINARY_MODE_NUM = 3 };
+
+// c(mr x nr) = (accumulate ? c : 0) + a * b, a is a panel of mr rows packed by k, b a panel of nr columns packed by k
+typedef void (*MSGemmKernel)(size_t k, const float *a, const float *b, float *c, size_t ldc, bool accumulate);
+// dst = a op b, b is one value for all of a if scalarB
+typedef void (*MSBinaryKernel)(const float *a, const float *b, float *dst, size_t size, bool scalarB);
+// data = min(max(data + bias, minValue), maxValue)
+typedef void (*MSBiasClampKernel)(float *data, float bias, size_t size, float minValue, float maxValue);
+// y += alpha * x
+typedef void (*MSAxpyKernel)(float alpha, const float *x, float *y, size_t size);
+typedef float (*MSDotKernel)(const float *a, const float *b, size_t size);
+
+struct MSIsaKernels {
+  MSCpuIsa isa;
+  size_t mr;
+  size_t nr;
+  MSGemmKernel gemm;
+  MSBinaryKernel binary[BINARY_MODE_NUM];
+  MSBiasClampKernel biasClamp;
+  MSAxpyKernel axpy;
+  MSDotKernel dot;
+};
+
+const MSIsaKernels *MSGetScalarKernels();
+#if defined(__x86_64__) || defined(__i386__)
+const MSIsaKernels *MSGetAvx2Kernels();
+const MSIsaKernels *MSGetAvx512Kernels();
+#endif
+
+// the kernels of the widest set the cpu supports, no wider than the one set by MSSetCpuIsa
+const MSIsaKernels *MSGetIsaKernels();
+
+MSCpuIsa MSGetCpuIsa();
+
+// limit the kernels to a set, the detected one at most, to run the narrower sets on a wide cpu
+void MSSetCpuIsa(MSCpuIsa isa);
+}  // namespace predict
+}  // namespace mindspore
+
+#endif  // PREDICT_SRC_OPERATOR_CPU_INCLUDE_FP32_ISA_H_
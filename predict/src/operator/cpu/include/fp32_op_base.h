@@ -0,0 +1,60 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREDICT_SRC_OPERATOR_CPU_INCLUDE_FP32_OP_BASE_H_
+#define PREDICT_SRC_OPERATOR_CPU_INCLUDE_FP32_OP_BASE_H_
+
+#include <functional>
+#include <vector>
+#include "src/op.h"
+#include "src/operator/cpu/include/fp32_func.h"
+#include "src/runtime/thread_pool.h"
+
+namespace mindspore {
+namespace predict {
+// The base of the native x86 fp32 ops. Their creators return nullptr for the tensors they do not support, so that
+// the op factory falls back to the kernel module.
+class Fp32OpBase : public OpBase {
+ public:
+  Fp32OpBase(const OpDef &opDef, const Context &ctx);
+  ~Fp32OpBase() override = default;
+
+ protected:
+  // the tensors are fp32, and the first nchwNum inputs and the outputs are not in NC4HW4
+  bool CheckTensors(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs, size_t inputNum,
+                    size_t nchwNum) const;
+
+  // the dims of a 4d tensor in NCHW order, from the NHWC dims of the output of a last conv
+  bool GetNchwDims(const Tensor *tensor, bool isNhwc, std::vector<size_t> *dims) const;
+
+  // run func(slot, begin, end) on the chunks of [0, size) with the threads of the session, slot in [0, threadNum)
+  // is the thread running a chunk, a chunk is a multiple of block
+  int ParallelFor(size_t size, size_t block, const ParallelForFunc &func) const;
+
+  // run func(begin, end) on the chunks of [0, size), a chunk is a multiple of block
+  int ParallelRange(size_t size, size_t block, const std::function<void(size_t, size_t)> &func) const;
+
+  // transpose an output computed in NCHW to the NHWC of a last conv
+  int ToNhwc(Tensor *output);
+
+  int threadNum;
+  bool isLastConv;
+  std::vector<float> nhwcBuf;
+};
+}  // namespace predict
+}  // namespace mindspore
+
+#endif  // PREDICT_SRC_OPERATOR_CPU_INCLUDE_FP32_OP_BASE_H_
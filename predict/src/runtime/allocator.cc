@@ -15,6 +15,7 @@
  */
 
 #include "src/runtime/allocator.h"
+#include <algorithm>
 #include "common/module_registry.h"
 #include "src/op_common.h"
 
@@ -51,31 +52,69 @@ void DefaultAllocator::UnLock() {
   }
 }
 
+namespace {
+constexpr size_t MIN_CLASS_SHIFT = 6;
+constexpr size_t MIN_CLASS_SIZE = 1 << MIN_CLASS_SHIFT;
+// the number of classes for each power of 2 is (1 << CLASS_STEP_SHIFT)
+constexpr size_t CLASS_STEP_SHIFT = 2;
+
+// get the size class of a size and the size of its buffers, which is at most 25% larger than the size
+size_t GetSizeClass(size_t size, size_t *classSize) {
+  if (size <= MIN_CLASS_SIZE) {
+    *classSize = MIN_CLASS_SIZE;
+    return 0;
+  }
+  // size is in (1 << msb, 1 << (msb + 1)]
+  size_t msb = MIN_CLASS_SHIFT;
+  while (((size - 1) >> (msb + 1)) != 0) {
+    msb++;
+  }
+  size_t stepShift = msb - CLASS_STEP_SHIFT;
+  size_t steps = (size + (static_cast<size_t>(1) << stepShift) - 1) >> stepShift;
+  *classSize = steps << stepShift;
+  return 1 + ((msb - MIN_CLASS_SHIFT) << CLASS_STEP_SHIFT) + (steps - (1 << CLASS_STEP_SHIFT) - 1);
+}
+}  // namespace
+
 void *DefaultAllocator::Malloc(size_t size) {
   if (size > MAX_MALLOC_SIZE) {
     return nullptr;
   }
+  size_t classSize = 0;
+  size_t sizeClass = GetSizeClass(size, &classSize);
+  // the last class whose buffers are smaller than (size << shiftFactor)
+  size_t maxClass = sizeClass;
+  // an empty request only takes the smallest class
+  if (shiftFactor > 0 && size > 0) {
+    size_t limit = size << shiftFactor;
+    size_t limitClassSize = 0;
+    size_t limitClass = GetSizeClass(limit - 1, &limitClassSize);
+    // even the smallest class is not below a small limit
+    size_t limitMaxClass = limitClassSize < limit ? limitClass : (limitClass == 0 ? 0 : limitClass - 1);
+    maxClass = std::max(sizeClass, limitMaxClass);
+  }
   Lock();
-  auto it = freeList.begin();
-  for (; it != freeList.end(); it++) {
-    auto membuf = *it;
-
-    if ((membuf->size >= size) && (membuf->size < (size << shiftFactor))) {
-      freeList.erase(it);
-      allocatedList.push_back(membuf);
-      UnLock();
-      return membuf->buf;
+  for (size_t i = sizeClass; i <= maxClass && i < freeList.size(); i++) {
+    if (freeList[i].empty()) {
+      continue;
     }
+    auto membuf = freeList[i].back();
+    freeList[i].pop_back();
+    allocatedList[membuf->buf] = membuf;
+    UnLock();
+    return membuf->buf;
   }
-  std::unique_ptr<MemBuf> membuf(reinterpret_cast<MemBuf *>(malloc(sizeof(MemBuf) + size)));
+  std::unique_ptr<MemBuf> membuf(reinterpret_cast<MemBuf *>(malloc(sizeof(MemBuf) + classSize)));
   if (membuf == nullptr) {
     UnLock();
     return nullptr;
   }
-  membuf->size = size;
+  membuf->size = classSize;
+  membuf->sizeClass = sizeClass;
   membuf->buf = reinterpret_cast<char *>(membuf.get()) + sizeof(MemBuf);
   auto bufPtr = membuf->buf;
-  allocatedList.push_back(membuf.release());
+  allocatedList[bufPtr] = membuf.release();
+  totalSize += classSize;
   UnLock();
   return bufPtr;
 }
@@ -85,16 +124,16 @@ void DefaultAllocator::Free(void *buf) {
     return;
   }
   Lock();
-  auto it = allocatedList.begin();
-  for (; it != allocatedList.end(); it++) {
-    auto membuf = *it;
-
-    if (membuf->buf == buf) {
-      allocatedList.erase(it);
-      freeList.push_back(membuf);
-      UnLock();
-      return;
+  auto it = allocatedList.find(buf);
+  if (it != allocatedList.end()) {
+    auto membuf = it->second;
+    allocatedList.erase(it);
+    if (freeList.size() <= membuf->sizeClass) {
+      freeList.resize(membuf->sizeClass + 1);
     }
+    freeList[membuf->sizeClass].push_back(membuf);
+    UnLock();
+    return;
   }
   UnLock();
   free(buf);
@@ -102,33 +141,24 @@ void DefaultAllocator::Free(void *buf) {
 
 size_t DefaultAllocator::GetTotalSize() {
   Lock();
-  size_t totalSize = 0;
-  auto it = allocatedList.begin();
-  for (; it != allocatedList.end(); it++) {
-    auto membuf = *it;
-    totalSize += membuf->size;
-  }
-  it = freeList.begin();
-  for (; it != freeList.end(); it++) {
-    auto membuf = *it;
-    totalSize += membuf->size;
-  }
+  size_t size = totalSize;
   UnLock();
-  return totalSize;
+  return size;
 }
 
 void DefaultAllocator::Clear() {
   Lock();
-  auto it = allocatedList.begin();
-  for (; it != allocatedList.end(); it++) {
-    free(*it);
+  for (auto &it : allocatedList) {
+    free(it.second);
   }
   allocatedList.clear();
-  it = freeList.begin();
-  for (; it != freeList.end(); it++) {
-    free(*it);
+  for (auto &bufs : freeList) {
+    for (auto membuf : bufs) {
+      free(membuf);
+    }
   }
   freeList.clear();
+  totalSize = 0;
   UnLock();
 }
 }  // namespace predict
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
 #include "common/module_registry.h"
@@ -43,6 +44,9 @@ class Allocator {
   std::string name;
 };
 
+// The buffers are rounded up to size classes, 4 classes for each power of 2, and a freed buffer is kept in the free
+// list of its class for the next Malloc of the class. A Malloc which misses its class reuses a buffer of the next
+// classes smaller than (size << shiftFactor).
 class DefaultAllocator : public Allocator {
  public:
   DefaultAllocator();
@@ -58,12 +62,16 @@ class DefaultAllocator : public Allocator {
   void UnLock();
   struct MemBuf {
     size_t size;
+    size_t sizeClass;
     void *buf;
   };
 
   std::mutex lock;
-  std::vector<MemBuf *> allocatedList;
-  std::vector<MemBuf *> freeList;
+  // the buffers in use by their addresses
+  std::unordered_map<void *, MemBuf *> allocatedList;
+  // the free buffers of each size class
+  std::vector<std::vector<MemBuf *>> freeList;
+  size_t totalSize = 0;
   int shiftFactor = 0;
   bool lockFlag = false;
 };
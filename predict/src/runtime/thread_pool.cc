@@ -24,35 +24,111 @@ static constexpr int kThreadPoolMaxThreads = 8;
 static const int kCoreNumThr = 4;
 static const int kMidCoreNum = 2;
 static const int kBigCoreNum = 2;
-bool LiteQueue::Enqueue(const ThreadPoolTask &task) {
-  const int tailIndex = tail.load(std::memory_order_relaxed);
-  // queue full
-  auto next = (tailIndex + 1) % kSingleThreadMaxTask;
-  if (next == head.load(std::memory_order_acquire)) {
-    return false;
+// a thread of the pool yields this many times for the next parallel for before sleeping
+static const int kThreadSpinCount = 1000;
+static const size_t kCacheLineSize = 64;
+
+class ParallelJob {
+ public:
+  ParallelJob(size_t size, size_t grain, int slotNum, const ParallelForFunc &func);
+  ~ParallelJob() = default;
+
+  // a free slot for a thread of the pool, -1 if every slot is joined, under the lock of the pool
+  int Join();
+  void Leave() { active.fetch_sub(1, std::memory_order_release); }
+  // no thread of the pool runs the job any more
+  bool Finished() const { return active.load(std::memory_order_acquire) == 0; }
+  // run the chunks of the slot, then the chunks stolen from the other slots, until no chunk is left
+  void Run(int slot);
+  int GetError() const { return error.load(); }
+
+ private:
+  struct Slot {
+    std::mutex mutex;
+    size_t begin{0};
+    size_t end{0};
+    // the slots are locked by different threads
+    char padding[kCacheLineSize]{};
+  };
+  bool Steal(int slot);
+
+  size_t size;
+  size_t grain;
+  int slotNum;
+  const ParallelForFunc &func;
+  std::unique_ptr<Slot[]> slots;
+  // the caller runs slot 0, active counts the threads of the pool only
+  int joined{1};
+  std::atomic_int active{0};
+  std::atomic_int error{0};
+};
+
+ParallelJob::ParallelJob(size_t size, size_t grain, int slotNum, const ParallelForFunc &func)
+    : size(size), grain(grain), slotNum(slotNum), func(func), slots(new Slot[slotNum]) {
+  size_t chunkNum = (size + grain - 1) / grain;
+  for (int i = 0; i < slotNum; ++i) {
+    slots[i].begin = chunkNum * i / slotNum;
+    slots[i].end = chunkNum * (i + 1) / slotNum;
   }
-  buffer[tailIndex] = task;
-  tail.store(next, std::memory_order_release);
-  taskSize.fetch_add(1);
-  return true;
 }
 
-bool LiteQueue::Dequeue(ThreadPoolTask *out) {
-  if (out == nullptr) {
-    MS_LOGE("ThreadPoolTask is nullptr");
-    return false;
+int ParallelJob::Join() {
+  if (joined >= slotNum) {
+    return -1;
   }
-  if (taskSize.load() == 0) {
-    return false;
+  active.fetch_add(1, std::memory_order_relaxed);
+  return joined++;
+}
+
+void ParallelJob::Run(int slot) {
+  Slot &own = slots[slot];
+  while (error.load(std::memory_order_relaxed) == 0) {
+    size_t chunk = 0;
+    bool found = false;
+    {
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (own.begin < own.end) {
+        chunk = own.begin++;
+        found = true;
+      }
+    }
+    if (!found) {
+      if (!Steal(slot)) {
+        return;
+      }
+      continue;
+    }
+    size_t begin = chunk * grain;
+    int ret = func(slot, begin, std::min(begin + grain, size));
+    if (ret != 0) {
+      int expected = 0;
+      (void)error.compare_exchange_strong(expected, ret);
+    }
   }
-  // queue empty
-  const int headIndex = head.load(std::memory_order_relaxed);
-  if (headIndex == tail.load(std::memory_order_acquire)) {
-    return false;
+}
+
+bool ParallelJob::Steal(int slot) {
+  for (int i = 1; i < slotNum; ++i) {
+    Slot &victim = slots[(slot + i) % slotNum];
+    size_t begin = 0;
+    size_t end = 0;
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      size_t left = victim.end - victim.begin;
+      if (left == 0) {
+        continue;
+      }
+      // the back half, the victim goes on with the front
+      end = victim.end;
+      victim.end -= (left + 1) / 2;
+      begin = victim.end;
+    }
+    std::lock_guard<std::mutex> lock(slots[slot].mutex);
+    slots[slot].begin = begin;
+    slots[slot].end = end;
+    return true;
   }
-  *out = buffer[headIndex];
-  head.store((headIndex + 1) % kSingleThreadMaxTask, std::memory_order_release);
-  return true;
+  return false;
 }
 
 bool LiteThreadBind::Bind(int numThreads, int mode) {
@@ -197,125 +273,105 @@ bool LiteThreadBind::SetCPUBind(pthread_t threadId, const cpu_set_t &cpuSet) {
 }
 
 LiteThreadPool::LiteThreadPool(int numThreads) {
-  queueList.resize(kThreadPoolMaxThreads);
-  queueList.clear();
+  threadList.reserve(kThreadPoolMaxThreads);
   AddNewThread(numThreads);
 }
 
 void LiteThreadPool::AddNewThread(int newNums) {
-  for (int i = curThreadNums, j = 0; j < newNums; ++j, ++i) {
-    queueList.push_back(std::unique_ptr<LiteQueue>(new LiteQueue()));
-    threadList.emplace_back([this, i]() {
-      ThreadPoolTask task;
-      while (!destroy) {
-        while (running != 0) {
-          MS_LOGD("i = %d, thread id = %lu, taskSize = %d", i, pthread_self(), queueList[i]->taskSize.load());
-          while (queueList[i]->taskSize.load() > 0 && queueList[i]->Dequeue(&task)) {
-            auto ret = task.first(task.second.taskId, task.second.tvmParam, task.second.cdata);
-            if (ret != 0) {
-              errorInfo.emplace_back(std::make_pair(task.second.taskId, std::make_pair(false, ret)));
-            }
-            queueList[i]->taskSize.fetch_sub(1);
-          }
-          std::this_thread::yield();
-        }
-        std::unique_lock<std::mutex> queueLock(tMutex);
-        queueReady.wait(queueLock, [this] { return destroy || running != 0; });
-      }
-    });
+  for (int i = 0; i < newNums; ++i) {
+    threadList.emplace_back([this]() { ThreadRun(); });
   }
   MS_LOGI("%d new thread create", newNums);
-  curThreadNums += newNums;
 }
 
-bool LiteThreadPool::DistributeTask(ThreadPoolTask task, int numTask) {
-  // wake up
-  errorInfo.clear();
-  if (!AddRunReference()) {
-    MS_LOGE("add reference failed");
-    return false;
-  }
-  bool kSuccFlag;
-  for (int i = 1; i < numTask; ++i) {
-    task.second.taskId = i;
-    do {
-      kSuccFlag = false;
-      for (auto &queue : queueList) {
-        MS_ASSERT(queue != nullptr);
-        if (queue->Enqueue(task)) {
-          kSuccFlag = true;
-          break;
-        }
-      }
+void LiteThreadPool::ThreadRun() {
+  while (true) {
+    for (int i = 0; i < kThreadSpinCount && jobNum.load(std::memory_order_relaxed) == 0; ++i) {
       std::this_thread::yield();
-    } while (!kSuccFlag);
+    }
+    ParallelJob *job = nullptr;
+    int slot = 0;
+    {
+      std::unique_lock<std::mutex> queueLock(tMutex);
+      queueReady.wait(queueLock, [this, &job, &slot] { return destroy || JoinJob(&job, &slot); });
+    }
+    if (job == nullptr) {
+      return;
+    }
+    job->Run(slot);
+    job->Leave();
   }
-  MS_LOGI("add %d task successful", numTask);
-  // master thread
-  int ret = task.first(0, task.second.tvmParam, task.second.cdata);
-  if (ret != 0) {
-    errorInfo.emplace_back(std::make_pair(0, std::make_pair(false, ret)));
+}
+
+bool LiteThreadPool::JoinJob(ParallelJob **job, int *slot) {
+  for (auto candidate : jobList) {
+    int freeSlot = candidate->Join();
+    if (freeSlot > 0) {
+      *job = candidate;
+      *slot = freeSlot;
+      return true;
+    }
   }
-  kSuccFlag = false;
-  while (!kSuccFlag) {
-    kSuccFlag = true;
-    for (auto iter = queueList.begin(); iter != queueList.end(); ++iter) {
-      if ((*iter)->taskSize.load() != 0) {
-        kSuccFlag = false;
-        break;
-      }
+  return false;
+}
+
+bool LiteThreadPool::ParallelFor(size_t size, size_t grain, int quota, const ParallelForFunc &func) {
+  size_t chunkNum = (size + grain - 1) / grain;
+  int slotNum = static_cast<int>(std::min(chunkNum, static_cast<size_t>(std::max(quota, 1))));
+  ParallelJob job(size, grain, slotNum, func);
+  if (slotNum > 1) {
+    std::lock_guard<std::mutex> queueLock(tMutex);
+    jobList.push_back(&job);
+    jobNum.fetch_add(1);
+    for (int i = 1; i < slotNum; ++i) {
+      queueReady.notify_one();
     }
+  }
+  // master thread
+  job.Run(0);
+  if (slotNum > 1) {
+    std::lock_guard<std::mutex> queueLock(tMutex);
+    jobList.erase(std::find(jobList.begin(), jobList.end(), &job));
+    jobNum.fetch_sub(1);
+  }
+  // the chunks are all taken, wait for the threads still running theirs
+  while (!job.Finished()) {
     std::this_thread::yield();
   }
-  // hibernate
-  if (!SubRunReference()) {
-    MS_LOGE("sub reference failed");
+  if (job.GetError() != 0) {
+    MS_LOGE("parallel for of %zu items failed, error code is %d", size, job.GetError());
     return false;
   }
-  MS_LOGI("finish %d task successful", numTask);
-  return CheckResult();
-}
-
-bool LiteThreadPool::AddRunReference() {
-  running.fetch_add(1);
-  std::lock_guard<std::mutex> queueLock(tMutex);
-  queueReady.notify_all();
+  MS_LOGD("parallel for of %zu items on %d slots successful", size, slotNum);
   return true;
 }
 
-bool LiteThreadPool::SubRunReference() {
-  running.fetch_sub(1);
-  return true;
-}
-
-bool LiteThreadPool::CheckResult() {
-  bool kSuccFlag = true;
-  for (auto result : errorInfo) {
-    if (result.second.first) {
-      MS_LOGE("task %d failed, error code is %d", result.first, result.second.second);
-      kSuccFlag = false;
-    }
-  }
-  return kSuccFlag;
+// the caller is one of the threads, and the pool is not larger than the other cores
+static int GetMaxThreadNum() {
+  static const int maxThreads = [] {
+    int coreNum = static_cast<int>(std::thread::hardware_concurrency());
+    return coreNum > 0 ? std::min(kThreadPoolMaxThreads, coreNum - 1) : kThreadPoolMaxThreads;
+  }();
+  return maxThreads;
 }
 
 int ThreadPool::GetThreadNum(int numThreads) {
-  if (numThreads <= 0 || numThreads > kThreadPoolMaxThreads) {
-    MS_LOGE("numThreads %d, must be greater than 0 or less than or equal to %d", numThreads, kThreadPoolMaxThreads);
+  if (numThreads <= 0) {
+    MS_LOGE("numThreads %d, must be greater than 0", numThreads);
     return -1;
-  } else {
-    if (numThreads > totalThreadNum) {
-      return (numThreads - totalThreadNum);
-    } else {
-      MS_LOGD("%d threads have been already created", numThreads);
-      return 0;
-    }
   }
+  int curThreads = gThreadPool == nullptr ? 0 : static_cast<int>(gThreadPool->threadList.size());
+  int needThreads = std::min(numThreads - 1, GetMaxThreadNum());
+  if (needThreads <= curThreads) {
+    MS_LOGD("%d threads have been already created", curThreads);
+    return 0;
+  }
+  return needThreads - curThreads;
 }
 
 void ThreadPool::GetThreadIdList() {
   if (gThreadPool != nullptr) {
-    for (int i = 0; i < totalThreadNum; ++i) {
+    for (size_t i = 0; i < gThreadPool->threadList.size(); ++i) {
       bool kSuccFlag = false;
       pthread_t threadHandle;
       do {
@@ -355,7 +411,10 @@ bool ThreadPool::SetThreadCpulBind(int mode) {
   }
   GetThreadIdList();
 
-  if (!gThreadBind->Bind(totalThreadNum, mode)) {
+  // the sessions may have grown the pool over the configured threads, which are the ones bound
+  int threadNum = gThreadPool == nullptr ? 0 : static_cast<int>(gThreadPool->threadList.size());
+  threadNum = std::min(threadNum, totalThreadNum - 1);
+  if (!gThreadBind->Bind(threadNum, mode)) {
     MS_LOGE("BindCore failed");
     return false;
   }
@@ -363,27 +422,38 @@ bool ThreadPool::SetThreadCpulBind(int mode) {
 }
 
 bool ThreadPool::SetThreadPool(int numThreads) {
+  // the pool only grows, once it has the threads the lock is not needed
+  if (numThreads > 0 && curThreadNum.load(std::memory_order_acquire) >= std::min(numThreads - 1, GetMaxThreadNum())) {
+    return true;
+  }
   std::lock_guard<std::mutex> Lock(gPoolMutex);
   int realNums = GetThreadNum(numThreads);
-  if (realNums < -1) {
+  if (realNums < 0) {
     return false;
   }
-  if (realNums == 0) {
-    return true;
-  }
   if (gThreadPool == nullptr) {
     gThreadPool = std::unique_ptr<LiteThreadPool>(new (std::nothrow) LiteThreadPool(realNums));
     if (gThreadPool == nullptr) {
       MS_LOGE("%d threads create failed", realNums);
       return false;
     }
-  } else {
+  } else if (realNums > 0) {
     gThreadPool->AddNewThread(realNums);
   }
+  curThreadNum.store(static_cast<int>(gThreadPool->threadList.size()), std::memory_order_release);
   MS_LOGD("%d threads create successful", realNums);
   return true;
 }
 
+LiteThreadPool *ThreadPool::GetThreadPool(int numThreads) {
+  if (!SetThreadPool(numThreads)) {
+    MS_LOGE("create %d threads failed", numThreads);
+    return nullptr;
+  }
+  // the pool is never released once created
+  return gThreadPool.get();
+}
+
 ThreadPool *ThreadPool::GetInstance() {
   static ThreadPool instance;
   return &instance;
@@ -395,11 +465,9 @@ void ThreadPool::ConfigThreadPool(int mode, int numThreads) {
 }
 
 bool ThreadPool::LaunchThreadPoolTask() {
-  if (gThreadPool == nullptr) {
-    if (!SetThreadPool(totalThreadNum)) {
-      MS_LOGE("create %d threads failed", totalThreadNum);
-      return false;
-    }
+  if (!SetThreadPool(totalThreadNum)) {
+    MS_LOGE("create %d threads failed", totalThreadNum);
+    return false;
   }
 
   if (gThreadBind == nullptr) {
@@ -415,27 +483,42 @@ bool ThreadPool::AddTask(const WorkFun &worker, void *cdata, int numTask) {
   if (numTask <= 0) {
     numTask = totalThreadNum;
   }
-  // single task, run master thread
-  if (numTask <= 1) {
-    TvmEnv env{};
-    env.num_task = numTask;
-    int ret = worker(0, &env, cdata);
+  TvmEnv env{};
+  env.num_task = numTask;
+  return ParallelFor(numTask, 1, numTask, [&worker, &env, cdata](int slot, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      int ret = worker(static_cast<int>(i), &env, cdata);
+      if (ret != 0) {
+        return ret;
+      }
+    }
+    return 0;
+  });
+}
+
+bool ThreadPool::ParallelFor(size_t size, size_t grain, int quota, const ParallelForFunc &func) {
+  grain = std::max<size_t>(grain, 1);
+  // single chunk, or single thread, run master thread
+  if (size <= grain || quota <= 1) {
+    int ret = size == 0 ? 0 : func(0, 0, size);
     if (ret != 0) {
-      MS_LOGE("task 0 failed, error code is %d", ret);
+      MS_LOGE("parallel for of %zu items failed, error code is %d", size, ret);
       return false;
     }
-    MS_LOGD("task 0 successful");
     return true;
   }
-  ThreadPoolTask task;
-  task.first = worker;
-  task.second.cdata = cdata;
-  return gThreadPool->DistributeTask(task, numTask);
+  auto pool = GetThreadPool(quota);
+  if (pool == nullptr) {
+    return false;
+  }
+  return pool->ParallelFor(size, grain, quota, func);
 }
 
 LiteThreadPool::~LiteThreadPool() {
-  destroy.store(true);
-  running.store(0);
+  {
+    std::lock_guard<std::mutex> queueLock(tMutex);
+    destroy = true;
+  }
   queueReady.notify_all();
   for (auto &thread : threadList) {
     if (thread.joinable()) {
@@ -30,30 +30,12 @@
 
 namespace mindspore {
 namespace predict {
-constexpr int kSingleThreadMaxTask = 4;
 using TvmEnv = TVMParallelGroupEnv;
 using WorkFun = FTVMParallelLambda;
-using TaskParam = struct Param {
-  void *cdata;
-  int32_t taskId;
-  TvmEnv *tvmParam;
-};
-using ThreadPoolTask = std::pair<WorkFun, TaskParam>;
-
-class LiteQueue {
- public:
-  LiteQueue() = default;
-  ~LiteQueue() = default;
+// func(slot, begin, end) runs the items [begin, end) of a parallel for, slot in [0, quota) is the thread running it
+using ParallelForFunc = std::function<int(int, size_t, size_t)>;
 
-  bool Enqueue(const ThreadPoolTask &task);
-  bool Dequeue(ThreadPoolTask *out);
-  std::atomic<int> taskSize{0};
-
- private:
-  std::atomic<int> head{0};
-  std::atomic<int> tail{0};
-  ThreadPoolTask buffer[kSingleThreadMaxTask]{};
-};
+class ParallelJob;
 
 class LiteThreadBind {
  public:
@@ -76,6 +58,10 @@ class LiteThreadBind {
   AffinityMode bindModel{MID_CORE};
 };
 
+// The threads of the pool steal the chunks of the parallel fors. The chunks of a parallel for are split over its
+// slots, the caller runs slot 0 and the threads of the pool join the other slots. A thread runs the chunks of its slot
+// one by one from the front, then steals half of the chunks left in another slot from the back. So a slow thread, or
+// a slot no thread joins as the pool is busy with the parallel fors of other sessions, leaves no core idle.
 class LiteThreadPool {
  public:
   LiteThreadPool() = default;
@@ -83,21 +69,18 @@ class LiteThreadPool {
   ~LiteThreadPool();
 
   void AddNewThread(int newNums);
-  bool DistributeTask(ThreadPoolTask task, int numTask);
+  // run func on the chunks of grain items of [0, size), by the caller and at most quota - 1 threads of the pool
+  bool ParallelFor(size_t size, size_t grain, int quota, const ParallelForFunc &func);
   std::vector<std::thread> threadList{};
 
  private:
-  using errCode = std::pair<bool, int>;
-  bool AddRunReference();
-  bool SubRunReference();
-  bool CheckResult();
-  int curThreadNums{0};
-  std::vector<std::unique_ptr<LiteQueue>> queueList;
-  std::atomic_int running{0};
+  void ThreadRun();
+  bool JoinJob(ParallelJob **job, int *slot);
+  std::vector<ParallelJob *> jobList{};
+  std::atomic_int jobNum{0};
   std::mutex tMutex;
   std::condition_variable queueReady;
-  std::atomic<bool> destroy = {false};
-  std::vector<std::pair<int, errCode>> errorInfo{};
+  bool destroy{false};
 };
 
 class ThreadPool {
@@ -106,6 +89,8 @@ class ThreadPool {
   void ConfigThreadPool(int mode, int numThreads);
   bool LaunchThreadPoolTask();
   bool AddTask(const WorkFun &worker, void *cdata, int numTask);
+  // the pool is shared by the sessions of the process, quota is the thread number of the session
+  bool ParallelFor(size_t size, size_t grain, int quota, const ParallelForFunc &func);
 
   ThreadPool(const ThreadPool &) = delete;
   ThreadPool &operator=(const ThreadPool &) = delete;
@@ -116,10 +101,13 @@ class ThreadPool {
   int GetThreadNum(int numThreads);
   void GetThreadIdList();
   bool SetThreadPool(int numThreads = 1);
+  LiteThreadPool *GetThreadPool(int numThreads);
   bool SetThreadCpulBind(int mode);
   std::unique_ptr<LiteThreadPool> gThreadPool{nullptr};
   std::unique_ptr<LiteThreadBind> gThreadBind{nullptr};
   std::mutex gPoolMutex;
+  // the thread number of the pool published after it grows, -1 before the pool is created
+  std::atomic_int curThreadNum{-1};
   int totalThreadNum{1};
   int bindMode{-1};
 };
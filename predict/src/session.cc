@@ -150,5 +150,13 @@ std::map<std::string, std::vector<Tensor *>> Session::GetAllOutput() {
   }
   return outputs;
 }
+
+size_t Session::GetWorkspaceSize() {
+  if (_graph == nullptr) {
+    MS_LOGE("the graph is nullptr");
+    return 0;
+  }
+  return _graph->GetWorkspaceSize();
+}
 }  // namespace predict
 }  // namespace mindspore
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "src/runtime/allocator.h"
+
+namespace mindspore {
+namespace predict {
+class AllocatorTest : public ::testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(AllocatorTest, ReuseSizeClass) {
+  DefaultAllocator allocator;
+  AllocatorContext ctx = {0, true};
+  allocator.SetContext(ctx);
+
+  void *buf = allocator.Malloc(100);
+  ASSERT_NE(buf, nullptr);
+  allocator.Free(buf);
+  // 100 and 110 are in the size class of 112
+  ASSERT_EQ(allocator.Malloc(110), buf);
+  void *other = allocator.Malloc(200);
+  ASSERT_NE(other, nullptr);
+  ASSERT_NE(other, buf);
+  ASSERT_EQ(allocator.GetTotalSize(), 112 + 224);
+
+  allocator.Free(buf);
+  allocator.Free(other);
+  // without shiftFactor a buffer of a larger class is not reused
+  void *small = allocator.Malloc(50);
+  ASSERT_NE(small, buf);
+  ASSERT_NE(small, other);
+  ASSERT_EQ(allocator.GetTotalSize(), 112 + 224 + 64);
+
+  allocator.Clear();
+  ASSERT_EQ(allocator.GetTotalSize(), 0);
+}
+
+TEST_F(AllocatorTest, ReuseLargerClass) {
+  DefaultAllocator allocator;
+  AllocatorContext ctx = {1, true};
+  allocator.SetContext(ctx);
+
+  void *buf = allocator.Malloc(100);
+  ASSERT_NE(buf, nullptr);
+  allocator.Free(buf);
+  // the buffer of 112 is too large for 50 but not for 60
+  void *small = allocator.Malloc(50);
+  ASSERT_NE(small, buf);
+  ASSERT_EQ(allocator.Malloc(60), buf);
+  ASSERT_EQ(allocator.GetTotalSize(), 112 + 64);
+}
+
+TEST_F(AllocatorTest, SmallSizeNotReuseLargerClass) {
+  DefaultAllocator allocator;
+  AllocatorContext ctx = {1, true};
+  allocator.SetContext(ctx);
+
+  void *buf = allocator.Malloc(100);
+  ASSERT_NE(buf, nullptr);
+  allocator.Free(buf);
+  // the limit of 20 is 40, which is below the smallest class, only the smallest class is taken
+  void *small = allocator.Malloc(20);
+  ASSERT_NE(small, nullptr);
+  ASSERT_NE(small, buf);
+  ASSERT_EQ(allocator.GetTotalSize(), 112 + 64);
+}
+
+TEST_F(AllocatorTest, MallocZero) {
+  DefaultAllocator allocator;
+  AllocatorContext ctx = {1, true};
+  allocator.SetContext(ctx);
+
+  void *buf = allocator.Malloc(100);
+  ASSERT_NE(buf, nullptr);
+  allocator.Free(buf);
+  void *empty = allocator.Malloc(0);
+  ASSERT_NE(empty, nullptr);
+  ASSERT_NE(empty, buf);
+  ASSERT_EQ(allocator.GetTotalSize(), 112 + 64);
+  allocator.Free(empty);
+  ASSERT_EQ(allocator.Malloc(0), empty);
+}
+
+}  // namespace predict
+}  // namespace mindspore
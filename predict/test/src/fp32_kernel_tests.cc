@@ -0,0 +1,194 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+#include "src/operator/cpu/include/fp32_func.h"
+
+namespace mindspore {
+namespace predict {
+class Fp32KernelTest : public ::testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() { MSSetCpuIsa(CPU_ISA_AVX512); }
+
+  static std::vector<float> Random(size_t size) {
+    std::vector<float> data(size);
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = static_cast<float>((i * 7919 + 13) % 97) / 48.5f - 1.0f;
+    }
+    return data;
+  }
+
+  static std::vector<MSCpuIsa> Isas() {
+    std::vector<MSCpuIsa> isas;
+    for (int isa = CPU_ISA_SCALAR; isa <= MSGetCpuIsa(); ++isa) {
+      isas.push_back(static_cast<MSCpuIsa>(isa));
+    }
+    return isas;
+  }
+};
+
+TEST_F(Fp32KernelTest, Gemm) {
+  // sizes around the tiles of each isa and the blocks of the packing
+  const size_t shapes[][3] = {{1, 33, 17}, {5, 7, 3}, {13, 35, 300}, {100, 530, 9}, {6, 16, 1}};
+  for (auto isa : Isas()) {
+    MSSetCpuIsa(isa);
+    for (auto &shape : shapes) {
+      size_t m = shape[0];
+      size_t n = shape[1];
+      size_t k = shape[2];
+      auto a = Random(m * k);
+      auto b = Random(k * n);
+      for (int trans = 0; trans < 4; ++trans) {
+        bool transA = (trans & 1) != 0;
+        bool transB = (trans & 2) != 0;
+        std::vector<float> c(m * n, NAN);
+        MSGemmFp32(transA, transB, m, n, k, a.data(), transA ? m : k, b.data(), transB ? k : n, c.data(), n);
+        for (size_t i = 0; i < m; ++i) {
+          for (size_t j = 0; j < n; ++j) {
+            float expect = 0;
+            for (size_t p = 0; p < k; ++p) {
+              expect += (transA ? a[p * m + i] : a[i * k + p]) * (transB ? b[j * k + p] : b[p * n + j]);
+            }
+            ASSERT_NEAR(c[i * n + j], expect, 1e-3) << "isa " << isa << " m " << m << " n " << n << " k " << k;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(Fp32KernelTest, Conv) {
+  // a 3x3 convolution of stride 2 with pads, as im2col and gemm against the direct sum
+  MSConvParam param = {9, 8, 5, 4, 3, 3, 2, 2, 1, 1, 1, 1};
+  const size_t inChannel = 3;
+  const size_t outChannel = 5;
+  const size_t plane = param.outH * param.outW;
+  const size_t depth = inChannel * param.kernelH * param.kernelW;
+  auto input = Random(inChannel * param.inH * param.inW);
+  auto weight = Random(outChannel * depth);
+  std::vector<float> expect(outChannel * plane, 0.0f);
+  for (size_t oc = 0; oc < outChannel; ++oc) {
+    for (size_t j = 0; j < plane; ++j) {
+      for (size_t p = 0; p < depth; ++p) {
+        size_t c = p / (param.kernelH * param.kernelW);
+        int ih = static_cast<int>(j / param.outW * param.strideH + p / param.kernelW % param.kernelH) - 1;
+        int iw = static_cast<int>(j % param.outW * param.strideW + p % param.kernelW) - 1;
+        if (ih >= 0 && ih < static_cast<int>(param.inH) && iw >= 0 && iw < static_cast<int>(param.inW)) {
+          expect[oc * plane + j] += weight[oc * depth + p] * input[(c * param.inH + ih) * param.inW + iw];
+        }
+      }
+    }
+  }
+  for (auto isa : Isas()) {
+    MSSetCpuIsa(isa);
+    // two tiles of the output pixels
+    std::vector<float> output(outChannel * plane);
+    for (size_t begin = 0; begin < plane; begin += 12) {
+      size_t end = std::min(begin + 12, plane);
+      std::vector<float> col(depth * (end - begin));
+      MSIm2ColFp32(input.data(), col.data(), inChannel, param, begin, end);
+      MSGemmFp32(false, false, outChannel, end - begin, depth, weight.data(), depth, col.data(), end - begin,
+                 output.data() + begin, plane);
+    }
+    for (size_t i = 0; i < output.size(); ++i) {
+      ASSERT_NEAR(output[i], expect[i], 1e-4) << "isa " << isa;
+    }
+  }
+}
+
+TEST_F(Fp32KernelTest, Depthwise) {
+  MSConvParam param = {6, 7, 6, 7, 3, 3, 1, 1, 1, 1, 1, 1};
+  auto input = Random(param.inH * param.inW);
+  auto weight = Random(param.kernelH * param.kernelW);
+  std::vector<float> output(param.outH * param.outW);
+  MSDepthwiseFp32(input.data(), weight.data(), 0.5f, output.data(), param);
+  for (size_t oh = 0; oh < param.outH; ++oh) {
+    for (size_t ow = 0; ow < param.outW; ++ow) {
+      float expect = 0.5f;
+      for (int kh = 0; kh < 3; ++kh) {
+        for (int kw = 0; kw < 3; ++kw) {
+          int ih = static_cast<int>(oh) + kh - 1;
+          int iw = static_cast<int>(ow) + kw - 1;
+          if (ih >= 0 && ih < 6 && iw >= 0 && iw < 7) {
+            expect += weight[kh * 3 + kw] * input[ih * 7 + iw];
+          }
+        }
+      }
+      ASSERT_NEAR(output[oh * param.outW + ow], expect, 1e-5);
+    }
+  }
+}
+
+TEST_F(Fp32KernelTest, Pooling) {
+  // 2x2 windows of stride 2 over a 3x3 plane, the last row and column padded
+  MSConvParam param = {3, 3, 2, 2, 2, 2, 2, 2, 1, 1, 0, 0};
+  std::vector<float> input = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<float> output(4);
+  MSPoolingFp32(input.data(), output.data(), param, 1, 1, true, false);
+  ASSERT_EQ(output, std::vector<float>({5, 6, 8, 9}));
+  MSPoolingFp32(input.data(), output.data(), param, 1, 1, false, false);
+  ASSERT_EQ(output, std::vector<float>({3, 4.5, 7.5, 9}));
+  // caffe counts the pads in the window
+  MSPoolingFp32(input.data(), output.data(), param, 1, 1, false, true);
+  ASSERT_EQ(output, std::vector<float>({3, 2.25, 3.75, 2.25}));
+}
+
+TEST_F(Fp32KernelTest, ElementWise) {
+  const size_t size = 37;
+  auto a = Random(size);
+  auto b = Random(size + 5);
+  for (auto isa : Isas()) {
+    MSSetCpuIsa(isa);
+    std::vector<float> dst(size);
+    MSBinaryFp32(a.data(), b.data() + 5, dst.data(), size, false, BINARY_ADD);
+    for (size_t i = 0; i < size; ++i) {
+      ASSERT_FLOAT_EQ(dst[i], a[i] + b[i + 5]);
+    }
+    MSBinaryFp32(a.data(), b.data(), dst.data(), size, true, BINARY_MUL);
+    for (size_t i = 0; i < size; ++i) {
+      ASSERT_FLOAT_EQ(dst[i], a[i] * b[0]);
+    }
+    MSBinaryFp32(a.data(), b.data(), dst.data(), size, false, BINARY_MAX);
+    for (size_t i = 0; i < size; ++i) {
+      ASSERT_FLOAT_EQ(dst[i], std::max(a[i], b[i]));
+    }
+    std::vector<float> bias = {1.0f, -0.5f};
+    dst.assign(a.begin(), a.end());
+    MSBiasActFp32(dst.data(), bias.data(), 1, size, ActivationType_RELU6);
+    for (size_t i = 0; i < size; ++i) {
+      ASSERT_FLOAT_EQ(dst[i], std::min(std::max(a[i] + 1.0f, 0.0f), 6.0f));
+    }
+  }
+}
+
+TEST_F(Fp32KernelTest, Softmax) {
+  // softmax along the middle axis of 2 x 3 x 2
+  std::vector<float> input = {1, 2, 3, 4, 5, 6, 0, 0, 0, 0, 0, 0};
+  std::vector<float> output(input.size());
+  MSSoftmaxFp32(input.data(), output.data(), 2, 3, 2);
+  float sum = expf(1) + expf(3) + expf(5);
+  ASSERT_NEAR(output[0], expf(1) / sum, 1e-6);
+  ASSERT_NEAR(output[4], expf(5) / sum, 1e-6);
+  ASSERT_NEAR(output[7], 1.0f / 3, 1e-6);
+}
+}  // namespace predict
+}  // namespace mindspore
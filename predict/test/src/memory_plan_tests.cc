@@ -0,0 +1,87 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "src/memory_plan.h"
+
+namespace mindspore {
+namespace predict {
+class MemoryPlanTest : public ::testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+class PlanTestNode : public Node {
+ public:
+  PlanTestNode(const std::string &opType, const std::vector<Tensor *> &in, const std::vector<Tensor *> &out) {
+    id = opType;
+    type = opType;
+    inputs = in;
+    outputs = out;
+  }
+};
+
+TEST_F(MemoryPlanTest, ReuseAndInPlace) {
+  // in -> conv -> a -> relu -> b -> conv -> c -> conv -> d, add(c, d) -> e -> conv -> out
+  Tensor in(DataType_DT_FLOAT, {100}, Format_NCHW, nullptr);
+  Tensor a(DataType_DT_FLOAT, {100}, Format_NCHW, nullptr);
+  Tensor b(DataType_DT_FLOAT, {100}, Format_NCHW, nullptr);
+  Tensor c(DataType_DT_FLOAT, {50}, Format_NCHW, nullptr);
+  Tensor d(DataType_DT_FLOAT, {50}, Format_NCHW, nullptr);
+  Tensor e(DataType_DT_FLOAT, {50}, Format_NCHW, nullptr);
+  Tensor out(DataType_DT_FLOAT, {10}, Format_NCHW, nullptr);
+  PlanTestNode conv1("Conv2D", {&in}, {&a});
+  PlanTestNode relu("Activation", {&a}, {&b});
+  PlanTestNode conv2("Conv2D", {&b}, {&c});
+  PlanTestNode conv3("Conv2D", {&c}, {&d});
+  PlanTestNode add("Add", {&c, &d}, {&e});
+  PlanTestNode conv4("Conv2D", {&e}, {&out});
+  conv1.AddOutEdge(&relu);
+  relu.AddOutEdge(&conv2);
+  conv2.AddOutEdge(&conv3);
+  conv2.AddOutEdge(&add);
+  conv3.AddOutEdge(&add);
+  add.AddOutEdge(&conv4);
+  std::unordered_map<Node *, std::unordered_set<Node *>> depends = {
+    {&relu, {&conv1}}, {&conv2, {&relu}}, {&conv3, {&conv2}}, {&add, {&conv2, &conv3}}, {&conv4, {&add}}};
+  std::deque<Node *> readyQue = {&conv1};
+
+  {
+    MemoryPlan plan;
+    ASSERT_EQ(plan.Build(readyQue, depends, {&in}, {&out}), RET_OK);
+    ASSERT_EQ(plan.GetNodes().size(), 6);
+    // relu and add write over their first inputs, d takes the memory of a and b which are dead
+    ASSERT_EQ(a.GetData(), b.GetData());
+    ASSERT_EQ(c.GetData(), e.GetData());
+    ASSERT_EQ(d.GetData(), a.GetData());
+    ASSERT_NE(c.GetData(), d.GetData());
+    ASSERT_EQ(plan.GetWorkspaceSize(), 448 + 256);
+    ASSERT_EQ(a.RefCount(), MSConst_WEIGHT_REFCOUNT);
+    ASSERT_EQ(in.GetData(), nullptr);
+    ASSERT_EQ(out.GetData(), nullptr);
+  }
+  ASSERT_EQ(a.GetData(), nullptr);
+  ASSERT_EQ(e.GetData(), nullptr);
+}
+}  // namespace predict
+}  // namespace mindspore
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "src/runtime/runtime_api.h"
+#include "src/runtime/thread_pool.h"
+
+namespace mindspore {
+namespace predict {
+class ThreadPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+
+  // every item is run once, by a slot of the quota
+  static bool RunOnce(size_t size, size_t grain, int quota) {
+    std::vector<std::atomic_int> counts(size);
+    for (auto &count : counts) {
+      count = 0;
+    }
+    std::atomic_bool slotValid{true};
+    bool ret = ThreadPool::GetInstance()->ParallelFor(size, grain, quota, [&](int slot, size_t begin, size_t end) {
+      if (slot < 0 || slot >= quota || begin >= end || end > size) {
+        slotValid = false;
+      }
+      for (size_t i = begin; i < end; ++i) {
+        counts[i]++;
+      }
+      return 0;
+    });
+    for (auto &count : counts) {
+      if (count != 1) {
+        return false;
+      }
+    }
+    return ret && slotValid;
+  }
+};
+
+TEST_F(ThreadPoolTest, ParallelFor) {
+  for (size_t size : {0, 1, 7, 64, 1000, 4097}) {
+    for (size_t grain : {1, 3, 64}) {
+      for (int quota : {1, 2, 4, 16}) {
+        ASSERT_TRUE(RunOnce(size, grain, quota)) << size << " " << grain << " " << quota;
+      }
+    }
+  }
+}
+
+TEST_F(ThreadPoolTest, StealUnevenChunks) {
+  // the chunks of slot 0 are slow, the other threads steal them
+  std::vector<std::atomic_int> counts(64);
+  for (auto &count : counts) {
+    count = 0;
+  }
+  bool ret = ThreadPool::GetInstance()->ParallelFor(64, 1, 4, [&counts](int slot, size_t begin, size_t end) {
+    if (begin < 16) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    counts[begin]++;
+    return 0;
+  });
+  ASSERT_TRUE(ret);
+  for (auto &count : counts) {
+    ASSERT_EQ(count, 1);
+  }
+}
+
+TEST_F(ThreadPoolTest, ConcurrentSessions) {
+  // the sessions share the threads of the pool, each with its own quota
+  std::atomic_int failed{0};
+  std::vector<std::thread> sessions;
+  for (int i = 0; i < 4; ++i) {
+    sessions.emplace_back([&failed, i]() {
+      for (int j = 0; j < 50; ++j) {
+        if (!RunOnce(1000 + j, 1 + i, 2 + i % 3)) {
+          failed++;
+        }
+      }
+    });
+  }
+  for (auto &session : sessions) {
+    session.join();
+  }
+  ASSERT_EQ(failed, 0);
+}
+
+TEST_F(ThreadPoolTest, Error) {
+  bool ret = ThreadPool::GetInstance()->ParallelFor(100, 1, 4, [](int slot, size_t begin, size_t end) {
+    return begin == 50 ? -1 : 0;
+  });
+  ASSERT_FALSE(ret);
+  ret = ThreadPool::GetInstance()->ParallelFor(100, 1, 1, [](int slot, size_t begin, size_t end) { return -1; });
+  ASSERT_FALSE(ret);
+}
+
+namespace {
+int CountTask(int taskId, TVMParallelGroupEnv *penv, void *cdata) {
+  auto counts = static_cast<std::vector<std::atomic_int> *>(cdata);
+  if (penv->num_task != static_cast<int>(counts->size())) {
+    return -1;
+  }
+  (*counts)[taskId]++;
+  return 0;
+}
+}  // namespace
+
+TEST_F(ThreadPoolTest, ParallelLaunch) {
+  std::vector<std::atomic_int> counts(8);
+  for (auto &count : counts) {
+    count = 0;
+  }
+  ConfigThreadPool(0, 4);
+  ASSERT_EQ(LiteBackendParallelLaunch(CountTask, &counts, 8), 0);
+  for (auto &count : counts) {
+    ASSERT_EQ(count, 1);
+  }
+}
+}  // namespace predict
+}  // namespace mindspore
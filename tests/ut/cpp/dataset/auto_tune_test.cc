@@ -0,0 +1,118 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include "dataset/core/client.h"
+#include "dataset/core/global_context.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestAutoTune : public UT::DatasetOpTesting {
+ protected:
+  void TearDown() override {
+    std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+    cfg->set_auto_num_workers(false);
+    cfg->set_cpu_budget(0);
+    UT::DatasetOpTesting::TearDown();
+  }
+};
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - The storage and batch ops have 4 workers each, but only 2 workers may run at the same time.
+//
+// Tree:  batch over storage
+//
+//    BatchOp
+//       |
+//    StorageOp
+//
+TEST_F(MindDataTestAutoTune, TestAutoTuneBudget) {
+  MS_LOG(INFO) << "UT test TestAutoTuneBudget.";
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  cfg->set_auto_num_workers(true);
+  cfg->set_cpu_budget(2);
+
+  Status rc;
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<StorageOp> my_storage_op;
+  rc = StorageOp::Builder()
+      .SetDatasetFilesDir(datasets_root_path_ + "/testDataset1")
+      .SetRowsPerBuffer(1)
+      .SetNumWorkers(4)
+      .Build(&my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<BatchOp> my_batch_op;
+  rc = BatchOp::Builder(2).SetNumWorkers(4).Build(&my_batch_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_batch_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_batch_op->AddChild(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_batch_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  // The budget is split in proportion to the workers of each op
+  AutoTune *auto_tune = my_tree->auto_tune();
+  ASSERT_NE(auto_tune, nullptr);
+  EXPECT_EQ(auto_tune->cpu_budget(), 2);
+  EXPECT_EQ(auto_tune->GetWorkerQuota(my_storage_op->id()), 1);
+  EXPECT_EQ(auto_tune->GetWorkerQuota(my_batch_op->id()), 1);
+
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+  int batch_count = 0;
+  while (!tensor_list.empty()) {
+    batch_count++;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  ASSERT_EQ(batch_count, 5);
+}
+
+// Test info:
+// - Without the auto num workers config, the tree does not create an auto tune.
+TEST_F(MindDataTestAutoTune, TestAutoTuneDisabled) {
+  MS_LOG(INFO) << "UT test TestAutoTuneDisabled.";
+  Status rc;
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<StorageOp> my_storage_op;
+  rc = StorageOp::Builder().SetDatasetFilesDir(datasets_root_path_ + "/testDataset1").Build(&my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_EQ(my_tree->auto_tune(), nullptr);
+}
@@ -0,0 +1,252 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/core/client.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include <memory>
+#include <vector>
+#include <iostream>
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+// Adds one to every byte of its input, in place.
+class InPlaceIncOp : public TensorOp {
+ public:
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    unsigned char *data = input->StartAddr();
+    for (dsize_t i = 0; i < input->SizeInBytes(); i++) {
+      data[i]++;
+    }
+    *output = input;
+    return Status::OK();
+  }
+
+  void Print(std::ostream &out) const override { out << "InPlaceIncOp"; }
+};
+
+class MindDataTestCacheOp : public UT::DatasetOpTesting {
+ protected:
+  // Builds repeat over (optional shuffle) over (optional map of the label) over cache over storage, and returns all
+  // the rows produced.
+  void RunCacheTree(int64_t cache_mem_size, const std::string &spill_dir, bool with_shuffle, uint32_t num_repeats,
+                    std::vector<TensorRow> *rows, std::shared_ptr<TensorOp> label_func = nullptr) {
+    Status rc;
+    auto my_tree = std::make_shared<ExecutionTree>();
+
+    std::string dataset_path = datasets_root_path_ + "/testDataset1";
+    std::shared_ptr<StorageOp> my_storage_op;
+    rc = StorageOp::Builder()
+        .SetDatasetFilesDir(dataset_path)
+        .SetRowsPerBuffer(3)
+        .SetWorkerConnectorSize(16)
+        .SetNumWorkers(2)
+        .Build(&my_storage_op);
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_tree->AssociateNode(my_storage_op);
+    EXPECT_TRUE(rc.IsOk());
+
+    std::shared_ptr<CacheOp> my_cache_op;
+    rc = CacheOp::Builder().SetCacheMemSize(cache_mem_size).SetSpillDir(spill_dir).SetRowsPerBuffer(4).Build(
+      &my_cache_op);
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_tree->AssociateNode(my_cache_op);
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_cache_op->AddChild(my_storage_op);
+    EXPECT_TRUE(rc.IsOk());
+
+    std::shared_ptr<DatasetOp> top_op = my_cache_op;
+    if (label_func != nullptr) {
+      std::shared_ptr<MapOp> my_map_op;
+      rc = MapOp::Builder()
+             .SetInColNames({"label"})
+             .SetOutColNames({})
+             .SetTensorFuncs({label_func})
+             .SetNumWorkers(1)
+             .Build(&my_map_op);
+      EXPECT_TRUE(rc.IsOk());
+      rc = my_tree->AssociateNode(my_map_op);
+      EXPECT_TRUE(rc.IsOk());
+      rc = my_map_op->AddChild(top_op);
+      EXPECT_TRUE(rc.IsOk());
+      top_op = my_map_op;
+    }
+    if (with_shuffle) {
+      std::shared_ptr<ShuffleOp> my_shuffle_op;
+      rc = ShuffleOp::Builder().SetShuffleSize(4).SetShuffleSeed(100).SetRowsPerBuffer(3).Build(&my_shuffle_op);
+      EXPECT_TRUE(rc.IsOk());
+      rc = my_tree->AssociateNode(my_shuffle_op);
+      EXPECT_TRUE(rc.IsOk());
+      rc = my_shuffle_op->AddChild(top_op);
+      EXPECT_TRUE(rc.IsOk());
+      top_op = my_shuffle_op;
+    }
+
+    std::shared_ptr<RepeatOp> my_repeat_op;
+    rc = RepeatOp::Builder(num_repeats).Build(&my_repeat_op);
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_tree->AssociateNode(my_repeat_op);
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_repeat_op->AddChild(top_op);
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_tree->AssignRoot(my_repeat_op);
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_tree->Prepare();
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_tree->Launch();
+    EXPECT_TRUE(rc.IsOk());
+
+    DatasetIterator di(my_tree);
+    TensorRow tensor_list;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+    label_col_ = di.col_name_id_map()["label"];
+    while (!tensor_list.empty()) {
+      rows->push_back(tensor_list);
+      rc = di.FetchNextTensorRow(&tensor_list);
+      EXPECT_TRUE(rc.IsOk());
+    }
+    EXPECT_EQ(my_cache_op->num_cached_rows(), 10);
+  }
+
+  // Every epoch replays the rows of the first epoch in the same order.
+  void CheckSameEpochs(const std::vector<TensorRow> &rows, size_t epoch_size) {
+    for (size_t i = epoch_size; i < rows.size(); i++) {
+      const TensorRow &expected = rows[i % epoch_size];
+      ASSERT_EQ(rows[i].size(), expected.size());
+      for (size_t j = 0; j < expected.size(); j++) {
+        EXPECT_TRUE(*rows[i][j] == *expected[j]);
+      }
+    }
+  }
+
+  int32_t label_col_ = 0;
+};
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - No memory limit, all the rows stay in memory.
+//
+// Tree:  repeat over cache over storage
+//
+//    RepeatOp
+//       |
+//    CacheOp
+//       |
+//    StorageOp
+//
+TEST_F(MindDataTestCacheOp, TestCacheInMemory) {
+  MS_LOG(INFO) << "UT test TestCacheInMemory.";
+  std::vector<TensorRow> rows;
+  RunCacheTree(0, "", false, 3, &rows);
+  ASSERT_EQ(rows.size(), 30);
+  CheckSameEpochs(rows, 10);
+}
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - The memory limit is only 1 byte, so all the rows are spilled to disk.
+//
+// Tree:  repeat over cache over storage
+//
+//    RepeatOp
+//       |
+//    CacheOp
+//       |
+//    StorageOp
+//
+TEST_F(MindDataTestCacheOp, TestCacheSpill) {
+  MS_LOG(INFO) << "UT test TestCacheSpill.";
+  std::vector<TensorRow> rows;
+  RunCacheTree(1, "/tmp/cache_op_test", false, 3, &rows);
+  ASSERT_EQ(rows.size(), 30);
+  CheckSameEpochs(rows, 10);
+}
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - The shuffle above the cache reshuffles the replayed rows in every epoch.
+//
+// Tree:  repeat over shuffle over cache over storage
+//
+//    RepeatOp
+//       |
+//    ShuffleOp
+//       |
+//    CacheOp
+//       |
+//    StorageOp
+//
+TEST_F(MindDataTestCacheOp, TestShuffleCache) {
+  MS_LOG(INFO) << "UT test TestShuffleCache.";
+  std::vector<TensorRow> rows;
+  RunCacheTree(0, "", true, 2, &rows);
+  ASSERT_EQ(rows.size(), 20);
+}
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - The map above the cache modifies the label in place, every epoch still starts from the cached rows.
+//
+// Tree:  repeat over map over cache over storage
+//
+//    RepeatOp
+//       |
+//     MapOp
+//       |
+//    CacheOp
+//       |
+//    StorageOp
+//
+TEST_F(MindDataTestCacheOp, TestInPlaceMapOverCache) {
+  MS_LOG(INFO) << "UT test TestInPlaceMapOverCache.";
+  std::vector<TensorRow> raw_rows;
+  RunCacheTree(0, "", false, 1, &raw_rows);
+  ASSERT_EQ(raw_rows.size(), 10);
+  // keep the raw labels aside, the rows below do not share them
+  std::vector<std::vector<unsigned char>> expected;
+  for (const auto &row : raw_rows) {
+    const std::shared_ptr<Tensor> &label = row[label_col_];
+    std::vector<unsigned char> data(label->StartAddr(), label->StartAddr() + label->SizeInBytes());
+    for (auto &byte : data) {
+      byte++;
+    }
+    expected.push_back(std::move(data));
+  }
+
+  std::vector<TensorRow> rows;
+  RunCacheTree(0, "", false, 3, &rows, std::make_shared<InPlaceIncOp>());
+  ASSERT_EQ(rows.size(), 30);
+  for (size_t i = 0; i < rows.size(); i++) {
+    const std::shared_ptr<Tensor> &label = rows[i][label_col_];
+    std::vector<unsigned char> data(label->StartAddr(), label->StartAddr() + label->SizeInBytes());
+    EXPECT_EQ(data, expected[i % 10]);
+  }
+}
+
+// Test info:
+// - A limited memory size without a spill directory is rejected by the builder.
+TEST_F(MindDataTestCacheOp, TestCacheBuilderCheck) {
+  MS_LOG(INFO) << "UT test TestCacheBuilderCheck.";
+  std::shared_ptr<CacheOp> my_cache_op;
+  Status rc = CacheOp::Builder().SetCacheMemSize(1024).Build(&my_cache_op);
+  EXPECT_FALSE(rc.IsOk());
+  rc = CacheOp::Builder().SetCacheMemSize(-1).SetSpillDir("/tmp").Build(&my_cache_op);
+  EXPECT_FALSE(rc.IsOk());
+}
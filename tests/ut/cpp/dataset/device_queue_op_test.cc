@@ -0,0 +1,130 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include "dataset/core/client.h"
+#include "dataset/core/global_context.h"
+#include "dataset/engine/host_queue.h"
+#include "dataset/util/arena.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestDeviceQueueOp : public UT::DatasetOpTesting {
+ protected:
+  void TearDown() override {
+    GlobalContext::config_manager()->set_pinned_pool_size(0);
+    UT::DatasetOpTesting::TearDown();
+  }
+};
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - The batches are allocated from the pinned pool and handed to the host queue without a copy.
+//
+// Tree:  device queue over batch over storage
+//
+//    DeviceQueueOp
+//       |
+//    BatchOp
+//       |
+//    StorageOp
+//
+TEST_F(MindDataTestDeviceQueueOp, TestPinnedZeroCopy) {
+  MS_LOG(INFO) << "UT test TestPinnedZeroCopy.";
+  GlobalContext::config_manager()->set_pinned_pool_size(16);
+  auto arena = std::dynamic_pointer_cast<Arena>(GlobalContext::Instance()->pinned_pool());
+  ASSERT_NE(arena, nullptr);
+
+  std::string channel_name = "zero_copy_test";
+  std::shared_ptr<HostQueue> host_queue;
+  Status rc = HostQueue::Open(channel_name, 2, &host_queue);
+  ASSERT_TRUE(rc.IsOk());
+  // A channel has a single queue
+  std::shared_ptr<HostQueue> other_queue;
+  EXPECT_FALSE(HostQueue::Open(channel_name, 2, &other_queue).IsOk());
+
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<StorageOp> my_storage_op;
+  rc = StorageOp::Builder()
+         .SetDatasetFilesDir(datasets_root_path_ + "/testDataset1")
+         .SetRowsPerBuffer(2)
+         .SetNumWorkers(2)
+         .Build(&my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<BatchOp> my_batch_op;
+  rc = BatchOp::Builder(2).SetNumWorkers(2).Build(&my_batch_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<DeviceQueueOp> my_device_queue_op;
+  rc = DeviceQueueOp::Builder(2).SetDeviceType("CPU").SetChannelName(channel_name).Build(&my_device_queue_op);
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(my_tree->AssociateNode(my_storage_op).IsOk());
+  EXPECT_TRUE(my_tree->AssociateNode(my_batch_op).IsOk());
+  EXPECT_TRUE(my_tree->AssociateNode(my_device_queue_op).IsOk());
+  EXPECT_TRUE(my_batch_op->AddChild(my_storage_op).IsOk());
+  EXPECT_TRUE(my_device_queue_op->AddChild(my_batch_op).IsOk());
+  EXPECT_TRUE(my_tree->AssignRoot(my_device_queue_op).IsOk());
+  EXPECT_TRUE(my_tree->Prepare().IsOk());
+  EXPECT_TRUE(my_tree->Launch().IsOk());
+
+  // Each item holds the 2 columns of a batch, at the address of the batch in the pinned pool
+  for (int i = 0; i < 5; i++) {
+    HostQueue::Item item;
+    rc = host_queue->Front(&item);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(item.addrs.size(), 2);
+    EXPECT_TRUE(arena->Contains(item.addrs[0]));
+    EXPECT_TRUE(arena->Contains(item.addrs[1]));
+    EXPECT_GT(item.sizes[0], 0);
+    host_queue->Pop();
+  }
+
+  // The batches are released once popped
+  my_tree.reset();
+  EXPECT_EQ(my_device_queue_op->held_tensors()->size(), 0);
+  HostQueue::Close(channel_name);
+  EXPECT_EQ(HostQueue::Find(channel_name), nullptr);
+  EXPECT_TRUE(host_queue->IsClosed());
+}
+
+TEST_F(MindDataTestDeviceQueueOp, TestPinnedPoolTooSmall) {
+  MS_LOG(INFO) << "UT test TestPinnedPoolTooSmall.";
+  std::shared_ptr<Arena> arena;
+  Status rc = Arena::CreateArena(&arena, 1, true);
+  ASSERT_TRUE(rc.IsOk());
+  std::shared_ptr<MemoryPool> pool = arena;
+
+  // A tensor which fits is allocated in the pool
+  std::shared_ptr<Tensor> small;
+  rc = Tensor::CreateTensor(&small, TensorShape({256, 256}), DataType(DataType::DE_UINT8), pool);
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(arena->Contains(small->StartAddr()));
+
+  // A tensor larger than the pool fails, the caller falls back to the regular memory
+  std::shared_ptr<Tensor> large;
+  rc = Tensor::CreateTensor(&large, TensorShape({1024, 1024, 2}), DataType(DataType::DE_UINT8), pool);
+  EXPECT_FALSE(rc.IsOk());
+
+  // The memory goes back to the pool with the tensor
+  int percent_free = arena->PercentFree();
+  small.reset();
+  EXPECT_GT(arena->PercentFree(), percent_free);
+}
@@ -0,0 +1,158 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "dataset/core/tensor.h"
+#include "dataset/engine/datasetops/map_op.h"
+#include "dataset/kernels/data/data_utils.h"
+#include "dataset/kernels/data/type_cast_op.h"
+#include "dataset/kernels/image/fused_normalize_op.h"
+#include "dataset/kernels/image/hwc_to_chw_op.h"
+#include "dataset/kernels/image/image_utils.h"
+#include "dataset/kernels/image/normalize_op.h"
+#include "dataset/kernels/image/resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+namespace {
+// Numbers are from the resnet50 model implementation
+const float kMean[3] = {121.0, 115.0, 100.0};
+const float kStd[3] = {70.0, 68.0, 71.0};
+
+// Runs the chain of ops the fused op replaces
+std::shared_ptr<Tensor> RunChain(const std::shared_ptr<Tensor> &input, bool hwc_to_chw, const DataType &type) {
+  std::shared_ptr<Tensor> output;
+  NormalizeOp normalize(kMean[0], kMean[1], kMean[2], kStd[0], kStd[1], kStd[2]);
+  EXPECT_TRUE(normalize.Compute(input, &output).IsOk());
+  if (hwc_to_chw) {
+    EXPECT_TRUE(HwcToChw(output, &output).IsOk());
+  }
+  if (type != DataType::DE_FLOAT32) {
+    std::shared_ptr<Tensor> cast_output;
+    EXPECT_TRUE(TypeCast(output, &cast_output, type).IsOk());
+    return cast_output;
+  }
+  return output;
+}
+
+// @return The largest absolute difference between two tensors of the same shape
+template <typename T>
+float MaxDiff(const std::shared_ptr<Tensor> &a, const std::shared_ptr<Tensor> &b) {
+  float max_diff = 0.0;
+  auto itr_b = b->begin<T>();
+  for (auto itr_a = a->begin<T>(); itr_a != a->end<T>(); ++itr_a, ++itr_b) {
+    max_diff = std::max(max_diff, std::fabs(static_cast<float>(*itr_a) - static_cast<float>(*itr_b)));
+  }
+  return max_diff;
+}
+}  // namespace
+
+class MindDataTestFusedNormalizeOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestFusedNormalizeOp() : CVOpCommon() {}
+};
+
+TEST_F(MindDataTestFusedNormalizeOp, TestOp) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedNormalizeOp::TestOp.";
+  for (bool hwc_to_chw : {true, false}) {
+    std::shared_ptr<Tensor> output_tensor;
+    FusedNormalizeOp op(kMean[0], kMean[1], kMean[2], kStd[0], kStd[1], kStd[2], hwc_to_chw,
+                        DataType(DataType::DE_FLOAT32));
+    EXPECT_TRUE(op.OneToOne());
+    Status s = op.Compute(input_tensor_, &output_tensor);
+    EXPECT_TRUE(s.IsOk());
+    std::shared_ptr<Tensor> expected = RunChain(input_tensor_, hwc_to_chw, DataType(DataType::DE_FLOAT32));
+    EXPECT_EQ(output_tensor->shape(), expected->shape());
+    EXPECT_EQ(output_tensor->type(), DataType(DataType::DE_FLOAT32));
+    EXPECT_LT(MaxDiff<float>(output_tensor, expected), 1e-4);
+  }
+}
+
+TEST_F(MindDataTestFusedNormalizeOp, TestFloat16) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedNormalizeOp::TestFloat16.";
+  std::shared_ptr<Tensor> output_tensor;
+  FusedNormalizeOp op(kMean[0], kMean[1], kMean[2], kStd[0], kStd[1], kStd[2], true, DataType(DataType::DE_FLOAT16));
+  Status s = op.Compute(input_tensor_, &output_tensor);
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<Tensor> expected = RunChain(input_tensor_, true, DataType(DataType::DE_FLOAT16));
+  EXPECT_EQ(output_tensor->shape(), expected->shape());
+  EXPECT_EQ(output_tensor->type(), DataType(DataType::DE_FLOAT16));
+  // One unit in the last place of a float16 around the largest values
+  EXPECT_LT(MaxDiff<float16>(output_tensor, expected), 4e-3);
+}
+
+TEST_F(MindDataTestFusedNormalizeOp, TestFallback) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedNormalizeOp::TestFallback.";
+  // A float image does not take the fused kernel but still gets the same result as the chain
+  std::shared_ptr<Tensor> float_image;
+  EXPECT_TRUE(TypeCast(input_tensor_, &float_image, DataType(DataType::DE_FLOAT32)).IsOk());
+  std::shared_ptr<Tensor> output_tensor;
+  FusedNormalizeOp op(kMean[0], kMean[1], kMean[2], kStd[0], kStd[1], kStd[2], true, DataType(DataType::DE_FLOAT32));
+  Status s = op.Compute(float_image, &output_tensor);
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<Tensor> expected = RunChain(float_image, true, DataType(DataType::DE_FLOAT32));
+  EXPECT_EQ(output_tensor->shape(), expected->shape());
+  EXPECT_LT(MaxDiff<float>(output_tensor, expected), 1e-4);
+
+  // The kernel itself rejects what it cannot handle
+  s = FusedNormalize(float_image, &output_tensor, kMean, kStd, true, DataType(DataType::DE_FLOAT32));
+  EXPECT_FALSE(s.IsOk());
+}
+
+TEST_F(MindDataTestFusedNormalizeOp, TestMapOpFusion) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedNormalizeOp::TestMapOpFusion.";
+  auto resize = std::make_shared<ResizeOp>(224, 224);
+  auto normalize = std::make_shared<NormalizeOp>(kMean[0], kMean[1], kMean[2], kStd[0], kStd[1], kStd[2]);
+  auto hwc_to_chw = std::make_shared<HwcToChwOp>();
+  auto cast = std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT16));
+
+  // Resize, Normalize, HwcToChw, TypeCast becomes Resize, FusedNormalize
+  std::vector<std::shared_ptr<TensorOp>> fused = MapOp::FuseTensorOps({resize, normalize, hwc_to_chw, cast});
+  ASSERT_EQ(fused.size(), 2);
+  EXPECT_EQ(fused[0], resize);
+  auto fused_normalize = std::dynamic_pointer_cast<FusedNormalizeOp>(fused[1]);
+  ASSERT_NE(fused_normalize, nullptr);
+  std::vector<DataType> types;
+  EXPECT_TRUE(fused_normalize->OutputType({DataType(DataType::DE_UINT8)}, types).IsOk());
+  EXPECT_EQ(types[0], DataType(DataType::DE_FLOAT16));
+  std::vector<TensorShape> shapes;
+  EXPECT_TRUE(fused_normalize->OutputShape({TensorShape({224, 224, 3})}, shapes).IsOk());
+  EXPECT_EQ(shapes[0], TensorShape({3, 224, 224}));
+
+  // A cast to an integer type is not fused
+  auto int_cast = std::make_shared<TypeCastOp>(DataType(DataType::DE_INT32));
+  fused = MapOp::FuseTensorOps({normalize, int_cast});
+  ASSERT_EQ(fused.size(), 2);
+  EXPECT_EQ(fused[0], normalize);
+
+  // A lone NormalizeOp stays as it is
+  fused = MapOp::FuseTensorOps({normalize});
+  ASSERT_EQ(fused.size(), 1);
+  EXPECT_EQ(fused[0], normalize);
+
+  // A second HwcToChw after the fused one is kept
+  fused = MapOp::FuseTensorOps({normalize, hwc_to_chw, hwc_to_chw});
+  ASSERT_EQ(fused.size(), 2);
+  EXPECT_EQ(fused[1], hwc_to_chw);
+}
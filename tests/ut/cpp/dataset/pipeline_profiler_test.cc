@@ -0,0 +1,152 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <unistd.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include "dataset/core/client.h"
+#include "dataset/core/global_context.h"
+#include "dataset/engine/pipeline_profiler.h"
+#include "dataset/util/path.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestPipelineProfiler : public UT::DatasetOpTesting {
+ protected:
+  void TearDown() override {
+    std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+    cfg->set_profiling_dir("");
+    cfg->set_monitor_sampling_interval(kCfgMonitorSamplingInterval);
+    UT::DatasetOpTesting::TearDown();
+  }
+};
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - The profiler counts the rows of each op and writes its files into a new directory when the tree
+//   is stopped.
+//
+// Tree:  batch over storage
+//
+//    BatchOp
+//       |
+//    StorageOp
+//
+TEST_F(MindDataTestPipelineProfiler, TestProfileBatch) {
+  MS_LOG(INFO) << "UT test TestProfileBatch.";
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  std::string profiling_dir = "/tmp/pipeline_profiler_test_" + std::to_string(getpid());
+  cfg->set_profiling_dir(profiling_dir);
+  cfg->set_monitor_sampling_interval(1);
+
+  Status rc;
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<StorageOp> my_storage_op;
+  rc = StorageOp::Builder()
+      .SetDatasetFilesDir(datasets_root_path_ + "/testDataset1")
+      .SetRowsPerBuffer(1)
+      .SetNumWorkers(2)
+      .Build(&my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<BatchOp> my_batch_op;
+  rc = BatchOp::Builder(2).SetNumWorkers(2).Build(&my_batch_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_batch_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_batch_op->AddChild(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_batch_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(Path(profiling_dir).IsDirectory());
+
+  PipelineProfiler *profiler = my_tree->profiler();
+  ASSERT_NE(profiler, nullptr);
+  std::string summary_file = profiler->summary_file();
+  std::string trace_file = profiler->trace_file();
+
+  {
+    DatasetIterator di(my_tree);
+    TensorRow tensor_list;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+    int batch_count = 0;
+    while (!tensor_list.empty()) {
+      batch_count++;
+      rc = di.FetchNextTensorRow(&tensor_list);
+      EXPECT_TRUE(rc.IsOk());
+    }
+    ASSERT_EQ(batch_count, 5);
+  }
+
+  // The ops are listed in post order, each batched row holds the 2 rows of a batch
+  nlohmann::json summary = profiler->Summary();
+  ASSERT_EQ(summary["ops"].size(), 2);
+  EXPECT_EQ(summary["ops"][0]["op_id"], my_storage_op->id());
+  EXPECT_EQ(summary["ops"][0]["rows"], 10);
+  EXPECT_EQ(summary["ops"][1]["op_id"], my_batch_op->id());
+  EXPECT_EQ(summary["ops"][1]["rows"], 5);
+  EXPECT_EQ(summary["ops"][1]["worker_busy_ms"].size(), 2);
+  EXPECT_EQ(summary["ops"][0]["push_blocked_ms"].size(), 2);
+
+  // The files are written when the tree is stopped, and only then
+  Path summary_path(summary_file);
+  Path trace_path(trace_file);
+  EXPECT_FALSE(summary_path.Exists());
+  rc = my_tree->Stop();
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(summary_path.Exists());
+  EXPECT_TRUE(trace_path.Exists());
+  (void)std::remove(summary_file.c_str());
+  (void)std::remove(trace_file.c_str());
+  rc = my_tree->Stop();
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_FALSE(summary_path.Exists());
+  my_tree.reset();
+  EXPECT_FALSE(summary_path.Exists());
+  (void)rmdir(profiling_dir.c_str());
+}
+
+// Test info:
+// - Without a profiling dir, the tree is not profiled.
+TEST_F(MindDataTestPipelineProfiler, TestProfileDisabled) {
+  MS_LOG(INFO) << "UT test TestProfileDisabled.";
+  Status rc;
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<StorageOp> my_storage_op;
+  rc = StorageOp::Builder().SetDatasetFilesDir(datasets_root_path_ + "/testDataset1").Build(&my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_EQ(my_tree->profiler(), nullptr);
+}
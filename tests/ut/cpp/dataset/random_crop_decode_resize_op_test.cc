@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
 #include <fstream>
 #include "common/common.h"
 #include "common/cvop_common.h"
@@ -27,6 +28,8 @@ using mindspore::LogStream;
 using mindspore::ExceptionType::NoExceptionType;
 using mindspore::MsLogLevel::INFO;
 constexpr double kMseThreshold = 2.0;
+// The scaled IDCT averages the dropped pixels in the frequency domain, it is close to but not exactly an area resize
+constexpr double kScaledMeanDiffThreshold = 4.0;
 
 class MindDataTestRandomCropDecodeResizeOp : public UT::CVOP::CVOpCommon {
  public:
@@ -48,8 +51,9 @@ TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp2) {
   const InterpolationMode interpolation = InterpolationMode::kLinear;
   constexpr uint32_t max_iter = 10;
 
+  // Without the scaled IDCT, the fused op decodes exactly the pixels of the crop
   auto crop_and_decode = RandomCropDecodeResizeOp(target_height, target_width, scale_lb, scale_ub, aspect_lb, aspect_ub,
-                                                  interpolation, max_iter);
+                                                  interpolation, max_iter, false);
   auto crop_and_decode_copy = crop_and_decode;
   auto decode_and_crop = static_cast<RandomCropAndResizeOp>(crop_and_decode_copy);
   EXPECT_TRUE(crop_and_decode.OneToOne());
@@ -153,3 +157,78 @@ TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp1) {
   }
   MS_LOG(INFO) << "RandomCropDecodeResizeOp test 2 finished";
 }
+
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestJpegScaleDenom) {
+  MS_LOG(INFO) << "starting RandomCropDecodeResizeOp test 3";
+  EXPECT_EQ(JpegScaleDenom(2268, 4032, 224, 224), 8);
+  EXPECT_EQ(JpegScaleDenom(1000, 1000, 224, 224), 4);
+  EXPECT_EQ(JpegScaleDenom(500, 1000, 224, 224), 2);
+  EXPECT_EQ(JpegScaleDenom(300, 300, 224, 224), 1);
+  EXPECT_EQ(JpegScaleDenom(100, 100, 224, 224), 1);
+
+  // The whole image decoded at half size is close to an area resize of the full decode
+  std::shared_ptr<Tensor> decoded, resized, scaled;
+  DecodeOp op(true);
+  ASSERT_TRUE(op.Compute(raw_input_tensor_, &decoded).IsOk());
+  int h = decoded->shape()[0];
+  int w = decoded->shape()[1];
+  ASSERT_TRUE(JpegCropAndDecode(raw_input_tensor_, &scaled, 0, 0, 0, 0, 2).IsOk());
+  ASSERT_EQ(scaled->shape()[0], (h + 1) / 2);
+  ASSERT_EQ(scaled->shape()[1], (w + 1) / 2);
+  ASSERT_TRUE(Resize(decoded, &resized, (h + 1) / 2, (w + 1) / 2, 0.0, 0.0, InterpolationMode::kArea).IsOk());
+  cv::Mat m1 = CVTensor::AsCVTensor(scaled)->mat();
+  cv::Mat m2 = CVTensor::AsCVTensor(resized)->mat();
+  double mean_diff = cv::norm(m1, m2, cv::NORM_L1) / (m1.total() * m1.channels());
+  MS_LOG(INFO) << "mean diff: " << mean_diff;
+  EXPECT_LT(mean_diff, kScaledMeanDiffThreshold);
+
+  // A crop window is mapped onto the scaled image
+  ASSERT_TRUE(JpegCropAndDecode(raw_input_tensor_, &scaled, 100, 200, 1000, 800, 4).IsOk());
+  EXPECT_EQ(scaled->shape()[0], 200);
+  EXPECT_EQ(scaled->shape()[1], 250);
+  EXPECT_FALSE(JpegCropAndDecode(raw_input_tensor_, &scaled, 100, 200, 1000, 800, 3).IsOk());
+  MS_LOG(INFO) << "RandomCropDecodeResizeOp test 3 finished";
+}
+
+// Micro-benchmark of the ImageNet style 224x224 training crop of a 4032x2268 jpeg, comparing the
+// Decode + RandomCropAndResize chain with the fused op, with and without the scaled IDCT.
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestBenchmark) {
+  MS_LOG(INFO) << "starting RandomCropDecodeResizeOp benchmark";
+  constexpr int target_size = 224;
+  constexpr int num_images = 20;
+  GlobalContext::config_manager()->set_seed(42);
+  DecodeOp decode_op(true);
+  RandomCropAndResizeOp crop_resize_op(target_size, target_size);
+  RandomCropDecodeResizeOp fused_op(target_size, target_size, RandomCropAndResizeOp::kDefScaleLb,
+                                    RandomCropAndResizeOp::kDefScaleUb, RandomCropAndResizeOp::kDefAspectLb,
+                                    RandomCropAndResizeOp::kDefAspectUb, RandomCropAndResizeOp::kDefInterpolation,
+                                    RandomCropAndResizeOp::kDefMaxIter, false);
+  RandomCropDecodeResizeOp scaled_op(target_size, target_size);
+
+  auto images_per_sec = [](std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return num_images / elapsed.count();
+  };
+  std::shared_ptr<Tensor> decoded, output;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_images; i++) {
+    ASSERT_TRUE(decode_op.Compute(raw_input_tensor_, &decoded).IsOk());
+    ASSERT_TRUE(crop_resize_op.Compute(decoded, &output).IsOk());
+  }
+  double chain_rate = images_per_sec(start);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_images; i++) {
+    ASSERT_TRUE(fused_op.Compute(raw_input_tensor_, &output).IsOk());
+  }
+  double fused_rate = images_per_sec(start);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_images; i++) {
+    ASSERT_TRUE(scaled_op.Compute(raw_input_tensor_, &output).IsOk());
+    ASSERT_EQ(output->shape()[0], target_size);
+    ASSERT_EQ(output->shape()[1], target_size);
+  }
+  double scaled_rate = images_per_sec(start);
+  MS_LOG(INFO) << "Images/sec: Decode + RandomCropAndResize " << chain_rate << ", RandomCropDecodeResize "
+               << fused_rate << ", RandomCropDecodeResize with scaled IDCT " << scaled_rate;
+  MS_LOG(INFO) << "RandomCropDecodeResizeOp benchmark finished";
+}
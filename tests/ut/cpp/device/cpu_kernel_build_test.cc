@@ -0,0 +1,113 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "device/cpu/cpu_kernel_build.h"
+#include "device/cpu/cpu_kernel_factory.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+std::atomic<int> g_init_count(0);
+
+class TestBuildCPUKernel : public CPUKernel {
+ public:
+  void InitKernel(const CNodePtr &) override { g_init_count++; }
+  bool Launch(const std::vector<AddressPtr> &, const std::vector<AddressPtr> &,
+              const std::vector<AddressPtr> &) override {
+    return true;
+  }
+};
+
+class TestBuildFailCPUKernel : public TestBuildCPUKernel {
+ public:
+  void InitKernel(const CNodePtr &) override { MS_LOG(EXCEPTION) << "TestBuildFail can not be built"; }
+};
+
+MS_REG_CPU_KERNEL(TestBuild, TestBuildCPUKernel);
+MS_REG_CPU_KERNEL(TestBuildFail, TestBuildFailCPUKernel);
+}  // namespace
+
+class TestCPUKernelBuild : public UT::Common {
+ public:
+  TestCPUKernelBuild() = default;
+  void SetUp() override {
+    graph_ = std::make_shared<session::KernelGraph>();
+    g_init_count = 0;
+  }
+
+  AnfNodePtr NewParameter(const std::vector<int> &shape) {
+    auto parameter = graph_->add_parameter();
+    parameter->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    return parameter;
+  }
+
+  // a float32 node of one input and one output of the given shape
+  CNodePtr NewKernel(const std::string &op_name, const AnfNodePtr &input, const std::vector<int> &shape) {
+    auto kernel = graph_->NewCNode({NewValueNode(std::make_shared<Primitive>(op_name)), input});
+    kernel->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+    builder.SetInputsFormat({kOpFormat_DEFAULT});
+    builder.SetInputsDeviceType({kNumberTypeFloat32});
+    builder.SetOutputsFormat({kOpFormat_DEFAULT});
+    builder.SetOutputsDeviceType({kNumberTypeFloat32});
+    AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), kernel.get());
+    execution_order_.push_back(kernel);
+    return kernel;
+  }
+
+  void Build(size_t thread_num) {
+    graph_->set_execution_order(execution_order_);
+    KernelBuild(graph_.get(), thread_num);
+  }
+
+ protected:
+  std::shared_ptr<session::KernelGraph> graph_;
+  std::vector<CNodePtr> execution_order_;
+};
+
+// the nodes of the same op, shapes and types share one kernel, which is initialized once
+TEST_F(TestCPUKernelBuild, IdenticalNodesShareKernel) {
+  auto x = NewParameter({2, 3});
+  auto y = NewParameter({4, 3});
+  auto a = NewKernel("TestBuild", x, {2, 3});
+  auto b = NewKernel("TestBuild", a, {2, 3});
+  auto c = NewKernel("TestBuild", y, {4, 3});
+  Build(2);
+  ASSERT_EQ(g_init_count, 2);
+  ASSERT_NE(AnfAlgo::GetKernelMod(a), nullptr);
+  ASSERT_EQ(AnfAlgo::GetKernelMod(a), AnfAlgo::GetKernelMod(b));
+  ASSERT_NE(AnfAlgo::GetKernelMod(a), AnfAlgo::GetKernelMod(c));
+}
+
+// a kernel failing to build on one of the worker threads fails the build of the graph
+TEST_F(TestCPUKernelBuild, FailureOnWorkerThread) {
+  auto x = NewParameter({2, 3});
+  auto a = NewKernel("TestBuild", x, {2, 3});
+  (void)NewKernel("TestBuildFail", a, {2, 3});
+  (void)NewKernel("TestBuild", a, {4, 3});
+  (void)NewKernel("TestBuild", a, {8, 3});
+  EXPECT_THROW(Build(4), std::runtime_error);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
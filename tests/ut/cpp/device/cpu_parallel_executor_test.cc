@@ -0,0 +1,161 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "common/common_test.h"
+#include "device/cpu/cpu_parallel_executor.h"
+#include "pipeline/parse/python_adapter.h"
+#include "session/anf_runtime_algorithm.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+class DummyKernelMod : public kernel::KernelMod {
+ public:
+  const std::vector<size_t> &GetInputSizeList() const override { return size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return size_list_; }
+  bool Launch(const std::vector<kernel::AddressPtr> &, const std::vector<kernel::AddressPtr> &,
+              const std::vector<kernel::AddressPtr> &, uintptr_t) override {
+    return true;
+  }
+
+ private:
+  std::vector<size_t> size_list_;
+};
+}  // namespace
+
+class TestCPUParallelExecutor : public UT::Common {
+ public:
+  TestCPUParallelExecutor() = default;
+  void SetUp() override { graph_ = std::make_shared<session::KernelGraph>(); }
+
+  // a kernel of its own kernel mod unless one is given, it sleeps for the given time when it is launched
+  CNodePtr NewKernel(const std::string &name, const PrimitivePtr &prim, const std::vector<AnfNodePtr> &inputs,
+                     int sleep_ms, kernel::KernelModPtr kernel_mod = nullptr) {
+    std::vector<AnfNodePtr> node_inputs{NewValueNode(prim)};
+    (void)node_inputs.insert(node_inputs.end(), inputs.begin(), inputs.end());
+    auto kernel = graph_->NewCNode(node_inputs);
+    AnfAlgo::SetKernelMod(kernel_mod != nullptr ? kernel_mod : std::make_shared<DummyKernelMod>(), kernel.get());
+    names_[kernel.get()] = name;
+    sleep_ms_[kernel.get()] = sleep_ms;
+    execution_order_.push_back(kernel);
+    return kernel;
+  }
+
+  // the start and the end of the launch of each kernel, such as "a+" and "a-", in the order they happen
+  std::vector<std::string> Run(size_t thread_num) {
+    graph_->set_execution_order(execution_order_);
+    events_.clear();
+    CPUParallelExecutor executor(thread_num);
+    executor.Run(graph_.get(), [this](const CNodePtr &kernel) {
+      AddEvent(names_.at(kernel.get()) + "+");
+      std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms_.at(kernel.get())));
+      AddEvent(names_.at(kernel.get()) + "-");
+    });
+    return events_;
+  }
+
+  static size_t IndexOf(const std::vector<std::string> &events, const std::string &event) {
+    return std::find(events.begin(), events.end(), event) - events.begin();
+  }
+
+  static PrimitivePtr NewAssign() {
+    auto prim = std::make_shared<Primitive>("Assign");
+    prim->set_signatures(
+      {std::make_tuple(std::string("variable"), SignatureEnumRW::kRWWrite, SignatureEnumKind::kKindPositionalKeyword,
+                       py::none(), SignatureEnumDType::kDTypeEmptyDefaultValue),
+       std::make_tuple(std::string("value"), SignatureEnumRW::kRWRead, SignatureEnumKind::kKindPositionalKeyword,
+                       py::none(), SignatureEnumDType::kDTypeEmptyDefaultValue)});
+    return prim;
+  }
+
+ protected:
+  void AddEvent(const std::string &event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(event);
+  }
+
+  std::shared_ptr<session::KernelGraph> graph_;
+  std::vector<CNodePtr> execution_order_;
+  std::unordered_map<AnfNode *, std::string> names_;
+  std::unordered_map<AnfNode *, int> sleep_ms_;
+  std::mutex mutex_;
+  std::vector<std::string> events_;
+};
+
+// b uses the output of a through a tuple_getitem, c is independent and runs beside a
+TEST_F(TestCPUParallelExecutor, DataDependency) {
+  auto relu = std::make_shared<Primitive>("ReLU");
+  auto x = graph_->add_parameter();
+  auto a = NewKernel("a", relu, {x}, 50);
+  auto getitem = graph_->NewCNode({NewValueNode(prim::kPrimTupleGetItem), a, NewValueNode(MakeValue(0))});
+  (void)NewKernel("b", relu, {getitem}, 0);
+  (void)NewKernel("c", relu, {x}, 0);
+
+  auto events = Run(2);
+  ASSERT_EQ(events.size(), 6);
+  ASSERT_GT(IndexOf(events, "b+"), IndexOf(events, "a-"));
+  ASSERT_LT(IndexOf(events, "c-"), IndexOf(events, "a-"));
+}
+
+// the assigns write the parameter in place, they run after the reader before them, one after the other, and before
+// the reader after them, even though the earlier ones take longer
+TEST_F(TestCPUParallelExecutor, TwoWritersOfOneParameter) {
+  std::shared_ptr<py::scoped_interpreter> env = parse::python_adapter::set_python_scoped();
+  auto relu = std::make_shared<Primitive>("ReLU");
+  auto assign = NewAssign();
+  auto param = graph_->add_parameter();
+  auto x = graph_->add_parameter();
+  auto y = graph_->add_parameter();
+  (void)NewKernel("r1", relu, {param}, 40);
+  (void)NewKernel("w1", assign, {param, x}, 20);
+  (void)NewKernel("w2", assign, {param, y}, 10);
+  (void)NewKernel("r2", relu, {param}, 0);
+  // the values of the assigns are only read, the readers of them do not wait for the assigns
+  (void)NewKernel("r3", relu, {x}, 0);
+
+  auto events = Run(4);
+  ASSERT_EQ(events.size(), 10);
+  events.erase(events.begin() + IndexOf(events, "r3+"));
+  events.erase(events.begin() + IndexOf(events, "r3-"));
+  ASSERT_EQ(events, std::vector<std::string>({"r1+", "r1-", "w1+", "w1-", "w2+", "w2-", "r2+", "r2-"}));
+}
+
+// the nodes built into one kernel share the arguments kept in it, they run one after the other even though they are
+// independent
+TEST_F(TestCPUParallelExecutor, SharedKernelMod) {
+  auto relu = std::make_shared<Primitive>("ReLU");
+  auto kernel_mod = std::make_shared<DummyKernelMod>();
+  auto x = graph_->add_parameter();
+  auto y = graph_->add_parameter();
+  (void)NewKernel("a", relu, {x}, 30, kernel_mod);
+  (void)NewKernel("b", relu, {y}, 0, kernel_mod);
+
+  auto events = Run(2);
+  ASSERT_EQ(events, std::vector<std::string>({"a+", "a-", "b+", "b-"}));
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
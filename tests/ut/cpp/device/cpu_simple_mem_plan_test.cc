@@ -0,0 +1,141 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <set>
+#include <vector>
+#include "common/common_test.h"
+#include "device/cpu/cpu_device_address.h"
+#include "device/cpu/cpu_simple_mem_plan.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/context/ms_context.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+const size_t kTensorSize = 2048;
+
+class DummyKernelMod : public kernel::KernelMod {
+ public:
+  DummyKernelMod() : output_size_list_({kTensorSize}) {}
+  const std::vector<size_t> &GetInputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+  bool Launch(const std::vector<kernel::AddressPtr> &, const std::vector<kernel::AddressPtr> &,
+              const std::vector<kernel::AddressPtr> &, uintptr_t) override {
+    return true;
+  }
+
+ private:
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+}  // namespace
+
+class TestCPUSimpleMemPlan : public UT::Common {
+ public:
+  TestCPUSimpleMemPlan() = default;
+  void SetUp() override {
+    graph_ = std::make_shared<session::KernelGraph>();
+    auto context = MsContext::GetInstance();
+    enable_mem_reuse_ = context->enable_mem_reuse();
+    parallel_num_ = context->cpu_inter_op_parallel_num();
+    context->set_cpu_inter_op_parallel_num(1);
+  }
+  void TearDown() override {
+    auto context = MsContext::GetInstance();
+    context->set_enable_mem_reuse(enable_mem_reuse_);
+    context->set_cpu_inter_op_parallel_num(parallel_num_);
+  }
+
+  // a chain of kernels from one graph input, each kernel has one output of kTensorSize
+  void NewChain(size_t kernel_num) {
+    auto x = std::make_shared<Parameter>(graph_);
+    x->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int>{512}));
+    auto input = graph_->NewParameter(x);
+    // the graph inputs are bound to the input tensors before every run, they are not planned
+    input_.resize(kTensorSize);
+    AnfAlgo::SetOutputAddr(std::make_shared<CPUDeviceAddress>(input_.data(), kTensorSize), 0, input.get());
+    AnfNodePtr prev = input;
+    for (size_t i = 0; i < kernel_num; ++i) {
+      auto kernel = graph_->NewCNode({NewValueNode(std::make_shared<Primitive>("ReLU")), prev});
+      kernel->set_abstract(x->abstract());
+      AnfAlgo::SetKernelMod(std::make_shared<DummyKernelMod>(), kernel.get());
+      AnfAlgo::SetOutputAddr(std::make_shared<CPUDeviceAddress>(nullptr, kTensorSize), 0, kernel.get());
+      execution_order_.push_back(kernel);
+      prev = kernel;
+    }
+    graph_->set_execution_order(execution_order_);
+  }
+
+  // assign the planned memory, and return the address of the output of each kernel
+  std::vector<const void *> Assign(CPUSimpleMemPlan *plan) {
+    memory_.resize(plan->GetGraphMemSize(graph_.get()));
+    plan->MemAssign(graph_.get(), memory_.data());
+    std::vector<const void *> outputs;
+    for (auto &kernel : execution_order_) {
+      auto ptr = static_cast<const uint8_t *>(AnfAlgo::GetOutputAddr(kernel, 0)->GetPtr());
+      EXPECT_TRUE(ptr >= memory_.data() && ptr + kTensorSize <= memory_.data() + memory_.size());
+      outputs.push_back(ptr);
+    }
+    return outputs;
+  }
+
+ protected:
+  std::shared_ptr<session::KernelGraph> graph_;
+  std::vector<CNodePtr> execution_order_;
+  std::vector<uint8_t> input_;
+  std::vector<uint8_t> memory_;
+  bool enable_mem_reuse_{true};
+  uint32_t parallel_num_{1};
+};
+
+// the output of a kernel is released once the next kernel has read it, so the chain only needs two blocks at a time
+TEST_F(TestCPUSimpleMemPlan, ReuseShrinksChain) {
+  MsContext::GetInstance()->set_enable_mem_reuse(true);
+  const size_t kernel_num = 5;
+  NewChain(kernel_num);
+  CPUSimpleMemPlan plan;
+  plan.MemPlan(graph_.get());
+  ASSERT_TRUE(plan.IsGraphMemReused(graph_.get()));
+  ASSERT_LT(plan.GetGraphMemSize(graph_.get()), kernel_num * kTensorSize);
+
+  auto outputs = Assign(&plan);
+  std::set<const void *> blocks(outputs.begin(), outputs.end());
+  ASSERT_LT(blocks.size(), kernel_num);
+  // a kernel never writes the block it reads
+  for (size_t i = 1; i < outputs.size(); ++i) {
+    ASSERT_NE(outputs[i], outputs[i - 1]);
+  }
+}
+
+// without the reuse every output has a block of its own
+TEST_F(TestCPUSimpleMemPlan, NaiveWithoutReuse) {
+  MsContext::GetInstance()->set_enable_mem_reuse(false);
+  const size_t kernel_num = 5;
+  NewChain(kernel_num);
+  CPUSimpleMemPlan plan;
+  plan.MemPlan(graph_.get());
+  ASSERT_FALSE(plan.IsGraphMemReused(graph_.get()));
+  ASSERT_EQ(plan.GetGraphMemSize(graph_.get()), kernel_num * kTensorSize);
+
+  auto outputs = Assign(&plan);
+  std::set<const void *> blocks(outputs.begin(), outputs.end());
+  ASSERT_EQ(blocks.size(), kernel_num);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
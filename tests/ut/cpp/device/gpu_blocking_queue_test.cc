@@ -0,0 +1,67 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <vector>
+#include "common/common_test.h"
+#include "device/gpu/blocking_queue.h"
+
+namespace mindspore {
+namespace device {
+class TestGpuBlockingQueue : public UT::Common {
+ public:
+  TestGpuBlockingQueue() = default;
+};
+
+// the copies of a batch are pending in the stub stream until the event of the batch, the host buffers may only be
+// released once they are done
+TEST_F(TestGpuBlockingQueue, ReleaseAfterCopy) {
+  const size_t feature_size = 16;
+  const size_t label_size = 4;
+  const size_t capacity = 3;
+  std::vector<unsigned char> device(capacity * (feature_size + label_size), 0);
+  BlockingQueue queue;
+  ASSERT_EQ(queue.Create(device.data(), feature_size, label_size, capacity), SUCCESS);
+
+  std::vector<unsigned char> feature(feature_size, 1);
+  std::vector<unsigned char> label(label_size, 2);
+  std::vector<void *> released;
+  queue.RegisterRelease([&](void *addr) {
+    released.push_back(addr);
+    // the host buffer is reused at once
+    auto data = static_cast<unsigned char *>(addr);
+    auto size = addr == feature.data() ? feature_size : label_size;
+    std::fill(data, data + size, 0xff);
+  });
+  ASSERT_EQ(queue.Push(feature.data(), feature_size, label.data(), label_size, 1), SUCCESS);
+  ASSERT_TRUE(released.empty());
+
+  void *feature_addr = nullptr;
+  void *label_addr = nullptr;
+  size_t size = 0;
+  ASSERT_EQ(queue.Front(&feature_addr, &size, &label_addr, &size), SUCCESS);
+  ASSERT_EQ(released, std::vector<void *>({feature.data(), label.data()}));
+  ASSERT_EQ(feature_addr, device.data());
+  auto device_feature = static_cast<unsigned char *>(feature_addr);
+  auto device_label = static_cast<unsigned char *>(label_addr);
+  ASSERT_EQ(std::vector<unsigned char>(device_feature, device_feature + feature_size),
+            std::vector<unsigned char>(feature_size, 1));
+  ASSERT_EQ(std::vector<unsigned char>(device_label, device_label + label_size),
+            std::vector<unsigned char>(label_size, 2));
+  ASSERT_EQ(queue.Pop(), SUCCESS);
+  ASSERT_TRUE(queue.Destroy());
+}
+}  // namespace device
+}  // namespace mindspore
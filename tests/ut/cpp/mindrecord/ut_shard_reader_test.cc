@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <functional>
 #include <iostream>
@@ -209,5 +211,141 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Finish();
 }
+
+TEST_F(TestShardReader, TestShardReaderMmap) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet through memory maps");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name"};
+
+  ShardReader stream_dataset;
+  ASSERT_EQ(stream_dataset.Open(file_name, 4, column_list), SUCCESS);
+  stream_dataset.Launch(true);
+  ShardReader mmap_dataset;
+  ASSERT_EQ(mmap_dataset.Open(file_name, 4, column_list, {}, false, true), SUCCESS);
+  ASSERT_TRUE(mmap_dataset.get_use_mmap());
+  mmap_dataset.Launch(true);
+  ASSERT_EQ(mmap_dataset.get_num_rows(), stream_dataset.get_num_rows());
+
+  for (int64_t i = 0; i < stream_dataset.get_num_rows(); ++i) {
+    auto expected = stream_dataset.GetNextById(i, 0);
+    auto x = mmap_dataset.GetNextById(i, 0);
+    auto views = mmap_dataset.GetNextViewById(i);
+    ASSERT_EQ(expected.size(), 1);
+    ASSERT_EQ(x.size(), 1);
+    ASSERT_EQ(views.size(), 1);
+    const auto &blob = std::get<0>(expected[0]);
+    ASSERT_EQ(std::get<0>(x[0]), blob);
+    ASSERT_EQ(std::get<0>(views[0]).size, blob.size());
+    ASSERT_TRUE(std::equal(blob.begin(), blob.end(), std::get<0>(views[0]).data));
+    ASSERT_EQ(std::get<1>(x[0]), std::get<1>(expected[0]));
+    ASSERT_EQ(std::get<1>(views[0]), std::get<1>(expected[0]));
+  }
+  ASSERT_TRUE(mmap_dataset.GetNextViewById(mmap_dataset.get_num_rows()).empty());
+  // No views without the memory maps
+  ASSERT_TRUE(stream_dataset.GetNextViewById(0).empty());
+  stream_dataset.Close();
+  mmap_dataset.Close();
+}
+
+TEST_F(TestShardReader, TestShardReaderBlockMmap) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with block way through memory maps");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"label"};
+  const bool kBlockReader = true;
+
+  ShardReader stream_dataset;
+  ASSERT_EQ(stream_dataset.Open(file_name, 4, column_list, {}, kBlockReader), SUCCESS);
+  stream_dataset.Launch();
+  ShardReader mmap_dataset;
+  ASSERT_EQ(mmap_dataset.Open(file_name, 4, column_list, {}, kBlockReader, true), SUCCESS);
+  mmap_dataset.Launch();
+
+  int count = 0;
+  while (true) {
+    auto expected = stream_dataset.GetBlockNext();
+    auto x = mmap_dataset.GetBlockNext();
+    ASSERT_EQ(x.size(), expected.size());
+    if (x.empty()) break;
+    ASSERT_EQ(std::get<0>(x[0]), std::get<0>(expected[0]));
+    ASSERT_EQ(std::get<1>(x[0]), std::get<1>(expected[0]));
+    count++;
+  }
+  ASSERT_EQ(count, mmap_dataset.get_num_rows());
+  stream_dataset.Finish();
+  stream_dataset.Close();
+  mmap_dataset.Finish();
+  mmap_dataset.Close();
+}
+
+TEST_F(TestShardReader, TestShardReaderReadAhead) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with read ahead");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name"};
+
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open(file_name, 4, column_list), SUCCESS);
+  dataset.Launch(true);
+  for (bool use_mmap : {false, true}) {
+    ShardReader read_ahead_dataset;
+    // A small budget, so the read ahead has to wait for the consumer
+    read_ahead_dataset.set_read_ahead_size(1 << 16);
+    ASSERT_EQ(read_ahead_dataset.Open(file_name, 4, column_list, {}, false, use_mmap), SUCCESS);
+    read_ahead_dataset.Launch(true);
+    for (int epoch = 0; epoch < 2; ++epoch) {
+      for (int64_t i = 0; i < dataset.get_num_rows(); ++i) {
+        auto expected = dataset.GetNextById(i, 0);
+        auto x = read_ahead_dataset.GetNextById(i, static_cast<int32_t>(i % 4));
+        ASSERT_EQ(x.size(), 1);
+        ASSERT_EQ(std::get<0>(x[0]), std::get<0>(expected[0]));
+        ASSERT_EQ(std::get<1>(x[0]), std::get<1>(expected[0]));
+      }
+      // Starts the read ahead again from the first row
+      read_ahead_dataset.ShuffleTask();
+    }
+    read_ahead_dataset.Close();
+  }
+  dataset.Close();
+}
+
+TEST_F(TestShardReader, TestShardReaderBinaryIndex) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with binary index");
+  std::string file_name = "./imagenet.shard01";
+  // all columns in index, and the labels read from the raw pages
+  for (const auto &column_list : {std::vector<std::string>{"file_name", "label"}, std::vector<std::string>{}}) {
+    ShardReader index_dataset;
+    ASSERT_EQ(index_dataset.Open(file_name, 4, column_list), SUCCESS);
+    index_dataset.Launch(true);
+    auto file_paths = index_dataset.get_shard_header()->get_shard_addresses();
+
+    // Without the binary index the rows are looked up in the sqlite index
+    for (const auto &path : file_paths) {
+      ASSERT_EQ(rename(common::SafeCStr(path + kBinaryIndexSuffix), common::SafeCStr(path + ".idx.bak")), 0);
+    }
+    ShardReader sql_dataset;
+    ASSERT_EQ(sql_dataset.Open(file_name, 4, column_list), SUCCESS);
+    sql_dataset.Launch(true);
+    for (const auto &path : file_paths) {
+      ASSERT_EQ(rename(common::SafeCStr(path + ".idx.bak"), common::SafeCStr(path + kBinaryIndexSuffix)), 0);
+    }
+
+    ASSERT_EQ(index_dataset.get_num_rows(), sql_dataset.get_num_rows());
+    for (int64_t i = 0; i < sql_dataset.get_num_rows(); ++i) {
+      auto expected = sql_dataset.GetNextById(i, 0);
+      auto x = index_dataset.GetNextById(i, 0);
+      ASSERT_EQ(x.size(), 1);
+      ASSERT_EQ(std::get<0>(x[0]), std::get<0>(expected[0]));
+      ASSERT_EQ(std::get<1>(x[0]), std::get<1>(expected[0]));
+    }
+    for (const auto &rg : index_dataset.ReadRowGroupSummary()) {
+      auto expected = sql_dataset.ReadRowGroupBrief(std::get<1>(rg), std::get<0>(rg), column_list);
+      auto x = index_dataset.ReadRowGroupBrief(std::get<1>(rg), std::get<0>(rg), column_list);
+      ASSERT_EQ(std::get<0>(x), SUCCESS);
+      ASSERT_EQ(std::get<4>(x), std::get<4>(expected));
+      ASSERT_EQ(std::get<5>(x), std::get<5>(expected));
+    }
+    index_dataset.Close();
+    sql_dataset.Close();
+  }
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -15,6 +15,7 @@
  */
 
 #include <chrono>
+#include <cstdio>
 #include <cstring>
 #include <dirent.h>
 #include <iostream>
@@ -26,6 +27,7 @@
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 #include "mindrecord/include/shard_reader.h"
+#include "mindrecord/include/shard_segment.h"
 #include "mindrecord/include/shard_writer.h"
 #include "mindrecord/include/shard_index_generator.h"
 #include "securec.h"
@@ -1460,5 +1462,286 @@ TEST_F(TestShardWriter, TestOpenForAppend) {
   MS_LOG(INFO) << "end ---- TestOpenForAppend\n";
 }
 
+TEST_F(TestShardWriter, TestShardWriterCompression) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test write and read compressed blob pages"));
+
+  // compressible blobs, as the text and tabular features are
+  std::vector<std::vector<uint8_t>> bin_data;
+  for (int i = 0; i < 10; i++) {
+    std::string row;
+    for (int j = 0; j < 200 + i * 100; j++) {
+      row += "feature_" + std::to_string(j % 7) + "," + std::to_string(i) + ";";
+    }
+    bin_data.emplace_back(row.begin(), row.end());
+  }
+  bin_data.emplace_back(std::vector<uint8_t>{1, 2, 3});  // stored as it is, does not get smaller
+  std::vector<json> annotations;
+  for (int i = 0; i < static_cast<int>(bin_data.size()); i++) {
+    annotations.push_back(json{{"file_name", "sample_" + std::to_string(i)}, {"label", i}});
+  }
+  auto expected_blobs = bin_data;
+
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json =
+    R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  std::map<std::uint64_t, std::vector<json>> rawdatas;
+  rawdatas.insert(pair<uint64_t, vector<json>>(anno_schema_id, annotations));
+
+  std::vector<std::string> file_names;
+  for (int i = 1; i <= 2; i++) {
+    file_names.emplace_back(std::string("./compression.shard0") + std::to_string(i));
+  }
+  mindrecord::ShardWriter fw;
+  ASSERT_EQ(fw.Open(file_names), SUCCESS);
+  ASSERT_EQ(fw.set_compression("UNKNOWN"), FAILED);
+  ASSERT_EQ(fw.set_compression(kCompressionLz), SUCCESS);
+  ASSERT_EQ(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)), SUCCESS);
+  // the codec does not change once the header is set
+  ASSERT_EQ(fw.set_compression(kCompressionNone), FAILED);
+  ASSERT_EQ(fw.WriteRawData(rawdatas, bin_data), SUCCESS);
+  ASSERT_EQ(fw.Commit(), SUCCESS);
+
+  std::string filename = "./compression.shard01";
+  mindrecord::ShardIndexGenerator sg{filename};
+  sg.Build();
+  ASSERT_EQ(sg.WriteToDatabase(), SUCCESS);
+
+  ShardHeader sh;
+  ASSERT_EQ(sh.Build(filename), SUCCESS);
+  ASSERT_EQ(sh.get_compression(), kCompressionLz);
+  // the readers of the files without compression refuse the compressed ones
+  ASSERT_EQ(sh.get_version(), "2.1");
+  auto blob_page = sh.GetPageByGroupId(0, 0);
+  ASSERT_EQ(blob_page.first, SUCCESS);
+  ASSERT_EQ(blob_page.second->get_compression(), kCompressionLz);
+  uint64_t raw_size = 0;
+  for (const auto &blob : expected_blobs) {
+    raw_size += blob.size();
+  }
+  ASSERT_LT(sh.GetPageByGroupId(0, 0).second->get_page_size() + sh.GetPageByGroupId(0, 1).second->get_page_size(),
+            raw_size / 2);
+
+  // row reader, with and without the memory maps
+  for (bool use_mmap : {false, true}) {
+    ShardReader dataset;
+    ASSERT_EQ(dataset.Open(filename, 4, {"file_name", "label"}, {}, false, use_mmap), SUCCESS);
+    dataset.Launch(true);
+    ASSERT_EQ(dataset.get_num_rows(), static_cast<int64_t>(expected_blobs.size()));
+    for (int64_t i = 0; i < dataset.get_num_rows(); ++i) {
+      auto x = dataset.GetNextById(i, 0);
+      ASSERT_EQ(x.size(), 1);
+      int label = std::get<1>(x[0])["label"];
+      ASSERT_EQ(std::get<0>(x[0]), expected_blobs[label]);
+    }
+    ASSERT_TRUE(dataset.GetNextViewById(0).empty());
+    dataset.Close();
+  }
+
+  // block reader
+  ShardReader block_dataset;
+  ASSERT_EQ(block_dataset.Open(filename, 4, {"label"}, {}, true), SUCCESS);
+  block_dataset.Launch();
+  int count = 0;
+  while (true) {
+    auto x = block_dataset.GetBlockNext();
+    if (x.empty()) break;
+    int label = std::get<1>(x[0])["label"];
+    ASSERT_EQ(std::get<0>(x[0]), expected_blobs[label]);
+    count++;
+  }
+  ASSERT_EQ(count, static_cast<int>(expected_blobs.size()));
+  block_dataset.Close();
+
+  for (const auto &name : file_names) {
+    auto filename_db = name + ".db";
+    remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(name));
+  }
+}
+
+TEST_F(TestShardWriter, TestShardWriterIncrementalIndex) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test index only the rows appended"));
+  std::string filename = "./IncrementalIndex.shard01";
+  auto make_rows = [](int start, int count, std::vector<std::vector<uint8_t>> *bin_data,
+                      std::vector<json> *annotations) {
+    for (int i = start; i < start + count; i++) {
+      // several rows to a page, so appending fills the last pages and adds new ones
+      bin_data->emplace_back(std::vector<uint8_t>(4000 + i, static_cast<uint8_t>(i)));
+      annotations->push_back(json{{"file_name", "sample_" + std::to_string(i)}, {"label", i}});
+    }
+  };
+  auto read_all = [&filename]() {
+    std::vector<std::tuple<std::vector<uint8_t>, json>> rows;
+    ShardReader dataset;
+    EXPECT_EQ(dataset.Open(filename, 4, {"file_name", "label"}), SUCCESS);
+    dataset.Launch(true);
+    for (int64_t i = 0; i < dataset.get_num_rows(); ++i) {
+      auto x = dataset.GetNextById(i, 0);
+      rows.insert(rows.end(), x.begin(), x.end());
+    }
+    dataset.Close();
+    return rows;
+  };
+
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json =
+    R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  {
+    std::vector<std::vector<uint8_t>> bin_data;
+    std::vector<json> annotations;
+    make_rows(0, 20, &bin_data, &annotations);
+    std::map<std::uint64_t, std::vector<json>> rawdatas{{anno_schema_id, annotations}};
+    mindrecord::ShardWriter fw;
+    ASSERT_EQ(fw.Open({filename}), SUCCESS);
+    ASSERT_EQ(fw.set_page_size(1 << 15), SUCCESS);
+    ASSERT_EQ(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)), SUCCESS);
+    ASSERT_EQ(fw.WriteRawData(rawdatas, bin_data), SUCCESS);
+    ASSERT_EQ(fw.Commit(), SUCCESS);
+    mindrecord::ShardIndexGenerator sg{filename};
+    sg.Build();
+    ASSERT_EQ(sg.WriteToDatabase(), SUCCESS);
+  }
+  int num_rows = 20;
+  for (int append = 0; append < 3; append++) {
+    std::vector<std::vector<uint8_t>> bin_data;
+    std::vector<json> annotations;
+    make_rows(num_rows, 15, &bin_data, &annotations);
+    num_rows += 15;
+    std::map<std::uint64_t, std::vector<json>> rawdatas{{anno_schema_id, annotations}};
+    mindrecord::ShardWriter fw;
+    ASSERT_EQ(fw.OpenForAppend(filename), SUCCESS);
+    ASSERT_EQ(fw.WriteRawData(rawdatas, bin_data), SUCCESS);
+    ASSERT_EQ(fw.Commit(), SUCCESS);
+    mindrecord::ShardIndexGenerator sg{filename, true};
+    sg.Build();
+    ASSERT_EQ(sg.WriteToDatabase(), SUCCESS);
+  }
+  auto incremental_rows = read_all();
+  ASSERT_EQ(incremental_rows.size(), static_cast<size_t>(num_rows));
+
+  // indexed from scratch
+  remove(common::SafeCStr(filename + ".db"));
+  remove(common::SafeCStr(filename + kBinaryIndexSuffix));
+  mindrecord::ShardIndexGenerator sg{filename};
+  sg.Build();
+  ASSERT_EQ(sg.WriteToDatabase(), SUCCESS);
+  auto expected_rows = read_all();
+  ASSERT_EQ(incremental_rows, expected_rows);
+
+  // the sqlite index holds the same rows
+  ASSERT_EQ(rename(common::SafeCStr(filename + kBinaryIndexSuffix), common::SafeCStr(filename + ".idx.bak")), 0);
+  ASSERT_EQ(read_all(), expected_rows);
+
+  remove(common::SafeCStr(filename + ".idx.bak"));
+  remove(common::SafeCStr(filename + ".db"));
+  remove(common::SafeCStr(filename));
+}
+
+TEST_F(TestShardWriter, TestShardWriterBinaryRawFormat) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test write raw rows laid out by the schema"));
+  json schema_json = R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "id": {"type": "int64"},
+                         "score": {"type": "float32"}, "weight": {"type": "float64"}, "data": {"type": "bytes"}})"_json;
+  std::vector<std::vector<uint8_t>> bin_data;
+  std::vector<json> annotations;
+  for (int i = 0; i < 30; i++) {
+    bin_data.emplace_back(std::vector<uint8_t>(100 + i, static_cast<uint8_t>(i)));
+    // float32 keeps the scores exactly
+    annotations.push_back(json{{"file_name", "sample_" + std::to_string(i)},
+                               {"label", i - 10},
+                               {"id", (int64_t{1} << 40) + i},
+                               {"score", i * 0.5},
+                               {"weight", i / 3.0}});
+  }
+  auto write = [&](const std::string &filename, const std::string &raw_format) {
+    mindrecord::ShardHeader header_data;
+    int schema_id = header_data.AddSchema(mindrecord::Schema::Build("annotation", schema_json));
+    std::map<std::uint64_t, std::vector<json>> rawdatas{{schema_id, annotations}};
+    std::vector<std::vector<uint8_t>> blobs(bin_data);
+    mindrecord::ShardWriter fw;
+    ASSERT_EQ(fw.Open({filename}), SUCCESS);
+    ASSERT_EQ(fw.set_raw_format(raw_format), SUCCESS);
+    ASSERT_EQ(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)), SUCCESS);
+    ASSERT_EQ(fw.WriteRawData(rawdatas, blobs), SUCCESS);
+    ASSERT_EQ(fw.Commit(), SUCCESS);
+    mindrecord::ShardIndexGenerator sg{filename};
+    sg.Build();
+    ASSERT_EQ(sg.WriteToDatabase(), SUCCESS);
+  };
+  auto read_all = [](const std::string &filename, const std::vector<std::string> &columns) {
+    std::vector<std::tuple<std::vector<uint8_t>, json>> rows;
+    ShardReader dataset;
+    EXPECT_EQ(dataset.Open(filename, 4, columns), SUCCESS);
+    dataset.Launch(true);
+    for (int64_t i = 0; i < dataset.get_num_rows(); ++i) {
+      auto x = dataset.GetNextById(i, 0);
+      rows.insert(rows.end(), x.begin(), x.end());
+    }
+    dataset.Close();
+    return rows;
+  };
+
+  std::string msgpack_file = "./RawFormatMsgpack.shard01";
+  std::string binary_file = "./RawFormatBinary.shard01";
+  write(msgpack_file, kRawFormatMsgpack);
+  write(binary_file, kRawFormatBinary);
+
+  // The readers, the label queries and the index get the same fields from both formats
+  auto expected_rows = read_all(msgpack_file, {});
+  ASSERT_EQ(expected_rows.size(), annotations.size());
+  ASSERT_EQ(read_all(binary_file, {}), expected_rows);
+  ASSERT_EQ(read_all(binary_file, {"weight", "file_name"}), read_all(msgpack_file, {"weight", "file_name"}));
+  ShardSegment msgpack_segment;
+  ShardSegment binary_segment;
+  ASSERT_EQ(msgpack_segment.Open(msgpack_file, 4), SUCCESS);
+  ASSERT_EQ(binary_segment.Open(binary_file, 4), SUCCESS);
+  ASSERT_EQ(binary_segment.get_shard_header()->get_raw_format(), kRawFormatBinary);
+  // the readers of msgpack rows refuse the binary ones
+  ASSERT_EQ(binary_segment.get_shard_header()->get_version(), "2.2");
+  ASSERT_EQ(msgpack_segment.get_shard_header()->get_version(), "2.0");
+  ASSERT_EQ(msgpack_segment.SetCategoryField("label"), SUCCESS);
+  ASSERT_EQ(binary_segment.SetCategoryField("label"), SUCCESS);
+  auto msgpack_page = msgpack_segment.ReadAllAtPageByName("0", 0, 10);
+  auto binary_page = binary_segment.ReadAllAtPageByName("0", 0, 10);
+  ASSERT_EQ(binary_page.first, SUCCESS);
+  ASSERT_EQ(binary_page.second.size(), static_cast<size_t>(1));
+  ASSERT_EQ(binary_page.second, msgpack_page.second);
+
+  // The encoded rows are viewed in the mapped file and decoded without the reader
+  ShardReader dataset;
+  dataset.set_keep_encoded_labels(true);
+  ASSERT_EQ(dataset.Open(binary_file, 4, {"data", "file_name", "label", "id", "score", "weight"}, {}, false, true),
+            SUCCESS);
+  dataset.Launch(true);
+  const ShardRawCodec *codec = dataset.get_raw_codec();
+  ASSERT_TRUE(codec != nullptr);
+  ASSERT_EQ(codec->get_fields().size(), static_cast<size_t>(5));
+  for (int64_t i = 0; i < dataset.get_num_rows(); ++i) {
+    auto x = dataset.GetNextViewById(i);
+    ASSERT_EQ(x.size(), static_cast<size_t>(1));
+    auto encoded_label = dataset.GetEncodedLabelView(i);
+    ASSERT_TRUE(encoded_label.data != nullptr);
+    json label;
+    ASSERT_EQ(codec->Decode(encoded_label.data, encoded_label.size, {}, &label), SUCCESS);
+    ASSERT_EQ(label, std::get<1>(expected_rows[i]));
+    const uint8_t *value = nullptr;
+    uint64_t size = 0;
+    ASSERT_TRUE(codec->GetField(encoded_label.data, encoded_label.size, codec->GetFieldId("file_name"), &value, &size));
+    ASSERT_EQ(std::string(reinterpret_cast<const char *>(value), size), label["file_name"].get<std::string>());
+  }
+  dataset.Close();
+
+  for (const auto &filename : {msgpack_file, binary_file}) {
+    remove(common::SafeCStr(filename + kBinaryIndexSuffix));
+    remove(common::SafeCStr(filename + ".db"));
+    remove(common::SafeCStr(filename));
+  }
+}
+
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -176,6 +176,31 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+TEST_F(TestOptOpt, IndexedIdempotent) {
+  FuncGraphPtr before = getPyFun.CallAndParseRet("test_idempotent", "before_2");
+  FuncGraphPtr after = getPyFun.CallAndParseRet("test_idempotent", "after");
+
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after);
+
+  // the graph is the only root, the transform visits the nodes of P from the primitive index
+  FuncGraphPtr before_clone = BasicClone(before);
+  OptimizerPtr optimizer = std::make_shared<Optimizer>("ut_test", std::make_shared<pipeline::Resource>());
+  FuncGraphManagerPtr manager = optimizer->manager();
+  manager->KeepRoots({before_clone});
+  ASSERT_EQ(manager->primitive_nodes()["P"].size(), 5);
+
+  SubstitutionList eq({idempotent_P});
+  ASSERT_TRUE(eq(before_clone, optimizer));
+  ASSERT_TRUE(Isomorphic(before_clone, after, &equiv_graph, &equiv_node));
+
+  // the replaced nodes left the index
+  ASSERT_EQ(manager->primitive_nodes()["P"].size(), 1);
+  for (auto &node : manager->primitive_nodes()["P"]) {
+    ASSERT_TRUE(manager->all_nodes().contains(node));
+  }
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
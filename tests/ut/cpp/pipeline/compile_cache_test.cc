@@ -0,0 +1,140 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "ir/func_graph_cloner.h"
+#include "ir/meta_tensor.h"
+#include "operator/ops.h"
+#include "pipeline/compile_cache.h"
+#include "pipeline/static_analysis/abstract_value.h"
+#include "utils/graph_utils.h"
+
+namespace mindspore {
+namespace pipeline {
+class TestCompileCache : public UT::Common {
+ public:
+  TestCompileCache() : getPyFun("gtest_input.optimizer.opt_test", true) {}
+
+  std::string GetKey(const FuncGraphPtr& func_graph, const abstract::AbstractBasePtrList& args_spec) {
+    auto res = std::make_shared<Resource>();
+    res->set_func_graph(func_graph);
+    res->set_args_spec(args_spec);
+    CompileCache cache("/tmp");
+    if (!cache.Fingerprint(res, VmPipeline())) {
+      return "";
+    }
+    return cache.key();
+  }
+
+  ResourcePtr NewResource(const FuncGraphPtr& func_graph, const abstract::AbstractBasePtrList& args_spec) {
+    auto res = std::make_shared<Resource>();
+    res->set_func_graph(func_graph);
+    res->set_args_spec(args_spec);
+    return res;
+  }
+
+  // x + w of the given shape, w is a constant tensor which is pickled aside the graph
+  FuncGraphPtr NewAddGraph(const std::vector<int>& shape) {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto abs = std::make_shared<abstract::AbstractTensor>(kFloat32, shape);
+    auto x = func_graph->add_parameter();
+    x->set_name("x");
+    x->set_abstract(abs);
+    auto w = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, shape);
+    auto data = static_cast<float*>(w->data_c(true));
+    for (int i = 0; i < w->DataSize(); ++i) {
+      data[i] = static_cast<float>(i);
+    }
+    auto add = func_graph->NewCNode({NewValueNode(prim::kPrimTensorAdd), x, NewValueNode(w)});
+    add->set_abstract(abs);
+    func_graph->set_output(add);
+    return func_graph;
+  }
+
+ public:
+  UT::PyFuncGraphFetcher getPyFun;
+};
+
+TEST_F(TestCompileCache, FingerprintKey) {
+  FuncGraphPtr before = getPyFun.CallAndParseRet("test_idempotent", "before_1");
+  FuncGraphPtr after = getPyFun.CallAndParseRet("test_idempotent", "after");
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after);
+
+  std::vector<int> shape = {2, 3};
+  abstract::AbstractBasePtrList args_spec = {std::make_shared<abstract::AbstractTensor>(kFloat32, shape)};
+  std::string key = GetKey(before, args_spec);
+  ASSERT_FALSE(key.empty());
+
+  // the key does not depend on the ids of the nodes
+  ASSERT_EQ(GetKey(BasicClone(before), args_spec), key);
+  ASSERT_NE(GetKey(after, args_spec), key);
+
+  shape = {4, 3};
+  abstract::AbstractBasePtrList other_spec = {std::make_shared<abstract::AbstractTensor>(kFloat32, shape)};
+  ASSERT_NE(GetKey(before, other_spec), key);
+}
+
+TEST_F(TestCompileCache, StoreAndLoad) {
+  std::string path = "/tmp/compile_cache_test_" + std::to_string(getpid());
+  ASSERT_EQ(mkdir(path.c_str(), S_IRWXU), 0);
+  std::vector<int> shape = {2, 3};
+  abstract::AbstractBasePtrList args_spec = {std::make_shared<abstract::AbstractTensor>(kFloat32, shape)};
+  FuncGraphPtr func_graph = NewAddGraph(shape);
+
+  // the graph is exported and imported again by the store, it reloads the same so it is stored
+  CompileCache cache(path);
+  auto res = NewResource(func_graph, args_spec);
+  ASSERT_TRUE(cache.Fingerprint(res, VmPipeline()));
+  cache.Store(res);
+  std::string entry = path + "/" + cache.key();
+  struct stat st;
+  ASSERT_EQ(stat(entry.c_str(), &st), 0);
+
+  // the same graph in another process, the stored one is loaded with the parameters bound by name
+  CompileCache other(path);
+  auto other_res = NewResource(BasicClone(func_graph), args_spec);
+  ASSERT_TRUE(other.Fingerprint(other_res, VmPipeline()));
+  ASSERT_EQ(other.key(), cache.key());
+  ASSERT_TRUE(other.Load(other_res));
+  FuncGraphPtr loaded = other_res->func_graph();
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_EQ(loaded->parameters().size(), 1);
+  ASSERT_EQ(loaded->parameters()[0]->cast<ParameterPtr>()->name(), "x");
+  FuncGraphPairMapEquiv equiv_graph;
+  NodeMapEquiv equiv_node;
+  ASSERT_TRUE(Isomorphic(func_graph, loaded, &equiv_graph, &equiv_node));
+  ASSERT_EQ(loaded->output()->abstract()->ToString(), func_graph->output()->abstract()->ToString());
+
+  // an entry other users may have written is not unpickled
+  ASSERT_EQ(chmod(entry.c_str(), S_IRWXU | S_IRWXG | S_IRWXO), 0);
+  ASSERT_FALSE(other.Load(NewResource(BasicClone(func_graph), args_spec)));
+  ASSERT_EQ(chmod(entry.c_str(), S_IRWXU), 0);
+  ASSERT_EQ(chmod(path.c_str(), S_IRWXU | S_IWOTH), 0);
+  ASSERT_FALSE(other.Load(NewResource(BasicClone(func_graph), args_spec)));
+
+  ASSERT_EQ(system(("rm -rf " + path).c_str()), 0);
+}
+}  // namespace pipeline
+}  // namespace mindspore
@@ -1155,5 +1155,38 @@ TEST_F(TestPrim, test_DictGetItem2) {
 }
 */
 
+TEST_F(TestPrim, test_py_infer_cache) {
+  // a cache of two results
+  PyInferCache cache(2);
+  auto prim = std::make_shared<Primitive>("infer_cache_prim");
+  AbstractBasePtrList args1 = {std::make_shared<AbstractScalar>(1)};
+  AbstractBasePtrList args2 = {std::make_shared<AbstractScalar>(2)};
+  AbstractBasePtrList args3 = {std::make_shared<AbstractScalar>(3)};
+  AbstractBasePtr res = std::make_shared<AbstractScalar>(10);
+  cache.Put(prim, "attrs", args1, res);
+
+  // a hit for equal arguments, a miss when the attributes changed or for another primitive
+  AbstractBasePtrList args1_copy = {std::make_shared<AbstractScalar>(1)};
+  auto hit = cache.Get(prim, "attrs", args1_copy);
+  ASSERT_TRUE(hit != nullptr);
+  ASSERT_TRUE(*hit == *res);
+  ASSERT_TRUE(cache.Get(prim, "changed_attrs", args1) == nullptr);
+  ASSERT_TRUE(cache.Get(std::make_shared<Primitive>("infer_cache_prim"), "attrs", args1) == nullptr);
+
+  // the least recently used result is evicted
+  cache.Put(prim, "attrs", args2, res);
+  ASSERT_TRUE(cache.Get(prim, "attrs", args1) != nullptr);
+  cache.Put(prim, "attrs", args3, res);
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_TRUE(cache.Get(prim, "attrs", args2) == nullptr);
+  ASSERT_TRUE(cache.Get(prim, "attrs", args1) != nullptr);
+  ASSERT_TRUE(cache.Get(prim, "attrs", args3) != nullptr);
+
+  // the results do not keep the primitive alive
+  std::weak_ptr<Primitive> weak_prim = prim;
+  prim = nullptr;
+  ASSERT_TRUE(weak_prim.expired());
+}
+
 }  // namespace abstract
 }  // namespace mindspore
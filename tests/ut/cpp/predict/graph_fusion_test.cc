@@ -0,0 +1,164 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "predict/converter/graph_fusion.h"
+
+namespace mindspore {
+namespace executor {
+class TestGraphFusion : public UT::Common {
+ public:
+  TestGraphFusion() = default;
+  void SetUp() override { graph_.reset(new SubGraphDefT()); }
+
+  uint32_t AddTensor(const std::vector<int> &dims, const std::vector<float> &data = {}) {
+    std::unique_ptr<TensorDefT> tensor(new TensorDefT());
+    tensor->dataType = predict::DataType_DT_FLOAT;
+    tensor->format = predict::Format_NCHW;
+    tensor->dims = dims;
+    tensor->data.resize(data.size() * sizeof(float));
+    if (!data.empty()) {
+      (void)memcpy(tensor->data.data(), data.data(), tensor->data.size());
+    }
+    graph_->allTensors.push_back(std::move(tensor));
+    return static_cast<uint32_t>(graph_->allTensors.size() - 1);
+  }
+
+  template <typename T>
+  NodeDef *AddNode(const std::string &name, predict::OpT type, std::unique_ptr<T> attr,
+                   const std::vector<uint32_t> &inputs, const std::vector<uint32_t> &outputs) {
+    std::unique_ptr<NodeDef> node(new NodeDef());
+    node->opDef.reset(new predict::OpDefT());
+    node->opDef->name = name;
+    node->opDef->attr.type = type;
+    node->opDef->attr.value = attr.release();
+    node->opDef->inputIndex = inputs;
+    node->opDef->outputIndex = outputs;
+    graph_->nodes.push_back(std::move(node));
+    return graph_->nodes.back().get();
+  }
+
+  NodeDef *AddActivation(const std::string &name, predict::ActivationType act_type, uint32_t input, uint32_t output) {
+    std::unique_ptr<predict::ActivationT> attr(new predict::ActivationT());
+    attr->type = act_type;
+    return AddNode(name, predict::OpT_Activation, std::move(attr), {input}, {output});
+  }
+
+  std::vector<float> GetData(uint32_t idx) const {
+    auto &tensor = graph_->allTensors[idx];
+    std::vector<float> data(tensor->data.size() / sizeof(float));
+    (void)memcpy(data.data(), tensor->data.data(), tensor->data.size());
+    return data;
+  }
+
+  std::unique_ptr<SubGraphDefT> graph_;
+};
+
+// conv -> batch norm -> bias add -> relu, all of them into the conv
+TEST_F(TestGraphFusion, ConvBatchNormBiasAddRelu) {
+  auto x = AddTensor({1, 1, 2, 2});
+  auto weight = AddTensor({2, 1, 1, 1}, {1.0f, 2.0f});
+  auto conv_out = AddTensor({1, 2, 2, 2});
+  auto scale = AddTensor({2}, {2.0f, 1.0f});
+  auto offset = AddTensor({2}, {0.5f, -1.0f});
+  auto mean = AddTensor({2}, {1.0f, 3.0f});
+  auto variance = AddTensor({2}, {3.0f, 0.0f});
+  auto bn_out = AddTensor({1, 2, 2, 2});
+  auto bn_mean = AddTensor({2});
+  auto bias = AddTensor({2}, {0.25f, 0.75f});
+  auto bias_out = AddTensor({1, 2, 2, 2});
+  auto relu_out = AddTensor({1, 2, 2, 2});
+  graph_->inputIndex = {x};
+  graph_->outputIndex = {relu_out};
+
+  std::unique_ptr<predict::Conv2DT> conv(new predict::Conv2DT());
+  conv->channelIn = 1;
+  conv->channelOut = 2;
+  AddNode("conv", predict::OpT_Conv2D, std::move(conv), {x, weight}, {conv_out});
+  std::unique_ptr<predict::FusedBatchNormT> bn(new predict::FusedBatchNormT());
+  bn->epsilon = 1.0f;
+  AddNode("bn", predict::OpT_FusedBatchNorm, std::move(bn), {conv_out, scale, offset, mean, variance},
+          {bn_out, bn_mean});
+  AddNode("bias_add", predict::OpT_BiasAdd, std::unique_ptr<predict::BiasAddT>(new predict::BiasAddT()),
+          {bn_out, bias}, {bias_out});
+  AddActivation("relu", predict::ActivationType_RELU, bias_out, relu_out);
+
+  GraphFusion fusion(graph_.get());
+  ASSERT_EQ(fusion.Run(), 3);
+  ASSERT_EQ(graph_->nodes.size(), 1);
+  auto &op = graph_->nodes[0]->opDef;
+  auto attr = op->attr.AsConv2D();
+  ASSERT_NE(attr, nullptr);
+  ASSERT_TRUE(attr->hasBias);
+  ASSERT_EQ(attr->activationType, predict::ActivationType_RELU);
+  // x, weight, the output of relu and the new bias are left
+  ASSERT_EQ(graph_->allTensors.size(), 4);
+  ASSERT_EQ(op->inputIndex.size(), 3);
+  ASSERT_EQ(op->outputIndex, graph_->outputIndex);
+  ASSERT_EQ(graph_->inputIndex, std::vector<uint32_t>({op->inputIndex[0]}));
+  // factor = scale / sqrt(variance + epsilon) = {1, 1}
+  auto new_weight = GetData(op->inputIndex[1]);
+  auto new_bias = GetData(op->inputIndex[2]);
+  ASSERT_EQ(new_weight.size(), 2);
+  ASSERT_FLOAT_EQ(new_weight[0], 1.0f);
+  ASSERT_FLOAT_EQ(new_weight[1], 2.0f);
+  ASSERT_EQ(new_bias.size(), 2);
+  ASSERT_FLOAT_EQ(new_bias[0], -1.0f * 1.0f + 0.5f + 0.25f);
+  ASSERT_FLOAT_EQ(new_bias[1], -3.0f * 1.0f - 1.0f + 0.75f);
+}
+
+// matmul -> bias add -> relu6, and a matmul whose output is an output of the graph is kept
+TEST_F(TestGraphFusion, MatMulBiasAddRelu6) {
+  auto a = AddTensor({4, 3});
+  auto b = AddTensor({3, 5});
+  auto mm_out = AddTensor({4, 5});
+  auto bias = AddTensor({5}, {1, 2, 3, 4, 5});
+  auto bias_out = AddTensor({4, 5});
+  auto relu_out = AddTensor({4, 5});
+  auto mm2_out = AddTensor({4, 5});
+  auto relu2_out = AddTensor({4, 5});
+  graph_->inputIndex = {a};
+  graph_->outputIndex = {relu_out, mm2_out, relu2_out};
+
+  AddNode("matmul", predict::OpT_MatMul, std::unique_ptr<predict::MatMulT>(new predict::MatMulT()), {a, b},
+          {mm_out});
+  AddNode("bias_add", predict::OpT_BiasAdd, std::unique_ptr<predict::BiasAddT>(new predict::BiasAddT()),
+          {mm_out, bias}, {bias_out});
+  AddActivation("relu6", predict::ActivationType_RELU6, bias_out, relu_out);
+  AddNode("matmul2", predict::OpT_MatMul, std::unique_ptr<predict::MatMulT>(new predict::MatMulT()), {a, b},
+          {mm2_out});
+  AddActivation("relu6_2", predict::ActivationType_RELU6, mm2_out, relu2_out);
+
+  GraphFusion fusion(graph_.get());
+  ASSERT_EQ(fusion.Run(), 2);
+  ASSERT_EQ(graph_->nodes.size(), 3);
+  auto &op = graph_->nodes[0]->opDef;
+  auto attr = op->attr.AsMatMul();
+  ASSERT_NE(attr, nullptr);
+  ASSERT_TRUE(attr->hasBias);
+  ASSERT_EQ(attr->activationType, predict::ActivationType_RELU6);
+  ASSERT_EQ(GetData(op->inputIndex[2]), std::vector<float>({1, 2, 3, 4, 5}));
+  ASSERT_EQ(op->outputIndex, std::vector<uint32_t>({graph_->outputIndex[0]}));
+  // the output of the second matmul is an output of the graph
+  ASSERT_EQ(graph_->nodes[1]->opDef->attr.AsMatMul()->activationType, predict::ActivationType_NO_ACTIVATION);
+  ASSERT_EQ(graph_->allTensors.size(), 6);
+}
+}  // namespace executor
+}  // namespace mindspore
@@ -31,6 +31,12 @@ class SessionBasicTest : public UT::Common {
   void TearDown() override {}
 };
 
+class RunOpGraphSession : public AscendSession {
+ public:
+  using SessionBasic::AddRunOpGraph;
+  using SessionBasic::GetRunOpGraph;
+};
+
 TEST_F(SessionBasicTest, ConstructKernelGraph) {
   /*
    * define kernel graph:
@@ -94,5 +100,27 @@ TEST_F(SessionBasicTest, ConstructKernelGraph) {
   EXPECT_EQ(AnfAlgo::GetCNodeName(new_outputs[0]), prim::kPrimMul->name());
 };
 
+TEST_F(SessionBasicTest, RunOpGraphCache) {
+  RunOpGraphSession sess;
+  sess.Init(0);
+  auto first_graph = std::make_shared<KernelGraph>();
+  sess.AddRunOpGraph("first", first_graph);
+  EXPECT_EQ(sess.GetRunOpGraph("first"), first_graph);
+  EXPECT_EQ(sess.GetRunOpGraph("second"), nullptr);
+
+  // the least recently used graph is dropped when the cache is full
+  const size_t graph_num = 1024;
+  auto second_graph = std::make_shared<KernelGraph>();
+  sess.AddRunOpGraph("second", second_graph);
+  for (size_t i = 2; i < graph_num; ++i) {
+    sess.AddRunOpGraph(std::to_string(i), std::make_shared<KernelGraph>());
+  }
+  EXPECT_EQ(sess.GetRunOpGraph("first"), first_graph);
+  sess.AddRunOpGraph("last", std::make_shared<KernelGraph>());
+  EXPECT_EQ(sess.GetRunOpGraph("second"), nullptr);
+  EXPECT_EQ(sess.GetRunOpGraph("first"), first_graph);
+  EXPECT_NE(sess.GetRunOpGraph("last"), nullptr);
+}
+
 }  // namespace session
 }  // namespace mindspore
\ No newline at end of file
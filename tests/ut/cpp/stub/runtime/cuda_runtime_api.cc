@@ -14,6 +14,32 @@
  * limitations under the License.
  */
 #include <cuda_runtime_api.h>
+#include <cstring>
+#include <deque>
+
+struct CUevent_st {
+  size_t mark;
+};
+
+namespace {
+struct PendingCopy {
+  void *dst;
+  const void *src;
+  size_t count;
+};
+std::deque<PendingCopy> pending_copies;
+size_t enqueued_copies = 0;
+size_t done_copies = 0;
+
+void RunCopies(size_t mark) {
+  while (done_copies < mark && !pending_copies.empty()) {
+    auto copy = pending_copies.front();
+    pending_copies.pop_front();
+    (void)memcpy(copy.dst, copy.src, copy.count);
+    done_copies++;
+  }
+}
+}  // namespace
 
 cudaError_t cudaMalloc(void **devPtr, size_t size) { return cudaSuccess; }
 
@@ -27,8 +53,43 @@ cudaError_t cudaStreamCreate(cudaStream_t *pStream) { return cudaSuccess; }
 
 cudaError_t cudaStreamDestroy(cudaStream_t stream) { return cudaSuccess; }
 
-cudaError_t cudaStreamSynchronize(cudaStream_t stream) { return cudaSuccess; }
+cudaError_t cudaStreamSynchronize(cudaStream_t stream) {
+  RunCopies(enqueued_copies);
+  return cudaSuccess;
+}
 
 cudaError_t cudaGetDeviceCount(int *count) { return cudaSuccess; }
 
 cudaError_t cudaSetDevice(int device) { return cudaSuccess; }
+
+const char *cudaGetErrorString(cudaError_t error) { return error == cudaSuccess ? "no error" : "error"; }
+
+cudaError_t cudaMemcpyAsync(void *dst, const void *src, size_t count, enum cudaMemcpyKind kind, cudaStream_t stream) {
+  if (dst == nullptr || src == nullptr) {
+    return cudaErrorInvalidValue;
+  }
+  pending_copies.push_back({dst, src, count});
+  enqueued_copies++;
+  return cudaSuccess;
+}
+
+// an event which is not recorded is complete
+cudaError_t cudaEventCreate(cudaEvent_t *event) {
+  *event = new CUevent_st{0};
+  return cudaSuccess;
+}
+
+cudaError_t cudaEventRecord(cudaEvent_t event, cudaStream_t stream) {
+  event->mark = enqueued_copies;
+  return cudaSuccess;
+}
+
+cudaError_t cudaEventSynchronize(cudaEvent_t event) {
+  RunCopies(event->mark);
+  return cudaSuccess;
+}
+
+cudaError_t cudaEventDestroy(cudaEvent_t event) {
+  delete event;
+  return cudaSuccess;
+}
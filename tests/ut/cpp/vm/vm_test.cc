@@ -56,5 +56,21 @@ TEST_F(TestCompileVM, FinalVM) {
   vm = nullptr;
 }
 
+TEST_F(TestCompileVM, FinalVMDecodedInsts) {
+  // args are pushed in reverse, so -1 refers to the first one
+  std::vector<std::pair<Instruction, VectorRef>> instr;
+  instr.push_back({Instruction::kPadStack, VectorRef({1})});
+  instr.push_back({Instruction::kTuple, VectorRef({-1, -2})});
+  instr.push_back({Instruction::kReturn, VectorRef({-1, 3})});
+  BackendPtr backend = std::make_shared<Backend>("vm");
+  FinalVM vm(instr, backend);
+  BaseRef out = vm.Eval(VectorRef({1, 2}));
+  ASSERT_TRUE(utils::isa<VectorRef>(out));
+  ASSERT_EQ(utils::cast<VectorRef>(out), VectorRef({1, 2}));
+  // the VM runs again from a fresh stack
+  out = vm.Eval(VectorRef({3, 4}));
+  ASSERT_EQ(utils::cast<VectorRef>(out), VectorRef({3, 4}));
+}
+
 }  // namespace compile
 }  // namespace mindspore
@@ -0,0 +1,86 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+import numpy as np
+import pytest
+
+import mindspore.dataset as ds
+from mindspore import log as logger
+
+DATA_DIR_TF = ["../data/dataset/testTFTestAllTypes/test.data"]
+SCHEMA_DIR_TF = "../data/dataset/testTFTestAllTypes/datasetSchema.json"
+
+
+def run_cache_repeat(cache_mem_size, spill_dir, repeat_count):
+    data1 = ds.TFRecordDataset(DATA_DIR_TF, SCHEMA_DIR_TF, shuffle=False)
+    data1 = data1.cache(cache_mem_size, spill_dir)
+    data1 = data1.repeat(repeat_count)
+
+    data2 = ds.TFRecordDataset(DATA_DIR_TF, SCHEMA_DIR_TF, shuffle=False)
+    expected = [item for item in data2.create_dict_iterator()]
+
+    num_rows = 0
+    for item in data1.create_dict_iterator():
+        for column, value in expected[num_rows % len(expected)].items():
+            np.testing.assert_array_equal(item[column], value)
+        num_rows += 1
+    assert num_rows == len(expected) * repeat_count
+
+
+def test_cache_in_memory():
+    """
+    cache all the rows in memory and replay them in each repeat.
+    """
+    logger.info("Test cache in memory")
+    run_cache_repeat(0, None, 3)
+
+
+def test_cache_spill(tmp_path):
+    """
+    spill all the rows to disk and replay them in each repeat.
+    """
+    logger.info("Test cache spill")
+    run_cache_repeat(1, str(tmp_path), 3)
+
+
+def test_cache_shuffle():
+    """
+    shuffle the cached rows in each repeat.
+    """
+    logger.info("Test cache shuffle")
+    data1 = ds.TFRecordDataset(DATA_DIR_TF, SCHEMA_DIR_TF, shuffle=False)
+    data1 = data1.cache()
+    data1 = data1.shuffle(4)
+    data1 = data1.repeat(2)
+    num_rows = 0
+    for _ in data1.create_dict_iterator():
+        num_rows += 1
+    assert num_rows == 24
+
+
+def test_cache_exception():
+    """
+    a limited cache_mem_size requires a spill_dir.
+    """
+    logger.info("Test cache exception")
+    data1 = ds.TFRecordDataset(DATA_DIR_TF, SCHEMA_DIR_TF, shuffle=False)
+    with pytest.raises(ValueError) as info:
+        data1.cache(1024)
+    assert "spill_dir" in str(info.value)
+
+
+if __name__ == '__main__':
+    test_cache_in_memory()
+    test_cache_shuffle()
+    test_cache_exception()
@@ -12,8 +12,13 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 # ==============================================================================
+import json
+
 import mindspore.dataset as ds
 
+DATA_DIR_TF = ["../data/dataset/testTFTestAllTypes/test.data"]
+SCHEMA_DIR_TF = "../data/dataset/testTFTestAllTypes/datasetSchema.json"
+
 
 def test_basic():
     ds.config.load('../data/dataset/declient.cfg')
@@ -37,5 +42,64 @@ def test_basic():
     assert ds.config.get_seed() == 5
 
 
-if __name__ == '__main__':
-    test_basic()
+def test_auto_num_workers():
+    ds.config.set_cpu_budget(2)
+    ds.config.set_auto_num_workers(True)
+    assert ds.config.get_cpu_budget() == 2
+    assert ds.config.get_auto_num_workers()
+
+    data = ds.TFRecordDataset(DATA_DIR_TF, SCHEMA_DIR_TF, shuffle=False)
+    data = data.map(input_columns=["col_sint32"], operations=(lambda x: x), num_parallel_workers=4)
+    data = data.batch(2, num_parallel_workers=4)
+    num_batches = 0
+    for _ in data.create_dict_iterator():
+        num_batches += 1
+    assert num_batches == 6
+
+    ds.config.set_auto_num_workers(False)
+    ds.config.set_cpu_budget(0)
+    assert not ds.config.get_auto_num_workers()
+
+
+def test_profiling(tmp_path):
+    ds.config.set_profiling_dir(str(tmp_path))
+    ds.config.set_monitor_sampling_interval(10)
+    assert ds.config.get_profiling_dir() == str(tmp_path)
+    assert ds.config.get_monitor_sampling_interval() == 10
+
+    data = ds.TFRecordDataset(DATA_DIR_TF, SCHEMA_DIR_TF, shuffle=False)
+    data = data.batch(2)
+    itr = data.create_dict_iterator()
+    for _ in itr:
+        pass
+    # The profiling is written when the pipeline is destroyed
+    itr.release()
+
+    summary_files = list(tmp_path.glob("pipeline_profiling_*.json"))
+    assert len(summary_files) == 1
+    assert len(list(tmp_path.glob("pipeline_trace_*.json"))) == 1
+    with open(str(summary_files[0])) as f:
+        summary = json.load(f)
+    rows = {op["op_type"].split("::")[-1]: op["rows"] for op in summary["ops"]}
+    assert rows["TFReaderOp"] == 12
+    assert rows["BatchOp"] == 6
+
+    ds.config.set_profiling_dir("")
+    ds.config.set_monitor_sampling_interval(100)
+    assert ds.config.get_profiling_dir() == ""
+
+
+def test_pinned_pool_size():
+    ds.config.set_pinned_pool_size(16)
+    assert ds.config.get_pinned_pool_size() == 16
+
+    # The batches from the pinned pool hold the same data
+    data = ds.TFRecordDataset(DATA_DIR_TF, SCHEMA_DIR_TF, shuffle=False)
+    data = data.batch(2)
+    pinned = [item["col_sint32"] for item in data.create_dict_iterator()]
+    ds.config.set_pinned_pool_size(0)
+    assert ds.config.get_pinned_pool_size() == 0
+    expected = [item["col_sint32"] for item in data.create_dict_iterator()]
+    assert len(pinned) == 6
+    for pinned_batch, expected_batch in zip(pinned, expected):
+        assert (pinned_batch == expected_batch).all()
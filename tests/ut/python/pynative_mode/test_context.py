@@ -71,6 +71,19 @@ def test_dump_target():
     assert context.get_context("save_dump_path") == "."
 
 
+def test_cpu_inter_op_parallel_num():
+    """ test_cpu_inter_op_parallel_num """
+    assert context.get_context("cpu_inter_op_parallel_num") == 1
+    with pytest.raises(TypeError):
+        context.set_context(cpu_inter_op_parallel_num="4")
+    with pytest.raises(ValueError):
+        context.set_context(cpu_inter_op_parallel_num=0)
+    context.set_context(cpu_inter_op_parallel_num=4)
+    assert context.get_context("cpu_inter_op_parallel_num") == 4
+    context.set_context(cpu_inter_op_parallel_num=1)
+    assert context.get_context("cpu_inter_op_parallel_num") == 1
+
+
 def test_set_context():
     """ test_set_context """
     context.set_context(mode=context.GRAPH_MODE, device_target="Ascend",